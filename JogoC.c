@@ -1,576 +1,1296 @@
-#include "raylib.h"
-#include <stdbool.h> 
-#include <string.h> 
-#include <stdio.h>
-#include <stdlib.h> // Fornece funes utilitrias como alocao de memria dinmica, usado para gerenciar as capivaras.
-#include <time.h> // Permite manipular e medir tempo, alm de inicializar o gerador de nmeros aleatrios.
-
-// ENUMS
-typedef enum Tela {
-    TELA_INICIAL,              // Tela de abertura do jogo
-    TELA_MENU,                 // Menu principal
-    TELA_CREDITOS,             // Tela que exibe os nomes dos criadores e informaes
-    TELA_JOGO,                 // Tela onde o jogo acontece
-    TELA_SELECAO_DIFICULDADE,  // Tela para o jogador escolher o nvel de dificuldade.
-    TELA_PAUSA                 // Tela exibida quando o jogo est pausado.
-} Tela;
-
-typedef enum Dificuldade {
-    FACIL,  
-    MEDIO, 
-    DIFICIL
-} Dificuldade;
-
-typedef enum TipoCapivara {
-    NORMAL,  // Capivara comum, d pontos positivos.
-    DOURADA, // Capivara dourada, d mais pontos.
-    CUTIA    // Cutia resulta em penalidade de pontos e ativa o efeito de chuva no modo dificil.
-} TipoCapivara;
-
-// STRUCTS
-typedef struct {
-    Rectangle rect;          // Posio e tamanho do animal na tela (x, y, largura, altura). Usado para desenho e deteco de coliso.
-    bool visivel;            // Indica se o animal est atualmente visvel para ser clicado.
-    double tempoVisivel;     // Tempo decorrido desde que o animal ficou visvel (para controle de durao).
-    double tempoTotalVisivel; // Tempo total que o animal deve permanecer visvel antes de desaparecer.
-    bool hit;                // Indica se o animal foi clicado (acertado).
-    double tempoAcertada;    // Tempo decorrido desde que o animal foi acertado (para animao de "atordoado").
-    bool machucada;          // Indica se o animal est no estado de "atordoado" aps ser acertado.
-    TipoCapivara tipo;       // O tipo especfico do animal (NORMAL, DOURADA, CUTIA), para determinar a textura e a pontuao.
-}CAPIVARA;
-
-// --- CONSTANTES DE DIFICULDADE ---
-// Estes arrays armazenam valores especficos para cada nvel de dificuldade(FACIL = 0, MEDIO = 1, DIFICIL = 2).
-
-const int CAPIVARAS_POR_DIFICULDADE[] = {3, 4, 5};       // Nmero total de posies para capivaras por dificuldade.
-const int MAX_SIMULTANEAS_INICIAL[] = {1, 2, 3};     // Mximo de capivaras visveis simultaneamente no incio do jogo.
-const float INTERVALO_MIN[] = {1.5f, 1.0f, 1.0f};    // Intervalo mnimo de tempo para uma nova capivara aparecer.
-const float INTERVALO_MAX[] = {3.0f, 2.0f, 1.5f};    // Intervalo mximo de tempo para uma nova capivara aparecer.
-const float TEMPO_VISIVEL_MIN[] = {1.0f, 0.8f, 0.5f}; // Tempo mnimo que uma capivara permanece visvel.
-const float TEMPO_VISIVEL_MAX[] = {1.8f, 1.5f, 0.8f}; // Tempo mximo que uma capivara permanece visvel.
-const int PENALIDADE_CUTIA[] = {-1, -2, -3};         // Pontos perdidos ao acertar uma cutia, por dificuldade.
-
-// --- VARIVEIS GLOBAIS DE TEXTURA ---
-// As texturas so carregadas uma nica vez na memria da GPU no incio do programa para otimizao.
-
-Texture2D fundoJogo;                 // Textura para o fundo da tela de jogo.
-Texture2D texturaCapivaraLevantada;  // Textura da capivara normal aparecendo.
-Texture2D texturaAnimalAtordoado;    // Textura genrica para qualquer animal que foi acertado.
-Texture2D texturaCutia;              // Textura da cutia.
-Texture2D texturaChuva;              // Textura do efeito de chuva.
-Texture2D texturaCapivaraDourada;    // Textura da capivara dourada.
-
-// --- VARIVEIS GLOBAIS DE ESTADO DO JOGO ---
-// Estas variveis controlam o estado atual e os dados gerais do jogo.
-
-Capivara* capivaras;             // Ponteiro para um array dinmico de estruturas Capivara. Ser alocado dinamicamente com base no nmero de capivaras por dificuldade.
-
-Dificuldade dificuldadeAtual;    // Armazena a dificuldade selecionada para a partida atual.
-double tempoRestanteJogo;        // Tempo restante da partida em segundos.
-int pontos;                      // Pontuao atual do jogador.
-bool jogoIniciado;               // true se o jogo comeou aps a contagem regressiva, false caso contrrio.
-bool jogoAcabou;                 // true se o tempo de jogo acabou, false caso contrrio.
-double contadorRegressivoInicial; // Contador para a contagem regressiva no incio da partida.
-double tempoChuvaAtual;          // Tempo restante para o efeito de chuva (em segundos).
-bool chovendo;                   // true se o efeito de chuva est ativo, false caso contrrio.
-int totalCapivaras;              // O nmero total de capivaras nesta partida.
-
-// --- DEFINIES DAS FUNES ---
-
-// Funo auxiliar para desenhar e gerenciar a interatividade de um boto genrico.
-
-bool DesenharBotao(Rectangle rect, const char* texto, Vector2 mousePos) {
-    Color cor = Fade(RED, 0.5f); // Cor padro do boto (vermelho semi-transparente).
-    bool clicado = false;        // Indicar se o boto foi clicado.
-
-    // Verifica se a posio do mouse est sobre o retngulo do boto.
-    if (CheckCollisionPointRec(mousePos, rect)) {
-        cor = BROWN; // Se o mouse estiver em cima, a cor muda para marrom.
-        // Verifica se o boto esquerdo do mouse foi pressionado.
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            clicado = true;
-        }
-    }
-    DrawRectangleRec(rect, cor); // Desenha o retngulo do boto com a cor definida.
-    // Desenha o texto do boto, centralizado horizontalmente e ajustado verticalmente.
-    DrawText(texto, rect.x + (rect.width - MeasureText(texto, 30)) / 2, rect.y + 15, 30, WHITE);
-    return clicado; // Retorna o estado do clique.
-}
-
-// Funo responsvel por inicializar todas as variveis e estados para uma nova partida.
-void InicializarJogo(Dificuldade dificuldade) {
-    srand(time(NULL)); // Inicializa o gerador de nmeros aleatrios. As capivaras apaream em posies, tipos e tempos aleatorios
-                       // 'time(NULL)' fornece uma semente diferente a cada execuo, garantindo aleatoriedade.
-    dificuldadeAtual = dificuldade; // Define a dificuldade escolhida para a partida.
-    pontos = 0;                     // Reseta a pontuao.
-    tempoRestanteJogo = 2 * 60;     // Define o tempo total de jogo para 2 minutos (120 segundos).
-    jogoIniciado = false;           // O jogo no comea imediatamente, espera a contagem regressiva.
-    jogoAcabou = false;             // O jogo no est acabado no incio.
-    contadorRegressivoInicial = 3.99; // Inicia a contagem regressiva (3, 2, 1, GO!). O .99  para garantir que o "GO!" aparea no tempo certo.
-    chovendo = false;               // A chuva no est ativa no incio.
-    tempoChuvaAtual = 0.0;          // Reseta o tempo da chuva.
-    totalCapivaras = CAPIVARAS_POR_DIFICULDADE[dificuldade]; // Define o nmero de slots de capivara com base na dificuldade.
-
-    // --- ALOCAO DINMICA DE MEMRIA PARA AS CAPIVARAS ---
-    //  crucial liberar a memria antiga antes de alocar uma nova, especialmente ao reiniciar o jogo, para evitar vazamentos de memria.
-    if (capivaras != NULL) { 
-        free(capivaras);    
-        capivaras = NULL;    
-    }
-    // Aloca um array de 'totalCapivaras' elementos do tipo Capivara.
-    capivaras = (Capivara*)malloc(totalCapivaras * sizeof(Capivara));
-
-    int larguraTela = GetScreenWidth(); // Obtm a largura atual da janela do jogo.
-    int larguraCapivara = 150;          // Largura base para a textura da capivara.
-    int alturaCapivara = 120;           // Altura base para a textura da capivara.
-    int espacamentoCapivara = 50;               // Espaamento horizontal entre cada capivara.
-    // Calcula a largura total que todas as capivaras e seus espaamentos ocuparo.
-    int larguraTotal = totalCapivaras * larguraCapivara + (totalCapivaras - 1) * espacamentoCapivara; // Onde N-1  o espao entre elas
-    // Calcula a posio X inicial para centralizar o bloco de capivaras na tela.
-    int startX = (larguraTela - larguraTotal) / 2;
-    int yPos = GetScreenHeight() / 2 + 120; // Posio Y fixa onde as capivaras aparecero(divide a tela no meio)
-
-    // Inicializa cada estrutura Capivara dentro do array alocado.
-    for (int i = 0; i < totalCapivaras; i++) {
-        // Define o retngulo de posio e tamanho para cada capivara.
-        capivaras[i].rect = (Rectangle){ (float)(startX + i * (larguraCapivara + espacamentoCapivara)), (float)yPos, (float)larguraCapivara, (float)alturaCapivara };
-        // Inicializa todos os outros campos da estrutura Capivara para seus valores padro.
-        // Isso garante que cada capivara comece invisvel, no acertada, no machucada e do tipo NORMAL.
-        capivaras[i] = (Capivara){capivaras[i].rect, false, 0.0, 0.0, false, 0.0, false, NORMAL};
-    }
-}
-
-// Funo responsvel por toda a lgica de atualizao do jogo a cada frame.
-// Inclui contagem de tempo, aparecimento de capivaras, deteco de cliques, etc.
-void AtualizarJogo() {
-    if (jogoAcabou) // Se o jogo j terminou, no h mais lgica para atualizar.
-        return;
-
-    // Lgica para a contagem regressiva antes do incio do jogo.
-    if (!jogoIniciado) {
-        contadorRegressivoInicial -= GetFrameTime(); // Decrementa o contador pelo tempo do ltimo frame.
-        if (contadorRegressivoInicial <= 0)         // Se o contador chegou a zero (ou menos).
-            jogoIniciado = true;                    // O jogo  marcado como iniciado.
-        return;                                     // Sai da funo, no atualiza o jogo real ainda.
-    }
-
-    // Lgica principal do tempo de jogo.
-    tempoRestanteJogo -= GetFrameTime(); // Decrementa o tempo restante do jogo.
-    if (tempoRestanteJogo <= 0) {       // Se o tempo acabou.
-        tempoRestanteJogo = 0;          // Garante que o tempo no fique negativo na exibio.
-        jogoAcabou = true;              // Marca o jogo como terminado.
-        return;                         // Sai da funo, o jogo acabou.
-    }
-
-    // Lgica principal da chuva do jogo.
-    if (chovendo) {                       // Se o estado de chuva est ativo.
-        tempoChuvaAtual -= GetFrameTime(); // Decrementa o tempo restante da chuva.
-        if (tempoChuvaAtual <= 0) {        // Se o tempo da chuva acabou.
-            chovendo = false;              // Desativa o estado de chuva.
-        }
-    }
-
-    // Obtm os parmetros de dificuldade correspondentes  dificuldade atual.
-    float intervaloMin = INTERVALO_MIN[dificuldadeAtual];
-    float tempoVisivelMin = TEMPO_VISIVEL_MIN[dificuldadeAtual];
-    float tempoVisivelMax = TEMPO_VISIVEL_MAX[dificuldadeAtual];
-    int maxCapivarasSimultaneas = MAX_SIMULTANEAS_INICIAL[dificuldadeAtual];
-    
-    int capivarasVisiveisAtualmente = 0; // Contador para saber quantas capivaras esto visveis.
-
-    // Loop para iterar sobre cada capivara (ou slot) e atualizar seu estado.
-    for (int i = 0; i < totalCapivaras; i++) {
-        // Conta as capivaras que esto visveis e no esto no estado de "atordoadas".
-        if (capivaras[i].visivel && !capivaras[i].machucada)
-            capivarasVisiveisAtualmente++;
-
-        // Lgica para capivaras que foram acertadas (estado "atordoada").
-        if (capivaras[i].machucada) {
-            capivaras[i].tempoAcertada += GetFrameTime(); // Incrementa o tempo que o animal est machucado.
-            if (capivaras[i].tempoAcertada >= 0.5) {      // Aps 0.5 segundos (tempo da animao de atordoado).
-                // Reseta o estado da capivara: invisvel, no acertada, no machucada, e volta ao tipo NORMAL para a prxima apario.
-                capivaras[i] = (Capivara){capivaras[i].rect, false, 0.0, 0.0, false, 0.0, false, NORMAL};
-            }
-            continue; // Pula para a prxima capivara no loop, pois esta j foi tratada neste frame.
-        }
-
-        // Lgica para capivaras que esto visveis (mas no machucadas) ou para fazer novas aparecerem.
-        if (capivaras[i].visivel) {
-            capivaras[i].tempoVisivel += GetFrameTime(); // Incrementa o tempo que a capivara est visvel.
-            // Se o tempo de visibilidade total foi atingido.
-            if (capivaras[i].tempoVisivel >= capivaras[i].tempoTotalVisivel) {
-                capivaras[i].visivel = false; // Torna a capivara invisvel.
-                capivaras[i].tipo = NORMAL;   // Reseta seu tipo para NORMAL para a prxima vez que aparecer.
-            }
-        }
-        // Condio para fazer uma nova capivara aparecer:
-        // 1. O slot atual no est visvel.
-        // 2. O nmero de capivaras visveis  menor que o mximo permitido.
-        // 3. NO EST CHOVENDO (capivaras normais/douradas no aparecem na chuva).
-        else if (capivarasVisiveisAtualmente < maxCapivarasSimultaneas && !chovendo) {
-            // Lgica para determinar a chance de uma nova capivara aparecer.
-            // GetRandomValue(0, 1000) cria um "tick"(probabilidade acumulada para um evento ocorrer em um determinado frame) para cada milissegundo de FrameTime,
-            // tornando a chance de apario mais consistente independente do FPS.
-            if (GetRandomValue(0, 1000) < (int)(GetFrameTime() * 1000 / intervaloMin)) {
-                TipoCapivara novoTipo = NORMAL; // Define o tipo padro como NORMAL.
-                int chance = GetRandomValue(1, 100); // Gera um nmero aleatrio para determinar o tipo do animal.
-
-                // Lgica de sorteio de tipo de capivara baseada na dificuldade.
-                switch(dificuldadeAtual) {
-                    case FACIL:    
-                        if (chance <= 10) // 10% de chance de aparecer uma CUTIA.
-                            novoTipo = CUTIA; break;
-                    case MEDIO:    
-                        if (chance <= 15) // 15% de chance de aparecer uma CUTIA.
-                            novoTipo = CUTIA;
-                        else if (chance <= 18) // 3% de chance de aparecer uma DOURADA (18 - 15 = 3).
-                            novoTipo = DOURADA; break;
-                    case DIFICIL:
-                        if (chance <= 20) // 20% de chance de aparecer uma CUTIA.
-                            novoTipo = CUTIA;
-                        else if (chance <= 25) // 5% de chance de aparecer uma DOURADA (25 - 20 = 5).
-                            novoTipo = DOURADA; break;
-                }
-
-                capivaras[i].visivel = true;     // Torna a capivara neste slot visvel.
-                capivaras[i].tempoVisivel = 0.0; // Reseta o tempo visvel dela.
-                // Define um tempo total de visibilidade aleatrio, dentro dos limites da dificuldade.
-                capivaras[i].tempoTotalVisivel = (double)GetRandomValue((int)(tempoVisivelMin * 1000), (int)(tempoVisivelMax * 1000)) / 1000.0;
-                capivaras[i].hit = false;        // Garante que ela no esteja marcada como acertada.
-                capivaras[i].tipo = novoTipo;    // Atribui o tipo de capivara sorteado.
-            }
-        }
-
-        // --- DETECO DE CLIQUE DO JOGADOR ---
-        // Verifica se:
-        // 1. A capivara est visvel.
-        // 2. No foi acertada ainda neste aparecimento.
-        // 3. O boto esquerdo do mouse foi pressionado neste frame.
-        // 4. A posio do mouse colide com o retngulo da capivara.
-        if (capivaras[i].visivel && !capivaras[i].hit && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), capivaras[i].rect)) {
-            capivaras[i].hit = true;        // Marca a capivara como acertada.
-            capivaras[i].machucada = true;  // Inicia o estado de "atordoada"
-            capivaras[i].tempoAcertada = 0.0; // Reseta o contador para o tempo de "atordoada".
-
-            // Lgica para adicionar ou subtrair pontos com base no tipo de animal acertado.
-            switch(capivaras[i].tipo) {
-                case NORMAL:
-                    pontos += 1; // Capivara normal: +1 ponto.
-                break;
-                case DOURADA:
-                    pontos += 2; // Capivara dourada: +2 pontos.
-                break;
-                case CUTIA:
-                    pontos += PENALIDADE_CUTIA[dificuldadeAtual]; // Cutia: perde pontos conforme a dificuldade.
-                    if(pontos < 0) // Garante que a pontuao nunca seja negativa.
-                        pontos = 0;
-                    if(dificuldadeAtual == DIFICIL){
-                        chovendo = true;      // Ativa o estado de chuva.
-                        tempoChuvaAtual = 5.0; // Define que a chuva durar 5 segundos.
-                    }
-                break;
-            }
-        }
-    }
-}
-
-// Funo responsvel por desenhar todos os elementos visuais do jogo na tela.
-void DesenharJogo() {
-    // Desenha o fundo do jogo. A funo DrawTexturePro  usada para redimensionar a textura
-    // para preencher toda a tela, independentemente do tamanho original da imagem.
-    DrawTexturePro(fundoJogo, (Rectangle){0,0, (float)fundoJogo.width, (float)fundoJogo.height}, (Rectangle){0,0, (float)GetScreenWidth(), (float)GetScreenHeight()}, (Vector2){0,0}, 0.0f, WHITE);
-    
-    // Desenha a textura da chuva se o estado 'chovendo' for true.
-    if (chovendo)
-        DrawTexture(texturaChuva, 0, 0, WHITE); // Desenha a textura de chuva na posio (0,0).
-
-    // Loop para desenhar cada capivara (ou animal) na tela.
-    for (int i = 0; i < totalCapivaras; i++) {
-        // Se a capivara no est visvel e no est machucada, no h necessidade de desenh-la.
-        if (!capivaras[i].visivel && !capivaras[i].machucada)
-            continue; // Pula para a prxima iterao do loop.
-
-        Texture2D* texAtual = &texturaCapivaraLevantada; // Por padro, usa a textura da capivara normal.
-        // Seleciona a textura correta com base no tipo de animal.
-        if (capivaras[i].tipo == DOURADA) {
-            texAtual = &texturaCapivaraDourada; // Se for dourada, usa a textura da capivara dourada.
-        } else if (capivaras[i].tipo == CUTIA) {
-            texAtual = &texturaCutia; // Se for cutia, usa a textura da cutia.
-        }
-        
-        Rectangle destRec = capivaras[i].rect; // O retngulo de destino onde a textura ser desenhada.
-        
-        // Ajusta o tamanho da cutia ao desenhar.
-        if (capivaras[i].tipo == CUTIA) {
-            float scale = 0.9f; // Fator de escala: 90% do tamanho do slot da capivara.
-            destRec.width *= scale;  // Reduz a largura.
-            destRec.height *= scale; // Reduz a altura.
-            // Centraliza a cutia dentro do espao original do slot (capivaras[i].rect).
-            destRec.x += (capivaras[i].rect.width - destRec.width) / 2;
-            destRec.y += (capivaras[i].rect.height - destRec.height) / 2;
-        }
-
-        // Desenha a textura apropriada: atordoada se machucada, ou a textura normal/dourada/cutia se visvel.
-        if (capivaras[i].machucada) {
-            // Se estiver machucada, sempre desenha a textura de atordoado.
-            DrawTexturePro(texturaAnimalAtordoado, (Rectangle){0,0, (float)texturaAnimalAtordoado.width, (float)texturaAnimalAtordoado.height}, destRec, (Vector2){0,0}, 0.0f, WHITE);
-        } else if (capivaras[i].visivel) {
-            // Se estiver visvel e no machucada, desenha a textura do tipo de animal.
-            DrawTexturePro(*texAtual, (Rectangle){0,0, (float)texAtual->width, (float)texAtual->height}, destRec, (Vector2){0,0}, 0.0f, WHITE);
-        }
-    }
-
-    // --- UI (Interface do Usurio) do Jogo ---
-
-    // Desenha o tempo restante no canto superior direito, formatado como "MM:SS".
-    DrawText(TextFormat("Tempo: %02d:%02d", (int)tempoRestanteJogo / 60, (int)tempoRestanteJogo % 60), GetScreenWidth() - 200, 20, 30, WHITE);
-    // Desenha a pontuao no canto superior esquerdo.
-    DrawText(TextFormat("Pontos: %d", pontos), 20, 20, 30, WHITE);
-    
-    // Desenha o boto de PAUSE no centro superior da tela.
-    Rectangle btnPausaRect = {GetScreenWidth() / 2.0f - 60, 20, 120, 40};
-    // A cor do boto muda ao passar o mouse.
-    DrawRectangleRec(btnPausaRect, CheckCollisionPointRec(GetMousePosition(), btnPausaRect) ? BROWN : Fade(RED, 0.5f));
-    DrawText("PAUSE", btnPausaRect.x + 25, btnPausaRect.y + 10, 20, WHITE);
-
-    // --- Contagem Regressiva Inicial ---
-    // Exibe a contagem regressiva antes do jogo realmente comear.
-    if (!jogoIniciado) {
-        const char* textoContador = "";
-        if (contadorRegressivoInicial > 1) // Se o contador  maior que 1 (ex: 3, 2).
-            textoContador = TextFormat("%d", (int)contadorRegressivoInicial); // Exibe o nmero inteiro.
-        else if (contadorRegressivoInicial > 0) // Se o contador est entre 0 e 1 (quase no fim).
-            textoContador = "GO!"; // Exibe "GO!".
-        
-        // Desenha o texto da contagem regressiva, centralizado na tela.
-        if (strlen(textoContador) > 0) { // Garante que s desenhe se houver texto.
-            DrawText(textoContador, GetScreenWidth() / 2 - MeasureText(textoContador, 100) / 2, GetScreenHeight() / 2 - 50, 100, GOLD);
-        }
-    }
-    
-    // --- Tela de Fim de Jogo (Overlay) ---
-    //  desenhada sobre o resto do jogo quando 'jogoAcabou'  true.
-    if (jogoAcabou) {
-        // Desenha um retngulo semi-transparente que escurece a tela, dando um efeito de overlay.
-        DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), ColorAlpha(BLACK, 0.7f));
-        const char* fimTexto = "Fim de jogo!";
-        const char* pontuacaoFinalTexto = TextFormat("Pontuao final: %d", pontos);
-        
-        // Desenha as mensagens de "Fim de jogo!" e a pontuao final, centralizadas.
-        DrawText(fimTexto, GetScreenWidth() / 2 - MeasureText(fimTexto, 60) / 2, GetScreenHeight() / 2 - 100, 60, WHITE);
-        DrawText(pontuacaoFinalTexto, GetScreenWidth() / 2 - MeasureText(pontuacaoFinalTexto, 40) / 2, GetScreenHeight() / 2 - 30, 40, WHITE);
-    }
-}
-
-// --- FUNO PRINCIPAL ---
-// O ponto de entrada do programa. Aqui o jogo  inicializado e o loop principal  executado.
-int main(void) {
-    const int larguraTela = 1500; // Define a largura da janela do jogo.
-    const int alturaTela = 800;   // Define a altura da janela do jogo.
-    InitWindow(larguraTela, alturaTela, "Barigueira Attack!"); // Inicializa a janela da Raylib com ttulo.
-    SetTargetFPS(60); // Define o limite de quadros por segundo (FPS) para 60, para uma experincia de jogo suave.
-
-    // --- CARREGAMENTO INICIAL DE TEXTURAS ---
-    // Todas as texturas so carregadas, para evitar atrasos durante o jogo e otimizar o uso da memria.
-    fundoJogo = LoadTexture("fundoJogo.png");                 // Carrega a imagem de fundo do jogo.
-    texturaCapivaraLevantada = LoadTexture("capivaraNormal.png"); // Carrega a imagem da capivara comum.
-    texturaCapivaraDourada = LoadTexture("capivaraDourada.png"); // Carrega a imagem da capivara dourada.
-    texturaAnimalAtordoado = LoadTexture("animalAtordoado.png"); // Carrega a imagem do animal atordoado (acertado).
-    texturaCutia = LoadTexture("cutiaJogo.png");                 // Carrega a imagem da cutia.
-    texturaChuva = LoadTexture("fundoChuvoso.png");             // Carrega a imagem do efeito de chuva.
-    Texture2D fundoPrincipal = LoadTexture("fundoPrincipal.png"); // Fundo da tela inicial.
-    Texture2D fundoMenu = LoadTexture("fundoMenu.png");           // Fundo do menu principal e seleo de dificuldade.
-    Texture2D fundoCreditos = LoadTexture("fundoCreditos.png");   // Fundo da tela de crditos.
-
-    Tela telaAtual = TELA_INICIAL; // Define o estado inicial do jogo para a tela de abertura.
-
-    // Inicializa o ponteiro como NULL para que a funo `free(capivaras)` no tente, liberar memria de um ponteiro no inicializado, o que causaria um erro.
-    capivaras = NULL;
-
-    // --- LOOP PRINCIPAL DO JOGO ---
-    // 'WindowShouldClose()' retorna true quando o usurio clica no 'X' da janela ou pressiona ESC.
-    
-    while (!WindowShouldClose()) {
-        Vector2 mouse = GetMousePosition(); // Obtm a posio atual do cursor do mouse a cada frame.
-
-        BeginDrawing(); // Inicia o modo de desenho da Raylib para este frame.
-        ClearBackground(BEIGE); // Limpa a tela com uma cor base (til se no houver um fundo ocupando 100%).
-
-        // --- MQUINA DE ESTADOS ---
-        // Um switch-case  usado para gerenciar as diferentes telas (estados) do jogo.
-        // A lgica e o desenho executados dependem da 'telaAtual'.
-        switch (telaAtual) {
-            case TELA_INICIAL: {
-                DrawTexture(fundoPrincipal, 0, 0, WHITE); // Desenha o fundo da tela inicial.
-                const char* titulo = "BARIGUEIRA ATTACK!";
-                // Desenha o ttulo do jogo, centralizado.
-                DrawText(titulo, larguraTela / 2 - MeasureText(titulo, 80) / 2, alturaTela / 2 - 150, 80, BEIGE);
-                // Desenha o boto "INICIAR". Se clicado, muda para a tela de menu.
-                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 490, 300, 60}, "INICIAR", mouse)) {
-                    telaAtual = TELA_MENU;
-                }
-            } break; 
-
-            case TELA_MENU: {
-                DrawTexture(fundoMenu, 0, 0, WHITE); // Desenha o fundo do menu.
-                const char* titulo = "MENU DO JOGO";
-                // Desenha o ttulo do menu, centralizado.
-                DrawText(titulo, larguraTela / 2 - MeasureText(titulo, 60) / 2, 150, 60, BEIGE);
-                // Boto "JOGAR": Se clicado, vai para a seleo de dificuldade.
-                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 300, 300, 60}, "JOGAR", mouse)) {
-                    telaAtual = TELA_SELECAO_DIFICULDADE;
-                }
-                // Boto "CRDITOS": Se clicado, vai para a tela de crditos.
-                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 385, 300, 60}, "CRDITOS", mouse)) {
-                    telaAtual = TELA_CREDITOS;
-                }
-                // Boto "SAIR": Se clicado, fecha a janela do jogo, encerrando o loop principal.
-                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 470, 300, 60}, "SAIR", mouse)) {
-                    CloseWindow();
-                }
-            } break; 
-
-            case TELA_SELECAO_DIFICULDADE: {
-                DrawTexture(fundoMenu, 0, 0, WHITE); // Usa o mesmo fundo do menu.
-                const char* titulo = "SELECIONE A DIFICULDADE";
-                // Desenha o ttulo da tela de seleo, centralizado.
-                DrawText(titulo, larguraTela / 2 - MeasureText(titulo, 60) / 2, 150, 60, BEIGE);
-
-                // Boto "FCIL": Inicializa o jogo com a dificuldade FACIL e transiciona para a tela de jogo.
-                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 300, 300, 60}, "FCIL", mouse)) {
-                    InicializarJogo(FACIL);
-                    telaAtual = TELA_JOGO;
-                }
-                // Boto "MDIO": Inicializa o jogo com a dificuldade MEDIO.
-                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 385, 300, 60}, "MDIO", mouse)) {
-                    InicializarJogo(MEDIO);
-                    telaAtual = TELA_JOGO;
-                }
-                // Boto "DIFCIL": Inicializa o jogo com a dificuldade DIFICIL.
-                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 470, 300, 60}, "DIFCIL", mouse)) {
-                    InicializarJogo(DIFICIL);
-                    telaAtual = TELA_JOGO;
-                }
-                // Boto "VOLTAR": Retorna ao menu principal.
-                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 555, 300, 60}, "VOLTAR", mouse)) {
-                    telaAtual = TELA_MENU;
-                }
-            } break; 
-
-            case TELA_JOGO: {
-                // A lgica do jogo s  atualizada se o jogo ainda no acabou.
-                if (!jogoAcabou) {
-                    AtualizarJogo(); // Chama a funo que contm toda a lgica do jogo.
-                    // Verifica se o boto de pause foi clicado
-                    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mouse, (Rectangle){larguraTela / 2.0f - 60, 20, 120, 40})) {
-                        telaAtual = TELA_PAUSA; // Se clicado, transiciona para a tela de pausa.
-                    }
-                }
-                DesenharJogo(); // Chama a funo que desenha todos os elementos visuais do jogo (incluindo o overlay de fim de jogo se aplicvel).
-
-                // Botes especficos que s aparecem quando o jogo termina.
-                if (jogoAcabou) {
-                    // Boto "REINICIAR": Reinicia o jogo com a mesma dificuldade.
-                    if (DesenharBotao((Rectangle){larguraTela / 2.0f - 260, alturaTela / 2.0f + 50, 250, 60}, "REINICIAR", mouse)) {
-                        InicializarJogo(dificuldadeAtual); // Chama a funo de inicializao novamente.
-                    }
-                    // Boto "MENU INICIAL": Volta ao menu principal.
-                    if (DesenharBotao((Rectangle){larguraTela / 2.0f + 10, alturaTela / 2.0f + 50, 250, 60}, "MENU INICIAL", mouse)) {
-                        // Antes de voltar ao menu principal,  necessario liberar a memria alocada para as capivaras.
-                        if (capivaras != NULL) {
-                            free(capivaras);     // Libera o bloco de memria.
-                            capivaras = NULL;    // Define o ponteiro para NULL para evitar acesso a memria j liberada
-                        }
-                        telaAtual = TELA_MENU; // Transiciona para o menu.
-                    }
-                }
-            } break;
-
-            case TELA_PAUSA: {
-                DesenharJogo(); // Desenha o jogo em segundo plano (como estava antes de pausar).
-                // Desenha um retngulo semi-transparente para criar um efeito de escurecimento sobre o jogo pausado.
-                DrawRectangle(0, 0, larguraTela, alturaTela, ColorAlpha(BLACK, 0.5f));
-                const char* textoPausa = "JOGO PAUSADO";
-                // Desenha o texto "JOGO PAUSADO", centralizado.
-                DrawText(textoPausa, larguraTela / 2 - MeasureText(textoPausa, 60) / 2, 150, 60, BEIGE);
-
-                // Boto "CONTINUAR": Despausa o jogo. Pode ser clicado ou pressionando ESC.
-                if (DesenharBotao((Rectangle){larguraTela / 2.0f - 150, 300, 300, 60}, "CONTINUAR", mouse) || IsKeyPressed(KEY_ESCAPE)) {
-                    telaAtual = TELA_JOGO; // Retorna  tela de jogo.
-                }
-                // Boto "REINICIAR": Reinicia a partida atual.
-                if (DesenharBotao((Rectangle){larguraTela / 2.0f - 150, 385, 300, 60}, "REINICIAR", mouse)) {
-                    InicializarJogo(dificuldadeAtual); // Re-inicializa o jogo.
-                    telaAtual = TELA_JOGO;
-                }
-                // Boto "MENU PRINCIPAL": Volta ao menu.
-                if (DesenharBotao((Rectangle){larguraTela / 2.0f - 150, 470, 300, 60}, "MENU PRINCIPAL", mouse)) {
-                    // Libera a memria das capivaras antes de sair do jogo para o menu.
-                    if (capivaras != NULL) {
-                        free(capivaras);
-                        capivaras = NULL;
-                    }
-                    telaAtual = TELA_MENU;
-                }
-            } break; 
-
-            case TELA_CREDITOS: {
-                DrawTexture(fundoCreditos, 0, 0, WHITE); // Desenha o fundo da tela de crditos.
-                const char* titulo = "CRDITOS";
-                // Desenha o ttulo "CRDITOS", centralizado.
-                DrawText(titulo, larguraTela / 2 - MeasureText(titulo, 60) / 2, 80, 60, BEIGE);
-
-                // Array de strings contendo todo o texto dos crditos.
-                const char* creditosTexto[] = {
-                    "ALUNOS:",
-                    "ANA WALTRICK | NGELO MIRANDA | VITOR KLUPPELL",
-                    "", 
-                    "INSTITUIO: CENTRO UNIVERSITRIO AUTNOMO DO BRASIL",
-                    "DISCIPLINA: PROGRAMAO AVANADA",
-                    "PROFESSOR: FABIO BETTIO",
-                    "",
-                    "INSPIRAO:",
-                    "JOGO WHACK-A-MOLE | CURITIBA | PARQUE BARIGUI | ANIMAIS",
-                    "",
-                    "OBRIGADO POR JOGAR!"
-                };
-                int yPos = 180; // Posio Y inicial para a primeira linha de crdito.
-                // Loop para desenhar cada linha de texto dos crditos.
-                for (int i = 0; i < sizeof(creditosTexto)/sizeof(creditosTexto[0]); i++) {
-                    // Desenha o texto, centralizado horizontalmente.
-                    DrawText(creditosTexto[i], larguraTela / 2 - MeasureText(creditosTexto[i], 28) / 2, yPos, 28, BEIGE);
-                    yPos += 40; // Incrementa a posio Y para a prxima linha.
-                }
-
-                // Boto "VOLTAR": Retorna ao menu principal.
-                if (DesenharBotao((Rectangle){larguraTela / 2.0f - 150, alturaTela - 100, 300, 60}, "VOLTAR", mouse)) {
-                    telaAtual = TELA_MENU;
-                }
-            } break; 
-        }
-        EndDrawing(); // Finaliza o modo de desenho, apresentando o frame renderizado na tela.
-    }
-
-    // --- DESALOCAO FINAL DA MEMRIA E RECURSOS AO FECHAR A JANELA ---
-    // Liberar todos os recursos alocados para evitar vazamentos de memria e garantir um encerramento limpo do programa.
-
-    if (capivaras != NULL) {
-        free(capivaras); 
-        capivaras = NULL; 
-    }
-
-    // Descarrega todas as texturas da memria.
-    UnloadTexture(fundoPrincipal);
-    UnloadTexture(fundoMenu);
-    UnloadTexture(fundoCreditos);
-    UnloadTexture(fundoJogo);
-    UnloadTexture(texturaCapivaraLevantada);
-    UnloadTexture(texturaAnimalAtordoado);
-    UnloadTexture(texturaCutia);
-    UnloadTexture(texturaChuva);
-    UnloadTexture(texturaCapivaraDourada);
-
-    CloseWindow(); // Fecha a janela da Raylib e libera seus recursos internos.
-    return 0;      // Retorna 0 para indicar que o programa foi executado com sucesso.
-}
-
+#include "raylib.h"
+#include "logica.h" // Lógica da partida, independente da Raylib.
+#include "gravacao.h" // Gravação e reprodução das partidas.
+#include "telemetria.h" // Eventos das partidas para os histogramas do tempo de reação (--telemetria).
+#include "atlas.h"  // Atlas com o fundo do jogo, a chuva e os animais em uma única textura.
+#include "recursos.h" // Carregamento das texturas a partir do pacote pré-processado.
+#include "lotes.h"  // Desenho com contagem de chamadas e trocas de textura.
+#include "entrada.h" // Fila de cliques e teclas com o momento de cada um.
+#include "perfil.h"  // Tempo de cada fase do frame (tecla F3).
+#include "texto.h"   // Texto com layout em cache, refeito só quando muda.
+#include "particulas.h" // Chuva, faíscas e pontos dos acertos.
+#include "placar.h"      // Recordes por dificuldade, em arquivo local...
+#include "placar_rede.h" // ...ou no servidor_placar (--placar PORTA).
+#include "versus.h"      // Dois jogadores no mesmo tabuleiro, com rollback...
+#include "rede_versus.h" // ...sincronizados por UDP (--versus).
+#include "resolucao.h"   // Desenho em coordenadas virtuais, esticado para a janela.
+#include "som.h"         // Sons dos acertos e do andamento da partida, misturados na thread de áudio.
+#include "simulacao.h"   // A partida avança em uma thread própria e publica estados para o desenho.
+#include "rlgl.h"    // Desenho das partículas direto no lote da Raylib.
+#include <float.h>
+#include <stdbool.h> 
+#include <string.h> 
+#include <stdio.h>
+#include <stdlib.h> // Fornece funções utilitárias como alocação de memória dinâmica, usado para gerenciar as capivaras.
+#include <time.h> // Permite manipular e medir tempo, além de inicializar o gerador de números aleatórios.
+
+// ENUMS
+typedef enum Tela {
+    TELA_INICIAL,              // Tela de abertura do jogo
+    TELA_MENU,                 // Menu principal
+    TELA_CREDITOS,             // Tela que exibe os nomes dos criadores e informações
+    TELA_JOGO,                 // Tela onde o jogo acontece
+    TELA_SELECAO_DIFICULDADE,  // Tela para o jogador escolher o nível de dificuldade.
+    TELA_PAUSA,                // Tela exibida quando o jogo está pausado.
+    TELA_ESPERA_VERSUS         // Modo versus: esperando o rival responder antes da partida.
+} Tela;
+
+// Os enums de dificuldade e tipo de animal, os arrays dos animais e as constantes de dificuldade ficam em logica.h,
+// junto com toda a lógica da partida, que não depende da Raylib.
+
+// --- VARIÁVEIS GLOBAIS DE TEXTURA ---
+// As texturas são carregadas uma única vez na memória da GPU no início do programa para otimização.
+
+Recursos recursos;                   // Todas as texturas, incluindo o atlas com fundo do jogo, chuva, capivaras, cutia e animal atordoado.
+bool mostrarEstatisticas = false;    // Exibe o contador de chamadas de desenho e trocas de textura (tecla F2).
+bool mostrarPerfil = false;          // Exibe o tempo de cada fase do frame e os percentis (tecla F3).
+
+// --- VARIÁVEIS GLOBAIS DE ESTADO DO JOGO ---
+// O estado da partida fica todo em uma única struct, que é avançada pela lógica do jogo (logica.c).
+
+EstadoJogo jogo;                 // Estado da partida atual (capivaras, pontos, tempo, chuva...).
+Gravacao gravacao;               // Semente, configuração e cliques da partida atual (ou da partida sendo reproduzida).
+const char* arquivoGravacao = NULL; // Se não for NULL, cada partida terminada é gravada neste arquivo (--gravar).
+bool reproduzindo = false;       // true se as partidas reproduzem a gravação carregada (--replay) em vez de ler o mouse.
+int proximoCliqueReproducao = 0; // Próximo clique gravado a ser aplicado na reprodução.
+InstantaneoJogo inicioPartida;   // A última partida logo depois de montada, para reiniciar sem montar o tabuleiro de novo.
+ConfiguracaoJogo configuracaoInicio; // Configuração de 'inicioPartida'.
+LinhaTempo linhaTempo;           // Quadros-chave da reprodução, para voltar e avançar com as setas.
+FilaEntrada filaEntrada;         // Cliques e teclas do frame, consumidos pelos botões e pelo campo de jogo.
+int totalBuracos = 0;            // Buracos por partida. 0 usa o padrão da dificuldade; o modo de estresse (--estresse N) enche a tela.
+SistemaParticulas chuva;         // Gotas de chuva (enquanto 'chovendo').
+SistemaParticulas efeitos;       // Faíscas e pontos dos acertos.
+GeradorAleatorio geradorParticulas; // Separado do gerador da partida, para os efeitos não mudarem a gravação.
+int totalGotas = 1500;           // Gotas na tela durante a chuva (--chuva N, para medir com dezenas de milhares).
+Placar placar;                   // Placar local (placar.idx / placar.log), se não houver servidor.
+bool placarAberto = false;
+int portaPlacar = 0;             // Porta do servidor_placar no loopback (--placar PORTA); 0 usa o placar local.
+#define MAX_PENDENTES_PLACAR 64
+RegistroPlacar pendentesPlacar[MAX_PENDENTES_PLACAR]; // Pontuações que ainda não chegaram ao servidor.
+int totalPendentesPlacar = 0;
+TextoCacheado textoPlacar;       // Posição da última partida no placar, mostrada no fim da partida.
+bool desenharSempre = false;      // true desliga a espera ociosa nas telas paradas (--sempre-desenhar), para comparar o uso de CPU.
+Resolucao resolucao;              // Textura de destino em coordenadas virtuais e a resolução interna dela.
+MixerSom mixer;                   // Amostras, vozes e o anel de comandos lido pela thread de áudio.
+AudioStream fluxoSom;             // Saída do mixer para o dispositivo de áudio.
+bool somAtivo = false;            // false com --sem-som ou sem dispositivo de áudio.
+AndamentoSom andamentoSom;        // Contagem, chuva e fim já tocados.
+ThreadSimulacao simulacao;        // Thread da partida normal (a reprodução e o versus avançam no frame, com --thread-unica também).
+EstadoJogo vistaJogo;             // Último estado publicado pela simulação, lido direto do buffer triplo.
+bool partidaFinalizada = false;   // FinalizarPartida já foi chamada na partida da thread.
+double deslocamentoRelogio = 0.0; // GetTime() - RelogioSimulacao(): a thread da simulação não chama a Raylib.
+Telemetria telemetria;            // Eventos das partidas normais para o analisar_telemetria (--telemetria).
+bool carregarTudo = false;        // Carrega todas as texturas no início e nunca as descarta (--carregar-tudo), para comparar.
+double esperaRecursos = 0.0;      // Segundos esperando texturas na troca de tela atual (InicializarJogo espera o atlas).
+
+// Texturas que cada tela desenha e as que ela prevê, da tela seguinte mais provável para a menos.
+// TOTAL_RECURSOS marca uma posição vazia.
+typedef struct {
+    unsigned usa;                 // Máscara de bits 1 << IdRecurso.
+    IdRecurso preve[2];
+} RecursosTela;
+
+static const RecursosTela RECURSOS_TELA[] = {
+    [TELA_INICIAL]             = { 1u << RECURSO_FUNDO_PRINCIPAL, { RECURSO_FUNDO_MENU, RECURSO_ATLAS } },
+    [TELA_MENU]                = { 1u << RECURSO_FUNDO_MENU,      { RECURSO_ATLAS, TOTAL_RECURSOS } },
+    [TELA_CREDITOS]            = { 1u << RECURSO_FUNDO_CREDITOS,  { RECURSO_FUNDO_MENU, TOTAL_RECURSOS } },
+    [TELA_JOGO]                = { 1u << RECURSO_ATLAS,           { RECURSO_FUNDO_MENU, TOTAL_RECURSOS } },
+    [TELA_SELECAO_DIFICULDADE] = { 1u << RECURSO_FUNDO_MENU,      { RECURSO_ATLAS, TOTAL_RECURSOS } },
+    [TELA_PAUSA]               = { 1u << RECURSO_ATLAS,           { RECURSO_FUNDO_MENU, TOTAL_RECURSOS } },
+    [TELA_ESPERA_VERSUS]       = { 1u << RECURSO_FUNDO_MENU,      { RECURSO_ATLAS, TOTAL_RECURSOS } },
+};
+
+// --- MODO VERSUS (--versus PORTA ENDERECO:PORTA) ---
+// A partida versus usa o mesmo 'jogo' da partida normal; a sessão guarda os pontos de cada jogador e os instantâneos.
+bool modoVersus = false;          // true: a escolha da dificuldade procura o rival em vez de começar sozinho.
+uint16_t portaVersus = PORTA_VERSUS;         // Porta UDP local.
+char enderecoRival[64] = "127.0.0.1";        // IPv4 do rival.
+uint16_t portaRival = PORTA_VERSUS + 1;
+int atrasoVersus = 2;             // Atraso de entrada em ticks (--atraso-entrada N); vale o do jogador 0.
+SimulacaoRede redeSimulada = {0}; // --latencia, --variacao e --perda: piora a rede de propósito, para testar no loopback.
+ConexaoVersus conexaoVersus;
+SessaoVersus versus;
+EntradaVersus entradaVersus;      // Cliques locais que a sessão ainda não aceitou (ela estava esperando o rival).
+double acumuladorVersus = 0.0;    // Tempo de frame ainda não simulado, como o 'acumulador' do PassoJogo.
+bool versusConfirmado = false;    // O resultado chegou e não muda mais (FinalizarPartida já foi chamada).
+bool versusPerdido = false;       // O rival parou de responder no meio da partida.
+
+// --- DEFINIÇÕES DAS FUNÇÕES ---
+
+// Função auxiliar para desenhar e gerenciar a interatividade de um botão genérico.
+
+bool DesenharBotao(Rectangle rect, const char* texto, Vector2 mousePos) {
+    Color cor = Fade(RED, 0.5f); // Cor padrão do botão (vermelho semi-transparente).
+    // Verifica se algum clique do frame caiu no botão, na posição em que o mouse estava no momento do clique.
+    bool clicado = ConsumirClique(&filaEntrada, rect) != NULL;
+
+    // Verifica se a posição do mouse está sobre o retângulo do botão.
+    bool destacado = CheckCollisionPointRec(mousePos, rect);
+    if (destacado) {
+        cor = BROWN; // Se o mouse estiver em cima, a cor muda para marrom.
+    }
+    RegistrarAreaDestaque(&filaEntrada, rect, destacado); // A espera ociosa acorda quando o destaque muda.
+    DesenharRetanguloLote(rect, cor); // Desenha o retângulo do botão com a cor definida.
+    // Desenha o texto do botão, centralizado horizontalmente e ajustado verticalmente (o layout fica em cache).
+    DesenharTextoFixoCentralizado(texto, (int)(rect.x + rect.width / 2), (int)rect.y + 15, 30, WHITE);
+    return clicado; // Retorna o estado do clique.
+}
+
+// Função responsável por inicializar todas as variáveis e estados para uma nova partida.
+// No modo de reprodução, a dificuldade é ignorada e a partida gravada recomeça. Retorna false se faltar memória
+// para a partida; quem chamou volta para uma tela de menu.
+bool InicializarJogo(Dificuldade dificuldade) {
+    // A contagem regressiva começa agora: o atlas tem que estar na GPU antes, senão a espera come a contagem.
+    if (!RecursoPronto(&recursos, RECURSO_ATLAS)) {
+        AdquirirRecurso(&recursos, RECURSO_ATLAS);
+        esperaRecursos += EsperarRecursos(&recursos, 1u << RECURSO_ATLAS);
+        LiberarRecurso(&recursos, RECURSO_ATLAS); // A troca para TELA_JOGO adquire de novo, no fim do frame.
+    }
+    LimparParticulas(&chuva);
+    LimparParticulas(&efeitos);
+    if (reproduzindo) {
+        if (!IniciarReproducao(&gravacao, &jogo, &proximoCliqueReproducao)) {
+            TraceLog(LOG_WARNING, "REPLAY: memória insuficiente para a partida");
+            return false;
+        }
+        LimparLinhaTempo(&linhaTempo);
+        return true;
+    }
+    // A semente do gerador de números aleatórios da partida. As capivaras aparecem em posições, tipos e tempos aleatorios
+    // 'time(NULL)' fornece uma semente diferente a cada execução, garantindo aleatoriedade. Ela fica na gravação.
+    uint64_t semente = (uint64_t)time(NULL) ^ ((uint64_t)(GetTime() * 1e6) << 20);
+    // Reseta pontos, tempo, chuva e contagem regressiva, e aloca os slots das capivaras centralizados na tela virtual.
+    ConfiguracaoJogo configuracao = { dificuldade, totalBuracos, (float)LARGURA_VIRTUAL, (float)ALTURA_VIRTUAL, semente };
+    // Com o mesmo tabuleiro da partida anterior (REINICIAR, ou a mesma dificuldade de novo), a partida é restaurada
+    // do instantâneo do início e só a semente muda.
+    bool mesmoTabuleiro = inicioPartida.memoria != NULL && configuracaoInicio.dificuldade == dificuldade &&
+                          configuracaoInicio.totalBuracos == configuracao.totalBuracos &&
+                          configuracaoInicio.larguraTela == configuracao.larguraTela && configuracaoInicio.alturaTela == configuracao.alturaTela;
+    bool ok = mesmoTabuleiro ? RecomecarEstadoJogo(&jogo, &inicioPartida, semente) : InicializarEstadoJogo(&jogo, &configuracao);
+    if (!ok) {
+        TraceLog(LOG_WARNING, "JOGO: memória insuficiente para a partida (%d buracos)", configuracao.totalBuracos);
+        return false;
+    }
+    // Sem memória para o instantâneo, ele continua sendo o do tabuleiro anterior e a próxima partida monta o seu.
+    if (!mesmoTabuleiro && SalvarInstantaneo(&jogo, &inicioPartida))
+        configuracaoInicio = configuracao;
+    IniciarGravacao(&gravacao, &configuracao); // Toda partida é gravada na memória; é barato.
+    jogo.gravacao = &gravacao;
+    if (simulacao.iniciada) {
+        AcertoJogo descartados[MAX_ACERTOS_SIMULACAO]; // Acertos da partida anterior que não viraram faíscas.
+        LerAcertosSimulacao(&simulacao, descartados, MAX_ACERTOS_SIMULACAO);
+        partidaFinalizada = false;
+        RetomarSimulacao(&simulacao); // A partida passa para a thread da simulação.
+    }
+    return true;
+}
+
+// Guarda a pontuação no placar da dificuldade e monta o texto com a posição dela.
+// Com servidor, as pontuações que não chegaram antes (servidor fechado) vão junto, no mesmo lote.
+void RegistrarPontuacao(const RegistroPlacar* registro) {
+    static const char* nomes[] = { "FÁCIL", "MÉDIO", "DIFÍCIL" };
+    PosicaoPlacar posicao = {0};
+    bool ok;
+    if (portaPlacar != 0) {
+        if (totalPendentesPlacar == MAX_PENDENTES_PLACAR) { // Fila cheia: a mais antiga é descartada.
+            memmove(pendentesPlacar, pendentesPlacar + 1, (MAX_PENDENTES_PLACAR - 1) * sizeof(RegistroPlacar));
+            totalPendentesPlacar--;
+        }
+        pendentesPlacar[totalPendentesPlacar++] = *registro;
+        static PosicaoPlacar posicoes[MAX_PENDENTES_PLACAR];
+        Soquete s = ConectarPlacar((uint16_t)portaPlacar, 300); // No loopback, a resposta leva menos de 1 ms.
+        ok = s != SOQUETE_INVALIDO && EnviarPontuacoesRede(s, pendentesPlacar, totalPendentesPlacar, posicoes);
+        FecharSoquete(s);
+        if (ok) {
+            posicao = posicoes[totalPendentesPlacar - 1];
+            totalPendentesPlacar = 0;
+        }
+    } else {
+        ok = placarAberto && AdicionarPontuacoes(&placar, registro, 1, &posicao);
+    }
+    if (ok)
+        DefinirTexto(&textoPlacar, TextFormat("Posição no placar (%s): %d de %d", nomes[registro->dificuldade], posicao.posicao, posicao.total), 30);
+    else
+        DefinirTexto(&textoPlacar, "Placar indisponível", 30);
+    if (!ok)
+        TraceLog(LOG_WARNING, "PLACAR: pontuação não registrada (%d pendentes)", totalPendentesPlacar);
+}
+
+// Chamada uma vez quando a partida termina: grava a partida ou, na reprodução, confere os pontos.
+// No versus, é chamada quando o resultado está confirmado pelas entradas do rival, e não entra no placar.
+void FinalizarPartida() {
+    if (modoVersus) {
+        int meus = versus.pontos[versus.jogadorLocal], dele = versus.pontos[1 - versus.jogadorLocal];
+        const char* resultado = meus > dele ? "Você venceu!" : (meus < dele ? "Você perdeu" : "Empate");
+        DefinirTexto(&textoPlacar, TextFormat("%s  Rival: %d", resultado, dele), 30);
+        const EstatisticasVersus* e = &versus.estatisticas;
+        TraceLog(LOG_INFO, "VERSUS: %d x %d; %lld rollbacks em %lld ticks (no máximo %d refeitos), %lld esperas, rtt %.1f ms, %lld de %lld pacotes perdidos",
+                 meus, dele, (long long)e->rollbacks, (long long)e->ticks, e->maxRefeitos, (long long)e->esperas, conexaoVersus.rttMs,
+                 (long long)conexaoVersus.pacotesPerdidos, (long long)conexaoVersus.pacotesEnviados);
+        return;
+    }
+    if (reproduzindo) {
+        if (jogo.pontos == gravacao.pontosFinais)
+            TraceLog(LOG_INFO, "REPLAY: OK, %d pontos", jogo.pontos);
+        else
+            TraceLog(LOG_WARNING, "REPLAY: divergiu, esperado %d pontos, obtido %d", gravacao.pontosFinais, jogo.pontos);
+        return;
+    }
+    EncerrarGravacao(&gravacao, &jogo);
+    // O modo de estresse tem outro tabuleiro: as pontuações dele não entram no placar.
+    if (totalBuracos == 0) {
+        RegistroPlacar registro = { jogo.pontos, (uint8_t)jogo.dificuldade, (int64_t)time(NULL), gravacao.configuracao.semente };
+        RegistrarPontuacao(&registro);
+    } else {
+        DefinirTexto(&textoPlacar, "Modo de estresse: fora do placar", 30);
+    }
+    if (arquivoGravacao != NULL) {
+        if (SalvarGravacao(&gravacao, arquivoGravacao))
+            TraceLog(LOG_INFO, "GRAVACAO: partida gravada em %s (%d cliques)", arquivoGravacao, gravacao.totalCliques);
+        else
+            TraceLog(LOG_WARNING, "GRAVACAO: não foi possível gravar %s", arquivoGravacao);
+    }
+}
+
+// Começa uma partida na dificuldade escolhida e retorna a próxima tela. No modo versus, abre a porta UDP e vai
+// esperar o rival; a partida começa quando os dois se encontram.
+Tela EscolherDificuldade(Dificuldade dificuldade) {
+    if (!modoVersus)
+        return InicializarJogo(dificuldade) ? TELA_JOGO : TELA_SELECAO_DIFICULDADE;
+    uint32_t nonce = (uint32_t)time(NULL) * 2654435761u ^ (uint32_t)(GetTime() * 1e6);
+    if (!AbrirConexaoVersus(&conexaoVersus, portaVersus, enderecoRival, portaRival, nonce, dificuldade, atrasoVersus, GetTime())) {
+        TraceLog(LOG_WARNING, "VERSUS: não foi possível abrir a porta UDP %d (rival %s:%d)", portaVersus, enderecoRival, portaRival);
+        return TELA_SELECAO_DIFICULDADE;
+    }
+    conexaoVersus.simulacao = redeSimulada;
+    return TELA_ESPERA_VERSUS;
+}
+
+// Retângulo do botão de PAUSE, no centro superior da tela.
+Rectangle RetanguloBotaoPausa() {
+    return (Rectangle){LARGURA_VIRTUAL / 2.0f - 60, 20, 120, 40};
+}
+
+// Função responsável por toda a lógica de atualização do jogo a cada frame.
+// Ela só passa os cliques do frame, com o momento de cada um, para PassoJogo (logica.c), que os aplica em ordem
+// contra o estado da partida naquele momento. Retorna true se o botão de pausa foi clicado: nesse caso a
+// partida só avança até o momento do clique na pausa, e os cliques depois dele são ignorados.
+bool AtualizarJogo() {
+    EntradaJogo entrada = {0};
+    double tempoCliques[MAX_CLIQUES_PASSO]; // Momento de cada clique da entrada, para medir a latência do som.
+    double dt = DuracaoQuadroEntrada(&filaEntrada);
+    bool pausou = false;
+    Rectangle btnPausaRect = RetanguloBotaoPausa();
+
+    for (int i = 0; i < filaEntrada.totalEventos; i++) {
+        EventoEntrada* e = &filaEntrada.eventos[i];
+        if (e->tipo != EVENTO_CLIQUE || e->consumido)
+            continue;
+        e->consumido = true;
+        double deslocamento = e->tempo - filaEntrada.inicioQuadro; // Momento do clique dentro do frame.
+        if (CheckCollisionPointRec(e->posicao, btnPausaRect)) {
+            pausou = true;
+            dt = deslocamento;
+            break;
+        }
+        if (entrada.totalCliques < MAX_CLIQUES_PASSO) {
+            tempoCliques[entrada.totalCliques] = e->tempo;
+            entrada.cliques[entrada.totalCliques++] = (CliqueJogo){ deslocamento, e->posicao.x, e->posicao.y };
+        }
+    }
+    // Na reprodução, os cliques do mouse são ignorados (só a pausa funciona) e os gravados são aplicados no lugar.
+    int acertosAntes = jogo.totalAcertosRecentes; // Os de antes de uma pausa já tocaram.
+    if (reproduzindo)
+        PassoReproducao(&gravacao, &linhaTempo, &jogo, &proximoCliqueReproducao, dt > 0.0 ? dt : 0.0);
+    else
+        PassoJogo(&jogo, dt > 0.0 ? dt : 0.0, &entrada);
+    // O som sai no mesmo frame do acerto, sem esperar o desenho: a thread de áudio o mistura no próximo buffer.
+    if (somAtivo)
+        TocarAcertosSom(&mixer, &jogo, acertosAntes, reproduzindo ? NULL : tempoCliques, (float)LARGURA_VIRTUAL);
+    if (jogo.jogoAcabou)
+        FinalizarPartida();
+    return pausou;
+}
+
+// Relógio da thread da simulação: o mesmo do GetTime (o dos cliques), sem chamar a Raylib.
+static double RelogioJogo(void) {
+    return RelogioSimulacao() + deslocamentoRelogio;
+}
+
+// Chamada pela thread da simulação depois de cada passo: o som sai no mesmo passo que aplicou o clique. Enquanto a
+// thread roda, só ela envia comandos ao mixer (o anel de comandos tem um produtor só).
+static void AoPassarSimulacao(void* contexto, const EstadoJogo* estado, int primeiroAcerto, const double* tempoCliques) {
+    (void)contexto;
+    if (!somAtivo)
+        return;
+    TocarAcertosSom(&mixer, estado, primeiroAcerto, tempoCliques, (float)LARGURA_VIRTUAL);
+    AtualizarAndamentoSom(&mixer, &andamentoSom, estado, true);
+}
+
+// Versão do AtualizarJogo com a partida na thread da simulação: só entrega os cliques do frame, com o momento de
+// cada um. O botão de pausa para a thread (ela aplica os cliques de antes dele e avança até agora), e os cliques
+// depois dele são ignorados. Quando a thread para sozinha no fim da partida, a partida volta para cá e é finalizada.
+bool AtualizarJogoThread() {
+    bool pausou = false;
+    if (SimulacaoRodando(&simulacao)) {
+        Rectangle btnPausaRect = RetanguloBotaoPausa();
+        for (int i = 0; i < filaEntrada.totalEventos; i++) {
+            EventoEntrada* e = &filaEntrada.eventos[i];
+            if (e->tipo != EVENTO_CLIQUE || e->consumido)
+                continue;
+            e->consumido = true;
+            if (CheckCollisionPointRec(e->posicao, btnPausaRect)) {
+                pausou = true;
+                break;
+            }
+            EnviarCliqueSimulacao(&simulacao, e->tempo, e->posicao.x, e->posicao.y);
+        }
+        if (pausou)
+            PausarSimulacao(&simulacao);
+    }
+    if (!pausou && !partidaFinalizada && !SimulacaoRodando(&simulacao) && jogo.jogoAcabou) {
+        partidaFinalizada = true;
+        FinalizarPartida();
+    }
+    return pausou;
+}
+
+// Avança a partida versus: recebe as entradas do rival, passa os cliques locais de cada tick para a sessão (que faz
+// os rollbacks) e envia as entradas locais. Como no PassoJogo, cada clique cai no tick em que aconteceu dentro do
+// frame. Não há pausa: os dois jogam a mesma partida. Continua sendo chamada depois do fim, até o resultado ser
+// confirmado (e depois, para o rival receber as últimas entradas locais).
+void AtualizarJogoVersus() {
+    double agora = GetTime();
+    ConfiguracaoJogo base = {0}; // Só é usada no aperto de mão, que já terminou.
+    ProcessarConexaoVersus(&conexaoVersus, &versus, &jogo, &base, agora);
+    if (!versusConfirmado && ConexaoVersusPerdida(&conexaoVersus, agora))
+        versusPerdido = true;
+
+    double dt = DuracaoQuadroEntrada(&filaEntrada);
+    double inicio = acumuladorVersus;
+    acumuladorVersus += dt > 0.0 ? dt : 0.0;
+    int ticks = (int)(acumuladorVersus * TICKS_POR_SEGUNDO);
+    acumuladorVersus -= ticks * PASSO_FIXO;
+    if (acumuladorVersus < 0.0) // Protege contra erro de arredondamento.
+        acumuladorVersus = 0.0;
+    if (ticks > JANELA_ROLLBACK) // Depois de um travamento longo, a sessão pararia na janela de qualquer jeito.
+        ticks = JANELA_ROLLBACK;
+
+    // Tick de cada clique dentro do frame (os de um frame sem tick inteiro ficam para o próximo).
+    int tickClique[MAX_EVENTOS_ENTRADA];
+    Vector2 posicaoClique[MAX_EVENTOS_ENTRADA];
+    int totalCliques = 0;
+    for (int i = 0; i < filaEntrada.totalEventos; i++) {
+        EventoEntrada* e = &filaEntrada.eventos[i];
+        if (e->tipo != EVENTO_CLIQUE || e->consumido)
+            continue;
+        e->consumido = true;
+        int k = (int)((inicio + e->tempo - filaEntrada.inicioQuadro) * TICKS_POR_SEGUNDO);
+        tickClique[totalCliques] = k < 0 ? 0 : (k >= ticks ? ticks - 1 : k);
+        posicaoClique[totalCliques++] = e->posicao;
+    }
+    int proximo = 0;
+    for (int k = 0; k <= ticks; k++) {
+        for (; proximo < totalCliques && (tickClique[proximo] <= k || k == ticks); proximo++) {
+            if (entradaVersus.totalCliques == MAX_CLIQUES_VERSUS)
+                continue;
+            Vector2 p = posicaoClique[proximo];
+            entradaVersus.x[entradaVersus.totalCliques] = (uint16_t)(p.x < 0.0f ? 0.0f : p.x);
+            entradaVersus.y[entradaVersus.totalCliques] = (uint16_t)(p.y < 0.0f ? 0.0f : p.y);
+            entradaVersus.totalCliques++;
+        }
+        if (k == ticks)
+            break;
+        int acertosAntes = jogo.totalAcertosRecentes;
+        if (AvancarSessaoVersus(&versus, &entradaVersus) == PASSO_AVANCOU)
+            entradaVersus.totalCliques = 0;
+        // Um rollback descarta os acertos já mostrados: depois dele, todos os que sobraram são do tick novo.
+        if (somAtivo)
+            TocarAcertosSom(&mixer, &jogo, versus.refeitosUltimoPasso > 0 ? 0 : acertosAntes, NULL, (float)LARGURA_VIRTUAL);
+        EnviarConexaoVersus(&conexaoVersus, &versus, agora);
+    }
+    if (ticks == 0)
+        EnviarConexaoVersus(&conexaoVersus, &versus, agora); // Mantém a confirmação chegando ao rival.
+
+    if (!versusConfirmado && SessaoVersusConfirmada(&versus)) {
+        versusConfirmado = true;
+        FinalizarPartida();
+    }
+}
+
+// Avança os efeitos visuais da partida: emite as faíscas e os pontos dos acertos do frame e mantém a chuva
+// enquanto 'chovendo' (quando ela para, as gotas terminam de cair e morrem no chão). Não mexe na lógica.
+// Com a thread da simulação, os acertos vêm do anel dela e 'estado' é o último publicado.
+void AtualizarEfeitos(double dt, const EstadoJogo* estado) {
+    float largura = (float)LARGURA_VIRTUAL, altura = (float)ALTURA_VIRTUAL;
+    AcertoJogo acertos[MAX_ACERTOS_SIMULACAO];
+    int totalAcertos;
+    if (simulacao.iniciada) {
+        totalAcertos = LerAcertosSimulacao(&simulacao, acertos, MAX_ACERTOS_SIMULACAO);
+    } else {
+        totalAcertos = jogo.totalAcertosRecentes;
+        memcpy(acertos, jogo.acertosRecentes, (size_t)totalAcertos * sizeof(AcertoJogo));
+        jogo.totalAcertosRecentes = 0;
+    }
+    for (int k = 0; k < totalAcertos; k++) {
+        const AcertoJogo* a = &acertos[k];
+        Retangulo r = estado->capivaras.rect[a->buraco];
+        EmitirAcerto(&efeitos, &geradorParticulas, r.x + r.largura / 2, r.y + r.altura / 2, (TipoCapivara)a->tipo, a->pontos);
+    }
+    if (estado->chovendo)
+        EmitirChuva(&chuva, &geradorParticulas, totalGotas, largura, altura);
+    AtualizarParticulas(&chuva, (float)dt, altura, altura + 30.0f, estado->chovendo);
+    AtualizarParticulas(&efeitos, (float)dt, FLT_MAX, 0.0f, false);
+}
+
+// Chamada pela thread de áudio da Raylib sempre que o fluxo precisa de mais quadros.
+static void PreencherSom(void* buffer, unsigned int quadros) {
+    MisturarSom(&mixer, (int16_t*)buffer, (int)quadros);
+}
+
+// Abre o dispositivo de áudio e liga o mixer a um fluxo de 16 bits estéreo com buffers de 'quadros' quadros.
+// Sem dispositivo, o jogo continua sem som.
+void IniciarAudio(int quadros) {
+    InitAudioDevice();
+    if (!IsAudioDeviceReady()) {
+        TraceLog(LOG_WARNING, "SOM: sem dispositivo de áudio, o jogo fica sem som");
+        return;
+    }
+    if (!IniciarSom(&mixer, RelogioJogo)) {
+        TraceLog(LOG_WARNING, "SOM: sem memória para as amostras");
+        CloseAudioDevice();
+        return;
+    }
+    SetAudioStreamBufferSizeDefault(quadros);
+    fluxoSom = LoadAudioStream(TAXA_SOM, 16, 2);
+    SetAudioStreamCallback(fluxoSom, PreencherSom);
+    PlayAudioStream(fluxoSom);
+    andamentoSom = (AndamentoSom){0};
+    somAtivo = true;
+    TraceLog(LOG_INFO, "SOM: buffers de %d quadros (%.1f ms)", quadros, 1000.0 * quadros / TAXA_SOM);
+}
+
+// Para a thread de áudio antes de ler as estatísticas do mixer e de liberar as amostras.
+void EncerrarAudio() {
+    if (!somAtivo)
+        return;
+    StopAudioStream(fluxoSom);
+    UnloadAudioStream(fluxoSom);
+    CloseAudioDevice();
+    somAtivo = false;
+    ResumoLatenciaSom r = ResumirLatenciaSom(&mixer);
+    if (r.total > 0)
+        TraceLog(LOG_INFO, "SOM: %lld acertos, clique -> envio p50 %.1f ms / p99 %.1f ms, envio -> mistura p50 %.1f ms / p99 %.1f ms, "
+                 "clique -> mistura p99 %.1f ms (máximo %.1f)", (long long)r.total, r.cliqueEnvioP50, r.cliqueEnvioP99,
+                 r.envioMisturaP50, r.envioMisturaP99, r.totalP99, r.totalMax);
+    if (mixer.vozesRoubadas > 0 || mixer.comandosPerdidos > 0)
+        TraceLog(LOG_INFO, "SOM: %lld vozes roubadas, %lld comandos perdidos", (long long)mixer.vozesRoubadas, (long long)mixer.comandosPerdidos);
+    LiberarSom(&mixer);
+}
+
+// Desenha as partículas em um único lote com a textura da fonte: as gotas e as faíscas usam o pixel branco que
+// a Raylib usa nas formas (da própria textura da fonte) e os pontos usam os glifos do texto em cache.
+// Os vértices vão direto para o lote da rlgl, sem uma chamada de desenho por partícula.
+void DesenharParticulas(const SistemaParticulas* s) {
+    if (s->total == 0)
+        return;
+    Texture2D textura = GetShapesTexture();
+    Rectangle branco = GetShapesTextureRectangle();
+    float u = (branco.x + branco.width / 2) / textura.width, v = (branco.y + branco.height / 2) / textura.height;
+    ContarDesenhoLote(textura.id);
+    rlSetTexture(textura.id);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    rlTexCoord2f(u, v); // Todas as gotas e faíscas usam o mesmo texel.
+    for (int i = 0; i < s->total; i++) {
+        if ((i & 1023) == 0) // Reserva espaço no lote em blocos; se ele encher, a rlgl o envia e continua.
+            rlCheckRenderBatchLimit(4 * (s->total - i < 1024 ? s->total - i : 1024));
+        uint32_t cor = s->cor[i];
+        uint8_t alfa = (uint8_t)(cor >> 24);
+        float x = s->x[i], y = s->y[i], t = s->tamanho[i];
+        if (s->tipo[i] == PARTICULA_CHUVA) {
+            // Risco fino inclinado na direção da queda: a base em (x, y), o topo 't' pixels acima.
+            float dx = -s->vx[i] / s->vy[i] * t;
+            rlColor4ub((uint8_t)cor, (uint8_t)(cor >> 8), (uint8_t)(cor >> 16), alfa);
+            rlVertex2f(x + dx, y - t);
+            rlVertex2f(x, y);
+            rlVertex2f(x + 1.5f, y);
+            rlVertex2f(x + dx + 1.5f, y - t);
+        } else if (s->tipo[i] == PARTICULA_FAISCA) {
+            // Diminui e desbota até sumir.
+            float f = s->vida[i] / s->duracao[i];
+            float metade = t * (0.5f + 0.5f * f) / 2;
+            rlColor4ub((uint8_t)cor, (uint8_t)(cor >> 8), (uint8_t)(cor >> 16), (uint8_t)(alfa * f));
+            rlVertex2f(x - metade, y - metade);
+            rlVertex2f(x - metade, y + metade);
+            rlVertex2f(x + metade, y + metade);
+            rlVertex2f(x + metade, y - metade);
+        }
+    }
+    rlEnd();
+    rlSetTexture(0);
+
+    // Pontos: poucos de cada vez, com os glifos em cache. Usam a mesma textura, então continuam no mesmo lote.
+    for (int i = 0; i < s->total; i++) {
+        if (s->tipo[i] != PARTICULA_PONTOS)
+            continue;
+        uint32_t cor = s->cor[i];
+        float f = s->vida[i] / s->duracao[i];
+        Color c = { (uint8_t)cor, (uint8_t)(cor >> 8), (uint8_t)(cor >> 16), (uint8_t)(255 * (f < 0.5f ? f * 2 : 1.0f)) };
+        const TextoCacheado* texto = TextoFixo(TextFormat("%+d", s->valor[i]), (int)s->tamanho[i]);
+        DesenharTextoCacheado(texto, (int)s->x[i] - texto->largura / 2, (int)s->y[i], c);
+    }
+}
+
+// Função auxiliar para desenhar uma textura de fundo esticada para preencher a tela virtual inteira.
+void DesenharFundo(Texture2D fundo) {
+    if (fundo.id == 0) // A textura ainda está sendo carregada em segundo plano: fica só a cor de fundo.
+        return;
+    Rectangle origem = {0, 0, (float)fundo.width, (float)fundo.height};
+    DesenharTexturaLote(fundo, origem, (Rectangle){0, 0, LARGURA_VIRTUAL, ALTURA_VIRTUAL}, WHITE);
+}
+
+// Função responsável por desenhar todos os elementos visuais do jogo na tela.
+// O fundo, a chuva e os animais vêm todos do atlas, então são desenhados em um único lote, sem troca de textura.
+// O texto e os retângulos da interface usam a textura da fonte e formam o segundo lote.
+// 'estado' é a partida a desenhar (a publicada pela simulação, se ela roda em outra thread) e 'adiantamento' é quanto
+// o frame está à frente do último tick dele: o cronômetro e a contagem são mostrados no momento do frame.
+void DesenharJogo(const EstadoJogo* estado, double adiantamento) {
+    // Desenha o fundo do jogo, esticado para preencher toda a tela, independentemente do tamanho original da imagem.
+    DesenharSpriteAtlas(&recursos.atlas, SPRITE_FUNDO_JOGO, (Rectangle){0,0, (float)LARGURA_VIRTUAL, (float)ALTURA_VIRTUAL}, WHITE);
+
+    // Loop para desenhar cada capivara (ou animal) na tela.
+    const Capivaras* c = &estado->capivaras;
+    for (int i = 0; i < estado->totalCapivaras; i++) {
+        // Se a capivara não está visível e não está machucada, não há necessidade de desenhá-la.
+        if (!c->visivel[i] && !c->machucada[i])
+            continue; // Pula para a próxima iteração do loop.
+
+        IdSprite sprite = SPRITE_CAPIVARA_NORMAL; // Por padrão, usa a imagem da capivara normal.
+        // Seleciona a imagem correta com base no tipo de animal.
+        if (c->tipo[i] == DOURADA) {
+            sprite = SPRITE_CAPIVARA_DOURADA; // Se for dourada, usa a imagem da capivara dourada.
+        } else if (c->tipo[i] == CUTIA) {
+            sprite = SPRITE_CUTIA; // Se for cutia, usa a imagem da cutia.
+        }
+        // Se estiver machucada, sempre desenha a imagem de atordoado.
+        if (c->machucada[i])
+            sprite = SPRITE_ATORDOADO;
+
+        // O retângulo de destino onde a imagem será desenhada: o buraco inteiro, ou 90% dele, centralizado, na
+        // cutia. É o mesmo retângulo que o teste de clique usa (ESCALA_DESENHO, em logica.c).
+        Retangulo slot = RetanguloDesenho(c->rect[i], c->tipo[i]);
+        Rectangle destRec = { slot.x, slot.y, slot.largura, slot.altura };
+
+        DesenharSpriteAtlas(&recursos.atlas, sprite, destRec, WHITE);
+    }
+
+    // --- Partículas ---
+    // A chuva cai na frente dos animais, e as faíscas e os pontos saem de cada acerto. Tudo usa a textura da
+    // fonte, a mesma da interface, então as partículas e o texto formam um único lote depois do atlas.
+    PERFIL_BLOCO(FASE_PARTICULAS) {
+        DesenharParticulas(&chuva);
+        DesenharParticulas(&efeitos);
+    }
+
+    // --- UI (Interface do Usuário) do Jogo ---
+
+    // Desenha o tempo restante no canto superior direito, formatado como "MM:SS".
+    // O texto só é montado de novo quando o segundo muda, e a pontuação quando ela muda.
+    static TextoCacheado textoTempo, textoPontos;
+    double tempoRestante = estado->tempoRestanteJogo;
+    if (estado->jogoIniciado && !estado->jogoAcabou)
+        tempoRestante = tempoRestante > adiantamento ? tempoRestante - adiantamento : 0.0;
+    int segundosRestantes = (int)tempoRestante;
+    if (TextoPrecisaAtualizar(&textoTempo, segundosRestantes))
+        DefinirTexto(&textoTempo, TextFormat("Tempo: %02d:%02d", segundosRestantes / 60, segundosRestantes % 60), 30);
+    DesenharTextoCacheado(&textoTempo, LARGURA_VIRTUAL - 200, 20, WHITE);
+    // Desenha a pontuação no canto superior esquerdo. No versus, a do jogador local, com a do rival embaixo.
+    int pontos = modoVersus ? versus.pontos[versus.jogadorLocal] : estado->pontos;
+    if (TextoPrecisaAtualizar(&textoPontos, pontos))
+        DefinirTexto(&textoPontos, TextFormat("Pontos: %d", pontos), 30);
+    DesenharTextoCacheado(&textoPontos, 20, 20, WHITE);
+    if (modoVersus) {
+        static TextoCacheado textoRival, textoRede;
+        int pontosRival = versus.pontos[1 - versus.jogadorLocal];
+        if (TextoPrecisaAtualizar(&textoRival, pontosRival))
+            DefinirTexto(&textoRival, TextFormat("Rival: %d", pontosRival), 30);
+        DesenharTextoCacheado(&textoRival, 20, 60, ORANGE);
+        // Estado da rede, refeito uma vez por segundo.
+        const EstatisticasVersus* e = &versus.estatisticas;
+        if (TextoPrecisaAtualizar(&textoRede, (int)GetTime()))
+            DefinirTexto(&textoRede, TextFormat("rtt %.0f ms  |  rollback em %.1f%% dos ticks (máx. %d)  |  atraso %d", conexaoVersus.rttMs,
+                                                e->ticks > 0 ? 100.0 * e->rollbacks / e->ticks : 0.0, e->maxRefeitos, versus.atraso), 20);
+        DesenharTextoCacheado(&textoRede, 20, 100, GOLD);
+    } else {
+        // Desenha o botão de PAUSE no centro superior da tela (o versus não tem pausa).
+        Rectangle btnPausaRect = RetanguloBotaoPausa();
+        // A cor do botão muda ao passar o mouse.
+        DesenharRetanguloLote(btnPausaRect, CheckCollisionPointRec(GetMousePosition(), btnPausaRect) ? BROWN : Fade(RED, 0.5f));
+        DesenharTextoFixo("PAUSE", (int)btnPausaRect.x + 25, (int)btnPausaRect.y + 10, 20, WHITE);
+    }
+
+    // --- Contagem Regressiva Inicial ---
+    // Exibe a contagem regressiva antes do jogo realmente começar.
+    if (!estado->jogoIniciado) {
+        static TextoCacheado textoContador;
+        double regressivo = estado->contadorRegressivoInicial - adiantamento;
+        int contador = (int)regressivo;
+        if (regressivo > 1) { // Se o contador é maior que 1 (ex: 3, 2).
+            if (TextoPrecisaAtualizar(&textoContador, contador))
+                DefinirTexto(&textoContador, TextFormat("%d", contador), 100); // Exibe o número inteiro.
+        } else if (regressivo > 0) { // Se o contador está entre 0 e 1 (quase no fim).
+            if (TextoPrecisaAtualizar(&textoContador, -1))
+                DefinirTexto(&textoContador, "GO!", 100); // Exibe "GO!".
+        }
+        
+        // Desenha o texto da contagem regressiva, centralizado na tela.
+        if (regressivo > 0) { // Garante que só desenhe se houver texto.
+            DesenharTextoCacheado(&textoContador, LARGURA_VIRTUAL / 2 - textoContador.largura / 2, ALTURA_VIRTUAL / 2 - 50, GOLD);
+        }
+    }
+    
+    // --- Tela de Fim de Jogo (Overlay) ---
+    // É desenhada sobre o resto do jogo quando 'jogoAcabou' é true.
+    if (estado->jogoAcabou) {
+        // Desenha um retângulo semi-transparente que escurece a tela, dando um efeito de overlay.
+        DesenharRetanguloLote((Rectangle){0, 0, (float)LARGURA_VIRTUAL, (float)ALTURA_VIRTUAL}, ColorAlpha(BLACK, 0.7f));
+        static TextoCacheado pontuacaoFinalTexto, replayTexto;
+        if (TextoPrecisaAtualizar(&pontuacaoFinalTexto, pontos))
+            DefinirTexto(&pontuacaoFinalTexto, TextFormat("Pontuação final: %d", pontos), 40);
+        
+        // Desenha as mensagens de "Fim de jogo!" e a pontuação final, centralizadas.
+        DesenharTextoFixoCentralizado("Fim de jogo!", LARGURA_VIRTUAL / 2, ALTURA_VIRTUAL / 2 - 100, 60, WHITE);
+        DesenharTextoCacheado(&pontuacaoFinalTexto, LARGURA_VIRTUAL / 2 - pontuacaoFinalTexto.largura / 2, ALTURA_VIRTUAL / 2 - 30, WHITE);
+        // Na reprodução, mostra se a pontuação bateu com a gravada; numa partida normal, a posição no placar; no
+        // versus, o resultado, depois que as últimas entradas do rival chegam.
+        if (modoVersus && !versusConfirmado)
+            DesenharTextoFixoCentralizado(versusPerdido ? "O rival desconectou antes de confirmar o resultado" : "Confirmando o resultado...",
+                                          LARGURA_VIRTUAL / 2, ALTURA_VIRTUAL / 2 + 130, 30, GOLD);
+        else if (!reproduzindo)
+            DesenharTextoCacheado(&textoPlacar, LARGURA_VIRTUAL / 2 - textoPlacar.largura / 2, ALTURA_VIRTUAL / 2 + 130, GOLD);
+        if (reproduzindo) {
+            bool bateu = estado->pontos == gravacao.pontosFinais;
+            if (bateu) {
+                DesenharTextoFixoCentralizado("REPLAY OK", LARGURA_VIRTUAL / 2, ALTURA_VIRTUAL / 2 + 130, 30, GREEN);
+            } else {
+                if (TextoPrecisaAtualizar(&replayTexto, gravacao.pontosFinais))
+                    DefinirTexto(&replayTexto, TextFormat("REPLAY DIVERGIU (gravado: %d)", gravacao.pontosFinais), 30);
+                DesenharTextoCacheado(&replayTexto, LARGURA_VIRTUAL / 2 - replayTexto.largura / 2, ALTURA_VIRTUAL / 2 + 130, RED);
+            }
+        }
+    }
+    // O rival parou de responder: a partida fica parada na janela de previsão.
+    if (versusPerdido && !estado->jogoAcabou) {
+        DesenharRetanguloLote((Rectangle){0, 0, (float)LARGURA_VIRTUAL, (float)ALTURA_VIRTUAL}, ColorAlpha(BLACK, 0.7f));
+        DesenharTextoFixoCentralizado("O rival desconectou", LARGURA_VIRTUAL / 2, ALTURA_VIRTUAL / 2 - 100, 60, WHITE);
+    }
+    // Durante a reprodução, indica que os cliques não são do jogador.
+    if (reproduzindo && !estado->jogoAcabou)
+        DesenharTextoFixo("REPLAY  (setas: -5 s / +5 s)", 20, 60, 20, GOLD);
+}
+
+// Partida a desenhar neste frame: o último estado publicado pela thread da simulação ou, sem ela, a própria
+// partida. 'adiantamento' recebe quanto o frame está à frente do estado (0 com a partida parada).
+const EstadoJogo* EstadoDesenho(bool emAndamento, double* adiantamento) {
+    *adiantamento = 0.0;
+    if (simulacao.iniciada) {
+        double tempo = 0.0;
+        const EstadoJogo* estado = LerEstadoSimulacao(&simulacao, &vistaJogo, &tempo);
+        if (estado != NULL) {
+            // Até um tick: se a simulação atrasar, o desenho não inventa o que ela ainda não decidiu.
+            if (emAndamento && SimulacaoRodando(&simulacao)) {
+                double diferenca = GetTime() - tempo;
+                *adiantamento = diferenca < 0.0 ? 0.0 : (diferenca > PASSO_FIXO ? PASSO_FIXO : diferenca);
+            }
+            return estado;
+        }
+    }
+    if (emAndamento)
+        *adiantamento = jogo.acumulador;
+    return &jogo;
+}
+
+// Adquire as texturas da tela nova (antes de liberar as da anterior, para as duas não serem descartadas no meio),
+// troca as previstas e espera as que a tela nova desenha. Com 'anterior' negativo, só adquire, sem esperar.
+static void TrocarRecursosTela(int anterior, Tela nova) {
+    if (carregarTudo)
+        return;
+    const RecursosTela* t = &RECURSOS_TELA[nova];
+    for (int i = 0; i < TOTAL_RECURSOS; i++)
+        if (t->usa & (1u << i))
+            AdquirirRecurso(&recursos, (IdRecurso)i);
+    if (anterior >= 0)
+        for (int i = 0; i < TOTAL_RECURSOS; i++)
+            if (RECURSOS_TELA[anterior].usa & (1u << i))
+                LiberarRecurso(&recursos, (IdRecurso)i);
+    IdRecurso previstos[2];
+    int totalPrevistos = 0;
+    for (int i = 0; i < 2; i++)
+        if (t->preve[i] != TOTAL_RECURSOS)
+            previstos[totalPrevistos++] = t->preve[i];
+    PreverRecursos(&recursos, previstos, totalPrevistos);
+    if (anterior >= 0)
+        esperaRecursos += EsperarRecursos(&recursos, t->usa);
+}
+
+// Telas em que nada se move sozinho: só a entrada do jogador muda o que aparece nelas.
+static bool TelaParada(Tela tela) {
+    return tela == TELA_MENU || tela == TELA_CREDITOS || tela == TELA_SELECAO_DIFICULDADE || tela == TELA_PAUSA || tela == TELA_INICIAL;
+}
+
+// --- FUNÇÃO PRINCIPAL ---
+// O ponto de entrada do programa. Aqui o jogo é inicializado e o loop principal é executado.
+int main(int argc, char* argv[]) {
+    // Modo de estresse: "--estresse [N]" joga com N buracos (1000 se N for omitido), em grade ocupando a tela.
+    // "--perfil [arquivo.csv]" grava o tempo de cada frame da sessão ao fechar o jogo (perfil.csv se omitido).
+    // "--gravar [arquivo.brec]" grava cada partida terminada (partida.brec se omitido).
+    // "--replay arquivo.brec" reproduz uma partida gravada na tela e confere a pontuação final.
+    // "--placar PORTA" envia as pontuações ao servidor_placar nessa porta em vez de guardá-las em placar.idx/.log.
+    // "--chuva N" faz a chuva do DIFICIL com N gotas (1500 por padrão), para medir o sistema de partículas.
+    // "--versus PORTA ENDERECO:PORTA" joga contra outra instância: UDP na PORTA local, rival em ENDERECO:PORTA (IPv4).
+    //   "--atraso-entrada N" muda o atraso de entrada (2 ticks); "--latencia MS", "--variacao MS" e "--perda %" pioram
+    //   a rede de propósito, para testar duas janelas na mesma máquina.
+    // "--janela LARGURAxALTURA" abre a janela com outro tamanho (1500x800 por padrão); "--tela-cheia" ocupa o monitor.
+    // "--escala F" fixa a resolução interna em F (de 0.5 a 1) da área na janela, sem a resolução dinâmica.
+    // "--sem-som" desliga o áudio; "--buffer-som N" muda o buffer de áudio (256 quadros, 5,3 ms, por padrão).
+    // "--thread-unica" avança a partida dentro do frame, como antes da thread da simulação (para comparar).
+    // "--telemetria [arquivo.btel]" grava os eventos das partidas (telemetria.btel se omitido) para os tempos de reação.
+    // "--orcamento-texturas MB" muda o orçamento das texturas na GPU (24 MB por padrão; 0 não tem limite).
+    // "--carregar-tudo" carrega todas as texturas no início e nunca as descarta, como antes (para comparar).
+    const char* arquivoPerfil = NULL;
+    const char* arquivoTelemetria = NULL;
+    bool threadUnica = false;
+    bool semSom = false;
+    int quadrosBufferSom = QUADROS_BUFFER_SOM;
+    int larguraJanela = LARGURA_VIRTUAL, alturaJanela = ALTURA_VIRTUAL;
+    bool telaCheia = false;
+    float escalaFixa = 0.0f; // 0: resolução dinâmica.
+    size_t orcamentoTexturas = ORCAMENTO_TEXTURAS_PADRAO;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--estresse") == 0) {
+            totalBuracos = 1000;
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0)
+                totalBuracos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--gravar") == 0) {
+            arquivoGravacao = "partida" EXTENSAO_GRAVACAO;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                arquivoGravacao = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            if (!CarregarGravacao(&gravacao, argv[++i])) {
+                fprintf(stderr, "Não foi possível ler a gravação %s\n", argv[i]);
+                return 1;
+            }
+            reproduzindo = true;
+        } else if (strcmp(argv[i], "--placar") == 0) {
+            portaPlacar = PORTA_PLACAR;
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0)
+                portaPlacar = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--chuva") == 0 && i + 1 < argc) {
+            totalGotas = atoi(argv[++i]);
+            if (totalGotas < 0)
+                totalGotas = 0;
+        } else if (strcmp(argv[i], "--versus") == 0 && i + 2 < argc) {
+            modoVersus = true;
+            portaVersus = (uint16_t)atoi(argv[++i]);
+            const char* rival = argv[++i];
+            const char* doisPontos = strrchr(rival, ':');
+            if (doisPontos != NULL) {
+                size_t n = (size_t)(doisPontos - rival) < sizeof(enderecoRival) - 1 ? (size_t)(doisPontos - rival) : sizeof(enderecoRival) - 1;
+                memcpy(enderecoRival, rival, n);
+                enderecoRival[n] = '\0';
+                rival = doisPontos + 1;
+            }
+            portaRival = (uint16_t)atoi(rival); // Só a porta: o rival está na mesma máquina.
+        } else if (strcmp(argv[i], "--atraso-entrada") == 0 && i + 1 < argc) {
+            atrasoVersus = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--latencia") == 0 && i + 1 < argc) {
+            redeSimulada.latenciaMs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--variacao") == 0 && i + 1 < argc) {
+            redeSimulada.variacaoMs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--perda") == 0 && i + 1 < argc) {
+            redeSimulada.perda = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--janela") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &larguraJanela, &alturaJanela) != 2 || larguraJanela < 1 || alturaJanela < 1) {
+                larguraJanela = LARGURA_VIRTUAL;
+                alturaJanela = ALTURA_VIRTUAL;
+            }
+        } else if (strcmp(argv[i], "--tela-cheia") == 0) {
+            telaCheia = true;
+        } else if (strcmp(argv[i], "--escala") == 0 && i + 1 < argc) {
+            escalaFixa = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--thread-unica") == 0) {
+            threadUnica = true;
+        } else if (strcmp(argv[i], "--telemetria") == 0) {
+            arquivoTelemetria = "telemetria" EXTENSAO_TELEMETRIA;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                arquivoTelemetria = argv[++i];
+        } else if (strcmp(argv[i], "--orcamento-texturas") == 0 && i + 1 < argc) {
+            int mb = atoi(argv[++i]);
+            orcamentoTexturas = mb > 0 ? (size_t)mb << 20 : 0;
+        } else if (strcmp(argv[i], "--carregar-tudo") == 0) {
+            carregarTudo = true;
+        } else if (strcmp(argv[i], "--sem-som") == 0) {
+            semSom = true;
+        } else if (strcmp(argv[i], "--buffer-som") == 0 && i + 1 < argc) {
+            quadrosBufferSom = atoi(argv[++i]);
+            if (quadrosBufferSom < 32)
+                quadrosBufferSom = QUADROS_BUFFER_SOM;
+        } else if (strcmp(argv[i], "--sempre-desenhar") == 0) {
+            desenharSempre = true;
+        } else if (strcmp(argv[i], "--perfil") == 0) {
+            arquivoPerfil = "perfil.csv";
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                arquivoPerfil = argv[++i];
+        }
+    }
+
+    // As telas são desenhadas em coordenadas virtuais de 1500x800 e esticadas para a janela, que pode ter qualquer
+    // tamanho (e ser redimensionada durante o jogo).
+    const int larguraTela = LARGURA_VIRTUAL;
+    const int alturaTela = ALTURA_VIRTUAL;
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+    InitWindow(larguraJanela, alturaJanela, "Barigueira Attack!"); // Inicializa a janela da Raylib com título.
+    SetWindowMinSize(LARGURA_VIRTUAL / 5, ALTURA_VIRTUAL / 5);
+    if (telaCheia) {
+        int monitor = GetCurrentMonitor();
+        SetWindowSize(GetMonitorWidth(monitor), GetMonitorHeight(monitor));
+        ToggleFullscreen();
+    }
+    // Define o limite de quadros por segundo (FPS) para 60, para uma experiência de jogo suave. A fila de entrada
+    // faz a espera entre os frames no lugar do SetTargetFPS, lendo o mouse e o teclado a cada milissegundo.
+    IniciarEntrada(&filaEntrada, 60);
+    IniciarResolucao(&resolucao, filaEntrada.duracaoAlvo, escalaFixa);
+    deslocamentoRelogio = GetTime() - RelogioSimulacao();
+    if (!semSom)
+        IniciarAudio(quadrosBufferSom);
+
+    // --- CARREGAMENTO INICIAL DE TEXTURAS ---
+    // As texturas são carregadas em segundo plano, enquanto a tela inicial já aparece com uma barra de progresso.
+    // Vêm do pacote barigueira.pak (sem decodificar PNG) ou, se ele não existir, dos PNGs.
+    // O campo de jogo (fundo, chuva e animais) fica no atlas. Só a tela inicial e as que ela prevê são pedidas; as
+    // outras são pedidas na troca de tela, e as que sobram no orçamento são descartadas.
+    IniciarCarregamentoRecursos(&recursos, carregarTudo ? 0 : orcamentoTexturas);
+    if (carregarTudo) {
+        static const IdRecurso ORDEM_TUDO[] = { RECURSO_FUNDO_PRINCIPAL, RECURSO_ATLAS, RECURSO_FUNDO_MENU, RECURSO_FUNDO_CREDITOS };
+        for (int i = 0; i < TOTAL_RECURSOS; i++)
+            AdquirirRecurso(&recursos, ORDEM_TUDO[i]);
+    }
+    TrocarRecursosTela(-1, TELA_INICIAL);
+    IniciarGerador(&geradorParticulas, (uint64_t)time(NULL));
+    if (reproduzindo)
+        modoVersus = false; // A reprodução tem os cliques de um jogador só.
+    // Zera o estado para que LiberarEstadoJogo não tente liberar memória de um ponteiro não inicializado, o que causaria um erro.
+    // Antes da telemetria, que fica apontada no estado.
+    memset(&jogo, 0, sizeof(jogo));
+    // A partida normal avança na thread da simulação. A reprodução (que salta com as setas) e o versus (que refaz
+    // ticks a cada pacote do rival) continuam avançando dentro do frame.
+    if (!threadUnica && !reproduzindo && !modoVersus && !IniciarThreadSimulacao(&simulacao, &jogo, RelogioJogo, AoPassarSimulacao, NULL))
+        TraceLog(LOG_WARNING, "SIMULACAO: não foi possível criar a thread; a partida avança no frame");
+    // Só as partidas normais: a reprodução volta no tempo e o versus refaz ticks, o que repetiria os eventos.
+    if (arquivoTelemetria != NULL && !reproduzindo && !modoVersus) {
+        if (IniciarTelemetria(&telemetria, arquivoTelemetria))
+            jogo.telemetria = &telemetria; // Mantida pelo InicializarEstadoJogo e pelo RecomecarEstadoJogo.
+        else
+            TraceLog(LOG_WARNING, "TELEMETRIA: não foi possível criar %s", arquivoTelemetria);
+    }
+    if (portaPlacar != 0 || modoVersus)
+        IniciarRedePlacar();
+    if (portaPlacar == 0 && !reproduzindo) {
+        placarAberto = AbrirPlacar(&placar, "placar");
+        placar.sincronizar = true; // Uma pontuação por partida: o fsync não pesa.
+        if (!placarAberto)
+            TraceLog(LOG_WARNING, "PLACAR: não foi possível abrir placar.idx / placar.log");
+    }
+    if (!IniciarParticulas(&chuva, totalGotas) || !IniciarParticulas(&efeitos, 8192))
+        TraceLog(LOG_WARNING, "PARTICULAS: sem memória para %d gotas", totalGotas);
+    bool primeiroFrame = true; // Para medir o tempo até o primeiro frame.
+
+    Tela telaAtual = TELA_INICIAL; // Define o estado inicial do jogo para a tela de abertura.
+
+    // --- LOOP PRINCIPAL DO JOGO ---
+    // 'WindowShouldClose()' retorna true quando o usuário clica no 'X' da janela ou pressiona ESC.
+    
+    // Uso de CPU nas telas paradas (tempo de processo / tempo de relógio), mostrado no log ao fechar.
+    double cpuTelasParadas = 0.0, tempoTelasParadas = 0.0;
+    // Memória das texturas residentes (média por frame) e espera pelas texturas nas trocas de tela.
+    double somaResidentes = 0.0;
+    int64_t quadros = 0;
+    int trocasTela = 0, trocasComEspera = 0;
+    double esperaTotal = 0.0, maiorEspera = 0.0;
+    
+    while (!WindowShouldClose()) {
+        Tela telaInicioQuadro = telaAtual;  // Se a tela mudar no frame, ele não é ocioso.
+        clock_t cpuInicioQuadro = clock();
+        double inicioQuadro = GetTime();
+        IniciarQuadroPerfil();              // Fecha a medição do frame anterior.
+        IniciarQuadroEntrada(&filaEntrada); // Recebe os cliques e teclas desde o frame anterior.
+        Vector2 mouse = filaEntrada.mouse;  // Obtém a posição atual do cursor do mouse a cada frame.
+        PERFIL_BLOCO(FASE_CARGA) {
+            ProcessarCarregamentoRecursos(&recursos); // Envia para a GPU a próxima textura que terminou de carregar.
+        }
+        Texture2D fundoPrincipal = recursos.texturas[RECURSO_FUNDO_PRINCIPAL]; // Fundo da tela inicial.
+        Texture2D fundoMenu = recursos.texturas[RECURSO_FUNDO_MENU];           // Fundo do menu principal e seleção de dificuldade.
+        Texture2D fundoCreditos = recursos.texturas[RECURSO_FUNDO_CREDITOS];   // Fundo da tela de créditos.
+
+        BeginDrawing(); // Inicia o modo de desenho da Raylib para este frame.
+        IniciarQuadroLotes();   // Zera o contador de chamadas de desenho deste frame.
+        // As telas são desenhadas na textura de destino, em coordenadas virtuais. Limpa com uma cor base (útil se não
+        // houver um fundo ocupando 100%).
+        IniciarDesenhoVirtual(&resolucao, BEIGE);
+
+        // --- MÁQUINA DE ESTADOS ---
+        // Um switch-case é usado para gerenciar as diferentes telas (estados) do jogo.
+        // A lógica e o desenho executados dependem da 'telaAtual'.
+        // O tempo do switch conta como FASE_TELAS, menos o da lógica e do desenho do jogo, medidos à parte.
+        EntrarFasePerfil(FASE_TELAS);
+        switch (telaAtual) {
+            case TELA_INICIAL: {
+                DesenharFundo(fundoPrincipal); // Desenha o fundo da tela inicial.
+                const char* titulo = "BARIGUEIRA ATTACK!";
+                // Desenha o título do jogo, centralizado.
+                DesenharTextoFixoCentralizado(titulo, larguraTela / 2, alturaTela / 2 - 150, 80, BEIGE);
+                // O botão "INICIAR" só aparece quando o menu está carregado. O atlas continua carregando em
+                // segundo plano e, se ainda faltar, a partida espera por ele.
+                if (RecursoPronto(&recursos, RECURSO_FUNDO_MENU)) {
+                    // Desenha o botão "INICIAR". Se clicado, muda para a tela de menu.
+                    if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 490, 300, 60}, "INICIAR", mouse)) {
+                        telaAtual = TELA_MENU;
+                        if (reproduzindo && InicializarJogo(gravacao.configuracao.dificuldade))
+                            telaAtual = TELA_JOGO; // Na reprodução, vai direto para a partida gravada.
+                    }
+                } else {
+                    // Barra de progresso do carregamento no lugar do botão.
+                    Rectangle barra = {larguraTela / 2.0f - 150, 510, 300, 20};
+                    DesenharRetanguloLote(barra, Fade(BLACK, 0.5f));
+                    DesenharRetanguloLote((Rectangle){barra.x, barra.y, barra.width * ProgressoRecursos(&recursos), barra.height}, BEIGE);
+                    DesenharTextoFixoCentralizado("CARREGANDO...", larguraTela / 2, 540, 20, BEIGE);
+                }
+            } break; 
+
+            case TELA_MENU: {
+                DesenharFundo(fundoMenu); // Desenha o fundo do menu.
+                const char* titulo = "MENU DO JOGO";
+                // Desenha o título do menu, centralizado.
+                DesenharTextoFixoCentralizado(titulo, larguraTela / 2, 150, 60, BEIGE);
+                // Botão "JOGAR": Se clicado, vai para a seleção de dificuldade.
+                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 300, 300, 60}, "JOGAR", mouse)) {
+                    telaAtual = TELA_SELECAO_DIFICULDADE;
+                }
+                // Botão "CRÉDITOS": Se clicado, vai para a tela de créditos.
+                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 385, 300, 60}, "CRÉDITOS", mouse)) {
+                    telaAtual = TELA_CREDITOS;
+                }
+                // Botão "SAIR": Se clicado, fecha a janela do jogo, encerrando o loop principal.
+                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 470, 300, 60}, "SAIR", mouse)) {
+                    CloseWindow();
+                }
+            } break; 
+
+            case TELA_SELECAO_DIFICULDADE: {
+                DesenharFundo(fundoMenu); // Usa o mesmo fundo do menu.
+                const char* titulo = "SELECIONE A DIFICULDADE";
+                // Desenha o título da tela de seleção, centralizado.
+                DesenharTextoFixoCentralizado(titulo, larguraTela / 2, 150, 60, BEIGE);
+
+                // Botão "FÁCIL": Inicializa o jogo com a dificuldade FACIL e transiciona para a tela de jogo
+                // (no modo versus, para a espera do rival).
+                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 300, 300, 60}, "FÁCIL", mouse)) {
+                    telaAtual = EscolherDificuldade(FACIL);
+                }
+                // Botão "MÉDIO": Inicializa o jogo com a dificuldade MEDIO.
+                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 385, 300, 60}, "MÉDIO", mouse)) {
+                    telaAtual = EscolherDificuldade(MEDIO);
+                }
+                // Botão "DIFÍCIL": Inicializa o jogo com a dificuldade DIFICIL.
+                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 470, 300, 60}, "DIFÍCIL", mouse)) {
+                    telaAtual = EscolherDificuldade(DIFICIL);
+                }
+                // Botão "VOLTAR": Retorna ao menu principal.
+                if (DesenharBotao((Rectangle){larguraTela / 2 - 150, 555, 300, 60}, "VOLTAR", mouse)) {
+                    telaAtual = TELA_MENU;
+                }
+            } break; 
+
+            case TELA_ESPERA_VERSUS: {
+                DesenharFundo(fundoMenu);
+                DesenharTextoFixoCentralizado("ESPERANDO O RIVAL...", larguraTela / 2, 150, 60, BEIGE);
+                static TextoCacheado textoRival;
+                if (TextoPrecisaAtualizar(&textoRival, portaRival))
+                    DefinirTexto(&textoRival, TextFormat("UDP %d  ->  %s:%d", portaVersus, enderecoRival, portaRival), 30);
+                DesenharTextoCacheado(&textoRival, larguraTela / 2 - textoRival.largura / 2, 250, BEIGE);
+                // O aperto de mão termina quando os dois lados viram o convite um do outro.
+                ConfiguracaoJogo base = { FACIL, 0, (float)larguraTela, (float)alturaTela, 0 };
+                double agora = GetTime();
+                if (ProcessarConexaoVersus(&conexaoVersus, &versus, &jogo, &base, agora)) {
+                    LimparParticulas(&chuva);
+                    LimparParticulas(&efeitos);
+                    entradaVersus.totalCliques = 0;
+                    acumuladorVersus = 0.0;
+                    versusConfirmado = false;
+                    versusPerdido = false;
+                    telaAtual = TELA_JOGO;
+                }
+                EnviarConexaoVersus(&conexaoVersus, &versus, agora);
+                if (telaAtual == TELA_ESPERA_VERSUS && DesenharBotao((Rectangle){larguraTela / 2 - 150, 470, 300, 60}, "VOLTAR", mouse)) {
+                    FecharConexaoVersus(&conexaoVersus);
+                    telaAtual = TELA_SELECAO_DIFICULDADE;
+                }
+            } break;
+
+            case TELA_JOGO: {
+                // Na reprodução, as setas voltam ou avançam 5 segundos (também depois do fim da partida).
+                if (reproduzindo) {
+                    int64_t salto = 0;
+                    if (ConsumirTecla(&filaEntrada, KEY_LEFT))
+                        salto = -5 * TICKS_POR_SEGUNDO;
+                    if (ConsumirTecla(&filaEntrada, KEY_RIGHT))
+                        salto = 5 * TICKS_POR_SEGUNDO;
+                    if (salto != 0) {
+                        PERFIL_BLOCO(FASE_LOGICA) {
+                            IrParaTickReproducao(&gravacao, &linhaTempo, &jogo, &proximoCliqueReproducao, jogo.tick + salto);
+                        }
+                        if (jogo.jogoAcabou)
+                            FinalizarPartida();
+                    }
+                }
+                // A lógica do jogo só é atualizada se o jogo ainda não acabou. No versus, a conexão é atendida até sair
+                // da partida: um rollback pode mudar o resultado depois do fim, e o rival ainda precisa das últimas
+                // entradas locais.
+                if (modoVersus) {
+                    PERFIL_BLOCO(FASE_LOGICA) {
+                        AtualizarJogoVersus();
+                    }
+                } else if (simulacao.iniciada) {
+                    // A lógica roda na thread da simulação: aqui só entram os cliques (e a pausa).
+                    PERFIL_BLOCO(FASE_LOGICA) {
+                        if (AtualizarJogoThread())
+                            telaAtual = TELA_PAUSA;
+                    }
+                } else if (!jogo.jogoAcabou) {
+                    // Chama a função que contém toda a lógica do jogo. Ela também verifica se o botão de pause foi clicado.
+                    PERFIL_BLOCO(FASE_LOGICA) {
+                        if (AtualizarJogo()) {
+                            telaAtual = TELA_PAUSA; // Se clicado, transiciona para a tela de pausa.
+                        }
+                    }
+                }
+                double adiantamento;
+                const EstadoJogo* estado = EstadoDesenho(telaAtual == TELA_JOGO, &adiantamento);
+                // Os efeitos continuam depois do fim da partida (as últimas faíscas terminam de cair), mas param na pausa.
+                if (telaAtual == TELA_JOGO) {
+                    PERFIL_BLOCO(FASE_PARTICULAS) {
+                        AtualizarEfeitos(DuracaoQuadroEntrada(&filaEntrada), estado);
+                    }
+                }
+                PERFIL_BLOCO(FASE_JOGO) {
+                    DesenharJogo(estado, adiantamento); // Chama a função que desenha todos os elementos visuais do jogo (incluindo o overlay de fim de jogo se aplicável).
+                }
+
+                // Botões específicos que só aparecem quando o jogo termina (ou, no versus, quando o rival some).
+                // Com a thread, só depois que ela devolveu a partida.
+                if ((simulacao.iniciada ? partidaFinalizada : jogo.jogoAcabou) || versusPerdido) {
+                    // Botão "REINICIAR": Reinicia o jogo com a mesma dificuldade. No versus, a revanche começa pelo menu.
+                    if (!modoVersus && DesenharBotao((Rectangle){larguraTela / 2.0f - 260, alturaTela / 2.0f + 50, 250, 60}, "REINICIAR", mouse)) {
+                        if (!InicializarJogo(jogo.dificuldade)) // Chama a função de inicialização novamente.
+                            telaAtual = TELA_MENU;
+                    }
+                    // Botão "MENU INICIAL": Volta ao menu principal.
+                    if (DesenharBotao((Rectangle){larguraTela / 2.0f + 10, alturaTela / 2.0f + 50, 250, 60}, "MENU INICIAL", mouse)) {
+                        // A arena da partida fica alocada para a próxima (é liberada só ao fechar o jogo).
+                        if (modoVersus) {
+                            FecharConexaoVersus(&conexaoVersus);
+                            versusPerdido = false;
+                        }
+                        telaAtual = TELA_MENU; // Transiciona para o menu.
+                    }
+                }
+            } break;
+
+            case TELA_PAUSA: {
+                PERFIL_BLOCO(FASE_JOGO) {
+                    double adiantamento;
+                    DesenharJogo(EstadoDesenho(false, &adiantamento), adiantamento); // Desenha o jogo em segundo plano (como estava antes de pausar).
+                }
+                // Desenha um retângulo semi-transparente para criar um efeito de escurecimento sobre o jogo pausado.
+                DesenharRetanguloLote((Rectangle){0, 0, (float)larguraTela, (float)alturaTela}, ColorAlpha(BLACK, 0.5f));
+                const char* textoPausa = "JOGO PAUSADO";
+                // Desenha o texto "JOGO PAUSADO", centralizado.
+                DesenharTextoFixoCentralizado(textoPausa, larguraTela / 2, 150, 60, BEIGE);
+
+                // Botão "CONTINUAR": Despausa o jogo. Pode ser clicado ou pressionando ESC.
+                if (DesenharBotao((Rectangle){larguraTela / 2.0f - 150, 300, 300, 60}, "CONTINUAR", mouse) || ConsumirTecla(&filaEntrada, KEY_ESCAPE)) {
+                    telaAtual = TELA_JOGO; // Retorna à tela de jogo.
+                    if (simulacao.iniciada)
+                        RetomarSimulacao(&simulacao); // O tempo pausado não conta.
+                }
+                // Botão "REINICIAR": Reinicia a partida atual.
+                if (DesenharBotao((Rectangle){larguraTela / 2.0f - 150, 385, 300, 60}, "REINICIAR", mouse)) {
+                    telaAtual = InicializarJogo(jogo.dificuldade) ? TELA_JOGO : TELA_MENU; // Re-inicializa o jogo.
+                }
+                // Botão "MENU PRINCIPAL": Volta ao menu.
+                if (DesenharBotao((Rectangle){larguraTela / 2.0f - 150, 470, 300, 60}, "MENU PRINCIPAL", mouse)) {
+                    // A arena da partida fica alocada para a próxima.
+                    telaAtual = TELA_MENU;
+                }
+            } break; 
+
+            case TELA_CREDITOS: {
+                DesenharFundo(fundoCreditos); // Desenha o fundo da tela de créditos.
+                const char* titulo = "CRÉDITOS";
+                // Desenha o título "CRÉDITOS", centralizado.
+                DesenharTextoFixoCentralizado(titulo, larguraTela / 2, 80, 60, BEIGE);
+
+                // Array de strings contendo todo o texto dos créditos.
+                const char* creditosTexto[] = {
+                    "ALUNOS:",
+                    "ANA WALTRICK | ÂNGELO MIRANDA | VITOR KLUPPELL",
+                    "", 
+                    "INSTITUIÇÃO: CENTRO UNIVERSITÁRIO AUTÔNOMO DO BRASIL",
+                    "DISCIPLINA: PROGRAMAÇÃO AVANÇADA",
+                    "PROFESSOR: FABIO BETTIO",
+                    "",
+                    "INSPIRAÇÃO:",
+                    "JOGO WHACK-A-MOLE | CURITIBA | PARQUE BARIGUI | ANIMAIS",
+                    "",
+                    "OBRIGADO POR JOGAR!"
+                };
+                int yPos = 180; // Posição Y inicial para a primeira linha de crédito.
+                // Loop para desenhar cada linha de texto dos créditos.
+                for (int i = 0; i < sizeof(creditosTexto)/sizeof(creditosTexto[0]); i++) {
+                    // Desenha o texto, centralizado horizontalmente.
+                    DesenharTextoFixoCentralizado(creditosTexto[i], larguraTela / 2, yPos, 28, BEIGE);
+                    yPos += 40; // Incrementa a posição Y para a próxima linha.
+                }
+
+                // Botão "VOLTAR": Retorna ao menu principal.
+                if (DesenharBotao((Rectangle){larguraTela / 2.0f - 150, alturaTela - 100, 300, 60}, "VOLTAR", mouse)) {
+                    telaAtual = TELA_MENU;
+                }
+            } break; 
+        }
+        SairFasePerfil();
+        // Contagem, chuva e fim da partida tocam a partir do estado; fora da partida (pausa, menus) a chuva para.
+        // Com a partida na thread da simulação, quem toca é ela.
+        if (somAtivo && !(simulacao.iniciada && SimulacaoRodando(&simulacao)))
+            AtualizarAndamentoSom(&mixer, &andamentoSom, &jogo, telaAtual == TELA_JOGO);
+        TerminarDesenhoVirtual(&resolucao); // Estica a resolução interna para a janela.
+        // F2 liga e desliga o contador de chamadas de desenho e trocas de textura.
+        if (ConsumirTecla(&filaEntrada, KEY_F2))
+            mostrarEstatisticas = !mostrarEstatisticas;
+        // F3 liga e desliga o painel com o tempo de cada fase do frame.
+        if (ConsumirTecla(&filaEntrada, KEY_F3))
+            mostrarPerfil = !mostrarPerfil;
+        // Os painéis são desenhados direto na janela, em resolução cheia.
+        PERFIL_BLOCO(FASE_PAINEIS) {
+            if (mostrarEstatisticas) {
+                DesenharEstatisticasLotes(10, GetScreenHeight() - 82);
+                DesenharResolucao(&resolucao, 10, GetScreenHeight() - 142);
+            }
+            if (mostrarPerfil)
+                DesenharPerfil(GetScreenWidth() - 370, GetScreenHeight() - 360);
+        }
+
+        PERFIL_BLOCO(FASE_APRESENTACAO) {
+            EndDrawing(); // Finaliza o modo de desenho, apresentando o frame renderizado na tela.
+        }
+        // A resolução dinâmica só olha os frames da partida: as outras telas são leves e quase sempre estão paradas.
+        if (telaAtual == TELA_JOGO && telaInicioQuadro == TELA_JOGO)
+            MedirQuadroResolucao(&resolucao, GetTime() - inicioQuadro);
+        PERFIL_BLOCO(FASE_ESPERA) {
+            LerEntrada(&filaEntrada);           // Guarda o que chegou na leitura de entrada do EndDrawing.
+            EsperarProximoQuadro(&filaEntrada); // Espera o próximo frame lendo a entrada a cada milissegundo.
+            // Numa tela parada, um frame sem eventos que não mudou de tela é igual ao próximo: em vez de redesenhar
+            // a 60 FPS, dorme até a entrada mudar algo (clique, tecla, mouse entrando ou saindo de um botão).
+            // Só dorme sem carregamento em andamento (a barra de progresso se move e as texturas vão para a GPU).
+            bool carregado = !CarregandoRecursos(&recursos);
+            if (!desenharSempre && carregado && TelaParada(telaAtual) && telaAtual == telaInicioQuadro && filaEntrada.totalEventos == 0)
+                EsperarMudancaEntrada(&filaEntrada);
+        }
+        if (TelaParada(telaInicioQuadro) && TelaParada(telaAtual)) {
+            cpuTelasParadas += (double)(clock() - cpuInicioQuadro) / CLOCKS_PER_SEC;
+            tempoTelasParadas += GetTime() - inicioQuadro;
+        }
+
+        // Troca de tela: as texturas da tela nova são adquiridas e, se ainda faltarem, esperadas aqui, antes do
+        // primeiro frame dela.
+        if (telaAtual != telaInicioQuadro) {
+            TrocarRecursosTela(telaInicioQuadro, telaAtual);
+            trocasTela++;
+            if (esperaRecursos > 0.0005)
+                trocasComEspera++;
+            esperaTotal += esperaRecursos;
+            if (esperaRecursos > maiorEspera)
+                maiorEspera = esperaRecursos;
+            esperaRecursos = 0.0;
+        }
+        somaResidentes += (double)recursos.bytesResidentes;
+        quadros++;
+
+        if (primeiroFrame) {
+            TraceLog(LOG_INFO, "RECURSOS: primeiro frame em %.1f ms", (GetTime() - recursos.inicioCarga) * 1000.0);
+            primeiroFrame = false;
+        }
+    }
+
+    // --- DESALOCAÇÃO FINAL DA MEMÓRIA E RECURSOS AO FECHAR A JANELA ---
+    // Liberar todos os recursos alocados para evitar vazamentos de memória e garantir um encerramento limpo do programa.
+
+    if (simulacao.iniciada) {
+        PausarSimulacao(&simulacao);
+        ResumoSimulacao r = ResumirSimulacao(&simulacao);
+        if (r.ticks > 0)
+            TraceLog(LOG_INFO, "SIMULACAO: %lld ticks em %lld passos (até %d por passo), atraso do tick p50 %.2f ms, p99 %.2f ms, máximo %.2f ms",
+                     (long long)r.ticks, (long long)r.passos, r.maxTicksPorPasso, r.atrasoP50, r.atrasoP99, r.atrasoMax);
+        EncerrarThreadSimulacao(&simulacao);
+    }
+    if (jogo.telemetria != NULL) { // Depois da simulação: ninguém mais registra eventos.
+        jogo.telemetria = NULL;
+        EncerrarTelemetria(&telemetria);
+        TraceLog(LOG_INFO, "TELEMETRIA: %llu eventos em %llu bytes (%s), %llu perdidos com o anel cheio",
+                 (unsigned long long)telemetria.registrosGravados, (unsigned long long)telemetria.bytesGravados, arquivoTelemetria,
+                 (unsigned long long)telemetria.perdidos);
+    }
+    EncerrarAudio();
+    LiberarEstadoJogo(&jogo);
+    if (tempoTelasParadas > 0.0)
+        TraceLog(LOG_INFO, "OCIOSO: %.1f%% de CPU em %.0f s nas telas paradas (%s)", 100.0 * cpuTelasParadas / tempoTelasParadas, tempoTelasParadas,
+                 desenharSempre ? "redesenhando a 60 FPS" : "com espera ociosa");
+    if (resolucao.quadrosMedidos > 0)
+        TraceLog(LOG_INFO, "RESOLUCAO: escala média %.0f%% na partida (mínima %.0f%%), %d descidas e %d subidas",
+                 100.0 * resolucao.somaEscala / resolucao.quadrosMedidos, resolucao.menorEscala * 100.0f, resolucao.descidas, resolucao.subidas);
+
+    // Grava os tempos de todos os frames, se pedido na linha de comando.
+    if (arquivoPerfil != NULL) {
+        if (SalvarPerfilCsv(arquivoPerfil))
+            TraceLog(LOG_INFO, "PERFIL: tempos dos frames gravados em %s", arquivoPerfil);
+        else
+            TraceLog(LOG_WARNING, "PERFIL: não foi possível gravar %s", arquivoPerfil);
+    }
+    EncerrarPerfil();
+    LiberarGravacao(&gravacao);
+    LiberarLinhaTempo(&linhaTempo);
+    LiberarInstantaneo(&inicioPartida);
+    FecharConexaoVersus(&conexaoVersus);
+    LiberarSessaoVersus(&versus);
+    if (placarAberto)
+        FecharPlacar(&placar);
+
+    if (quadros > 0)
+        TraceLog(LOG_INFO, "RECURSOS: %.1f MB residentes em média (pico %.1f MB, orçamento %s), %d carregamentos e %d descartes",
+                 somaResidentes / quadros / 1048576.0, recursos.picoResidentes / 1048576.0,
+                 recursos.orcamento > 0 ? TextFormat("%.0f MB", recursos.orcamento / 1048576.0) : "sem limite",
+                 recursos.carregamentos, recursos.descartes);
+    if (trocasTela > 0)
+        TraceLog(LOG_INFO, "RECURSOS: %d trocas de tela, %d esperaram texturas (média %.2f ms, máximo %.1f ms)",
+                 trocasTela, trocasComEspera, esperaTotal / trocasTela * 1000.0, maiorEspera * 1000.0);
+    // Descarrega todas as texturas da memória.
+    DescarregarRecursos(&recursos);
+    LiberarResolucao(&resolucao);
+    LiberarParticulas(&chuva);
+    LiberarParticulas(&efeitos);
+
+    CloseWindow(); // Fecha a janela da Raylib e libera seus recursos internos.
+    return 0;      // Retorna 0 para indicar que o programa foi executado com sucesso.
+}
+
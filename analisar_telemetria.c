@@ -0,0 +1,219 @@
+#include "logica.h"
+#include "telemetria.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- HISTOGRAMAS DO TEMPO DE REAÇÃO ---
+// Lê arquivos de telemetria (JogoC --telemetria) e mostra, para cada dificuldade e tipo de animal: quantos
+// apareceram, quantos foram acertados e quantos escaparam, os percentis do tempo de reação (do aparecimento ao
+// clique) e o histograma dele. Também mostra os cliques perdidos, as chuvas e a média de pontos por partida.
+// Não depende da Raylib.
+//
+// Uso: analisar_telemetria arquivo.btel [...] [--balde MS] [--csv arquivo]
+//   --balde  largura de cada faixa do histograma (padrão 50 ms)
+//   --csv    grava o histograma de cada dificuldade e animal (uma linha por faixa)
+
+#define TOTAL_DIFICULDADES 3
+#define TOTAL_TIPOS 3
+#define MAX_FAIXAS 256          // Reações mais lentas entram na última faixa.
+#define LARGURA_BARRA 40
+
+static const char* NOMES_DIFICULDADE[TOTAL_DIFICULDADES] = { "FACIL", "MEDIO", "DIFICIL" };
+static const char* NOMES_TIPO[TOTAL_TIPOS] = { "capivara", "dourada", "cutia" };
+
+typedef struct {
+    int* reacoes;          // Tempo de reação de cada acerto, em ticks.
+    int totalReacoes, capacidade;
+    int64_t aparecimentos, escaparam;
+    int64_t ticksVisivel;  // Soma do tempo visível sorteado nos aparecimentos.
+} Grupo;
+
+typedef struct {
+    int64_t partidas, terminadas, erros, chuvas, pontos;
+} ResumoDificuldade;
+
+static Grupo grupos[TOTAL_DIFICULDADES][TOTAL_TIPOS];
+static ResumoDificuldade resumos[TOTAL_DIFICULDADES];
+
+static int CompararInt(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static bool AnotarReacao(Grupo* g, int ticks) {
+    if (g->totalReacoes == g->capacidade) {
+        int capacidade = g->capacidade > 0 ? g->capacidade * 2 : 1024;
+        int* reacoes = (int*)realloc(g->reacoes, (size_t)capacidade * sizeof(int));
+        if (reacoes == NULL)
+            return false;
+        g->reacoes = reacoes;
+        g->capacidade = capacidade;
+    }
+    g->reacoes[g->totalReacoes++] = ticks;
+    return true;
+}
+
+static double Percentil(const Grupo* g, int p, double msPorTick) {
+    int n = g->totalReacoes;
+    if (n == 0)
+        return 0.0;
+    int i = (int)((int64_t)n * p / 100);
+    return g->reacoes[i < n ? i : n - 1] * msPorTick;
+}
+
+int main(int argc, char* argv[]) {
+    const char* arquivoCsv = NULL;
+    double balde = 50.0;
+    int totalArquivos = 0;
+    int ticksPorSegundo = TICKS_POR_SEGUNDO;
+    int64_t totalRegistros = 0, perdidos = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            arquivoCsv = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "--balde") == 0 && i + 1 < argc) {
+            balde = atof(argv[++i]);
+            continue;
+        }
+        if (argv[i][0] == '-') {
+            fprintf(stderr, "uso: %s arquivo%s [...] [--balde MS] [--csv arquivo]\n", argv[0], EXTENSAO_TELEMETRIA);
+            return 2;
+        }
+
+        RegistroTelemetria* registros;
+        int64_t total = CarregarTelemetria(argv[i], &registros, &ticksPorSegundo);
+        if (total < 0) {
+            fprintf(stderr, "%s: não é um arquivo de telemetria válido\n", argv[i]);
+            return 1;
+        }
+        totalArquivos++;
+        totalRegistros += total;
+        // Os eventos de uma partida vêm depois do INICIO_PARTIDA dela, que diz a dificuldade.
+        int dificuldade = -1;
+        for (int64_t k = 0; k < total; k++) {
+            const RegistroTelemetria* r = &registros[k];
+            if (r->evento == EVENTO_PERDAS) {
+                perdidos += r->valor;
+                continue;
+            }
+            if (r->evento == EVENTO_INICIO_PARTIDA) {
+                dificuldade = r->tipo < TOTAL_DIFICULDADES ? r->tipo : -1;
+                if (dificuldade >= 0)
+                    resumos[dificuldade].partidas++;
+                continue;
+            }
+            if (dificuldade < 0)
+                continue;
+            ResumoDificuldade* resumo = &resumos[dificuldade];
+            Grupo* g = r->tipo < TOTAL_TIPOS ? &grupos[dificuldade][r->tipo] : NULL;
+            switch (r->evento) {
+                case EVENTO_APARECEU:
+                    if (g != NULL) {
+                        g->aparecimentos++;
+                        g->ticksVisivel += r->valor;
+                    }
+                break;
+                case EVENTO_ACERTO:
+                    if (g != NULL && !AnotarReacao(g, r->valor)) {
+                        fprintf(stderr, "memória insuficiente\n");
+                        return 1;
+                    }
+                break;
+                case EVENTO_ESCONDEU:
+                    if (g != NULL)
+                        g->escaparam++;
+                break;
+                case EVENTO_ERRO:
+                    resumo->erros++;
+                break;
+                case EVENTO_INICIO_CHUVA:
+                    resumo->chuvas++;
+                break;
+                case EVENTO_FIM_PARTIDA:
+                    resumo->terminadas++;
+                    resumo->pontos += r->valor;
+                    dificuldade = -1;
+                break;
+            }
+        }
+        free(registros);
+    }
+    if (totalArquivos == 0 || balde <= 0.0) {
+        fprintf(stderr, "uso: %s arquivo%s [...] [--balde MS] [--csv arquivo]\n", argv[0], EXTENSAO_TELEMETRIA);
+        return 2;
+    }
+
+    double msPorTick = 1000.0 / ticksPorSegundo;
+    printf("%d arquivo(s), %lld registros, %lld perdidos com o anel cheio\n", totalArquivos, (long long)totalRegistros,
+           (long long)perdidos);
+    FILE* csv = NULL;
+    if (arquivoCsv != NULL) {
+        csv = fopen(arquivoCsv, "w");
+        if (csv == NULL) {
+            fprintf(stderr, "não foi possível criar %s\n", arquivoCsv);
+            return 1;
+        }
+        fprintf(csv, "dificuldade,animal,inicio_ms,fim_ms,acertos\n");
+    }
+
+    for (int d = 0; d < TOTAL_DIFICULDADES; d++) {
+        const ResumoDificuldade* resumo = &resumos[d];
+        if (resumo->partidas == 0)
+            continue;
+        printf("\n%s: %lld partidas (%lld terminadas, média de %.1f pontos), %lld cliques sem acerto, %lld chuvas\n",
+               NOMES_DIFICULDADE[d], (long long)resumo->partidas, (long long)resumo->terminadas,
+               resumo->terminadas > 0 ? (double)resumo->pontos / resumo->terminadas : 0.0, (long long)resumo->erros,
+               (long long)resumo->chuvas);
+        printf("  %-9s %8s %8s %8s %7s %10s %8s %8s %8s %8s\n", "animal", "apareceu", "acertos", "escapou", "acerto",
+               "visível", "p10", "p50", "p90", "p99");
+        for (int t = 0; t < TOTAL_TIPOS; t++) {
+            Grupo* g = &grupos[d][t];
+            if (g->aparecimentos == 0 && g->totalReacoes == 0)
+                continue;
+            qsort(g->reacoes, (size_t)g->totalReacoes, sizeof(int), CompararInt);
+            int64_t decididos = g->totalReacoes + g->escaparam;
+            printf("  %-9s %8lld %8d %8lld %6.1f%% %7.0f ms %5.0f ms %5.0f ms %5.0f ms %5.0f ms\n", NOMES_TIPO[t],
+                   (long long)g->aparecimentos, g->totalReacoes, (long long)g->escaparam,
+                   decididos > 0 ? 100.0 * g->totalReacoes / decididos : 0.0,
+                   g->aparecimentos > 0 ? (double)g->ticksVisivel / g->aparecimentos * msPorTick : 0.0,
+                   Percentil(g, 10, msPorTick), Percentil(g, 50, msPorTick), Percentil(g, 90, msPorTick),
+                   Percentil(g, 99, msPorTick));
+        }
+
+        // Histograma de cada animal, em faixas de 'balde' ms, até a reação mais lenta.
+        for (int t = 0; t < TOTAL_TIPOS; t++) {
+            Grupo* g = &grupos[d][t];
+            if (g->totalReacoes == 0)
+                continue;
+            int faixas[MAX_FAIXAS] = { 0 };
+            int totalFaixas = 0, maior = 0;
+            for (int k = 0; k < g->totalReacoes; k++) {
+                int f = (int)(g->reacoes[k] * msPorTick / balde);
+                if (f >= MAX_FAIXAS)
+                    f = MAX_FAIXAS - 1;
+                faixas[f]++;
+                if (f + 1 > totalFaixas)
+                    totalFaixas = f + 1;
+            }
+            for (int f = 0; f < totalFaixas; f++)
+                if (faixas[f] > maior)
+                    maior = faixas[f];
+            printf("\n  %s, reação de %d acertos:\n", NOMES_TIPO[t], g->totalReacoes);
+            for (int f = 0; f < totalFaixas; f++) {
+                int barra = (int)((int64_t)faixas[f] * LARGURA_BARRA / maior);
+                printf("  %5.0f-%-5.0f ms %6d |%.*s\n", f * balde, (f + 1) * balde, faixas[f], barra,
+                       "########################################");
+                if (csv != NULL)
+                    fprintf(csv, "%s,%s,%.0f,%.0f,%d\n", NOMES_DIFICULDADE[d], NOMES_TIPO[t], f * balde, (f + 1) * balde, faixas[f]);
+            }
+        }
+    }
+    if (csv != NULL)
+        fclose(csv);
+    for (int d = 0; d < TOTAL_DIFICULDADES; d++)
+        for (int t = 0; t < TOTAL_TIPOS; t++)
+            free(grupos[d][t].reacoes);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "atlas.h"
+#include "lotes.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LARGURA_ATLAS 2048 // Largura fixa do atlas. 2048 é suportado por qualquer GPU integrada.
+#define MARGEM_ATLAS 2     // Espaço entre as imagens, para o filtro bilinear não misturar imagens vizinhas.
+
+// Os fundos mantêm o tamanho original; os animais, desenhados em 150x120, são reduzidos para 256x256.
+const DefinicaoSprite SPRITES_ATLAS[TOTAL_SPRITES] = {
+    [SPRITE_FUNDO_JOGO]       = { "fundoJogo",       "fundoJogo.png",       1500, 900 },
+    [SPRITE_CHUVA]            = { "fundoChuvoso",    "fundoChuvoso.png",    1500, 800 },
+    [SPRITE_CAPIVARA_NORMAL]  = { "capivaraNormal",  "capivaraNormal.png",  256,  256 },
+    [SPRITE_CAPIVARA_DOURADA] = { "capivaraDourada", "capivaraDourada.png", 256,  256 },
+    [SPRITE_CUTIA]            = { "cutiaJogo",       "cutiaJogo.png",       256,  256 },
+    [SPRITE_ATORDOADO]        = { "animalAtordoado", "animalAtordoado.png", 256,  256 },
+};
+
+bool EmpacotarAtlas(Image* imagem, Rectangle regioes[TOTAL_SPRITES]) {
+    Image imagens[TOTAL_SPRITES] = {0};
+    int ordem[TOTAL_SPRITES]; // Índices das imagens, da mais alta para a mais baixa.
+
+    // Carrega cada imagem, converte para RGBA e reduz para o tamanho máximo definido.
+    for (int i = 0; i < TOTAL_SPRITES; i++) {
+        imagens[i] = LoadImage(SPRITES_ATLAS[i].arquivo);
+        if (imagens[i].data == NULL) {
+            TraceLog(LOG_ERROR, "ATLAS: nao foi possivel carregar %s", SPRITES_ATLAS[i].arquivo);
+            for (int j = 0; j < i; j++)
+                UnloadImage(imagens[j]);
+            return false;
+        }
+        ImageFormat(&imagens[i], PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        float escalaX = (float)SPRITES_ATLAS[i].larguraMaxima / imagens[i].width;
+        float escalaY = (float)SPRITES_ATLAS[i].alturaMaxima / imagens[i].height;
+        float escala = escalaX < escalaY ? escalaX : escalaY;
+        if (escala < 1.0f)
+            ImageResize(&imagens[i], (int)(imagens[i].width * escala), (int)(imagens[i].height * escala));
+        ordem[i] = i;
+    }
+
+    // Ordena por altura (ordenação por inserção, são poucas imagens).
+    for (int i = 1; i < TOTAL_SPRITES; i++) {
+        int atual = ordem[i];
+        int j = i - 1;
+        while (j >= 0 && imagens[ordem[j]].height < imagens[atual].height) {
+            ordem[j + 1] = ordem[j];
+            j--;
+        }
+        ordem[j + 1] = atual;
+    }
+
+    // Empacotamento em prateleiras: as imagens são colocadas lado a lado; quando não cabem mais na largura,
+    // uma nova prateleira começa abaixo da mais alta imagem da prateleira atual.
+    int x = 0, y = 0, alturaPrateleira = 0;
+    for (int k = 0; k < TOTAL_SPRITES; k++) {
+        int i = ordem[k];
+        if (x + imagens[i].width > LARGURA_ATLAS) {
+            x = 0;
+            y += alturaPrateleira + MARGEM_ATLAS;
+            alturaPrateleira = 0;
+        }
+        regioes[i] = (Rectangle){ (float)x, (float)y, (float)imagens[i].width, (float)imagens[i].height };
+        x += imagens[i].width + MARGEM_ATLAS;
+        if (imagens[i].height > alturaPrateleira)
+            alturaPrateleira = imagens[i].height;
+    }
+    int alturaAtlas = y + alturaPrateleira;
+
+    // Copia cada imagem para a sua região.
+    *imagem = GenImageColor(LARGURA_ATLAS, alturaAtlas, BLANK);
+    for (int i = 0; i < TOTAL_SPRITES; i++) {
+        Rectangle origem = { 0, 0, (float)imagens[i].width, (float)imagens[i].height };
+        ImageDraw(imagem, imagens[i], origem, regioes[i], WHITE);
+        UnloadImage(imagens[i]);
+    }
+    return true;
+}
+
+int FormatarDescricaoAtlas(char* texto, int tamanho, const Rectangle regioes[TOTAL_SPRITES]) {
+    int usado = 0;
+    for (int i = 0; i < TOTAL_SPRITES; i++) {
+        int n = snprintf(texto + usado, tamanho > usado ? (size_t)(tamanho - usado) : 0, "%s %d %d %d %d\n",
+                         SPRITES_ATLAS[i].nome, (int)regioes[i].x, (int)regioes[i].y, (int)regioes[i].width, (int)regioes[i].height);
+        if (n < 0 || usado + n >= tamanho)
+            return -1; // Não coube no buffer.
+        usado += n;
+    }
+    return usado;
+}
+
+bool SalvarDescricaoAtlas(const char* arquivo, const Rectangle regioes[TOTAL_SPRITES]) {
+    char texto[1024];
+    int tamanho = FormatarDescricaoAtlas(texto, sizeof(texto), regioes);
+    if (tamanho < 0)
+        return false;
+    FILE* f = fopen(arquivo, "w");
+    if (f == NULL)
+        return false;
+    bool ok = fwrite(texto, 1, (size_t)tamanho, f) == (size_t)tamanho;
+    fclose(f);
+    return ok;
+}
+
+bool LerDescricaoAtlas(const char* texto, Rectangle regioes[TOTAL_SPRITES]) {
+    bool encontrado[TOTAL_SPRITES] = {false};
+    char nome[64];
+    int x, y, largura, altura, lidos;
+    // Uma linha por imagem: nome x y largura altura.
+    while (sscanf(texto, "%63s %d %d %d %d%n", nome, &x, &y, &largura, &altura, &lidos) == 5) {
+        texto += lidos;
+        for (int i = 0; i < TOTAL_SPRITES; i++) {
+            if (strcmp(nome, SPRITES_ATLAS[i].nome) == 0) {
+                regioes[i] = (Rectangle){ (float)x, (float)y, (float)largura, (float)altura };
+                encontrado[i] = true;
+            }
+        }
+    }
+    for (int i = 0; i < TOTAL_SPRITES; i++)
+        if (!encontrado[i])
+            return false;
+    return true;
+}
+
+// Lê o arquivo de descrição do atlas. Retorna false se o arquivo não existir ou faltar alguma imagem.
+static bool LerArquivoDescricaoAtlas(const char* arquivo, Rectangle regioes[TOTAL_SPRITES]) {
+    if (!FileExists(arquivo))
+        return false;
+    char* texto = LoadFileText(arquivo);
+    if (texto == NULL)
+        return false;
+    bool ok = LerDescricaoAtlas(texto, regioes);
+    UnloadFileText(texto);
+    return ok;
+}
+
+bool CarregarImagemAtlas(Image* imagem, Rectangle regioes[TOTAL_SPRITES], const char* arquivoImagem, const char* arquivoDescricao) {
+    *imagem = (Image){0};
+    if (FileExists(arquivoImagem) && LerArquivoDescricaoAtlas(arquivoDescricao, regioes)) {
+        *imagem = LoadImage(arquivoImagem);
+    }
+    if (imagem->data == NULL) {
+        // Sem atlas pré-gerado: monta o atlas agora, a partir dos PNGs originais.
+        TraceLog(LOG_WARNING, "ATLAS: %s nao encontrado, empacotando as imagens na inicializacao", arquivoImagem);
+        if (!EmpacotarAtlas(imagem, regioes))
+            return false;
+    }
+    return true;
+}
+
+void DesenharSpriteAtlas(const Atlas* atlas, IdSprite sprite, Rectangle destino, Color cor) {
+    DesenharTexturaLote(atlas->textura, atlas->regioes[sprite], destino, cor);
+}
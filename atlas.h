@@ -0,0 +1,61 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include "raylib.h"
+
+// --- ATLAS DE TEXTURAS DO CAMPO DE JOGO ---
+// O fundo do jogo, a chuva e todos os animais ficam em uma única textura (o atlas). Assim o campo inteiro é
+// desenhado sem trocar de textura, e a Raylib consegue juntar tudo em um único lote de desenho.
+// O atlas é gerado offline pelo programa empacotar_atlas (atlas.png + atlas.txt); se os arquivos não
+// existirem, o jogo monta o mesmo atlas na inicialização a partir dos PNGs originais.
+
+// Identificador de cada imagem dentro do atlas.
+typedef enum IdSprite {
+    SPRITE_FUNDO_JOGO,        // Fundo da tela de jogo.
+    SPRITE_CHUVA,             // Efeito de chuva, desenhado sobre o fundo.
+    SPRITE_CAPIVARA_NORMAL,   // Capivara normal aparecendo.
+    SPRITE_CAPIVARA_DOURADA,  // Capivara dourada.
+    SPRITE_CUTIA,             // Cutia.
+    SPRITE_ATORDOADO,         // Qualquer animal que foi acertado.
+    TOTAL_SPRITES
+} IdSprite;
+
+// Como cada imagem entra no atlas.
+typedef struct {
+    const char* nome;     // Nome usado no arquivo de descrição do atlas.
+    const char* arquivo;  // PNG original.
+    int larguraMaxima;    // A imagem é reduzida (mantendo a proporção) para caber neste tamanho.
+    int alturaMaxima;
+} DefinicaoSprite;
+
+extern const DefinicaoSprite SPRITES_ATLAS[TOTAL_SPRITES];
+
+typedef struct {
+    Texture2D textura;                 // Textura única com todas as imagens.
+    Rectangle regioes[TOTAL_SPRITES];  // Região de cada imagem dentro da textura.
+} Atlas;
+
+#define ARQUIVO_ATLAS_IMAGEM "atlas.png"    // Imagem gerada pelo empacotador.
+#define ARQUIVO_ATLAS_DESCRICAO "atlas.txt" // Uma linha por imagem: nome x y largura altura.
+
+// Carrega as imagens originais e as empacota em uma única imagem. Não precisa de janela.
+// Retorna false se algum PNG não puder ser lido.
+bool EmpacotarAtlas(Image* imagem, Rectangle regioes[TOTAL_SPRITES]);
+
+// Escreve a descrição do atlas (as regiões de cada imagem) em 'texto'. Retorna o tamanho escrito, ou -1 se não couber.
+int FormatarDescricaoAtlas(char* texto, int tamanho, const Rectangle regioes[TOTAL_SPRITES]);
+
+// Grava a descrição do atlas em um arquivo.
+bool SalvarDescricaoAtlas(const char* arquivo, const Rectangle regioes[TOTAL_SPRITES]);
+
+// Lê a descrição do atlas a partir do texto. Retorna false se faltar alguma imagem.
+bool LerDescricaoAtlas(const char* texto, Rectangle regioes[TOTAL_SPRITES]);
+
+// Lê o atlas pré-gerado (ou o empacota a partir dos PNGs) só na memória, sem usar a GPU.
+// Pode ser chamada fora da thread de desenho.
+bool CarregarImagemAtlas(Image* imagem, Rectangle regioes[TOTAL_SPRITES], const char* arquivoImagem, const char* arquivoDescricao);
+
+// Desenha uma imagem do atlas esticada no retângulo de destino.
+void DesenharSpriteAtlas(const Atlas* atlas, IdSprite sprite, Rectangle destino, Color cor);
+
+#endif
@@ -0,0 +1,159 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime.
+#include "logica.h"
+#include "placar.h"
+#include "placar_rede.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// --- TESTE DE CARGA DO PLACAR ---
+// Simula várias instâncias do jogo enviando pontuações ao servidor_placar ao mesmo tempo. Cada cliente é uma
+// thread com a sua conexão, que envia lotes de pontuações aleatórias e espera as posições antes do próximo lote.
+// No fim, mostra os envios por segundo e a latência de cada lote (ida e volta, incluindo o fsync do servidor).
+//
+// Uso: carga_placar [--porta P] [--clientes C] [--lote B] [--segundos S] [--csv arquivo]
+//   --csv  acrescenta uma linha com o resultado (o cabeçalho é escrito se o arquivo estiver vazio)
+
+#define MAX_CLIENTES 256
+#define MAX_AMOSTRAS (1 << 20) // Latências guardadas por cliente.
+
+typedef struct {
+    int indice;
+    int64_t envios;
+    int totalAmostras;
+    float* latencias;  // Microssegundos por lote.
+    bool falhou;
+} Cliente;
+
+static int porta = PORTA_PLACAR;
+static int tamanhoLote = 16;
+static double duracao = 5.0;
+
+static double Agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void* RodarCliente(void* argumento) {
+    Cliente* cliente = (Cliente*)argumento;
+    Soquete s = ConectarPlacar((uint16_t)porta, 5000);
+    if (s == SOQUETE_INVALIDO) {
+        cliente->falhou = true;
+        return NULL;
+    }
+    GeradorAleatorio gerador;
+    IniciarGerador(&gerador, 0x9E3779B97F4A7C15ull * (uint64_t)(cliente->indice + 1));
+    RegistroPlacar* lote = (RegistroPlacar*)malloc((size_t)tamanhoLote * sizeof(RegistroPlacar));
+    PosicaoPlacar* posicoes = (PosicaoPlacar*)malloc((size_t)tamanhoLote * sizeof(PosicaoPlacar));
+    double fim = Agora() + duracao;
+    for (double agora = Agora(); agora < fim;) {
+        for (int k = 0; k < tamanhoLote; k++) {
+            // Pontuações parecidas com as do jogo: a dificuldade muda a faixa.
+            int d = SortearValor(&gerador, 0, 2);
+            lote[k] = (RegistroPlacar){ SortearValor(&gerador, 0, 60 + 60 * d), (uint8_t)d, (int64_t)time(NULL),
+                                        (uint64_t)SortearValor(&gerador, 0, 1 << 30) };
+        }
+        if (!EnviarPontuacoesRede(s, lote, tamanhoLote, posicoes)) {
+            cliente->falhou = true;
+            break;
+        }
+        double depois = Agora();
+        if (cliente->totalAmostras < MAX_AMOSTRAS)
+            cliente->latencias[cliente->totalAmostras++] = (float)((depois - agora) * 1e6);
+        cliente->envios += tamanhoLote;
+        agora = depois;
+    }
+    free(lote);
+    free(posicoes);
+    FecharSoquete(s);
+    return NULL;
+}
+
+static int CompararFloat(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char* argv[]) {
+    int totalClientes = 8;
+    const char* arquivoCsv = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--porta") == 0 && i + 1 < argc)
+            porta = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--clientes") == 0 && i + 1 < argc)
+            totalClientes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc)
+            tamanhoLote = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--segundos") == 0 && i + 1 < argc)
+            duracao = atof(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            arquivoCsv = argv[++i];
+        else {
+            fprintf(stderr, "uso: %s [--porta P] [--clientes C] [--lote B] [--segundos S] [--csv arquivo]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (totalClientes < 1 || totalClientes > MAX_CLIENTES || tamanhoLote < 1 || tamanhoLote > MAX_LOTE_PLACAR) {
+        fprintf(stderr, "clientes: 1 a %d, lote: 1 a %d\n", MAX_CLIENTES, MAX_LOTE_PLACAR);
+        return 2;
+    }
+    if (!IniciarRedePlacar())
+        return 1;
+
+    static Cliente clientes[MAX_CLIENTES];
+    pthread_t threads[MAX_CLIENTES];
+    double inicio = Agora();
+    for (int c = 0; c < totalClientes; c++) {
+        clientes[c].indice = c;
+        clientes[c].latencias = (float*)malloc(MAX_AMOSTRAS * sizeof(float));
+        pthread_create(&threads[c], NULL, RodarCliente, &clientes[c]);
+    }
+    for (int c = 0; c < totalClientes; c++)
+        pthread_join(threads[c], NULL);
+    double segundos = Agora() - inicio;
+
+    // Junta as latências de todos os clientes para os percentis.
+    int64_t envios = 0, totalAmostras = 0;
+    int falhas = 0;
+    for (int c = 0; c < totalClientes; c++) {
+        envios += clientes[c].envios;
+        totalAmostras += clientes[c].totalAmostras;
+        falhas += clientes[c].falhou;
+    }
+    float* amostras = (float*)malloc((size_t)(totalAmostras > 0 ? totalAmostras : 1) * sizeof(float));
+    int64_t n = 0;
+    for (int c = 0; c < totalClientes; c++) {
+        memcpy(amostras + n, clientes[c].latencias, (size_t)clientes[c].totalAmostras * sizeof(float));
+        n += clientes[c].totalAmostras;
+        free(clientes[c].latencias);
+    }
+    qsort(amostras, (size_t)n, sizeof(float), CompararFloat);
+    float p50 = n > 0 ? amostras[n / 2] : 0, p99 = n > 0 ? amostras[(n * 99) / 100] : 0, maximo = n > 0 ? amostras[n - 1] : 0;
+    free(amostras);
+
+    if (falhas == totalClientes) {
+        fprintf(stderr, "nenhum cliente conseguiu falar com o servidor na porta %d\n", porta);
+        return 1;
+    }
+    printf("%d clientes, lotes de %d: %lld envios em %.2f s = %.0f envios/s\n", totalClientes, tamanhoLote, (long long)envios, segundos,
+           envios / segundos);
+    printf("latência por lote: p50 %.0f us, p99 %.0f us, máximo %.0f us%s\n", p50, p99, maximo,
+           falhas > 0 ? " (alguns clientes falharam)" : "");
+
+    if (arquivoCsv != NULL) {
+        FILE* csv = fopen(arquivoCsv, "a");
+        if (csv == NULL) {
+            fprintf(stderr, "não foi possível abrir %s\n", arquivoCsv);
+            return 1;
+        }
+        if (ftell(csv) == 0)
+            fprintf(csv, "clientes,lote,envios,segundos,envios_por_s,p50_us,p99_us,max_us\n");
+        fprintf(csv, "%d,%d,%lld,%.3f,%.0f,%.0f,%.0f,%.0f\n", totalClientes, tamanhoLote, (long long)envios, segundos, envios / segundos,
+                p50, p99, maximo);
+        fclose(csv);
+    }
+    return falhas > 0;
+}
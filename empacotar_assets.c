@@ -0,0 +1,194 @@
+#include "raylib.h"
+#include "atlas.h"
+#include "logica.h"
+#include "pacote.h"
+#include "recursos.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- EMPACOTADOR DE RECURSOS (ETAPA DE BUILD) ---
+// Decodifica todos os PNGs uma única vez, monta o atlas do campo de jogo e grava tudo em um pacote
+// versionado (barigueira.pak) com os pixels já no formato da GPU e um índice no início.
+// Com --c, também gera um arquivo C com o pacote como array, para embutir no executável (PACOTE_EMBUTIDO).
+// Com --mascaras, gera as máscaras de colisão dos animais (mascaras.c, compilado com a lógica): deve ser
+// executado sempre que um PNG de animal mudar.
+// Deve ser executado na pasta dos PNGs.
+// Uso: empacotar_assets [barigueira.pak] [--c pacote_embutido.c] [--mascaras mascaras.c]
+
+#define MAX_ENTRADAS 16
+
+typedef struct {
+    EntradaPacote entrada;
+    const void* dados;
+} EntradaPendente;
+
+// Arredonda 'valor' para cima até o próximo múltiplo de ALINHAMENTO_PACOTE.
+static uint64_t Alinhar(uint64_t valor) {
+    return (valor + ALINHAMENTO_PACOTE - 1) / ALINHAMENTO_PACOTE * ALINHAMENTO_PACOTE;
+}
+
+// Monta o pacote completo em memória. Retorna o buffer (alocado com malloc) e o tamanho em '*tamanho'.
+static uint8_t* MontarPacote(EntradaPendente* entradas, int total, size_t* tamanho) {
+    uint64_t posicao = Alinhar(sizeof(CabecalhoPacote) + total * sizeof(EntradaPacote));
+    for (int i = 0; i < total; i++) {
+        entradas[i].entrada.deslocamento = posicao;
+        posicao = Alinhar(posicao + entradas[i].entrada.tamanho);
+    }
+
+    uint8_t* buffer = (uint8_t*)calloc(1, (size_t)posicao); // O espaço de alinhamento fica zerado.
+    if (buffer == NULL)
+        return NULL;
+    CabecalhoPacote cabecalho = { {'B', 'P', 'A', 'K'}, VERSAO_PACOTE, (uint32_t)total, 0 };
+    memcpy(buffer, &cabecalho, sizeof(cabecalho));
+    for (int i = 0; i < total; i++) {
+        memcpy(buffer + sizeof(CabecalhoPacote) + i * sizeof(EntradaPacote), &entradas[i].entrada, sizeof(EntradaPacote));
+        memcpy(buffer + entradas[i].entrada.deslocamento, entradas[i].dados, (size_t)entradas[i].entrada.tamanho);
+    }
+    *tamanho = (size_t)posicao;
+    return buffer;
+}
+
+// Gera um arquivo C com o pacote como array, alinhado como o arquivo mapeado.
+static bool GravarPacoteC(const char* arquivo, const uint8_t* dados, size_t tamanho) {
+    FILE* f = fopen(arquivo, "w");
+    if (f == NULL)
+        return false;
+    fprintf(f, "// Gerado pelo empacotar_assets. Não editar.\n");
+    fprintf(f, "#include <stddef.h>\n\n");
+    fprintf(f, "#if defined(_MSC_VER)\n__declspec(align(%d))\n#else\n__attribute__((aligned(%d)))\n#endif\n", ALINHAMENTO_PACOTE, ALINHAMENTO_PACOTE);
+    fprintf(f, "const unsigned char DADOS_PACOTE_EMBUTIDO[%zu] = {\n", tamanho);
+    for (size_t i = 0; i < tamanho; i++)
+        fprintf(f, "%u,%s", dados[i], (i % 32 == 31) ? "\n" : "");
+    fprintf(f, "\n};\nconst size_t TAMANHO_PACOTE_EMBUTIDO = %zu;\n", tamanho);
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+// Gera o arquivo C com as máscaras de colisão, a partir dos PNGs originais de cada animal.
+static bool GravarMascarasC(const char* arquivo) {
+    static const IdSprite SPRITE_TIPO[TOTAL_TIPOS_CAPIVARA] = { SPRITE_CAPIVARA_NORMAL, SPRITE_CAPIVARA_DOURADA, SPRITE_CUTIA };
+    static MascarasColisao mascaras;
+    for (int t = 0; t < TOTAL_TIPOS_CAPIVARA; t++) {
+        Image imagem = LoadImage(SPRITES_ATLAS[SPRITE_TIPO[t]].arquivo);
+        if (imagem.data == NULL) {
+            fprintf(stderr, "Erro ao carregar %s\n", SPRITES_ATLAS[SPRITE_TIPO[t]].arquivo);
+            return false;
+        }
+        ImageFormat(&imagem, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        MontarMascaraColisao(mascaras.bits[t], (const uint8_t*)imagem.data, imagem.width, imagem.height);
+        UnloadImage(imagem);
+    }
+
+    FILE* f = fopen(arquivo, "w");
+    if (f == NULL)
+        return false;
+    fprintf(f, "// Gerado pelo empacotar_assets --mascaras. Não editar.\n");
+    fprintf(f, "// Máscaras de colisão dos animais (logica.h), uma linha de bits por linha da máscara.\n");
+    fprintf(f, "#include \"logica.h\"\n\n");
+    fprintf(f, "const MascarasColisao MASCARAS_COLISAO = { {\n");
+    for (int t = 0; t < TOTAL_TIPOS_CAPIVARA; t++) {
+        fprintf(f, "    { // %s\n", SPRITES_ATLAS[SPRITE_TIPO[t]].arquivo);
+        for (int y = 0; y < LADO_MASCARA; y++) {
+            fprintf(f, "        {");
+            for (int w = 0; w < PALAVRAS_MASCARA; w++)
+                fprintf(f, "%s0x%016llxull", w > 0 ? ", " : "", (unsigned long long)mascaras.bits[t][y][w]);
+            fprintf(f, "},\n");
+        }
+        fprintf(f, "    },\n");
+    }
+    fprintf(f, "} };\n");
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    const char* arquivoPacote = ARQUIVO_PACOTE;
+    const char* arquivoC = NULL;
+    const char* arquivoMascaras = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--c") == 0 && i + 1 < argc)
+            arquivoC = argv[++i];
+        else if (strcmp(argv[i], "--mascaras") == 0 && i + 1 < argc)
+            arquivoMascaras = argv[++i];
+        else
+            arquivoPacote = argv[i];
+    }
+
+    EntradaPendente entradas[MAX_ENTRADAS];
+    Image imagens[TOTAL_RECURSOS] = {0};
+    int total = 0;
+
+    // Atlas do campo de jogo e sua descrição.
+    Rectangle regioes[TOTAL_SPRITES];
+    if (!EmpacotarAtlas(&imagens[RECURSO_ATLAS], regioes))
+        return 1;
+    char descricao[1024];
+    int tamanhoDescricao = FormatarDescricaoAtlas(descricao, sizeof(descricao), regioes);
+    if (tamanhoDescricao < 0)
+        return 1;
+
+    // Fundos das telas, convertidos para RGBA de 8 bits.
+    for (int i = 0; i < TOTAL_RECURSOS; i++) {
+        if (RECURSOS[i].arquivo == NULL)
+            continue;
+        imagens[i] = LoadImage(RECURSOS[i].arquivo);
+        if (imagens[i].data == NULL) {
+            fprintf(stderr, "Erro ao carregar %s\n", RECURSOS[i].arquivo);
+            return 1;
+        }
+        ImageFormat(&imagens[i], PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    }
+
+    for (int i = 0; i < TOTAL_RECURSOS; i++) {
+        EntradaPendente* e = &entradas[total++];
+        memset(e, 0, sizeof(*e));
+        strncpy(e->entrada.nome, RECURSOS[i].nome, sizeof(e->entrada.nome) - 1);
+        e->entrada.tipo = ENTRADA_TEXTURA;
+        e->entrada.largura = (uint32_t)imagens[i].width;
+        e->entrada.altura = (uint32_t)imagens[i].height;
+        e->entrada.formato = (uint32_t)imagens[i].format;
+        e->entrada.tamanho = (uint64_t)GetPixelDataSize(imagens[i].width, imagens[i].height, imagens[i].format);
+        e->dados = imagens[i].data;
+    }
+    EntradaPendente* e = &entradas[total++];
+    memset(e, 0, sizeof(*e));
+    strncpy(e->entrada.nome, ENTRADA_DESCRICAO_ATLAS, sizeof(e->entrada.nome) - 1);
+    e->entrada.tipo = ENTRADA_DADOS;
+    e->entrada.tamanho = (uint64_t)tamanhoDescricao;
+    e->dados = descricao;
+
+    size_t tamanho = 0;
+    uint8_t* pacote = MontarPacote(entradas, total, &tamanho);
+    for (int i = 0; i < TOTAL_RECURSOS; i++)
+        UnloadImage(imagens[i]);
+    if (pacote == NULL)
+        return 1;
+
+    FILE* f = fopen(arquivoPacote, "wb");
+    bool ok = f != NULL && fwrite(pacote, 1, tamanho, f) == tamanho;
+    if (f != NULL)
+        fclose(f);
+    if (ok && arquivoC != NULL)
+        ok = GravarPacoteC(arquivoC, pacote, tamanho);
+    free(pacote);
+    if (!ok) {
+        fprintf(stderr, "Erro ao gravar o pacote\n");
+        return 1;
+    }
+
+    if (arquivoMascaras != NULL) {
+        if (!GravarMascarasC(arquivoMascaras)) {
+            fprintf(stderr, "Erro ao gravar as máscaras de colisão\n");
+            return 1;
+        }
+        printf("Máscaras de colisão gravadas em %s\n", arquivoMascaras);
+    }
+
+    printf("Pacote v%d gravado em %s (%.1f MB, %d entradas)\n", VERSAO_PACOTE, arquivoPacote, tamanho / (1024.0 * 1024.0), total);
+    for (int i = 0; i < total; i++)
+        printf("  %-16s %5u x %-5u %10llu bytes\n", entradas[i].entrada.nome, entradas[i].entrada.largura, entradas[i].entrada.altura, (unsigned long long)entradas[i].entrada.tamanho);
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "raylib.h"
+#include "atlas.h"
+#include <stdio.h>
+
+// --- EMPACOTADOR DE ATLAS (FERRAMENTA OFFLINE) ---
+// Junta o fundo do jogo, a chuva e as imagens dos animais em um único atlas.png, e grava em atlas.txt a
+// região de cada imagem. Deve ser executado na pasta dos PNGs, sempre que alguma imagem mudar.
+// Uso: empacotar_atlas [atlas.png] [atlas.txt]
+
+int main(int argc, char* argv[]) {
+    const char* arquivoImagem = argc > 1 ? argv[1] : ARQUIVO_ATLAS_IMAGEM;
+    const char* arquivoDescricao = argc > 2 ? argv[2] : ARQUIVO_ATLAS_DESCRICAO;
+
+    Image atlas;
+    Rectangle regioes[TOTAL_SPRITES];
+    if (!EmpacotarAtlas(&atlas, regioes)) // Só usa as funções de imagem da Raylib, não abre janela.
+        return 1;
+
+    if (!ExportImage(atlas, arquivoImagem) || !SalvarDescricaoAtlas(arquivoDescricao, regioes)) {
+        fprintf(stderr, "Erro ao gravar %s / %s\n", arquivoImagem, arquivoDescricao);
+        UnloadImage(atlas);
+        return 1;
+    }
+
+    printf("Atlas %dx%d gravado em %s\n", atlas.width, atlas.height, arquivoImagem);
+    for (int i = 0; i < TOTAL_SPRITES; i++)
+        printf("  %-16s %4d %4d %4d %4d\n", SPRITES_ATLAS[i].nome, (int)regioes[i].x, (int)regioes[i].y, (int)regioes[i].width, (int)regioes[i].height);
+    UnloadImage(atlas);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "entrada.h"
+#include <string.h>
+
+void IniciarEntrada(FilaEntrada* fila, int fps) {
+    memset(fila, 0, sizeof(*fila));
+    fila->duracaoAlvo = 1.0 / fps;
+    fila->ultimaLeitura = GetTime();
+    fila->fimQuadro = fila->ultimaLeitura;
+    fila->mouse = GetMousePosition();
+}
+
+void IniciarQuadroEntrada(FilaEntrada* fila) {
+    fila->inicioQuadro = fila->fimQuadro;
+    fila->fimQuadro = GetTime();
+    memcpy(fila->eventos, fila->pendentes, (size_t)fila->totalPendentes * sizeof(EventoEntrada));
+    fila->totalEventos = fila->totalPendentes;
+    fila->totalPendentes = 0;
+    fila->mouse = GetMousePosition();
+    fila->totalAreas = 0;
+}
+
+double DuracaoQuadroEntrada(const FilaEntrada* fila) {
+    return fila->fimQuadro - fila->inicioQuadro;
+}
+
+// Guarda um evento para o próximo frame. Se a fila encher, os eventos mais novos são descartados.
+static void AdicionarEvento(FilaEntrada* fila, TipoEventoEntrada tipo, double tempo, int tecla) {
+    if (fila->totalPendentes == MAX_EVENTOS_ENTRADA)
+        return;
+    fila->pendentes[fila->totalPendentes++] = (EventoEntrada){ tipo, tempo, GetMousePosition(), tecla, false };
+}
+
+void LerEntrada(FilaEntrada* fila) {
+    double agora = GetTime();
+    // O evento aconteceu em algum momento entre a leitura anterior e esta; o meio do intervalo é a melhor estimativa.
+    double tempo = (fila->ultimaLeitura + agora) / 2.0;
+    fila->ultimaLeitura = agora;
+
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+        AdicionarEvento(fila, EVENTO_CLIQUE, tempo, 0);
+    // GetKeyPressed devolve, uma por vez, todas as teclas pressionadas desde a última leitura.
+    for (int tecla = GetKeyPressed(); tecla != 0; tecla = GetKeyPressed())
+        AdicionarEvento(fila, EVENTO_TECLA, tempo, tecla);
+}
+
+void EsperarProximoQuadro(FilaEntrada* fila) {
+    double proximo = fila->fimQuadro + fila->duracaoAlvo;
+    for (double agora = GetTime(); agora < proximo; agora = GetTime()) {
+        double espera = proximo - agora;
+        WaitTime(espera < INTERVALO_AMOSTRAGEM ? espera : INTERVALO_AMOSTRAGEM);
+        PollInputEvents(); // Lê a entrada do sistema fora do EndDrawing.
+        LerEntrada(fila);
+    }
+}
+
+void RegistrarAreaDestaque(FilaEntrada* fila, Rectangle area, bool destacada) {
+    if (fila->totalAreas == MAX_AREAS_DESTAQUE)
+        return;
+    fila->areas[fila->totalAreas] = area;
+    fila->destacadas[fila->totalAreas++] = destacada;
+}
+
+// true se o mouse entrou ou saiu de algum botão desde que ele foi desenhado.
+static bool DestaqueMudou(const FilaEntrada* fila) {
+    Vector2 mouse = GetMousePosition();
+    for (int i = 0; i < fila->totalAreas; i++)
+        if (CheckCollisionPointRec(mouse, fila->areas[i]) != fila->destacadas[i])
+            return true;
+    return false;
+}
+
+void EsperarMudancaEntrada(FilaEntrada* fila) {
+    // Algo já mudou durante a espera do frame: redesenha sem dormir.
+    if (fila->totalPendentes > 0 || DestaqueMudou(fila))
+        return;
+    bool focada = IsWindowFocused();
+    EnableEventWaiting();
+    for (;;) {
+        PollInputEvents(); // Com a espera por eventos ligada, dorme até o sistema entregar um evento.
+        LerEntrada(fila);
+        if (fila->totalPendentes > 0 || DestaqueMudou(fila) || WindowShouldClose() || IsWindowResized() || IsWindowFocused() != focada)
+            break;
+    }
+    DisableEventWaiting();
+    // O frame seguinte começa agora: o tempo dormindo não entra na duração dele nem no ritmo dos próximos.
+    fila->fimQuadro = GetTime();
+}
+
+EventoEntrada* ConsumirClique(FilaEntrada* fila, Rectangle area) {
+    for (int i = 0; i < fila->totalEventos; i++) {
+        EventoEntrada* e = &fila->eventos[i];
+        if (e->tipo == EVENTO_CLIQUE && !e->consumido && CheckCollisionPointRec(e->posicao, area)) {
+            e->consumido = true;
+            return e;
+        }
+    }
+    return NULL;
+}
+
+bool ConsumirTecla(FilaEntrada* fila, int tecla) {
+    for (int i = 0; i < fila->totalEventos; i++) {
+        EventoEntrada* e = &fila->eventos[i];
+        if (e->tipo == EVENTO_TECLA && !e->consumido && e->tecla == tecla) {
+            e->consumido = true;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,82 @@
+#ifndef ENTRADA_H
+#define ENTRADA_H
+
+#include "raylib.h"
+
+// --- FILA DE ENTRADA COM TEMPO ---
+// A Raylib só lê a entrada uma vez por frame (no EndDrawing) e o IsMouseButtonPressed só diz se houve um clique
+// desde a última leitura: o momento exato se perde e dois cliques no mesmo frame viram um. Esta fila lê a entrada
+// a cada milissegundo enquanto espera o próximo frame (no lugar da espera do SetTargetFPS) e guarda cada clique
+// e cada tecla com o seu momento (GetTime) e a posição do mouse naquela hora.
+//
+// Todas as telas consomem a mesma fila: os botões, o botão de pausa e o campo de jogo. Um evento consumido por
+// um botão não é visto por mais ninguém; o que ninguém consumir é descartado no fim do frame.
+
+#define MAX_EVENTOS_ENTRADA 64 // Eventos guardados entre dois frames.
+#define MAX_AREAS_DESTAQUE 16 // Botões por tela que mudam de cor com o mouse em cima.
+#define INTERVALO_AMOSTRAGEM 0.001 // Intervalo entre leituras da entrada durante a espera do frame, em segundos.
+
+typedef enum TipoEventoEntrada {
+    EVENTO_CLIQUE, // Botão esquerdo do mouse pressionado.
+    EVENTO_TECLA   // Tecla pressionada.
+} TipoEventoEntrada;
+
+typedef struct {
+    TipoEventoEntrada tipo;
+    double tempo;      // Momento estimado do evento (no relógio do GetTime): meio do intervalo entre duas leituras.
+    Vector2 posicao;   // Posição do mouse na leitura em que o evento apareceu.
+    int tecla;         // Só para EVENTO_TECLA (KEY_*).
+    bool consumido;    // true depois que alguma tela usou o evento.
+} EventoEntrada;
+
+typedef struct {
+    EventoEntrada eventos[MAX_EVENTOS_ENTRADA]; // Eventos do frame atual, em ordem de tempo.
+    int totalEventos;
+    EventoEntrada pendentes[MAX_EVENTOS_ENTRADA]; // Eventos lidos durante a espera, entregues no próximo frame.
+    int totalPendentes;
+    double inicioQuadro;     // Início do intervalo coberto pelo frame atual (fim do anterior).
+    double fimQuadro;        // Fim do intervalo: o momento em que o frame atual começou.
+    double duracaoAlvo;      // Duração desejada de um frame (1 / FPS).
+    double ultimaLeitura;    // Momento da última leitura da entrada.
+    Vector2 mouse;           // Posição atual do mouse (para destacar botões).
+    Rectangle areas[MAX_AREAS_DESTAQUE]; // Botões desenhados no frame, para a espera ociosa saber quando o destaque muda.
+    bool destacadas[MAX_AREAS_DESTAQUE]; // Se o mouse estava sobre cada botão quando ele foi desenhado.
+    int totalAreas;
+} FilaEntrada;
+
+// Prepara a fila e define o FPS desejado. Substitui o SetTargetFPS, que não pode ser usado junto.
+void IniciarEntrada(FilaEntrada* fila, int fps);
+
+// Começa um frame: entrega os eventos lidos desde o frame anterior. Deve ser chamada no início de cada frame.
+void IniciarQuadroEntrada(FilaEntrada* fila);
+
+// Duração do intervalo coberto pelo frame atual, em segundos (usada no lugar do GetFrameTime).
+double DuracaoQuadroEntrada(const FilaEntrada* fila);
+
+// Lê os cliques e teclas que a Raylib recebeu desde a última leitura. Deve ser chamada logo depois do
+// EndDrawing (que lê a entrada do sistema) e é chamada pela própria espera do frame.
+void LerEntrada(FilaEntrada* fila);
+
+// Espera até a hora do próximo frame, lendo a entrada a cada INTERVALO_AMOSTRAGEM.
+void EsperarProximoQuadro(FilaEntrada* fila);
+
+// --- ESPERA OCIOSA ---
+// Nas telas paradas (menus, créditos, pausa) nada muda até o jogador mexer em alguma coisa. Em vez de redesenhar
+// a 60 FPS, o loop principal chama EsperarMudancaEntrada depois de um frame em que nada aconteceu: ela dorme
+// até o sistema entregar um evento (EnableEventWaiting) e só volta quando ele muda a tela: um clique, uma tecla,
+// a janela redimensionada ou o mouse entrando ou saindo de um botão. Mover o mouse sem mudar nenhum destaque
+// não acorda o jogo. O próximo frame é desenhado uma vez e, se nada mais acontecer, o jogo volta a dormir.
+
+// Registra um botão desenhado no frame e se ele está destacado (mouse em cima). Chamada pelo DesenharBotao.
+void RegistrarAreaDestaque(FilaEntrada* fila, Rectangle area, bool destacada);
+
+// Bloqueia até a entrada mudar algo na tela. Não retorna antes de pelo menos um evento do sistema.
+void EsperarMudancaEntrada(FilaEntrada* fila);
+
+// Consome o primeiro clique ainda não usado dentro de 'area'. Retorna NULL se não houver.
+EventoEntrada* ConsumirClique(FilaEntrada* fila, Rectangle area);
+
+// Consome a primeira vez que 'tecla' foi pressionada neste frame. Retorna true se ela foi pressionada.
+bool ConsumirTecla(FilaEntrada* fila, int tecla);
+
+#endif
@@ -0,0 +1,304 @@
+#include "gravacao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAMANHO_CABECALHO_GRAVACAO 48
+
+void IniciarGravacao(Gravacao* gravacao, const ConfiguracaoJogo* configuracao) {
+    gravacao->configuracao = *configuracao;
+    gravacao->pontosFinais = -1;
+    gravacao->tickFinal = 0;
+    gravacao->totalCliques = 0; // O array de cliques da partida anterior é reaproveitado.
+}
+
+void GravarClique(Gravacao* gravacao, int64_t tick, float x, float y) {
+    if (gravacao->totalCliques == gravacao->capacidadeCliques) {
+        int novaCapacidade = gravacao->capacidadeCliques == 0 ? 256 : gravacao->capacidadeCliques * 2;
+        CliqueGravado* novo = (CliqueGravado*)realloc(gravacao->cliques, (size_t)novaCapacidade * sizeof(CliqueGravado));
+        if (novo == NULL)
+            return;
+        gravacao->cliques = novo;
+        gravacao->capacidadeCliques = novaCapacidade;
+    }
+    gravacao->cliques[gravacao->totalCliques++] = (CliqueGravado){ tick, x, y };
+}
+
+void EncerrarGravacao(Gravacao* gravacao, const EstadoJogo* jogo) {
+    gravacao->pontosFinais = jogo->pontos;
+    gravacao->tickFinal = jogo->tick;
+}
+
+void LiberarGravacao(Gravacao* gravacao) {
+    free(gravacao->cliques);
+    memset(gravacao, 0, sizeof(*gravacao));
+}
+
+// --- FORMATO DO ARQUIVO ---
+// Os campos são escritos byte a byte em little-endian, então o arquivo é o mesmo em qualquer plataforma.
+
+static uint8_t* EscreverU32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++)
+        *p++ = (uint8_t)(v >> (8 * i));
+    return p;
+}
+
+static uint8_t* EscreverU64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; i++)
+        *p++ = (uint8_t)(v >> (8 * i));
+    return p;
+}
+
+static uint8_t* EscreverFloat(uint8_t* p, float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return EscreverU32(p, bits);
+}
+
+// Inteiro sem sinal em 7 bits por byte: diferenças de tick pequenas ocupam 1 ou 2 bytes.
+static uint8_t* EscreverVarint(uint8_t* p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static uint32_t LerU32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++)
+        v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static uint64_t LerU64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++)
+        v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static float LerFloat(const uint8_t* p) {
+    uint32_t bits = LerU32(p);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// Lê um varint entre 'p' e 'fim'. Retorna NULL se os dados acabarem no meio.
+static const uint8_t* LerVarint(const uint8_t* p, const uint8_t* fim, uint64_t* v) {
+    *v = 0;
+    for (int deslocamento = 0; p < fim && deslocamento < 64; deslocamento += 7) {
+        uint8_t byte = *p++;
+        *v |= (uint64_t)(byte & 0x7F) << deslocamento;
+        if ((byte & 0x80) == 0)
+            return p;
+    }
+    return NULL;
+}
+
+bool SalvarGravacao(const Gravacao* gravacao, const char* arquivo) {
+    // Cada clique ocupa no máximo 10 bytes de varint e 8 de posição.
+    size_t tamanhoMaximo = TAMANHO_CABECALHO_GRAVACAO + (size_t)gravacao->totalCliques * 18;
+    uint8_t* buffer = (uint8_t*)malloc(tamanhoMaximo);
+    if (buffer == NULL)
+        return false;
+
+    const ConfiguracaoJogo* c = &gravacao->configuracao;
+    uint8_t* p = buffer;
+    memcpy(p, MAGICA_GRAVACAO, 4);
+    p += 4;
+    *p++ = VERSAO_GRAVACAO;
+    *p++ = (uint8_t)c->dificuldade;
+    *p++ = 0;
+    *p++ = 0;
+    p = EscreverU64(p, c->semente);
+    p = EscreverU32(p, (uint32_t)c->totalBuracos);
+    p = EscreverFloat(p, c->larguraTela);
+    p = EscreverFloat(p, c->alturaTela);
+    p = EscreverU32(p, (uint32_t)gravacao->pontosFinais);
+    p = EscreverU64(p, (uint64_t)gravacao->tickFinal);
+    p = EscreverU32(p, (uint32_t)gravacao->totalCliques);
+    p += TAMANHO_CABECALHO_GRAVACAO - (p - buffer); // Espaço reservado no fim do cabeçalho.
+
+    int64_t tickAnterior = 0;
+    for (int i = 0; i < gravacao->totalCliques; i++) {
+        const CliqueGravado* clique = &gravacao->cliques[i];
+        p = EscreverVarint(p, (uint64_t)(clique->tick - tickAnterior)); // Os cliques estão em ordem de tick.
+        p = EscreverFloat(p, clique->x);
+        p = EscreverFloat(p, clique->y);
+        tickAnterior = clique->tick;
+    }
+
+    FILE* f = fopen(arquivo, "wb");
+    size_t tamanho = (size_t)(p - buffer);
+    bool ok = f != NULL && fwrite(buffer, 1, tamanho, f) == tamanho;
+    if (f != NULL && fclose(f) != 0)
+        ok = false;
+    free(buffer);
+    return ok;
+}
+
+bool CarregarGravacao(Gravacao* gravacao, const char* arquivo) {
+    memset(gravacao, 0, sizeof(*gravacao));
+    FILE* f = fopen(arquivo, "rb");
+    if (f == NULL)
+        return false;
+    fseek(f, 0, SEEK_END);
+    long tamanho = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (tamanho < TAMANHO_CABECALHO_GRAVACAO) {
+        fclose(f);
+        return false;
+    }
+    uint8_t* buffer = (uint8_t*)malloc((size_t)tamanho);
+    bool ok = buffer != NULL && fread(buffer, 1, (size_t)tamanho, f) == (size_t)tamanho;
+    fclose(f);
+    if (!ok || memcmp(buffer, MAGICA_GRAVACAO, 4) != 0 || buffer[4] != VERSAO_GRAVACAO || buffer[5] > DIFICIL) {
+        free(buffer);
+        return false;
+    }
+
+    ConfiguracaoJogo* c = &gravacao->configuracao;
+    c->dificuldade = (Dificuldade)buffer[5];
+    c->semente = LerU64(buffer + 8);
+    c->totalBuracos = (int)LerU32(buffer + 16);
+    c->larguraTela = LerFloat(buffer + 20);
+    c->alturaTela = LerFloat(buffer + 24);
+    gravacao->pontosFinais = (int)LerU32(buffer + 28);
+    gravacao->tickFinal = (int64_t)LerU64(buffer + 32);
+    uint32_t total = LerU32(buffer + 40);
+
+    // Cada clique ocupa pelo menos 9 bytes, então um total maior que o arquivo é corrupção.
+    const uint8_t* p = buffer + TAMANHO_CABECALHO_GRAVACAO;
+    const uint8_t* fim = buffer + tamanho;
+    if (total > (uint32_t)(fim - p) / 9) {
+        free(buffer);
+        return false;
+    }
+    gravacao->cliques = (CliqueGravado*)malloc((size_t)(total > 0 ? total : 1) * sizeof(CliqueGravado));
+    gravacao->capacidadeCliques = (int)total;
+    int64_t tick = 0;
+    for (uint32_t i = 0; i < total && gravacao->cliques != NULL; i++) {
+        uint64_t diferenca;
+        p = LerVarint(p, fim, &diferenca);
+        if (p == NULL || fim - p < 8) {
+            ok = false;
+            break;
+        }
+        tick += (int64_t)diferenca;
+        gravacao->cliques[i] = (CliqueGravado){ tick, LerFloat(p), LerFloat(p + 4) };
+        p += 8;
+        gravacao->totalCliques++;
+    }
+    free(buffer);
+    if (!ok || gravacao->cliques == NULL) {
+        LiberarGravacao(gravacao);
+        return false;
+    }
+    return true;
+}
+
+// --- REPRODUÇÃO ---
+
+bool IniciarReproducao(const Gravacao* gravacao, EstadoJogo* jogo, int* proximoClique) {
+    bool ok = InicializarEstadoJogo(jogo, &gravacao->configuracao);
+    jogo->gravacao = NULL; // A reprodução não grava de novo.
+    *proximoClique = 0;
+    return ok;
+}
+
+void ReproduzirAte(const Gravacao* gravacao, EstadoJogo* jogo, int* proximoClique, int64_t tickAlvo) {
+    // Cada clique é aplicado exatamente como no PassoJogo: primeiro a simulação chega ao tick dele, depois o clique.
+    while (*proximoClique < gravacao->totalCliques && gravacao->cliques[*proximoClique].tick <= tickAlvo) {
+        const CliqueGravado* clique = &gravacao->cliques[(*proximoClique)++];
+        AvancarJogoAte(jogo, clique->tick);
+        AplicarClique(jogo, clique->x, clique->y);
+    }
+    AvancarJogoAte(jogo, tickAlvo);
+}
+
+void PassoReproducao(const Gravacao* gravacao, LinhaTempo* linha, EstadoJogo* jogo, int* proximoClique, double dt) {
+    if (jogo->jogoAcabou)
+        return;
+    int64_t ticks = (int64_t)((jogo->acumulador + dt) * TICKS_POR_SEGUNDO);
+    jogo->acumulador += dt - ticks * PASSO_FIXO;
+    if (jogo->acumulador < 0.0) // Protege contra erro de arredondamento.
+        jogo->acumulador = 0.0;
+    if (linha != NULL)
+        IrParaTickReproducao(gravacao, linha, jogo, proximoClique, jogo->tick + ticks);
+    else
+        ReproduzirAte(gravacao, jogo, proximoClique, jogo->tick + ticks);
+}
+
+// Primeiro clique gravado depois de 'tick' (busca binária: os cliques estão em ordem de tick).
+static int CliqueDepoisDe(const Gravacao* gravacao, int64_t tick) {
+    int inicio = 0, fim = gravacao->totalCliques;
+    while (inicio < fim) {
+        int meio = (inicio + fim) / 2;
+        if (gravacao->cliques[meio].tick <= tick)
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+    return inicio;
+}
+
+void IrParaTickReproducao(const Gravacao* gravacao, LinhaTempo* linha, EstadoJogo* jogo, int* proximoClique, int64_t tickAlvo) {
+    if (tickAlvo < 0)
+        tickAlvo = 0;
+    if (tickAlvo < jogo->tick && linha->totalQuadros > 0) {
+        // Para trás: volta ao último quadro-chave antes do alvo. Os cliques até o tick dele já estão aplicados.
+        int k = (int)(tickAlvo / TICKS_ENTRE_QUADROS_CHAVE);
+        if (k >= linha->totalQuadros)
+            k = linha->totalQuadros - 1;
+        if (!RestaurarInstantaneo(jogo, &linha->quadros[k]))
+            return; // Sem memória para voltar: a reprodução fica onde está.
+        *proximoClique = CliqueDepoisDe(gravacao, jogo->tick);
+    }
+    // Para frente: salva os quadros-chave que ainda não existem pelo caminho.
+    for (;;) {
+        int64_t tickQuadro = (int64_t)linha->totalQuadros * TICKS_ENTRE_QUADROS_CHAVE;
+        if (tickQuadro > tickAlvo || tickQuadro > jogo->tickFimJogo || tickQuadro < jogo->tick)
+            break;
+        if (linha->totalQuadros == linha->capacidade) {
+            int novaCapacidade = linha->capacidade == 0 ? 64 : linha->capacidade * 2;
+            InstantaneoJogo* novo = (InstantaneoJogo*)realloc(linha->quadros, (size_t)novaCapacidade * sizeof(InstantaneoJogo));
+            if (novo == NULL)
+                break;
+            memset(novo + linha->capacidade, 0, (size_t)(novaCapacidade - linha->capacidade) * sizeof(InstantaneoJogo));
+            linha->quadros = novo;
+            linha->capacidade = novaCapacidade;
+        }
+        ReproduzirAte(gravacao, jogo, proximoClique, tickQuadro);
+        if (!SalvarInstantaneo(jogo, &linha->quadros[linha->totalQuadros]))
+            break; // Sem memória: os quadros-chave param aqui e o resto é reproduzido desde o último.
+        linha->totalQuadros++;
+    }
+    ReproduzirAte(gravacao, jogo, proximoClique, tickAlvo);
+}
+
+void LimparLinhaTempo(LinhaTempo* linha) {
+    linha->totalQuadros = 0; // Os instantâneos ficam alocados para a próxima reprodução.
+}
+
+void LiberarLinhaTempo(LinhaTempo* linha) {
+    for (int k = 0; k < linha->capacidade; k++)
+        LiberarInstantaneo(&linha->quadros[k]);
+    free(linha->quadros);
+    memset(linha, 0, sizeof(*linha));
+}
+
+int ReproduzirGravacao(const Gravacao* gravacao) {
+    EstadoJogo jogo = {0};
+    int proximoClique;
+    if (!IniciarReproducao(gravacao, &jogo, &proximoClique)) {
+        LiberarEstadoJogo(&jogo);
+        return -1;
+    }
+    ReproduzirAte(gravacao, &jogo, &proximoClique, jogo.tickFimJogo); // Pula direto para o fim da partida.
+    int pontos = jogo.pontos;
+    LiberarEstadoJogo(&jogo);
+    return pontos;
+}
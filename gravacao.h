@@ -0,0 +1,89 @@
+#ifndef GRAVACAO_H
+#define GRAVACAO_H
+
+#include "logica.h"
+#include <stddef.h>
+
+// --- GRAVAÇÃO E REPRODUÇÃO DE PARTIDAS ---
+// A partida é determinística: com a mesma configuração (incluindo a semente) e os mesmos cliques nos mesmos ticks,
+// o resultado é sempre o mesmo. Então basta gravar a configuração e cada clique com o seu tick para reproduzir
+// uma partida inteira, na tela ou sem janela, na velocidade máxima. A gravação guarda também os pontos finais,
+// e a reprodução confere se eles batem: uma gravação serve como teste de regressão e de desempenho.
+// Este módulo não depende da Raylib.
+//
+// Formato do arquivo (little-endian):
+//   "BREC", versão (1 byte), dificuldade (1 byte), 2 bytes reservados
+//   semente (8 bytes), totalBuracos (4), larguraTela (4, float), alturaTela (4, float)
+//   pontosFinais (4), tickFinal (8), totalCliques (4)
+//   para cada clique: diferença de tick para o clique anterior (varint), x (4, float), y (4, float)
+
+#define MAGICA_GRAVACAO "BREC"
+#define VERSAO_GRAVACAO 2 // 2: o clique testa a máscara de colisão do animal, e não o buraco inteiro.
+#define EXTENSAO_GRAVACAO ".brec"
+
+typedef struct {
+    int64_t tick;  // Tick em que o clique foi aplicado.
+    float x, y;    // Posição exata do clique, para a reprodução acertar os mesmos animais.
+} CliqueGravado;
+
+typedef struct Gravacao {
+    ConfiguracaoJogo configuracao; // Configuração da partida, com a semente.
+    int pontosFinais;              // Pontos no fim da partida (-1 se ela não terminou).
+    int64_t tickFinal;             // Tick do fim da partida.
+    CliqueGravado* cliques;
+    int totalCliques;
+    int capacidadeCliques;
+} Gravacao;
+
+// Começa uma gravação vazia para uma partida com esta configuração.
+void IniciarGravacao(Gravacao* gravacao, const ConfiguracaoJogo* configuracao);
+
+// Acrescenta um clique. Chamada pelo PassoJogo quando o estado do jogo aponta para a gravação.
+void GravarClique(Gravacao* gravacao, int64_t tick, float x, float y);
+
+// Guarda o resultado da partida terminada.
+void EncerrarGravacao(Gravacao* gravacao, const EstadoJogo* jogo);
+
+bool SalvarGravacao(const Gravacao* gravacao, const char* arquivo);
+
+// Lê uma gravação. Retorna false se o arquivo não existir, tiver outra versão ou estiver corrompido.
+bool CarregarGravacao(Gravacao* gravacao, const char* arquivo);
+
+void LiberarGravacao(Gravacao* gravacao);
+
+// Prepara 'jogo' para reproduzir a gravação (mesma configuração e semente). '*proximoClique' volta a 0.
+// Retorna false se faltar memória para a partida.
+bool IniciarReproducao(const Gravacao* gravacao, EstadoJogo* jogo, int* proximoClique);
+
+// Avança a reprodução até 'tickAlvo', aplicando os cliques gravados em seus ticks.
+void ReproduzirAte(const Gravacao* gravacao, EstadoJogo* jogo, int* proximoClique, int64_t tickAlvo);
+
+
+// --- LINHA DO TEMPO DA REPRODUÇÃO ---
+// Um instantâneo da partida a cada TICKS_ENTRE_QUADROS_CHAVE ticks, salvo na primeira vez que a reprodução passa
+// por ele. Voltar no tempo restaura o último quadro-chave antes do alvo e reproduz só o pedaço que falta.
+
+#define TICKS_ENTRE_QUADROS_CHAVE TICKS_POR_SEGUNDO // Um quadro-chave por segundo de partida.
+
+typedef struct {
+    InstantaneoJogo* quadros; // quadros[k]: a partida no tick k * TICKS_ENTRE_QUADROS_CHAVE, com os cliques desse tick.
+    int totalQuadros;         // Quadros-chave já salvos (sempre os primeiros).
+    int capacidade;
+} LinhaTempo;
+
+// Leva a reprodução até 'tickAlvo', para frente ou para trás, salvando os quadros-chave que passar.
+void IrParaTickReproducao(const Gravacao* gravacao, LinhaTempo* linha, EstadoJogo* jogo, int* proximoClique, int64_t tickAlvo);
+
+// Avança a reprodução em 'dt' segundos de frame, com o mesmo acumulador do PassoJogo (reprodução na tela).
+// Com uma linha do tempo, salva os quadros-chave pelo caminho para permitir voltar; 'linha' pode ser NULL.
+void PassoReproducao(const Gravacao* gravacao, LinhaTempo* linha, EstadoJogo* jogo, int* proximoClique, double dt);
+
+// Esquece os quadros-chave (nova reprodução), mantendo a memória deles.
+void LimparLinhaTempo(LinhaTempo* linha);
+void LiberarLinhaTempo(LinhaTempo* linha);
+
+// Reproduz a partida inteira sem janela, o mais rápido possível. Retorna os pontos finais, ou -1 se faltar memória
+// para a partida. O estado é liberado antes de retornar.
+int ReproduzirGravacao(const Gravacao* gravacao);
+
+#endif
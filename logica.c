@@ -0,0 +1,698 @@
+#include "logica.h"
+#include "gravacao.h" // Gravação dos cliques aplicados, para reproduzir a partida.
+#include "telemetria.h" // Eventos da partida para os tempos de reação.
+#include <math.h>   // sqrtf e ceilf, usados para montar a grade de buracos.
+#include <stdlib.h> // realloc e free, usados na arena da partida.
+#include <string.h>
+
+// --- CONSTANTES DE DIFICULDADE ---
+// Não são 'const' para que o simulador possa testar outros valores (simulador --tabela). O jogo nunca as altera.
+
+int CAPIVARAS_POR_DIFICULDADE[] = {3, 4, 5};       // Número total de posições para capivaras por dificuldade.
+int MAX_SIMULTANEAS_INICIAL[] = {1, 2, 3};     // Máximo de capivaras visíveis simultaneamente no início do jogo.
+float INTERVALO_MIN[] = {1.5f, 1.0f, 1.0f};    // Intervalo mínimo de tempo para uma nova capivara aparecer.
+float INTERVALO_MAX[] = {3.0f, 2.0f, 1.5f};    // Intervalo máximo de tempo para uma nova capivara aparecer.
+float TEMPO_VISIVEL_MIN[] = {1.0f, 0.8f, 0.5f}; // Tempo mínimo que uma capivara permanece visível.
+float TEMPO_VISIVEL_MAX[] = {1.8f, 1.5f, 0.8f}; // Tempo máximo que uma capivara permanece visível.
+int PENALIDADE_CUTIA[] = {-1, -2, -3};         // Pontos perdidos ao acertar uma cutia, por dificuldade.
+int CHANCE_CUTIA[] = {10, 15, 20};             // Chance (em %) de um aparecimento ser uma cutia.
+int CHANCE_DOURADA[] = {0, 3, 5};              // Chance (em %) de um aparecimento ser uma capivara dourada.
+
+// A cutia é desenhada com 90% do tamanho do buraco; as capivaras o ocupam inteiro.
+const float ESCALA_DESENHO[TOTAL_TIPOS_CAPIVARA] = {1.0f, 1.0f, 0.9f};
+
+// --- GERADOR DE NÚMEROS ALEATÓRIOS ---
+
+void IniciarGerador(GeradorAleatorio* gerador, uint64_t semente) {
+    // Espalha os bits da semente (splitmix64) para que sementes parecidas gerem sequências bem diferentes.
+    uint64_t z = semente + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    gerador->estado = (z != 0) ? z : 0x9E3779B97F4A7C15ULL; // O xorshift nunca pode ter estado zero.
+}
+
+int SortearValor(GeradorAleatorio* gerador, int min, int max) {
+    if (min > max) { // Aceita os limites invertidos, como a Raylib.
+        int tmp = min;
+        min = max;
+        max = tmp;
+    }
+    // Passo do xorshift64*.
+    uint64_t x = gerador->estado;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    gerador->estado = x;
+    uint32_t aleatorio = (uint32_t)((x * 0x2545F4914F6CDD1DULL) >> 32);
+    // Reduz para o intervalo [min, max] com multiplicação, evitando o viés e o custo do operador '%'.
+    uint64_t tamanho = (uint64_t)((int64_t)max - min) + 1;
+    return (int)((int64_t)min + (int64_t)(((uint64_t)aleatorio * tamanho) >> 32));
+}
+
+// --- CONVERSÃO DE TEMPO ---
+
+#define DURACAO_JOGO 120.0        // Duração da partida em segundos (2 minutos).
+#define DURACAO_CONTAGEM 3.99     // Contagem regressiva (3, 2, 1, GO!). O .99 é para garantir que o "GO!" apareça no tempo certo.
+#define DURACAO_CHUVA 5.0         // Duração do efeito de chuva em segundos.
+#define DURACAO_ATORDOADO 0.5     // Tempo da animação de atordoado em segundos.
+
+// Converte segundos para ticks, arredondando para o tick mais próximo.
+static int64_t SegundosParaTicks(double segundos) {
+    return (int64_t)(segundos * TICKS_POR_SEGUNDO + 0.5);
+}
+
+// Sorteia uma duração entre 'min' e 'max' segundos (com resolução de milissegundos, como antes) e a converte para ticks.
+// Sempre retorna pelo menos 1 tick, para que um evento nunca seja reagendado para o próprio tick.
+static int64_t SortearTicks(GeradorAleatorio* gerador, float min, float max) {
+    int ms = SortearValor(gerador, (int)(min * 1000), (int)(max * 1000));
+    int64_t ticks = ((int64_t)ms * TICKS_POR_SEGUNDO + 999) / 1000; // Arredonda para cima.
+    return ticks > 0 ? ticks : 1;
+}
+
+// --- AGENDA DE EVENTOS (HEAP MÍNIMO INDEXADO) ---
+
+// true se o evento do buraco 'a' vem antes do evento do buraco 'b'. O índice desempata, para a ordem ser determinística.
+static bool EventoAntes(const EstadoJogo* jogo, int a, int b) {
+    int64_t ta = jogo->capivaras.tickEvento[a];
+    int64_t tb = jogo->capivaras.tickEvento[b];
+    return ta < tb || (ta == tb && a < b);
+}
+
+static void TrocarNaAgenda(EstadoJogo* jogo, int i, int j) {
+    int a = jogo->agenda[i];
+    int b = jogo->agenda[j];
+    jogo->agenda[i] = b;
+    jogo->agenda[j] = a;
+    jogo->posicaoAgenda[b] = i;
+    jogo->posicaoAgenda[a] = j;
+}
+
+static void SubirNaAgenda(EstadoJogo* jogo, int i) {
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (!EventoAntes(jogo, jogo->agenda[i], jogo->agenda[pai]))
+            break;
+        TrocarNaAgenda(jogo, i, pai);
+        i = pai;
+    }
+}
+
+static void DescerNaAgenda(EstadoJogo* jogo, int i) {
+    for (;;) {
+        int menor = i;
+        int esq = 2 * i + 1;
+        int dir = esq + 1;
+        if (esq < jogo->tamanhoAgenda && EventoAntes(jogo, jogo->agenda[esq], jogo->agenda[menor]))
+            menor = esq;
+        if (dir < jogo->tamanhoAgenda && EventoAntes(jogo, jogo->agenda[dir], jogo->agenda[menor]))
+            menor = dir;
+        if (menor == i)
+            break;
+        TrocarNaAgenda(jogo, i, menor);
+        i = menor;
+    }
+}
+
+// Agenda o próximo evento do buraco 'i' para 'tick'. Cada buraco tem sempre exatamente um evento na agenda,
+// então reagendar é só mudar a chave e reposicionar o buraco no heap.
+static void AgendarEvento(EstadoJogo* jogo, int i, int64_t tick) {
+    int64_t anterior = jogo->capivaras.tickEvento[i];
+    jogo->capivaras.tickEvento[i] = tick;
+    if (tick < anterior)
+        SubirNaAgenda(jogo, jogo->posicaoAgenda[i]);
+    else
+        DescerNaAgenda(jogo, jogo->posicaoAgenda[i]);
+}
+
+// Agenda a próxima tentativa de aparecimento do buraco 'i', dentro de INTERVALO_MIN..INTERVALO_MAX.
+static void AgendarAparecimento(EstadoJogo* jogo, int i) {
+    Dificuldade d = jogo->dificuldade;
+    AgendarEvento(jogo, i, jogo->tick + SortearTicks(&jogo->gerador, INTERVALO_MIN[d], INTERVALO_MAX[d]));
+}
+
+// --- PARTIDA ---
+
+// Tamanho de um array dentro da arena, arredondado para manter o alinhamento de 8 bytes.
+static size_t TamanhoBloco(size_t tamanho) {
+    return (tamanho + 7) & ~(size_t)7;
+}
+
+// Reserva 'tamanho' bytes da arena da partida, mantendo o alinhamento de 8 bytes.
+static void* ReservarBloco(char** cursor, size_t tamanho) {
+    void* p = *cursor;
+    *cursor += TamanhoBloco(tamanho);
+    return p;
+}
+
+// Aumenta a arena até 'tamanho' bytes, mantendo o conteúdo. Se ela já for grande o suficiente, não faz nada.
+// Se faltar memória, a arena antiga continua intacta e a função retorna false.
+static bool GarantirMemoria(EstadoJogo* jogo, size_t tamanho) {
+    if (tamanho <= jogo->capacidadeMemoria)
+        return true;
+    void* memoria = realloc(jogo->memoria, tamanho);
+    if (memoria == NULL)
+        return false;
+    jogo->memoria = memoria;
+    jogo->capacidadeMemoria = tamanho;
+    return true;
+}
+
+// Deixa a partida sem buracos quando a arena não pôde crescer: nada é desenhado nem simulado sobre ela.
+static bool DesistirInicializacao(EstadoJogo* jogo) {
+    jogo->totalCapivaras = 0;
+    jogo->tamanhoMemoria = 0;
+    jogo->tamanhoAgenda = 0;
+    jogo->grade.colunas = 0;
+    jogo->grade.linhas = 0;
+    jogo->grade.totalEntradas = 0;
+    return false;
+}
+
+// Bytes da arena para o tabuleiro atual. Segue a mesma ordem de DistribuirMemoria.
+static size_t TamanhoMemoria(const EstadoJogo* jogo) {
+    size_t n = (size_t)jogo->totalCapivaras;
+    size_t celulas = (size_t)(jogo->grade.colunas * jogo->grade.linhas);
+    size_t tamanho = TamanhoBloco(n * sizeof(Retangulo));
+    tamanho += 4 * TamanhoBloco(n * sizeof(bool));          // visivel, hit, machucada, tipo
+    tamanho += 2 * TamanhoBloco(n * sizeof(int64_t));       // tickEvento, tickSurgimento
+    tamanho += 2 * TamanhoBloco(n * sizeof(int));           // agenda, posicaoAgenda
+    tamanho += TamanhoBloco((celulas + 1) * sizeof(int));
+    tamanho += TamanhoBloco((size_t)jogo->grade.totalEntradas * sizeof(int));
+    return tamanho;
+}
+
+// Aponta cada array para o seu lugar na arena. As posições vêm primeiro, porque a grade depende delas e é
+// calculada antes de a arena ter o tamanho final. Chamada também ao restaurar um instantâneo em outra arena.
+static void DistribuirMemoria(EstadoJogo* jogo) {
+    size_t n = (size_t)jogo->totalCapivaras;
+    size_t celulas = (size_t)(jogo->grade.colunas * jogo->grade.linhas);
+    char* cursor = (char*)jogo->memoria;
+    jogo->capivaras.rect = (Retangulo*)ReservarBloco(&cursor, n * sizeof(Retangulo));
+    jogo->capivaras.visivel = (bool*)ReservarBloco(&cursor, n * sizeof(bool));
+    jogo->capivaras.hit = (bool*)ReservarBloco(&cursor, n * sizeof(bool));
+    jogo->capivaras.machucada = (bool*)ReservarBloco(&cursor, n * sizeof(bool));
+    jogo->capivaras.tipo = (uint8_t*)ReservarBloco(&cursor, n * sizeof(uint8_t));
+    jogo->capivaras.tickEvento = (int64_t*)ReservarBloco(&cursor, n * sizeof(int64_t));
+    jogo->capivaras.tickSurgimento = (int64_t*)ReservarBloco(&cursor, n * sizeof(int64_t));
+    jogo->agenda = (int*)ReservarBloco(&cursor, n * sizeof(int));
+    jogo->posicaoAgenda = (int*)ReservarBloco(&cursor, n * sizeof(int));
+    jogo->grade.inicioCelula = (int*)ReservarBloco(&cursor, (celulas + 1) * sizeof(int));
+    jogo->grade.buracosCelula = (int*)ReservarBloco(&cursor, (size_t)jogo->grade.totalEntradas * sizeof(int));
+}
+
+// Posiciona os buracos. Até o tamanho da tela, usa a fileira centralizada original; com mais buracos,
+// monta uma grade que ocupa a tela abaixo da interface, reduzindo os animais para caber.
+static void PosicionarBuracos(EstadoJogo* jogo, float larguraTela, float alturaTela) {
+    int n = jogo->totalCapivaras;
+    float larguraCapivara = 150;    // Largura base para a textura da capivara.
+    float alturaCapivara = 120;     // Altura base para a textura da capivara.
+    float espacamentoCapivara = 50; // Espaçamento horizontal entre cada capivara.
+    // Calcula a largura total que todas as capivaras e seus espaçamentos ocuparão.
+    float larguraTotal = n * larguraCapivara + (n - 1) * espacamentoCapivara;
+
+    if (larguraTotal <= larguraTela) {
+        // Calcula a posição X inicial para centralizar o bloco de capivaras na tela.
+        int startX = ((int)larguraTela - (int)larguraTotal) / 2;
+        int yPos = (int)alturaTela / 2 + 120; // Posição Y fixa onde as capivaras aparecerão(divide a tela no meio)
+        for (int i = 0; i < n; i++)
+            jogo->capivaras.rect[i] = (Retangulo){ (float)startX + i * (larguraCapivara + espacamentoCapivara), (float)yPos, larguraCapivara, alturaCapivara };
+        return;
+    }
+
+    // Grade: cada célula tem a proporção de um slot original com o espaçamento (200 x 170).
+    float topo = 80; // Espaço reservado para o tempo, os pontos e o botão de pausa.
+    float areaLargura = larguraTela;
+    float areaAltura = alturaTela - topo;
+    int colunas = (int)ceilf(sqrtf(n * areaLargura * 170.0f / (areaAltura * 200.0f)));
+    if (colunas < 1)
+        colunas = 1;
+    if (colunas > n)
+        colunas = n;
+    int linhas = (n + colunas - 1) / colunas;
+    float celulaLargura = areaLargura / colunas;
+    float celulaAltura = areaAltura / linhas;
+    float escala = fminf(celulaLargura / 200.0f, celulaAltura / 170.0f);
+    float largura = larguraCapivara * escala;
+    float altura = alturaCapivara * escala;
+    for (int i = 0; i < n; i++) {
+        int coluna = i % colunas;
+        int linha = i / colunas;
+        jogo->capivaras.rect[i] = (Retangulo){ coluna * celulaLargura + (celulaLargura - largura) / 2,
+                                               topo + linha * celulaAltura + (celulaAltura - altura) / 2, largura, altura };
+    }
+}
+
+// Limites das células tocadas pelo retângulo 'r' na grade.
+static void CelulasDoRetangulo(const GradeEspacial* g, Retangulo r, int* c0, int* l0, int* c1, int* l1) {
+    *c0 = (int)((r.x - g->origemX) / g->tamanhoCelula);
+    *l0 = (int)((r.y - g->origemY) / g->tamanhoCelula);
+    *c1 = (int)((r.x + r.largura - g->origemX) / g->tamanhoCelula);
+    *l1 = (int)((r.y + r.altura - g->origemY) / g->tamanhoCelula);
+    if (*c1 >= g->colunas) *c1 = g->colunas - 1;
+    if (*l1 >= g->linhas) *l1 = g->linhas - 1;
+}
+
+// Conta quantas entradas a grade vai precisar para a área ocupada pelos buracos, com células do tamanho do maior buraco.
+static int PrepararGrade(EstadoJogo* jogo) {
+    GradeEspacial* g = &jogo->grade;
+    Retangulo* rect = jogo->capivaras.rect;
+    float minX = rect[0].x, minY = rect[0].y, maxX = rect[0].x + rect[0].largura, maxY = rect[0].y + rect[0].altura;
+    float maiorLado = 1.0f;
+    for (int i = 0; i < jogo->totalCapivaras; i++) {
+        minX = fminf(minX, rect[i].x);
+        minY = fminf(minY, rect[i].y);
+        maxX = fmaxf(maxX, rect[i].x + rect[i].largura);
+        maxY = fmaxf(maxY, rect[i].y + rect[i].altura);
+        maiorLado = fmaxf(maiorLado, fmaxf(rect[i].largura, rect[i].altura));
+    }
+    g->origemX = minX;
+    g->origemY = minY;
+    g->tamanhoCelula = maiorLado; // Cada buraco toca no máximo 2 x 2 células.
+    g->colunas = (int)((maxX - minX) / maiorLado) + 1;
+    g->linhas = (int)((maxY - minY) / maiorLado) + 1;
+    int entradas = 0;
+    for (int i = 0; i < jogo->totalCapivaras; i++) {
+        int c0, l0, c1, l1;
+        CelulasDoRetangulo(g, rect[i], &c0, &l0, &c1, &l1);
+        entradas += (c1 - c0 + 1) * (l1 - l0 + 1);
+    }
+    return entradas;
+}
+
+// Preenche a grade (os arrays já estão alocados): primeiro conta os buracos por célula, depois os distribui.
+static void MontarGrade(EstadoJogo* jogo) {
+    GradeEspacial* g = &jogo->grade;
+    int totalCelulas = g->colunas * g->linhas;
+    memset(g->inicioCelula, 0, (size_t)(totalCelulas + 1) * sizeof(int));
+    for (int i = 0; i < jogo->totalCapivaras; i++) {
+        int c0, l0, c1, l1;
+        CelulasDoRetangulo(g, jogo->capivaras.rect[i], &c0, &l0, &c1, &l1);
+        for (int l = l0; l <= l1; l++)
+            for (int c = c0; c <= c1; c++)
+                g->inicioCelula[l * g->colunas + c + 1]++;
+    }
+    for (int c = 0; c < totalCelulas; c++) // Soma acumulada: início de cada célula.
+        g->inicioCelula[c + 1] += g->inicioCelula[c];
+    // Usa a posição de escrita de cada célula emprestada de 'inicioCelula' e depois a restaura.
+    for (int i = 0; i < jogo->totalCapivaras; i++) {
+        int c0, l0, c1, l1;
+        CelulasDoRetangulo(g, jogo->capivaras.rect[i], &c0, &l0, &c1, &l1);
+        for (int l = l0; l <= l1; l++)
+            for (int c = c0; c <= c1; c++)
+                g->buracosCelula[g->inicioCelula[l * g->colunas + c]++] = i;
+    }
+    for (int c = totalCelulas; c > 0; c--)
+        g->inicioCelula[c] = g->inicioCelula[c - 1];
+    g->inicioCelula[0] = 0;
+}
+
+bool InicializarEstadoJogo(EstadoJogo* jogo, const ConfiguracaoJogo* configuracao) {
+    Dificuldade dificuldade = configuracao->dificuldade;
+    jogo->dificuldade = dificuldade;    // Define a dificuldade escolhida para a partida.
+    IniciarGerador(&jogo->gerador, configuracao->semente); // A mesma semente sempre gera a mesma partida.
+    jogo->pontos = 0;                   // Reseta a pontuação.
+    jogo->totalAcertosRecentes = 0;
+    jogo->jogoIniciado = false;         // O jogo não começa imediatamente, espera a contagem regressiva.
+    jogo->jogoAcabou = false;           // O jogo não está acabado no início.
+    jogo->chovendo = false;             // A chuva não está ativa no início.
+    // Define o número de slots de capivara com base na dificuldade, ou o número pedido na configuração.
+    int padrao = CAPIVARAS_POR_DIFICULDADE[dificuldade];
+    jogo->totalCapivaras = configuracao->totalBuracos > 0 ? configuracao->totalBuracos : padrao;
+    // Tabuleiros maiores mantêm a mesma proporção de animais visíveis por buraco.
+    jogo->maxSimultaneas = MAX_SIMULTANEAS_INICIAL[dificuldade] * jogo->totalCapivaras / padrao;
+    if (jogo->maxSimultaneas < MAX_SIMULTANEAS_INICIAL[dificuldade])
+        jogo->maxSimultaneas = MAX_SIMULTANEAS_INICIAL[dificuldade];
+
+    // Tempo em ticks: a contagem regressiva começa no tick 0 e a partida dura DURACAO_JOGO depois dela.
+    jogo->tick = 0;
+    jogo->acumulador = 0.0;
+    jogo->tickInicioJogo = SegundosParaTicks(DURACAO_CONTAGEM);
+    jogo->tickFimJogo = jogo->tickInicioJogo + SegundosParaTicks(DURACAO_JOGO);
+    jogo->tickFimChuva = 0;
+    jogo->capivarasVisiveis = 0;
+    jogo->tempoRestanteJogo = DURACAO_JOGO;
+    jogo->contadorRegressivoInicial = DURACAO_CONTAGEM;
+    jogo->tempoChuvaAtual = 0.0;
+
+    // --- ARENA DA PARTIDA ---
+    // A arena da partida anterior é reaproveitada: reiniciar com o mesmo tabuleiro não aloca nem libera memória.
+    // As posições são calculadas primeiro, no início da arena, porque o tamanho da grade depende delas.
+    int n = jogo->totalCapivaras;
+    if (!GarantirMemoria(jogo, TamanhoBloco((size_t)n * sizeof(Retangulo))))
+        return DesistirInicializacao(jogo);
+    jogo->capivaras.rect = (Retangulo*)jogo->memoria;
+    PosicionarBuracos(jogo, configuracao->larguraTela, configuracao->alturaTela);
+    jogo->grade.totalEntradas = PrepararGrade(jogo);
+    jogo->tamanhoMemoria = TamanhoMemoria(jogo);
+    if (!GarantirMemoria(jogo, jogo->tamanhoMemoria)) // Se crescer, o realloc mantém as posições já calculadas.
+        return DesistirInicializacao(jogo);
+    DistribuirMemoria(jogo);
+    jogo->tamanhoAgenda = 0; // Os buracos só entram na agenda quando a contagem regressiva termina.
+    MontarGrade(jogo);
+
+    // Inicializa cada slot invisível, não acertado, não machucado e do tipo NORMAL.
+    memset(jogo->capivaras.visivel, 0, (size_t)n * sizeof(bool));
+    memset(jogo->capivaras.hit, 0, (size_t)n * sizeof(bool));
+    memset(jogo->capivaras.machucada, 0, (size_t)n * sizeof(bool));
+    memset(jogo->capivaras.tipo, NORMAL, (size_t)n * sizeof(uint8_t));
+    memset(jogo->capivaras.tickEvento, 0, (size_t)n * sizeof(int64_t));
+    memset(jogo->capivaras.tickSurgimento, 0, (size_t)n * sizeof(int64_t));
+    return true;
+}
+
+void LiberarEstadoJogo(EstadoJogo* jogo) {
+    // Libera a arena e evita acesso a memória já liberada.
+    free(jogo->memoria);
+    jogo->memoria = NULL;
+    jogo->tamanhoMemoria = 0;
+    jogo->capacidadeMemoria = 0;
+    memset(&jogo->capivaras, 0, sizeof(jogo->capivaras));
+    jogo->agenda = NULL;
+    jogo->posicaoAgenda = NULL;
+    jogo->tamanhoAgenda = 0;
+    jogo->grade.inicioCelula = NULL;
+    jogo->grade.buracosCelula = NULL;
+}
+
+bool SalvarInstantaneo(const EstadoJogo* jogo, InstantaneoJogo* instantaneo) {
+    if (instantaneo->capacidade < jogo->tamanhoMemoria) {
+        void* memoria = malloc(jogo->tamanhoMemoria);
+        if (memoria == NULL)
+            return false; // O instantâneo continua com o que tinha.
+        free(instantaneo->memoria);
+        instantaneo->memoria = memoria;
+        instantaneo->capacidade = jogo->tamanhoMemoria;
+    }
+    instantaneo->estado = *jogo;
+    memcpy(instantaneo->memoria, jogo->memoria, jogo->tamanhoMemoria);
+    return true;
+}
+
+bool RestaurarInstantaneo(EstadoJogo* jogo, const InstantaneoJogo* instantaneo) {
+    // A arena cresce antes de tudo: se faltar memória, a partida fica exatamente como estava.
+    if (!GarantirMemoria(jogo, instantaneo->estado.tamanhoMemoria))
+        return false;
+    // A arena, a gravação e a telemetria são do destino; todo o resto vem do instantâneo.
+    void* memoria = jogo->memoria;
+    size_t capacidade = jogo->capacidadeMemoria;
+    struct Gravacao* gravacao = jogo->gravacao;
+    struct Telemetria* telemetria = jogo->telemetria;
+    *jogo = instantaneo->estado;
+    jogo->memoria = memoria;
+    jogo->capacidadeMemoria = capacidade;
+    jogo->gravacao = gravacao;
+    jogo->telemetria = telemetria;
+    jogo->totalAcertosRecentes = 0;
+    memcpy(jogo->memoria, instantaneo->memoria, jogo->tamanhoMemoria);
+    DistribuirMemoria(jogo); // Os ponteiros copiados apontam para a arena de origem.
+    return true;
+}
+
+bool RecomecarEstadoJogo(EstadoJogo* jogo, const InstantaneoJogo* inicio, uint64_t semente) {
+    if (!RestaurarInstantaneo(jogo, inicio))
+        return false;
+    IniciarGerador(&jogo->gerador, semente); // Até a contagem regressiva terminar, a semente só está no gerador.
+    return true;
+}
+
+void LiberarInstantaneo(InstantaneoJogo* instantaneo) {
+    free(instantaneo->memoria);
+    instantaneo->memoria = NULL;
+    instantaneo->capacidade = 0;
+}
+
+void VerInstantaneo(const InstantaneoJogo* instantaneo, EstadoJogo* vista) {
+    *vista = instantaneo->estado;
+    vista->memoria = instantaneo->memoria;
+    vista->capacidadeMemoria = instantaneo->capacidade;
+    vista->gravacao = NULL;
+    vista->telemetria = NULL;
+    DistribuirMemoria(vista);
+}
+
+Retangulo RetanguloDesenho(Retangulo buraco, int tipo) {
+    float escala = ESCALA_DESENHO[tipo];
+    float largura = buraco.largura * escala, altura = buraco.altura * escala;
+    return (Retangulo){ buraco.x + (buraco.largura - largura) / 2, buraco.y + (buraco.altura - altura) / 2, largura, altura };
+}
+
+void MontarMascaraColisao(uint64_t mascara[LADO_MASCARA][PALAVRAS_MASCARA], const uint8_t* pixels, int largura, int altura) {
+    memset(mascara, 0, LADO_MASCARA * PALAVRAS_MASCARA * sizeof(uint64_t));
+    for (int y = 0; y < LADO_MASCARA; y++) {
+        int py = (2 * y + 1) * altura / (2 * LADO_MASCARA);
+        for (int x = 0; x < LADO_MASCARA; x++) {
+            int px = (2 * x + 1) * largura / (2 * LADO_MASCARA);
+            if (pixels[((size_t)py * largura + px) * 4 + 3] >= 128)
+                mascara[y][x >> 6] |= 1ull << (x & 63);
+        }
+    }
+}
+
+// Verifica se o ponto (x, y) cai em um pixel opaco do animal 'tipo' desenhado no buraco 'r'. O ponto é levado para
+// as coordenadas da máscara e a resposta é um bit: sem laço, e as divisões só para os pontos dentro do desenho.
+static bool PontoNoAnimal(float x, float y, Retangulo r, int tipo) {
+    Retangulo d = RetanguloDesenho(r, tipo);
+    if (!(x >= d.x && x < d.x + d.largura && y >= d.y && y < d.y + d.altura))
+        return false;
+    int coluna = (int)((x - d.x) * LADO_MASCARA / d.largura), linha = (int)((y - d.y) * LADO_MASCARA / d.altura);
+    coluna = coluna < LADO_MASCARA ? coluna : LADO_MASCARA - 1; // Arredondamento na borda direita e na de baixo.
+    linha = linha < LADO_MASCARA ? linha : LADO_MASCARA - 1;
+    return (MASCARAS_COLISAO.bits[tipo][linha][coluna >> 6] >> (coluna & 63)) & 1;
+}
+
+// Fim da contagem regressiva: todos os buracos entram na agenda com um primeiro aparecimento sorteado.
+static void IniciarPartida(EstadoJogo* jogo) {
+    jogo->jogoIniciado = true;
+    for (int i = 0; i < jogo->totalCapivaras; i++) {
+        Dificuldade d = jogo->dificuldade;
+        jogo->capivaras.tickEvento[i] = jogo->tick + SortearTicks(&jogo->gerador, INTERVALO_MIN[d], INTERVALO_MAX[d]);
+        jogo->agenda[i] = i;
+        jogo->posicaoAgenda[i] = i;
+    }
+    jogo->tamanhoAgenda = jogo->totalCapivaras;
+    for (int i = jogo->tamanhoAgenda / 2 - 1; i >= 0; i--) // Monta o heap de baixo para cima.
+        DescerNaAgenda(jogo, i);
+    if (jogo->telemetria != NULL)
+        RegistrarTelemetria(jogo->telemetria, EVENTO_INICIO_PARTIDA, jogo->tick, jogo->totalCapivaras, jogo->dificuldade, 0);
+}
+
+// Processa o evento vencido do buraco 'i' no tick atual.
+static void ProcessarEvento(EstadoJogo* jogo, int i) {
+    Capivaras* c = &jogo->capivaras;
+    Dificuldade dificuldade = jogo->dificuldade;
+
+    // Fim do estado "atordoada": após DURACAO_ATORDOADO o slot volta a ficar livre.
+    if (c->machucada[i]) {
+        // Reseta o estado da capivara: invisível, não acertada, não machucada, e volta ao tipo NORMAL para a próxima aparição.
+        c->visivel[i] = false;
+        c->hit[i] = false;
+        c->machucada[i] = false;
+        c->tipo[i] = NORMAL;
+        AgendarAparecimento(jogo, i);
+        return;
+    }
+
+    // Fim do tempo de visibilidade: o animal se esconde sem ter sido acertado.
+    if (c->visivel[i]) {
+        if (jogo->telemetria != NULL)
+            RegistrarTelemetria(jogo->telemetria, EVENTO_ESCONDEU, jogo->tick, i, c->tipo[i], (int)(jogo->tick - c->tickSurgimento[i]));
+        c->visivel[i] = false; // Torna a capivara invisível.
+        c->tipo[i] = NORMAL;   // Reseta seu tipo para NORMAL para a próxima vez que aparecer.
+        jogo->capivarasVisiveis--;
+        AgendarAparecimento(jogo, i);
+        return;
+    }
+
+    // Tentativa de aparecimento. Ela só acontece se:
+    // 1. O número de capivaras visíveis é menor que o máximo permitido.
+    // 2. NÃO ESTÁ CHOVENDO (capivaras normais/douradas não aparecem na chuva).
+    // Caso contrário, o buraco tenta de novo depois de outro intervalo.
+    if (jogo->capivarasVisiveis >= jogo->maxSimultaneas || jogo->chovendo) {
+        AgendarAparecimento(jogo, i);
+        return;
+    }
+
+    TipoCapivara novoTipo = NORMAL;             // Define o tipo padrão como NORMAL.
+    int chance = SortearValor(&jogo->gerador, 1, 100); // Gera um número aleatório para determinar o tipo do animal.
+
+    // Lógica de sorteio de tipo de capivara baseada na dificuldade.
+    // Ex.: no MEDIO, 1 a 15 é CUTIA (15%) e 16 a 18 é DOURADA (3%).
+    if (chance <= CHANCE_CUTIA[dificuldade])
+        novoTipo = CUTIA;
+    else if (chance <= CHANCE_CUTIA[dificuldade] + CHANCE_DOURADA[dificuldade])
+        novoTipo = DOURADA;
+
+    c->visivel[i] = true;              // Torna a capivara neste slot visível.
+    c->hit[i] = false;                 // Garante que ela não esteja marcada como acertada.
+    c->tipo[i] = (uint8_t)novoTipo;    // Atribui o tipo de capivara sorteado.
+    c->tickSurgimento[i] = jogo->tick; // Guarda quando ela apareceu.
+    jogo->capivarasVisiveis++;
+    // Agenda o desaparecimento com um tempo de visibilidade aleatório, dentro dos limites da dificuldade.
+    int64_t tempoVisivel = SortearTicks(&jogo->gerador, TEMPO_VISIVEL_MIN[dificuldade], TEMPO_VISIVEL_MAX[dificuldade]);
+    AgendarEvento(jogo, i, jogo->tick + tempoVisivel);
+    if (jogo->telemetria != NULL)
+        RegistrarTelemetria(jogo->telemetria, EVENTO_APARECEU, jogo->tick, i, novoTipo, (int)tempoVisivel);
+}
+
+// Recalcula os contadores em segundos usados na exibição a partir do tick atual.
+static void AtualizarTempos(EstadoJogo* jogo) {
+    jogo->contadorRegressivoInicial = jogo->jogoIniciado ? 0.0 : DURACAO_CONTAGEM - jogo->tick * PASSO_FIXO;
+    int64_t restante = jogo->tickFimJogo - (jogo->jogoIniciado ? jogo->tick : jogo->tickInicioJogo);
+    jogo->tempoRestanteJogo = restante > 0 ? restante * PASSO_FIXO : 0.0;
+    jogo->tempoChuvaAtual = jogo->chovendo ? (jogo->tickFimChuva - jogo->tick) * PASSO_FIXO : 0.0;
+}
+
+// Desliga a chuva se ela terminou até o tick 'tick'.
+static void AtualizarChuva(EstadoJogo* jogo, int64_t tick) {
+    if (jogo->chovendo && jogo->tickFimChuva <= tick) {
+        jogo->chovendo = false;
+        if (jogo->telemetria != NULL)
+            RegistrarTelemetria(jogo->telemetria, EVENTO_FIM_CHUVA, jogo->tickFimChuva, -1, 0, 0);
+    }
+}
+
+void AvancarJogoAte(EstadoJogo* jogo, int64_t tickAlvo) {
+    if (jogo->jogoAcabou || tickAlvo <= jogo->tick) // Se o jogo já terminou, não há mais lógica para atualizar.
+        return;
+
+    // Lógica para a contagem regressiva antes do início do jogo.
+    if (!jogo->jogoIniciado) {
+        if (tickAlvo < jogo->tickInicioJogo) { // A contagem ainda não terminou.
+            jogo->tick = tickAlvo;
+            AtualizarTempos(jogo);
+            return;
+        }
+        jogo->tick = jogo->tickInicioJogo; // A contagem terminou: a partida começa exatamente neste tick.
+        IniciarPartida(jogo);
+    }
+
+    // Eventos que vencem antes do fim da partida, em ordem de tick. Ticks sem eventos são pulados de uma vez.
+    int64_t limite = tickAlvo < jogo->tickFimJogo ? tickAlvo : jogo->tickFimJogo - 1;
+    while (jogo->tamanhoAgenda > 0 && jogo->capivaras.tickEvento[jogo->agenda[0]] <= limite) {
+        int i = jogo->agenda[0];
+        jogo->tick = jogo->capivaras.tickEvento[i];
+        AtualizarChuva(jogo, jogo->tick); // A chuva que acabou antes deste evento já não bloqueia o aparecimento.
+        ProcessarEvento(jogo, i);
+    }
+
+    // Lógica principal do tempo de jogo.
+    if (tickAlvo >= jogo->tickFimJogo) { // Se o tempo acabou.
+        jogo->tick = jogo->tickFimJogo;
+        jogo->jogoAcabou = true;         // Marca o jogo como terminado.
+    } else {
+        jogo->tick = tickAlvo;
+    }
+    AtualizarChuva(jogo, jogo->tick);
+    if (jogo->jogoAcabou && jogo->telemetria != NULL)
+        RegistrarTelemetria(jogo->telemetria, EVENTO_FIM_PARTIDA, jogo->tick, -1, 0, jogo->pontos);
+    AtualizarTempos(jogo);
+}
+
+int64_t ProximoEventoJogo(const EstadoJogo* jogo) {
+    if (!jogo->jogoIniciado)
+        return jogo->tickInicioJogo;
+    if (jogo->tamanhoAgenda > 0 && jogo->capivaras.tickEvento[jogo->agenda[0]] < jogo->tickFimJogo)
+        return jogo->capivaras.tickEvento[jogo->agenda[0]];
+    return jogo->tickFimJogo;
+}
+
+// Clique durante a partida que não acertou nenhum animal.
+static int Errou(EstadoJogo* jogo) {
+    if (jogo->telemetria != NULL)
+        RegistrarTelemetria(jogo->telemetria, EVENTO_ERRO, jogo->tick, -1, 0, 0);
+    return -1;
+}
+
+int AplicarClique(EstadoJogo* jogo, float x, float y) {
+    if (!jogo->jogoIniciado || jogo->jogoAcabou)
+        return -1;
+
+    // O clique só é testado contra os buracos da célula da grade onde ele caiu (no máximo uns poucos).
+    const GradeEspacial* g = &jogo->grade;
+    if (x < g->origemX || y < g->origemY)
+        return Errou(jogo);
+    int coluna = (int)((x - g->origemX) / g->tamanhoCelula);
+    int linha = (int)((y - g->origemY) / g->tamanhoCelula);
+    if (coluna >= g->colunas || linha >= g->linhas)
+        return Errou(jogo);
+    int celula = linha * g->colunas + coluna;
+
+    Dificuldade dificuldade = jogo->dificuldade;
+    Capivaras* c = &jogo->capivaras;
+    for (int k = g->inicioCelula[celula]; k < g->inicioCelula[celula + 1]; k++) {
+        int i = g->buracosCelula[k];
+        // --- DETECÇÃO DE CLIQUE DO JOGADOR ---
+        // Verifica se a capivara está visível, ainda não foi acertada neste aparecimento,
+        // e se o clique foi em um pixel opaco do desenho dele.
+        if (!c->visivel[i] || c->hit[i] || !PontoNoAnimal(x, y, c->rect[i], c->tipo[i]))
+            continue;
+
+        c->hit[i] = true;       // Marca a capivara como acertada.
+        c->machucada[i] = true; // Inicia o estado de "atordoada"
+        jogo->capivarasVisiveis--;
+        AgendarEvento(jogo, i, jogo->tick + SegundosParaTicks(DURACAO_ATORDOADO)); // Agenda o fim do atordoamento.
+        if (jogo->telemetria != NULL) // O tempo de reação: do aparecimento até o clique.
+            RegistrarTelemetria(jogo->telemetria, EVENTO_ACERTO, jogo->tick, i, c->tipo[i], (int)(jogo->tick - c->tickSurgimento[i]));
+
+        // Lógica para adicionar ou subtrair pontos com base no tipo de animal acertado.
+        int pontosAntes = jogo->pontos;
+        switch(c->tipo[i]) {
+            case NORMAL:
+                jogo->pontos += 1; // Capivara normal: +1 ponto.
+            break;
+            case DOURADA:
+                jogo->pontos += 2; // Capivara dourada: +2 pontos.
+            break;
+            case CUTIA:
+                jogo->pontos += PENALIDADE_CUTIA[dificuldade]; // Cutia: perde pontos conforme a dificuldade.
+                if(jogo->pontos < 0) // Garante que a pontuação nunca seja negativa.
+                    jogo->pontos = 0;
+                if(dificuldade == DIFICIL){
+                    jogo->chovendo = true; // Ativa o estado de chuva.
+                    jogo->tickFimChuva = jogo->tick + SegundosParaTicks(DURACAO_CHUVA); // Define que a chuva durará 5 segundos.
+                    AtualizarTempos(jogo);
+                    if (jogo->telemetria != NULL)
+                        RegistrarTelemetria(jogo->telemetria, EVENTO_INICIO_CHUVA, jogo->tick, i, CUTIA, (int)SegundosParaTicks(DURACAO_CHUVA));
+                }
+            break;
+        }
+        if (jogo->totalAcertosRecentes < MAX_ACERTOS_RECENTES) {
+            // Na cutia, mostra a penalidade cheia mesmo quando a pontuação parou em zero.
+            int pontos = c->tipo[i] == CUTIA ? PENALIDADE_CUTIA[dificuldade] : jogo->pontos - pontosAntes;
+            jogo->acertosRecentes[jogo->totalAcertosRecentes++] = (AcertoJogo){ i, c->tipo[i], pontos, -1 };
+        }
+        return i;
+    }
+    return Errou(jogo);
+}
+
+void PassoJogo(EstadoJogo* jogo, double dt, const EntradaJogo* entrada) {
+    if (jogo->jogoAcabou)
+        return;
+
+    // Acumulador de passo fixo: simula só os ticks inteiros que cabem no tempo acumulado.
+    // O passo começa em (tickInicio + acumulador), então um clique em 'deslocamento' cai no tick
+    // tickInicio + (acumulador + deslocamento) * TICKS_POR_SEGUNDO, independente da taxa de quadros.
+    int64_t tickInicio = jogo->tick;
+    double inicio = jogo->acumulador;
+    if (entrada != NULL) {
+        for (int k = 0; k < entrada->totalCliques; k++) {
+            const CliqueJogo* clique = &entrada->cliques[k];
+            double deslocamento = clique->deslocamento < 0.0 ? 0.0 : (clique->deslocamento > dt ? dt : clique->deslocamento);
+            AvancarJogoAte(jogo, tickInicio + (int64_t)((inicio + deslocamento) * TICKS_POR_SEGUNDO));
+            if (jogo->gravacao != NULL) // Grava o clique com o tick em que ele foi aplicado.
+                GravarClique(jogo->gravacao, jogo->tick, clique->x, clique->y);
+            int acertosAntes = jogo->totalAcertosRecentes;
+            AplicarClique(jogo, clique->x, clique->y);
+            if (jogo->totalAcertosRecentes > acertosAntes) // A interface sabe quando o clique aconteceu (som, latência).
+                jogo->acertosRecentes[acertosAntes].clique = k;
+        }
+    }
+
+    int64_t ticks = (int64_t)((inicio + dt) * TICKS_POR_SEGUNDO);
+    jogo->acumulador = inicio + dt - ticks * PASSO_FIXO;
+    if (jogo->acumulador < 0.0) // Protege contra erro de arredondamento.
+        jogo->acumulador = 0.0;
+    AvancarJogoAte(jogo, tickInicio + ticks);
+}
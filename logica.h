@@ -0,0 +1,245 @@
+#ifndef LOGICA_H
+#define LOGICA_H
+
+#include <stdbool.h>
+#include <stddef.h> // size_t, usado no tamanho da arena da partida.
+#include <stdint.h> // Tipos inteiros de tamanho fixo, usados no estado do gerador de números aleatórios.
+
+// --- NÚCLEO DA LÓGICA DO JOGO ---
+// Este módulo contém toda a simulação de uma partida (contagem regressiva, tempo, chuva, aparecimento dos animais,
+// cliques e pontuação) sem depender da Raylib. Assim a lógica pode rodar sem janela (em testes, simulações ou
+// servidores) e ser avançada muito mais rápido do que a tela é atualizada.
+
+// ENUMS
+typedef enum Dificuldade {
+    FACIL,
+    MEDIO,
+    DIFICIL
+} Dificuldade;
+
+typedef enum TipoCapivara {
+    NORMAL,  // Capivara comum, dá pontos positivos.
+    DOURADA, // Capivara dourada, dá mais pontos.
+    CUTIA    // Cutia resulta em penalidade de pontos e ativa o efeito de chuva no modo dificil.
+} TipoCapivara;
+
+#define TOTAL_TIPOS_CAPIVARA 3
+
+// STRUCTS
+
+// Retângulo próprio do núcleo, com o mesmo formato do 'Rectangle' da Raylib, para não depender da biblioteca gráfica.
+typedef struct {
+    float x, y;            // Canto superior esquerdo.
+    float largura, altura; // Tamanho do retângulo.
+} Retangulo;
+
+// Todos os animais (um por buraco) em estrutura de arrays: cada campo fica em um array contínuo.
+// Os campos lidos a cada evento e clique (estado e tipo) ficam juntos e pequenos; a posição, usada só no
+// desenho e no teste de clique, fica separada. Assim tabuleiros com milhares de buracos cabem bem no cache.
+typedef struct {
+    // Dados quentes
+    bool* visivel;            // Indica se o animal está atualmente visível para ser clicado.
+    bool* hit;                // Indica se o animal foi clicado (acertado).
+    bool* machucada;          // Indica se o animal está no estado de "atordoado" após ser acertado.
+    uint8_t* tipo;            // O tipo específico do animal (TipoCapivara), para determinar a textura e a pontuação.
+    int64_t* tickEvento;      // Tick do próximo evento agendado deste buraco: aparecer (invisível), sumir (visível) ou acordar (machucada).
+    int64_t* tickSurgimento;  // Tick em que o animal apareceu. O tempo visível é calculado a partir dele, sem contador por frame.
+    // Dados frios
+    Retangulo* rect;          // Posição e tamanho do buraco na tela. Usado para desenho e detecção de colisão.
+} Capivaras;
+
+// Índice espacial em grade uniforme para o teste de clique. Cada célula guarda os buracos que a tocam, em
+// um único array (formato CSR). Um clique só olha a sua célula, então custa O(1) em qualquer tamanho de tabuleiro.
+typedef struct {
+    float origemX, origemY;  // Canto superior esquerdo da grade.
+    float tamanhoCelula;     // Lado de cada célula (quadrada).
+    int colunas, linhas;
+    int* inicioCelula;       // Buracos da célula c: buracosCelula[inicioCelula[c] .. inicioCelula[c + 1] - 1].
+    int* buracosCelula;
+    int totalEntradas;       // Tamanho de 'buracosCelula'.
+} GradeEspacial;
+
+// Parâmetros de uma nova partida.
+typedef struct {
+    Dificuldade dificuldade;
+    int totalBuracos;          // 0 usa CAPIVARAS_POR_DIFICULDADE; valores maiores montam uma grade que ocupa a tela.
+    float larguraTela, alturaTela;
+    uint64_t semente;          // Semente do gerador de números aleatórios da partida.
+} ConfiguracaoJogo;
+
+// Estado do gerador de números aleatórios (xorshift64*). Cada partida tem o seu, dentro do estado do jogo, e ele
+// é iniciado com a semente da configuração: a mesma semente e os mesmos cliques sempre produzem a mesma partida,
+// sem depender de 'rand()' ou do 'GetRandomValue()' da Raylib.
+typedef struct {
+    uint64_t estado; // Nunca pode ser zero.
+} GeradorAleatorio;
+
+// Um clique do jogador, com o momento em que aconteceu dentro do passo.
+typedef struct {
+    double deslocamento;  // Segundos desde o início do passo (0 a dt).
+    float x, y;           // Posição do clique na tela.
+} CliqueJogo;
+
+#define MAX_CLIQUES_PASSO 32 // Cliques aceitos por passo. Mesmo com cliques muito rápidos, um frame tem poucos.
+
+// Registro da entrada do jogador em um passo da simulação: todos os cliques do passo, em ordem de tempo.
+typedef struct {
+    int totalCliques;
+    CliqueJogo cliques[MAX_CLIQUES_PASSO];
+} EntradaJogo;
+
+// --- SIMULAÇÃO EM PASSO FIXO ---
+// A lógica avança sempre em ticks de duração fixa, independente da taxa de quadros. O tempo de cada frame
+// entra em um acumulador, e só ticks inteiros são simulados, então 30 Hz e 144 Hz jogam exatamente o mesmo jogo.
+#define TICKS_POR_SEGUNDO 120                    // Frequência da simulação.
+#define PASSO_FIXO (1.0 / TICKS_POR_SEGUNDO)     // Duração de um tick em segundos.
+
+// Um acerto aplicado pela lógica, guardado para a interface mostrar (faíscas e pontos na tela).
+typedef struct {
+    int buraco;     // Buraco acertado.
+    uint8_t tipo;   // TipoCapivara do animal acertado.
+    int pontos;     // Pontos do acerto (negativos na cutia).
+    int clique;     // Índice do clique na EntradaJogo do PassoJogo que acertou (-1 se veio de outro caminho).
+} AcertoJogo;
+
+#define MAX_ACERTOS_RECENTES 32 // Acertos guardados até a interface os ler; os seguintes são descartados.
+
+// Todo o estado de uma partida. Antes eram variáveis globais no JogoC.c.
+// Os arrays de todos os buracos (posições, estado, agenda e grade) ficam em uma arena: um bloco único que é
+// reaproveitado de uma partida para a outra e só cresce quando o tabuleiro fica maior. Reiniciar não aloca nada,
+// e a partida inteira é a struct mais os 'tamanhoMemoria' bytes da arena, copiáveis com dois memcpy.
+typedef struct {
+    Capivaras capivaras;             // Arrays com um slot por buraco.
+    void* memoria;                   // Arena da partida, com todos os arrays. Os ponteiros apontam para dentro dela.
+    size_t tamanhoMemoria;           // Bytes da arena usados nesta partida.
+    size_t capacidadeMemoria;        // Bytes alocados na arena.
+    int totalCapivaras;              // O número total de capivaras nesta partida.
+    int maxSimultaneas;              // Máximo de animais visíveis ao mesmo tempo, proporcional ao número de buracos.
+    GradeEspacial grade;             // Índice espacial para o teste de clique.
+    Dificuldade dificuldade;         // Dificuldade selecionada para a partida.
+    GeradorAleatorio gerador;        // Gerador de números aleatórios da partida (iniciado com a semente da configuração).
+    struct Gravacao* gravacao;       // Se não for NULL, cada clique aplicado pelo PassoJogo é gravado nela (gravacao.h).
+    struct Telemetria* telemetria;   // Se não for NULL, cada aparecimento, acerto, erro e chuva é registrado nela (telemetria.h).
+    double tempoRestanteJogo;        // Tempo restante da partida em segundos (derivado do tick atual, para exibição).
+    int pontos;                      // Pontuação atual do jogador.
+    bool jogoIniciado;               // true se o jogo começou após a contagem regressiva, false caso contrário.
+    bool jogoAcabou;                 // true se o tempo de jogo acabou, false caso contrário.
+    double contadorRegressivoInicial; // Contador para a contagem regressiva no início da partida (derivado do tick atual).
+    double tempoChuvaAtual;          // Tempo restante para o efeito de chuva (em segundos, derivado do tick atual).
+    bool chovendo;                   // true se o efeito de chuva está ativo, false caso contrário.
+
+    // Controle do tempo em ticks.
+    int64_t tick;                    // Tick atual da partida (0 = início da contagem regressiva).
+    double acumulador;               // Tempo de frame ainda não simulado (sempre menor que PASSO_FIXO).
+    int64_t tickInicioJogo;          // Tick em que a contagem regressiva termina.
+    int64_t tickFimJogo;             // Tick em que o tempo da partida acaba.
+    int64_t tickFimChuva;            // Tick em que a chuva atual termina.
+    int capivarasVisiveis;           // Animais visíveis e não atordoados, mantido a cada evento (sem varrer os buracos).
+
+    // Agenda de eventos: heap mínimo indexado com um evento por buraco, ordenado por (tickEvento, índice).
+    // Cada atualização só visita os buracos cujo evento venceu.
+    int* agenda;                     // Índices dos buracos em ordem de heap.
+    int* posicaoAgenda;              // Posição de cada buraco dentro de 'agenda'.
+    int tamanhoAgenda;               // Quantos buracos estão na agenda (0 antes do fim da contagem regressiva).
+
+    // Acertos desde a última leitura da interface, que zera 'totalAcertosRecentes'. Não afetam a simulação.
+    AcertoJogo acertosRecentes[MAX_ACERTOS_RECENTES];
+    int totalAcertosRecentes;
+} EstadoJogo;
+
+// Cópia de uma partida em um momento, para reiniciar, voltar no tempo na reprodução ou refazer a simulação.
+// Salvar e restaurar não alocam nada depois do primeiro uso: são uma cópia da struct e um memcpy da arena.
+typedef struct {
+    EstadoJogo estado;   // Cópia da struct (os ponteiros apontam para a arena original e são refeitos ao restaurar).
+    void* memoria;       // Cópia da arena.
+    size_t capacidade;   // Bytes alocados em 'memoria'.
+} InstantaneoJogo;
+
+// --- CONSTANTES DE DIFICULDADE ---
+// Estes arrays armazenam valores específicos para cada nível de dificuldade(FACIL = 0, MEDIO = 1, DIFICIL = 2).
+
+extern int CAPIVARAS_POR_DIFICULDADE[]; // Número total de posições para capivaras por dificuldade.
+extern int MAX_SIMULTANEAS_INICIAL[];   // Máximo de capivaras visíveis simultaneamente no início do jogo.
+extern float INTERVALO_MIN[];           // Intervalo mínimo de tempo para uma nova capivara aparecer.
+extern float INTERVALO_MAX[];           // Intervalo máximo de tempo para uma nova capivara aparecer.
+extern float TEMPO_VISIVEL_MIN[];       // Tempo mínimo que uma capivara permanece visível.
+extern float TEMPO_VISIVEL_MAX[];       // Tempo máximo que uma capivara permanece visível.
+extern int PENALIDADE_CUTIA[];          // Pontos perdidos ao acertar uma cutia, por dificuldade.
+extern int CHANCE_CUTIA[];              // Chance (em %) de um aparecimento ser uma cutia.
+extern int CHANCE_DOURADA[];            // Chance (em %) de um aparecimento ser uma capivara dourada.
+
+// --- MÁSCARAS DE COLISÃO ---
+// Um clique só acerta um animal se cair em um pixel opaco do desenho dele: os cantos transparentes do buraco não
+// contam. A máscara de cada animal é o canal alfa do PNG reduzido a LADO_MASCARA x LADO_MASCARA bits, uma linha de
+// PALAVRAS_MASCARA inteiros de 64 bits por linha da imagem. As coordenadas são relativas ao desenho (de 0 a 1 nos
+// dois eixos), então a mesma máscara vale para qualquer tamanho de buraco. As máscaras são geradas a partir dos
+// PNGs pelo empacotar_assets (--mascaras mascaras.c) e compiladas com a lógica, para a reprodução e o versus
+// acertarem os mesmos animais sem carregar imagens.
+#define LADO_MASCARA 128
+#define PALAVRAS_MASCARA (LADO_MASCARA / 64)
+
+typedef struct {
+    uint64_t bits[TOTAL_TIPOS_CAPIVARA][LADO_MASCARA][PALAVRAS_MASCARA]; // Bit x da linha y: o ponto (x, y) é opaco.
+} MascarasColisao;
+
+extern const MascarasColisao MASCARAS_COLISAO;              // Gerada em mascaras.c.
+extern const float ESCALA_DESENHO[TOTAL_TIPOS_CAPIVARA];    // Tamanho do desenho de cada animal em relação ao buraco (centralizado).
+
+// Monta a máscara de um animal a partir de pixels RGBA de 8 bits: cada bit é opaco se o pixel no centro da sua
+// área tiver alfa de 128 ou mais.
+void MontarMascaraColisao(uint64_t mascara[LADO_MASCARA][PALAVRAS_MASCARA], const uint8_t* pixels, int largura, int altura);
+
+// Retângulo em que o animal do tipo 'tipo' é desenhado dentro do buraco 'buraco'.
+Retangulo RetanguloDesenho(Retangulo buraco, int tipo);
+
+// --- FUNÇÕES ---
+
+// Inicializa o gerador com uma semente. A mesma semente sempre produz a mesma sequência.
+void IniciarGerador(GeradorAleatorio* gerador, uint64_t semente);
+
+// Sorteia um inteiro entre 'min' e 'max' (inclusive), como o GetRandomValue da Raylib.
+int SortearValor(GeradorAleatorio* gerador, int min, int max);
+
+// Prepara uma nova partida. O tamanho da tela é usado para posicionar os buracos. Retorna false se faltar memória
+// para a arena; nesse caso a partida fica sem buracos e a arena anterior continua alocada.
+bool InicializarEstadoJogo(EstadoJogo* jogo, const ConfiguracaoJogo* configuracao);
+
+// Libera a arena da partida. Só é preciso ao sair: uma nova partida reaproveita a arena da anterior.
+void LiberarEstadoJogo(EstadoJogo* jogo);
+
+// Salva a partida no instantâneo, que só aloca memória quando a arena da partida é maior que a dele. Retorna false,
+// sem mexer no instantâneo, se faltar memória.
+bool SalvarInstantaneo(const EstadoJogo* jogo, InstantaneoJogo* instantaneo);
+
+// Volta a partida ao momento do instantâneo, que pode ter vindo de outro EstadoJogo. A gravação ligada à partida
+// continua a mesma, e os acertos recentes são descartados (já foram mostrados). Retorna false, sem mexer na
+// partida, se faltar memória para a arena.
+bool RestaurarInstantaneo(EstadoJogo* jogo, const InstantaneoJogo* instantaneo);
+void LiberarInstantaneo(InstantaneoJogo* instantaneo);
+
+// Monta em 'vista' uma partida que lê direto do instantâneo, sem copiar a arena: os ponteiros apontam para a
+// memória do instantâneo. Só serve para leitura (desenho), enquanto o instantâneo não mudar.
+void VerInstantaneo(const InstantaneoJogo* instantaneo, EstadoJogo* vista);
+
+// Recomeça a partida a partir de 'inicio', salvo logo depois de InicializarEstadoJogo, com outra semente: o mesmo
+// resultado de InicializarEstadoJogo com a mesma configuração e 'semente', sem posicionar os buracos nem montar a
+// grade de novo. Retorna false, como RestaurarInstantaneo, se faltar memória.
+bool RecomecarEstadoJogo(EstadoJogo* jogo, const InstantaneoJogo* inicio, uint64_t semente);
+
+// Avança a simulação em 'dt' segundos de frame: o tempo entra no acumulador e só ticks inteiros são simulados.
+// Cada clique da entrada é aplicado no tick em que aconteceu, contra o estado daquele momento, e não no fim do
+// frame; dois cliques no mesmo frame contam separadamente. Não lê nada de fora dos parâmetros.
+void PassoJogo(EstadoJogo* jogo, double dt, const EntradaJogo* entrada);
+
+// Avança a simulação até o tick 'tickAlvo', processando só os eventos que vencem no caminho.
+// Simulações sem tela podem pular direto para o fim da partida com uma única chamada.
+void AvancarJogoAte(EstadoJogo* jogo, int64_t tickAlvo);
+
+// Tick do próximo evento agendado (o fim da contagem regressiva, um aparecimento, um desaparecimento ou o fim de
+// um atordoamento), ou o tick do fim da partida se não houver nenhum antes dele. Até lá, nada muda sem um clique.
+int64_t ProximoEventoJogo(const EstadoJogo* jogo);
+
+// Aplica um clique em (x, y) no tick atual. Retorna o índice do animal acertado, ou -1 se o clique não acertou nada.
+int AplicarClique(EstadoJogo* jogo, float x, float y);
+
+#endif
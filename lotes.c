@@ -0,0 +1,55 @@
+#include "lotes.h"
+
+static EstatisticasLotes quadroAtual;    // Contadores do frame sendo desenhado.
+static EstatisticasLotes quadroAnterior; // Contadores do último frame completo, usados na exibição.
+static unsigned int texturaAtual;        // Textura do último desenho (0 = nenhuma ainda neste frame).
+
+void IniciarQuadroLotes(void) {
+    quadroAnterior = quadroAtual;
+    quadroAtual = (EstatisticasLotes){0, 0, 0};
+    texturaAtual = 0;
+}
+
+EstatisticasLotes ObterEstatisticasLotes(void) {
+    return quadroAnterior;
+}
+
+// Registra um desenho com a textura 'id' e conta a troca se ela for diferente da anterior.
+static void ContarDesenho(unsigned int id) {
+    quadroAtual.chamadas++;
+    if (id != texturaAtual) {
+        quadroAtual.trocasTextura++;
+        texturaAtual = id;
+    }
+}
+
+void ContarDesenhoLote(unsigned int textura) {
+    ContarDesenho(textura);
+}
+
+void ContarLayoutTextoLote(void) {
+    quadroAtual.layoutsTexto++;
+}
+
+void DesenharTexturaLote(Texture2D textura, Rectangle origem, Rectangle destino, Color cor) {
+    ContarDesenho(textura.id);
+    DrawTexturePro(textura, origem, destino, (Vector2){0, 0}, 0.0f, cor);
+}
+
+void DesenharTextoLote(const char* texto, int x, int y, int tamanho, Color cor) {
+    ContarDesenho(GetFontDefault().texture.id); // O texto usa a textura da fonte padrão.
+    DrawText(texto, x, y, tamanho, cor);
+}
+
+void DesenharRetanguloLote(Rectangle rect, Color cor) {
+    ContarDesenho(GetShapesTexture().id); // Por padrão as formas usam um pixel branco da textura da fonte, então não quebram o lote do texto.
+    DrawRectangleRec(rect, cor);
+}
+
+void DesenharEstatisticasLotes(int x, int y) {
+    // Desenhado direto com a Raylib para não entrar na própria contagem.
+    DrawRectangle(x, y, 300, 72, Fade(BLACK, 0.6f));
+    DrawText(TextFormat("Chamadas de desenho: %d", quadroAnterior.chamadas), x + 10, y + 6, 18, WHITE);
+    DrawText(TextFormat("Trocas de textura: %d", quadroAnterior.trocasTextura), x + 10, y + 28, 18, WHITE);
+    DrawText(TextFormat("Layouts de texto: %d", quadroAnterior.layoutsTexto), x + 10, y + 50, 18, WHITE);
+}
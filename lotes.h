@@ -0,0 +1,36 @@
+#ifndef LOTES_H
+#define LOTES_H
+
+#include "raylib.h"
+
+// --- CONTADOR DE CHAMADAS DE DESENHO E TROCAS DE TEXTURA ---
+// A Raylib junta desenhos seguidos que usam a mesma textura em um único lote. Toda vez que a textura muda,
+// o lote atual é enviado para a GPU e um novo começa. Estas funções desenham normalmente, mas contam quantas
+// chamadas foram feitas e quantas vezes a textura mudou no frame, para mostrar o efeito do atlas.
+
+typedef struct {
+    int chamadas;        // Chamadas de desenho feitas no frame.
+    int trocasTextura;   // Quantas vezes a textura mudou (cada troca quebra o lote da Raylib).
+    int layoutsTexto;    // Textos que tiveram o layout refeito no frame (texto.c); 0 na maioria dos frames.
+} EstatisticasLotes;
+
+// Zera os contadores. Deve ser chamada logo depois do BeginDrawing.
+void IniciarQuadroLotes(void);
+
+// Retorna os contadores do frame anterior (o frame atual ainda está sendo montado).
+EstatisticasLotes ObterEstatisticasLotes(void);
+
+// Versões contadas das funções de desenho da Raylib.
+void DesenharTexturaLote(Texture2D textura, Rectangle origem, Rectangle destino, Color cor);
+void DesenharTextoLote(const char* texto, int x, int y, int tamanho, Color cor);
+void DesenharRetanguloLote(Rectangle rect, Color cor);
+
+// Registra um desenho feito direto pela rlgl com a textura 'textura' (texto em cache).
+void ContarDesenhoLote(unsigned int textura);
+// Registra um layout de texto refeito.
+void ContarLayoutTextoLote(void);
+
+// Mostra os contadores do frame anterior no canto da tela.
+void DesenharEstatisticasLotes(int x, int y);
+
+#endif
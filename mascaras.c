@@ -0,0 +1,396 @@
+// Gerado pelo empacotar_assets --mascaras. Não editar.
+// Máscaras de colisão dos animais (logica.h), uma linha de bits por linha da máscara.
+#include "logica.h"
+
+const MascarasColisao MASCARAS_COLISAO = { {
+    { // capivaraNormal.png
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0003f80000000000ull, 0x000000000ff80000ull},
+        {0x0003f80000000000ull, 0x000000000ff80000ull},
+        {0x0003f80000000000ull, 0x000000000ff80000ull},
+        {0x0003f80000000000ull, 0x000000000ff80000ull},
+        {0x003ff80000000000ull, 0x000000000fff0000ull},
+        {0x003ff80000000000ull, 0x000000000fff0000ull},
+        {0x003ff80000000000ull, 0x000000000fff0000ull},
+        {0xfffff80000000000ull, 0x000000000fffffffull},
+        {0xfffff80000000000ull, 0x000000000fffffffull},
+        {0xfffff80000000000ull, 0x000000000fffffffull},
+        {0xfffff80000000000ull, 0x000000000fffffffull},
+        {0xffffff8000000000ull, 0x0000000000ffffffull},
+        {0xffffff8000000000ull, 0x0000000000ffffffull},
+        {0xffffff8000000000ull, 0x0000000000ffffffull},
+        {0xfffffff000000000ull, 0x0000000000ffffffull},
+        {0xfffffff000000000ull, 0x0000000000ffffffull},
+        {0xfffffff000000000ull, 0x0000000000ffffffull},
+        {0xfffffff000000000ull, 0x0000000000ffffffull},
+        {0xffffffff00000000ull, 0x000000000fffffffull},
+        {0xffffffff00000000ull, 0x000000000fffffffull},
+        {0xffffffff00000000ull, 0x000000000fffffffull},
+        {0xffffffffe0000000ull, 0x000000000fffffffull},
+        {0xffffffffe0000000ull, 0x000000000fffffffull},
+        {0xffffffffe0000000ull, 0x000000000fffffffull},
+        {0xffffffffe0000000ull, 0x000000000fffffffull},
+        {0xfffffffffe000000ull, 0x000000007fffffffull},
+        {0xfffffffffe000000ull, 0x000000007fffffffull},
+        {0xfffffffffe000000ull, 0x000000007fffffffull},
+        {0xfffffffffe000000ull, 0x000000007fffffffull},
+        {0xffffffffffe00000ull, 0x000000007fffffffull},
+        {0xffffffffffe00000ull, 0x000000007fffffffull},
+        {0xffffffffffe00000ull, 0x000000007fffffffull},
+        {0xffffffffffe00000ull, 0x00000007ffffffffull},
+        {0xffffffffffe00000ull, 0x00000007ffffffffull},
+        {0xffffffffffe00000ull, 0x00000007ffffffffull},
+        {0xffffffffffe00000ull, 0x00000007ffffffffull},
+        {0xffffffffffe00000ull, 0x00000007ffffffffull},
+        {0xffffffffffe00000ull, 0x00000007ffffffffull},
+        {0xffffffffffe00000ull, 0x00000007ffffffffull},
+        {0xffffffffffe00000ull, 0x00000007ffffffffull},
+        {0xffffffffffe00000ull, 0x0000003fffffffffull},
+        {0xffffffffffe00000ull, 0x0000003fffffffffull},
+        {0xffffffffffe00000ull, 0x0000003fffffffffull},
+        {0xffffffffffe00000ull, 0x0000003fffffffffull},
+        {0xffffffffffe00000ull, 0x0000003fffffffffull},
+        {0xffffffffffe00000ull, 0x0000003fffffffffull},
+        {0xffffffffffe00000ull, 0x0000003fffffffffull},
+        {0xffffffffffe00000ull, 0x000003ffffffffffull},
+        {0xffffffffffe00000ull, 0x000003ffffffffffull},
+        {0xffffffffffe00000ull, 0x000003ffffffffffull},
+        {0xfffffffffe000000ull, 0x000003ffffffffffull},
+        {0xfffffffffe000000ull, 0x000003ffffffffffull},
+        {0xfffffffffe000000ull, 0x000003ffffffffffull},
+        {0xfffffffffe000000ull, 0x000003ffffffffffull},
+        {0xffffffffe0000000ull, 0x000003ffffffffffull},
+        {0xffffffffe0000000ull, 0x000003ffffffffffull},
+        {0xffffffffe0000000ull, 0x000003ffffffffffull},
+        {0xffffff8000000000ull, 0x000003ffffffffffull},
+        {0xffffff8000000000ull, 0x000003ffffffffffull},
+        {0xffffff8000000000ull, 0x000003ffffffffffull},
+        {0xffffff8000000000ull, 0x000003ffffffffffull},
+        {0xfffff80000000000ull, 0x0000003fffffffffull},
+        {0xfffff80000000000ull, 0x0000003fffffffffull},
+        {0xfffff80000000000ull, 0x0000003fffffffffull},
+        {0xffffff8000000000ull, 0x00000007ffffffffull},
+        {0xffffff8000000000ull, 0x00000007ffffffffull},
+        {0xffffff8000000000ull, 0x00000007ffffffffull},
+        {0xffffff8000000000ull, 0x00000007ffffffffull},
+        {0xffffff8000000000ull, 0x000000007fffffffull},
+        {0xffffff8000000000ull, 0x000000007fffffffull},
+        {0xffffff8000000000ull, 0x000000007fffffffull},
+        {0xfffff80000000000ull, 0x000000000fffffffull},
+        {0xfffff80000000000ull, 0x000000000fffffffull},
+        {0xfffff80000000000ull, 0x000000000fffffffull},
+        {0xfffff80000000000ull, 0x000000000fffffffull},
+        {0xfffc000000000000ull, 0x000000000007ffffull},
+        {0xfffc000000000000ull, 0x000000000007ffffull},
+        {0xfffc000000000000ull, 0x000000000007ffffull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+    },
+    { // capivaraDourada.png
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0003f80000000000ull, 0x0000000003fe0000ull},
+        {0x0003f80000000000ull, 0x0000000003fe0000ull},
+        {0x0003f80000000000ull, 0x0000000003fe0000ull},
+        {0x003ff80000000000ull, 0x0000000003ffc000ull},
+        {0x003ff80000000000ull, 0x0000000003ffc000ull},
+        {0x003ff80000000000ull, 0x0000000003ffc000ull},
+        {0x003ff80000000000ull, 0x0000000003ffc000ull},
+        {0xfffff80000000000ull, 0x0000000003ffffffull},
+        {0xfffff80000000000ull, 0x0000000003ffffffull},
+        {0xfffff80000000000ull, 0x0000000003ffffffull},
+        {0xffffff0000000000ull, 0x00000000007fffffull},
+        {0xffffff0000000000ull, 0x00000000007fffffull},
+        {0xffffff0000000000ull, 0x00000000007fffffull},
+        {0xffffffe000000000ull, 0x00000000007fffffull},
+        {0xffffffe000000000ull, 0x00000000007fffffull},
+        {0xffffffe000000000ull, 0x00000000007fffffull},
+        {0xffffffe000000000ull, 0x00000000007fffffull},
+        {0xfffffffc00000000ull, 0x0000000003ffffffull},
+        {0xfffffffc00000000ull, 0x0000000003ffffffull},
+        {0xfffffffc00000000ull, 0x0000000003ffffffull},
+        {0xffffffffc0000000ull, 0x0000000003ffffffull},
+        {0xffffffffc0000000ull, 0x0000000003ffffffull},
+        {0xffffffffc0000000ull, 0x0000000003ffffffull},
+        {0xfffffffff8000000ull, 0x000000001fffffffull},
+        {0xfffffffff8000000ull, 0x000000001fffffffull},
+        {0xfffffffff8000000ull, 0x000000001fffffffull},
+        {0xfffffffff8000000ull, 0x000000001fffffffull},
+        {0xffffffffff000000ull, 0x000000001fffffffull},
+        {0xffffffffff000000ull, 0x000000001fffffffull},
+        {0xffffffffff000000ull, 0x000000001fffffffull},
+        {0xffffffffff000000ull, 0x00000001ffffffffull},
+        {0xffffffffff000000ull, 0x00000001ffffffffull},
+        {0xffffffffff000000ull, 0x00000001ffffffffull},
+        {0xffffffffff000000ull, 0x00000001ffffffffull},
+        {0xffffffffff000000ull, 0x00000001ffffffffull},
+        {0xffffffffff000000ull, 0x00000001ffffffffull},
+        {0xffffffffff000000ull, 0x00000001ffffffffull},
+        {0xffffffffff000000ull, 0x0000000fffffffffull},
+        {0xffffffffff000000ull, 0x0000000fffffffffull},
+        {0xffffffffff000000ull, 0x0000000fffffffffull},
+        {0xffffffffff000000ull, 0x0000000fffffffffull},
+        {0xffffffffff000000ull, 0x0000000fffffffffull},
+        {0xffffffffff000000ull, 0x0000000fffffffffull},
+        {0xffffffffff000000ull, 0x0000000fffffffffull},
+        {0xffffffffff000000ull, 0x0000007fffffffffull},
+        {0xffffffffff000000ull, 0x0000007fffffffffull},
+        {0xffffffffff000000ull, 0x0000007fffffffffull},
+        {0xfffffffff8000000ull, 0x0000007fffffffffull},
+        {0xfffffffff8000000ull, 0x0000007fffffffffull},
+        {0xfffffffff8000000ull, 0x0000007fffffffffull},
+        {0xffffffffc0000000ull, 0x0000007fffffffffull},
+        {0xffffffffc0000000ull, 0x0000007fffffffffull},
+        {0xffffffffc0000000ull, 0x0000007fffffffffull},
+        {0xffffffffc0000000ull, 0x0000007fffffffffull},
+        {0xffffff0000000000ull, 0x0000007fffffffffull},
+        {0xffffff0000000000ull, 0x0000007fffffffffull},
+        {0xffffff0000000000ull, 0x0000007fffffffffull},
+        {0xfffff80000000000ull, 0x0000000fffffffffull},
+        {0xfffff80000000000ull, 0x0000000fffffffffull},
+        {0xfffff80000000000ull, 0x0000000fffffffffull},
+        {0xffffff0000000000ull, 0x00000001ffffffffull},
+        {0xffffff0000000000ull, 0x00000001ffffffffull},
+        {0xffffff0000000000ull, 0x00000001ffffffffull},
+        {0xffffff0000000000ull, 0x00000001ffffffffull},
+        {0xffffff0000000000ull, 0x000000001fffffffull},
+        {0xffffff0000000000ull, 0x000000001fffffffull},
+        {0xffffff0000000000ull, 0x000000001fffffffull},
+        {0xfffff80000000000ull, 0x0000000003ffffffull},
+        {0xfffff80000000000ull, 0x0000000003ffffffull},
+        {0xfffff80000000000ull, 0x0000000003ffffffull},
+        {0xfffff80000000000ull, 0x0000000003ffffffull},
+        {0xfffc000000000000ull, 0x000000000001ffffull},
+        {0xfffc000000000000ull, 0x000000000001ffffull},
+        {0xfffc000000000000ull, 0x000000000001ffffull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+    },
+    { // cutiaJogo.png
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x00ff000000000000ull, 0x00000001ff000000ull},
+        {0x00ff000000000000ull, 0x00000001ff000000ull},
+        {0x00ff000000000000ull, 0x0000000fff000000ull},
+        {0x07ffe00000000000ull, 0x0000000fffe00000ull},
+        {0x07ffe00000000000ull, 0x0000000fffe00000ull},
+        {0x07ffe00000000000ull, 0x0000000fffe00000ull},
+        {0xffffe00000000000ull, 0x0000001fffffffffull},
+        {0xffffe00000000000ull, 0x0000001fffffffffull},
+        {0xffffe00000000000ull, 0x0000001fffffffffull},
+        {0xffffe00000000000ull, 0x0000001fffffffffull},
+        {0xffffe00000000000ull, 0x0000001fffffffffull},
+        {0xffffe00000000000ull, 0x0000001fffffffffull},
+        {0xffffff0000000000ull, 0x0000001fffffffffull},
+        {0xffffff0000000000ull, 0x0000001fffffffffull},
+        {0xffffffe000000000ull, 0x0000001fffffffffull},
+        {0xffffffe000000000ull, 0x0000001fffffffffull},
+        {0xffffffe000000000ull, 0x0000001fffffffffull},
+        {0xffffffe000000000ull, 0x00000003ffffffffull},
+        {0xfffffffc00000000ull, 0x00000003ffffffffull},
+        {0xfffffffc00000000ull, 0x00000003ffffffffull},
+        {0xffffffff80000000ull, 0x00000003ffffffffull},
+        {0xffffffff80000000ull, 0x00000003ffffffffull},
+        {0xffffffff80000000ull, 0x00000003ffffffffull},
+        {0xfffffffff0000000ull, 0x00000003ffffffffull},
+        {0xfffffffff0000000ull, 0x00000003ffffffffull},
+        {0xfffffffff0000000ull, 0x00000003ffffffffull},
+        {0xfffffffffe000000ull, 0x0000001fffffffffull},
+        {0xfffffffffe000000ull, 0x0000001fffffffffull},
+        {0xfffffffffe000000ull, 0x0000001fffffffffull},
+        {0xffffffffffc00000ull, 0x0000001fffffffffull},
+        {0xffffffffffc00000ull, 0x0000001fffffffffull},
+        {0xffffffffffc00000ull, 0x0000001fffffffffull},
+        {0xfffffffffff80000ull, 0x0000007fffffffffull},
+        {0xfffffffffff80000ull, 0x0000007fffffffffull},
+        {0xfffffffffff80000ull, 0x0000007fffffffffull},
+        {0xfffffffffff80000ull, 0x0000007fffffffffull},
+        {0xfffffffffff80000ull, 0x0000007fffffffffull},
+        {0xfffffffffff80000ull, 0x0000007fffffffffull},
+        {0xfffffffffff80000ull, 0x000003ffffffffffull},
+        {0xfffffffffff80000ull, 0x000003ffffffffffull},
+        {0xfffffffffff80000ull, 0x000003ffffffffffull},
+        {0xfffffffffff80000ull, 0x000003ffffffffffull},
+        {0xfffffffffff80000ull, 0x000003ffffffffffull},
+        {0xfffffffffff80000ull, 0x000003ffffffffffull},
+        {0xfffffffffff80000ull, 0x00001fffffffffffull},
+        {0xfffffffffff80000ull, 0x00001fffffffffffull},
+        {0xfffffffffff80000ull, 0x00001fffffffffffull},
+        {0xfffffffffff80000ull, 0x00001fffffffffffull},
+        {0xfffffffffff80000ull, 0x00001fffffffffffull},
+        {0xfffffffffff80000ull, 0x00001fffffffffffull},
+        {0xfffffffffff80000ull, 0x0000ffffffffffffull},
+        {0xfffffffffff80000ull, 0x0000ffffffffffffull},
+        {0xfffffffffff80000ull, 0x0000ffffffffffffull},
+        {0xfffffffffff80000ull, 0x0000ffffffffffffull},
+        {0xfffffffffff80000ull, 0x0000ffffffffffffull},
+        {0xfffffffffff80000ull, 0x0000ffffffffffffull},
+        {0xfffffffffff80000ull, 0x0000ffffffffffffull},
+        {0xfffffffffff80000ull, 0x0000ffffffffffffull},
+        {0xffffffffffc00000ull, 0x0000ffffffffffffull},
+        {0xffffffffffc00000ull, 0x0000ffffffffffffull},
+        {0xffffffffffc00000ull, 0x0000ffffffffffffull},
+        {0xfffffffffe000000ull, 0x0000ffffffffffffull},
+        {0xfffffffffe000000ull, 0x0000ffffffffffffull},
+        {0xfffffffffe000000ull, 0x0000ffffffffffffull},
+        {0xfffffffff0000000ull, 0x0000ffffffffffffull},
+        {0xfffffffff0000000ull, 0x0000ffffffffffffull},
+        {0xfffffffff0000000ull, 0x0000ffffffffffffull},
+        {0xfffffffc00000000ull, 0x00001fffffffffffull},
+        {0xfffffffc00000000ull, 0x00001fffffffffffull},
+        {0xfffffffc00000000ull, 0x00001fffffffffffull},
+        {0xfffffc0000000000ull, 0x000003ffffffffffull},
+        {0xfffffc0000000000ull, 0x000003ffffffffffull},
+        {0xfffffc0000000000ull, 0x000003ffffffffffull},
+        {0xfffffc0000000000ull, 0x0000007fffffffffull},
+        {0xfffffc0000000000ull, 0x0000007fffffffffull},
+        {0xfffffc0000000000ull, 0x0000007fffffffffull},
+        {0xfffffc0000000000ull, 0x0000000fffffffffull},
+        {0xfffff80000000000ull, 0x0000000fffffffffull},
+        {0xfffff80000000000ull, 0x0000000fffffffffull},
+        {0xffffe00000000000ull, 0x000000003fffffffull},
+        {0xffffe00000000000ull, 0x000000003fffffffull},
+        {0xffffe00000000000ull, 0x000000003fffffffull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+        {0x0000000000000000ull, 0x0000000000000000ull},
+    },
+} };
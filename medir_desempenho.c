@@ -0,0 +1,392 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime.
+#include "logica.h"
+#include "pacote.h"
+#include "telemetria.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// --- MICROBENCHMARKS DO JOGO ---
+// Mede os caminhos quentes de um frame sem abrir janela, em tabuleiros de vários tamanhos:
+//   passo          PassoJogo de um frame a 60 Hz (aparecimento, sumiço e chuva), ao longo de partidas inteiras
+//   clique         AplicarClique em posições aleatórias no meio da partida (grade espacial + máscara de colisão)
+//   hud_formatar   montar as strings do HUD (tempo e pontos) em todo frame, como sem o cache de texto
+//   hud_cache      o mesmo, montando só quando o segundo ou a pontuação mudam, como o TextoPrecisaAtualizar
+//   pacote         abrir um pacote de recursos e copiar todas as texturas (o que o envio para a GPU lê)
+//   telemetria     registrar um evento no anel da telemetria (o custo que a lógica paga por evento)
+// Não depende da Raylib.
+//
+// Cada medida é repetida RODADAS vezes e vale a mais rápida, que é a menos sujeita a interrupções do sistema. O
+// resultado sai em uma tabela e, com --csv, em CSV. Com --comparar, o resultado é comparado com um CSV anterior
+// e o código de saída é 1 se alguma medida ficou mais lenta que a tolerância: serve para pegar uma regressão
+// antes de ela chegar ao jogo.
+//
+// Uso: medir_desempenho [--csv arquivo] [--comparar base.csv] [--tolerancia %] [--buracos N ...] [--pacote arquivo]
+//   --buracos     mede só os tamanhos dados (pode repetir); o padrão é 5, 50, 500 e 5000
+//   --tolerancia  quanto uma medida pode ficar mais lenta que a base antes de contar como regressão (padrão 10%)
+//   --pacote      mede também um pacote de verdade (por exemplo barigueira.pak), além dos sintéticos
+
+#define MAX_TAMANHOS 32
+#define MAX_RESULTADOS 64
+#define RODADAS 5            // Repetições de cada medida; vale a mais rápida.
+#define TEMPO_RODADA 0.1     // Segundos de repetição por rodada, para o relógio não dominar nas medidas curtas.
+#define LADO_TEXTURA 1024    // Texturas dos pacotes sintéticos: 1024x1024 RGBA (4 MB cada).
+#define ARQUIVO_PACOTE_SINTETICO "medir_desempenho.pak"
+
+static volatile unsigned sumidouro; // Resultados que o compilador não pode descartar.
+
+static double Agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+typedef struct {
+    char medida[24];
+    int tamanho;         // Buracos, texturas do pacote ou 0 quando não se aplica.
+    double ns;           // Tempo de uma operação, em nanossegundos (a melhor rodada).
+    long operacoes;      // Operações na melhor rodada.
+} Resultado;
+
+// Uma medida: executa 'quantas' operações e retorna o tempo gasto só nelas, em segundos (a preparação entre
+// blocos, como restaurar a partida, fica de fora).
+typedef double (*FuncaoMedida)(void* contexto, long quantas);
+
+static Resultado Medir(const char* nome, int tamanho, FuncaoMedida funcao, void* contexto, long bloco) {
+    Resultado r = {0};
+    snprintf(r.medida, sizeof(r.medida), "%s", nome);
+    r.tamanho = tamanho;
+    r.ns = -1.0;
+    for (int rodada = 0; rodada < RODADAS; rodada++) {
+        long vezes = 0;
+        double tempo = 0.0;
+        do {
+            tempo += funcao(contexto, bloco);
+            vezes += bloco;
+        } while (tempo < TEMPO_RODADA);
+        double ns = tempo * 1e9 / vezes;
+        if (r.ns < 0.0 || ns < r.ns) {
+            r.ns = ns;
+            r.operacoes = vezes;
+        }
+    }
+    return r;
+}
+
+// --- Partida ---
+
+typedef struct {
+    EstadoJogo jogo;
+    InstantaneoJogo inicio;   // Partida logo depois de montada, para recomeçar quando ela acaba.
+    InstantaneoJogo meio;     // Partida no meio, com animais visíveis, para os cliques.
+    GeradorAleatorio gerador; // Posições dos cliques.
+} ContextoPartida;
+
+static double MedirPasso(void* contexto, long quantas) {
+    ContextoPartida* c = (ContextoPartida*)contexto;
+    EntradaJogo entrada = {0};
+    double tempo = 0.0;
+    long feitas = 0;
+    while (feitas < quantas) {
+        if (c->jogo.jogoAcabou)
+            RestaurarInstantaneo(&c->jogo, &c->inicio);
+        double inicio = Agora();
+        for (; feitas < quantas && !c->jogo.jogoAcabou; feitas++)
+            PassoJogo(&c->jogo, 1.0 / 60.0, &entrada);
+        tempo += Agora() - inicio;
+    }
+    return tempo;
+}
+
+static double MedirClique(void* contexto, long quantas) {
+    ContextoPartida* c = (ContextoPartida*)contexto;
+    // Os acertos mudam a partida: cada bloco começa do mesmo meio de partida.
+    RestaurarInstantaneo(&c->jogo, &c->meio);
+    float x[256], y[256];
+    long n = quantas < 256 ? quantas : 256;
+    for (long i = 0; i < n; i++) {
+        x[i] = (float)SortearValor(&c->gerador, 0, 1499);
+        y[i] = (float)SortearValor(&c->gerador, 0, 799);
+    }
+    int acertos = 0;
+    double inicio = Agora();
+    for (long i = 0; i < n; i++)
+        acertos += AplicarClique(&c->jogo, x[i], y[i]) >= 0;
+    double tempo = Agora() - inicio;
+    c->jogo.totalAcertosRecentes = 0;
+    sumidouro += acertos;
+    return tempo;
+}
+
+// --- Telemetria ---
+
+static double MedirTelemetria(void* contexto, long quantas) {
+    Telemetria* t = (Telemetria*)contexto;
+    // Faz o papel da thread da telemetria entre os blocos: o anel começa vazio e não enche (quantas <= capacidade).
+    t->leitura = t->escrita;
+    double inicio = Agora();
+    for (long i = 0; i < quantas; i++)
+        RegistrarTelemetria(t, EVENTO_ACERTO, i, (int)(i & 1023), NORMAL, (int)(i & 127));
+    return Agora() - inicio;
+}
+
+// --- HUD ---
+
+typedef struct {
+    bool cache;
+    int quadro;
+    int chaveTempo, chavePontos;   // Último valor formatado, como no TextoCacheado.
+    char tempo[32], pontos[32];
+} ContextoHud;
+
+static double MedirHud(void* contexto, long quantas) {
+    ContextoHud* c = (ContextoHud*)contexto;
+    double inicio = Agora();
+    for (long i = 0; i < quantas; i++, c->quadro++) {
+        // Uma partida de 60 s a 60 FPS, com um acerto a cada meio segundo.
+        int segundos = 60 - (c->quadro % 3600) / 60;
+        int pontos = (c->quadro % 3600) / 30;
+        if (!c->cache || segundos != c->chaveTempo) {
+            snprintf(c->tempo, sizeof(c->tempo), "Tempo: %02d:%02d", segundos / 60, segundos % 60);
+            c->chaveTempo = segundos;
+        }
+        if (!c->cache || pontos != c->chavePontos) {
+            snprintf(c->pontos, sizeof(c->pontos), "Pontos: %d", pontos);
+            c->chavePontos = pontos;
+        }
+        sumidouro += (unsigned char)c->tempo[8] + (unsigned char)c->pontos[8];
+    }
+    return Agora() - inicio;
+}
+
+// --- Pacote ---
+
+typedef struct {
+    const char* arquivo;
+    uint8_t* destino;         // Área de cópia, do tamanho da maior textura.
+    size_t tamanhoDestino;
+} ContextoPacote;
+
+// Abre o pacote, procura cada entrada pelo nome e copia os pixels, como o envio da textura para a GPU.
+static double MedirPacote(void* contexto, long quantas) {
+    ContextoPacote* c = (ContextoPacote*)contexto;
+    double inicio = Agora();
+    for (long i = 0; i < quantas; i++) {
+        Pacote pacote;
+        if (!AbrirPacote(&pacote, c->arquivo))
+            break;
+        for (uint32_t k = 0; k < pacote.totalEntradas; k++) {
+            const EntradaPacote* e = BuscarEntradaPacote(&pacote, pacote.entradas[k].nome);
+            size_t n = e->tamanho < c->tamanhoDestino ? (size_t)e->tamanho : c->tamanhoDestino;
+            memcpy(c->destino, DadosEntradaPacote(&pacote, e), n);
+        }
+        FecharPacote(&pacote);
+    }
+    return Agora() - inicio;
+}
+
+// Grava um pacote com 'texturas' texturas RGBA de LADO_TEXTURA x LADO_TEXTURA, no formato do empacotar_assets.
+static bool GravarPacoteSintetico(const char* arquivo, int texturas) {
+    FILE* f = fopen(arquivo, "wb");
+    if (f == NULL)
+        return false;
+    CabecalhoPacote cabecalho = { {'B', 'P', 'A', 'K'}, VERSAO_PACOTE, (uint32_t)texturas, 0 };
+    size_t tamanho = (size_t)LADO_TEXTURA * LADO_TEXTURA * 4;
+    size_t inicioDados = sizeof(CabecalhoPacote) + texturas * sizeof(EntradaPacote);
+    inicioDados = (inicioDados + ALINHAMENTO_PACOTE - 1) / ALINHAMENTO_PACOTE * ALINHAMENTO_PACOTE;
+    bool ok = fwrite(&cabecalho, sizeof(cabecalho), 1, f) == 1;
+    for (int i = 0; i < texturas && ok; i++) {
+        EntradaPacote e = {0};
+        snprintf(e.nome, sizeof(e.nome), "textura%d", i);
+        e.tipo = ENTRADA_TEXTURA;
+        e.largura = e.altura = LADO_TEXTURA;
+        e.formato = 7; // PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+        e.deslocamento = inicioDados + (uint64_t)i * tamanho;
+        e.tamanho = tamanho;
+        ok = fwrite(&e, sizeof(e), 1, f) == 1;
+    }
+    uint8_t* pixels = (uint8_t*)malloc(tamanho);
+    ok = ok && pixels != NULL && fseek(f, (long)inicioDados, SEEK_SET) == 0;
+    for (int i = 0; i < texturas && ok; i++) {
+        memset(pixels, 40 + i, tamanho);
+        ok = fwrite(pixels, 1, tamanho, f) == tamanho;
+    }
+    free(pixels);
+    return fclose(f) == 0 && ok;
+}
+
+// --- Comparação com uma base ---
+
+// Lê um CSV gravado por este programa. Retorna quantas medidas foram lidas.
+static int LerCsv(const char* arquivo, Resultado* resultados, int maximo) {
+    FILE* f = fopen(arquivo, "r");
+    if (f == NULL)
+        return -1;
+    char linha[256];
+    int total = 0;
+    if (fgets(linha, sizeof(linha), f) == NULL) { // Cabeçalho.
+        fclose(f);
+        return 0;
+    }
+    while (total < maximo && fgets(linha, sizeof(linha), f) != NULL) {
+        Resultado* r = &resultados[total];
+        if (sscanf(linha, "%23[^,],%d,%lf,%ld", r->medida, &r->tamanho, &r->ns, &r->operacoes) == 4)
+            total++;
+    }
+    fclose(f);
+    return total;
+}
+
+int main(int argc, char* argv[]) {
+    int tamanhos[MAX_TAMANHOS] = { 5, 50, 500, 5000 };
+    int totalTamanhos = 4;
+    bool tamanhosDados = false;
+    const char* arquivoCsv = NULL;
+    const char* arquivoBase = NULL;
+    const char* arquivoPacote = NULL;
+    double tolerancia = 10.0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            arquivoCsv = argv[++i];
+        } else if (strcmp(argv[i], "--comparar") == 0 && i + 1 < argc) {
+            arquivoBase = argv[++i];
+        } else if (strcmp(argv[i], "--tolerancia") == 0 && i + 1 < argc) {
+            tolerancia = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--pacote") == 0 && i + 1 < argc) {
+            arquivoPacote = argv[++i];
+        } else if (strcmp(argv[i], "--buracos") == 0 && i + 1 < argc) {
+            if (!tamanhosDados)
+                totalTamanhos = 0;
+            tamanhosDados = true;
+            if (totalTamanhos < MAX_TAMANHOS)
+                tamanhos[totalTamanhos++] = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "uso: %s [--csv arquivo] [--comparar base.csv] [--tolerancia %%] [--buracos N ...] [--pacote arquivo]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    static Resultado resultados[MAX_RESULTADOS];
+    int totalResultados = 0;
+    printf("%-14s %8s %14s %12s\n", "medida", "tamanho", "por operação", "operações");
+#define REGISTRAR(resultado) do { \
+        Resultado r_ = (resultado); \
+        printf("%-14s %8d %11.1f ns %12ld\n", r_.medida, r_.tamanho, r_.ns, r_.operacoes); \
+        fflush(stdout); \
+        if (totalResultados < MAX_RESULTADOS) \
+            resultados[totalResultados++] = r_; \
+    } while (0)
+
+    // Partidas no DIFICIL (com chuva), com a mesma semente em todas as execuções.
+    for (int t = 0; t < totalTamanhos; t++) {
+        if (tamanhos[t] < 1)
+            continue;
+        static ContextoPartida c;
+        ConfiguracaoJogo configuracao = { DIFICIL, tamanhos[t], 1500.0f, 800.0f, 20240601 };
+        bool ok = InicializarEstadoJogo(&c.jogo, &configuracao) && SalvarInstantaneo(&c.jogo, &c.inicio);
+        AvancarJogoAte(&c.jogo, c.jogo.tickInicioJogo + (c.jogo.tickFimJogo - c.jogo.tickInicioJogo) / 2);
+        if (!ok || !SalvarInstantaneo(&c.jogo, &c.meio)) {
+            fprintf(stderr, "sem memória para a partida com %d buracos\n", tamanhos[t]);
+            return 1;
+        }
+        RestaurarInstantaneo(&c.jogo, &c.inicio);
+        IniciarGerador(&c.gerador, 42);
+        REGISTRAR(Medir("passo", tamanhos[t], MedirPasso, &c, 1024));
+        REGISTRAR(Medir("clique", tamanhos[t], MedirClique, &c, 256));
+        LiberarInstantaneo(&c.inicio);
+        LiberarInstantaneo(&c.meio);
+        LiberarEstadoJogo(&c.jogo);
+        memset(&c, 0, sizeof(c));
+    }
+
+    static Telemetria telemetria;
+    if (IniciarTelemetria(&telemetria, NULL)) {
+        REGISTRAR(Medir("telemetria", 0, MedirTelemetria, &telemetria, CAPACIDADE_TELEMETRIA));
+        EncerrarTelemetria(&telemetria);
+    }
+
+    ContextoHud hud = { false, 0, -1, -1, "", "" };
+    REGISTRAR(Medir("hud_formatar", 0, MedirHud, &hud, 4096));
+    hud = (ContextoHud){ true, 0, -1, -1, "", "" };
+    REGISTRAR(Medir("hud_cache", 0, MedirHud, &hud, 4096));
+
+    // Pacotes sintéticos de 1, 4 e 16 texturas (4 a 64 MB), já no cache de disco do sistema: mede o mapeamento,
+    // a validação do índice, a busca por nome e a leitura dos pixels, não o disco.
+    ContextoPacote pacote = { ARQUIVO_PACOTE_SINTETICO, NULL, (size_t)LADO_TEXTURA * LADO_TEXTURA * 4 };
+    pacote.destino = (uint8_t*)malloc(pacote.tamanhoDestino);
+    static const int texturas[] = { 1, 4, 16 };
+    for (int i = 0; i < 3 && pacote.destino != NULL; i++) {
+        if (!GravarPacoteSintetico(ARQUIVO_PACOTE_SINTETICO, texturas[i])) {
+            fprintf(stderr, "não foi possível criar %s\n", ARQUIVO_PACOTE_SINTETICO);
+            break;
+        }
+        REGISTRAR(Medir("pacote", texturas[i], MedirPacote, &pacote, 1));
+    }
+    remove(ARQUIVO_PACOTE_SINTETICO);
+    if (arquivoPacote != NULL && pacote.destino != NULL) {
+        Pacote p;
+        if (AbrirPacote(&p, arquivoPacote)) {
+            int total = (int)p.totalEntradas;
+            size_t maior = 0;
+            for (uint32_t k = 0; k < p.totalEntradas; k++)
+                if (p.entradas[k].tamanho > maior)
+                    maior = (size_t)p.entradas[k].tamanho;
+            FecharPacote(&p);
+            if (maior > pacote.tamanhoDestino) {
+                free(pacote.destino);
+                pacote.destino = (uint8_t*)malloc(maior);
+                pacote.tamanhoDestino = maior;
+            }
+            pacote.arquivo = arquivoPacote;
+            if (pacote.destino != NULL)
+                REGISTRAR(Medir("pacote_real", total, MedirPacote, &pacote, 1));
+        } else {
+            fprintf(stderr, "não foi possível abrir o pacote %s\n", arquivoPacote);
+        }
+    }
+    free(pacote.destino);
+#undef REGISTRAR
+
+    if (arquivoCsv != NULL) {
+        FILE* csv = fopen(arquivoCsv, "w");
+        if (csv == NULL) {
+            fprintf(stderr, "não foi possível criar %s\n", arquivoCsv);
+            return 1;
+        }
+        fprintf(csv, "medida,tamanho,ns_por_operacao,operacoes\n");
+        for (int i = 0; i < totalResultados; i++)
+            fprintf(csv, "%s,%d,%.1f,%ld\n", resultados[i].medida, resultados[i].tamanho, resultados[i].ns, resultados[i].operacoes);
+        fclose(csv);
+    }
+
+    // Comparação: só as medidas que existem nas duas execuções.
+    if (arquivoBase != NULL) {
+        static Resultado base[MAX_RESULTADOS];
+        int totalBase = LerCsv(arquivoBase, base, MAX_RESULTADOS);
+        if (totalBase < 0) {
+            fprintf(stderr, "não foi possível ler %s\n", arquivoBase);
+            return 1;
+        }
+        int regressoes = 0;
+        printf("\ncomparação com %s (tolerância %.0f%%):\n", arquivoBase, tolerancia);
+        for (int i = 0; i < totalResultados; i++) {
+            for (int k = 0; k < totalBase; k++) {
+                if (strcmp(base[k].medida, resultados[i].medida) != 0 || base[k].tamanho != resultados[i].tamanho || base[k].ns <= 0.0)
+                    continue;
+                double variacao = 100.0 * (resultados[i].ns - base[k].ns) / base[k].ns;
+                bool regrediu = variacao > tolerancia;
+                regressoes += regrediu;
+                printf("  %-14s %8d %11.1f -> %11.1f ns  %+6.1f%%%s\n", resultados[i].medida, resultados[i].tamanho, base[k].ns,
+                       resultados[i].ns, variacao, regrediu ? "  REGRESSÃO" : "");
+                break;
+            }
+        }
+        if (regressoes > 0) {
+            printf("%d medida(s) mais lenta(s) que a base\n", regressoes);
+            return 1;
+        }
+        printf("nenhuma regressão\n");
+    }
+    return 0;
+}
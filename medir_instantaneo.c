@@ -0,0 +1,109 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime.
+#include "logica.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// --- MEDIÇÃO DOS INSTANTÂNEOS ---
+// Mede quanto custa salvar e restaurar uma partida (SalvarInstantaneo / RestaurarInstantaneo) e reiniciar uma
+// partida reaproveitando a arena, em tabuleiros de 5 a 10 mil buracos. Cada partida é avançada até o meio, com
+// animais visíveis e a agenda cheia, antes de medir. Não depende da Raylib.
+//
+// Uso: medir_instantaneo [--csv arquivo] [--buracos N ...]
+//   --buracos  mede só os tamanhos dados (pode repetir); o padrão é 5, 50, 500, 1000, 5000 e 10000
+//   --csv      grava também uma linha por tamanho, com os tempos em nanossegundos
+
+#define MAX_TAMANHOS 32
+#define TEMPO_MINIMO 0.05 // Segundos de repetição por medida, para o relógio não dominar nos tabuleiros pequenos.
+
+static double Agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+typedef enum { MEDIR_SALVAR, MEDIR_RESTAURAR, MEDIR_REINICIAR, MEDIR_REINICIAR_ARENA_NOVA } Medida;
+
+// Repete a operação até passar TEMPO_MINIMO e retorna o tempo médio de uma vez, em nanossegundos.
+static double Medir(Medida medida, EstadoJogo* jogo, InstantaneoJogo* instantaneo, const ConfiguracaoJogo* configuracao) {
+    long vezes = 0;
+    double inicio = Agora(), fim;
+    do {
+        for (int k = 0; k < 16; k++) {
+            switch (medida) {
+                case MEDIR_SALVAR: SalvarInstantaneo(jogo, instantaneo); break;
+                case MEDIR_RESTAURAR: RestaurarInstantaneo(jogo, instantaneo); break;
+                case MEDIR_REINICIAR: InicializarEstadoJogo(jogo, configuracao); break;
+                case MEDIR_REINICIAR_ARENA_NOVA: // Como antes da arena: libera e aloca a cada partida.
+                    LiberarEstadoJogo(jogo);
+                    InicializarEstadoJogo(jogo, configuracao);
+                    break;
+            }
+        }
+        vezes += 16;
+        fim = Agora();
+    } while (fim - inicio < TEMPO_MINIMO);
+    return (fim - inicio) * 1e9 / vezes;
+}
+
+int main(int argc, char* argv[]) {
+    int tamanhos[MAX_TAMANHOS] = { 5, 50, 500, 1000, 5000, 10000 };
+    int totalTamanhos = 6;
+    bool tamanhosDados = false;
+    const char* arquivoCsv = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            arquivoCsv = argv[++i];
+        } else if (strcmp(argv[i], "--buracos") == 0 && i + 1 < argc) {
+            if (!tamanhosDados)
+                totalTamanhos = 0;
+            tamanhosDados = true;
+            if (totalTamanhos < MAX_TAMANHOS)
+                tamanhos[totalTamanhos++] = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "uso: %s [--csv arquivo] [--buracos N ...]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    FILE* csv = NULL;
+    if (arquivoCsv != NULL) {
+        csv = fopen(arquivoCsv, "w");
+        if (csv == NULL) {
+            fprintf(stderr, "não foi possível criar %s\n", arquivoCsv);
+            return 1;
+        }
+        fprintf(csv, "buracos,bytes,salvar_ns,restaurar_ns,reiniciar_ns,reiniciar_arena_nova_ns\n");
+    }
+
+    printf("%8s %10s %12s %12s %12s %16s\n", "buracos", "bytes", "salvar", "restaurar", "reiniciar", "arena nova");
+    for (int t = 0; t < totalTamanhos; t++) {
+        if (tamanhos[t] < 1)
+            continue;
+        ConfiguracaoJogo configuracao = { DIFICIL, tamanhos[t], 1500.0f, 800.0f, 20240601 };
+        EstadoJogo jogo = {0};
+        InstantaneoJogo instantaneo = {0};
+        bool ok = InicializarEstadoJogo(&jogo, &configuracao);
+        AvancarJogoAte(&jogo, jogo.tickInicioJogo + (jogo.tickFimJogo - jogo.tickInicioJogo) / 2);
+        if (!ok || !SalvarInstantaneo(&jogo, &instantaneo)) {
+            fprintf(stderr, "sem memória para a partida com %d buracos\n", tamanhos[t]);
+            return 1;
+        }
+
+        double salvar = Medir(MEDIR_SALVAR, &jogo, &instantaneo, &configuracao);
+        double restaurar = Medir(MEDIR_RESTAURAR, &jogo, &instantaneo, &configuracao);
+        size_t bytes = sizeof(EstadoJogo) + jogo.tamanhoMemoria;
+        double reiniciar = Medir(MEDIR_REINICIAR, &jogo, &instantaneo, &configuracao);
+        double arenaNova = Medir(MEDIR_REINICIAR_ARENA_NOVA, &jogo, &instantaneo, &configuracao);
+
+        printf("%8d %10zu %9.0f ns %9.0f ns %9.0f ns %13.0f ns\n", tamanhos[t], bytes, salvar, restaurar, reiniciar, arenaNova);
+        if (csv != NULL)
+            fprintf(csv, "%d,%zu,%.0f,%.0f,%.0f,%.0f\n", tamanhos[t], bytes, salvar, restaurar, reiniciar, arenaNova);
+        LiberarInstantaneo(&instantaneo);
+        LiberarEstadoJogo(&jogo);
+    }
+    if (csv != NULL)
+        fclose(csv);
+    return 0;
+}
@@ -0,0 +1,269 @@
+#define _POSIX_C_SOURCE 200809L // nanosleep.
+#include "logica.h"
+#include "simulacao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// --- RITMO DA SIMULAÇÃO COM O DESENHO TRAVANDO ---
+// Roda a mesma partida de duas formas, sem janela, com um "desenho" de mentira a 60 FPS que às vezes trava (como
+// uma espera longa do vsync ou um frame pesado):
+//   no frame:   a partida avança dentro do frame, como com --thread-unica;
+//   na thread:  a partida avança na thread da simulação, e o frame só lê o estado publicado e entrega os cliques.
+// Um robô clica nos animais; cada clique acontece em um momento qualquer do frame anterior, e a fila de entrada o
+// entrega no frame seguinte. Para cada forma mostra, em milissegundos:
+//   atraso do tick     da hora em que cada tick venceu até ele ser simulado;
+//   clique -> lógica   do clique até o passo que o aplicou (a entrada continua sendo lida pelo desenho);
+//   idade do estado    quanto o estado desenhado estava atrás do momento do frame.
+// Sai com código 1 se o p99 do atraso do tick na thread passar de um tick: a simulação perdeu o ritmo.
+//
+// Uso: medir_simulacao [--segundos S] [--travadas %] [--travada MS] [--buracos N] [--csv arquivo]
+//   --segundos  tempo de cada forma (padrão 20)        --buracos  buracos do tabuleiro (padrão: o da dificuldade)
+//   --travadas  frames que travam (padrão 5%)          --csv      acrescenta uma linha por forma
+//   --travada   duração de cada travada (padrão 50 ms)
+
+#define MAX_MEDIDAS (TICKS_POR_SEGUNDO * 600)
+
+typedef struct {
+    float* valores;
+    int total;
+} Medidas;
+
+static void Anotar(Medidas* m, double ms) {
+    if (m->total < MAX_MEDIDAS)
+        m->valores[m->total++] = (float)ms;
+}
+
+static int CompararFloat(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+static float Percentil(const Medidas* m, int p) {
+    int n = m->total;
+    return n > 0 ? m->valores[(int64_t)n * p / 100 < n ? (int64_t)n * p / 100 : n - 1] : 0.0f;
+}
+
+static void Dormir(double segundos) {
+    if (segundos <= 0.0)
+        return;
+    struct timespec t = { (time_t)segundos, (long)((segundos - (time_t)segundos) * 1e9) };
+    nanosleep(&t, NULL);
+}
+
+static Medidas cliqueLogica; // Preenchida pelo passo da thread (AoPassar) ou pelo frame.
+
+// Chamada pela thread da simulação depois de cada passo: anota quanto cada clique do passo esperou.
+static void AoPassar(void* contexto, const EstadoJogo* jogo, int primeiroAcerto, const double* tempoCliques) {
+    (void)contexto;
+    (void)primeiroAcerto;
+    double agora = RelogioSimulacao();
+    for (int k = 0; k < jogo->totalAcertosRecentes; k++)
+        if (jogo->acertosRecentes[k].clique >= 0)
+            Anotar(&cliqueLogica, (agora - tempoCliques[jogo->acertosRecentes[k].clique]) * 1000.0);
+}
+
+// Robô: em cada frame, com alguma chance, clica no meio de um animal visível no estado que o desenho vê.
+static bool EscolherClique(const EstadoJogo* jogo, GeradorAleatorio* gerador, float* x, float* y) {
+    const Capivaras* c = &jogo->capivaras;
+    if (!jogo->jogoIniciado || jogo->jogoAcabou || SortearValor(gerador, 0, 99) >= 40)
+        return false;
+    int inicio = SortearValor(gerador, 0, jogo->totalCapivaras - 1);
+    for (int n = 0; n < jogo->totalCapivaras; n++) {
+        int i = (inicio + n) % jogo->totalCapivaras;
+        if (!c->visivel[i] || c->hit[i] || c->tipo[i] == CUTIA)
+            continue;
+        *x = c->rect[i].x + c->rect[i].largura / 2;
+        *y = c->rect[i].y + c->rect[i].altura / 2;
+        return true;
+    }
+    return false;
+}
+
+typedef struct {
+    const char* nome;
+    Medidas atrasoTick, idadeEstado;
+    float cliqueP50, cliqueP99, cliqueMax;
+    int64_t ticks, travadas;
+    int maxTicksPorPasso;
+} Resultado;
+
+static double segundos = 20.0, chanceTravada = 5.0, duracaoTravada = 0.050;
+static int buracos = 0;
+
+static void Rodar(bool naThread, Resultado* r) {
+    EstadoJogo jogo;
+    memset(&jogo, 0, sizeof(jogo));
+    ConfiguracaoJogo configuracao = { DIFICIL, buracos, 1500.0f, 800.0f, 2024 };
+    if (!InicializarEstadoJogo(&jogo, &configuracao)) {
+        fprintf(stderr, "sem memória para a partida\n");
+        exit(1);
+    }
+    GeradorAleatorio gerador;
+    IniciarGerador(&gerador, 99);
+    ThreadSimulacao simulacao;
+    cliqueLogica.total = 0;
+    if (naThread) {
+        if (!IniciarThreadSimulacao(&simulacao, &jogo, RelogioSimulacao, AoPassar, NULL)) {
+            fprintf(stderr, "não foi possível criar a thread da simulação\n");
+            exit(1);
+        }
+        RetomarSimulacao(&simulacao);
+    }
+
+    const double duracaoQuadro = 1.0 / 60.0;
+    double inicio = RelogioSimulacao(), fim = inicio + segundos;
+    double inicioQuadro = inicio, proximoQuadro = inicio;
+    EstadoJogo vista;
+    while (inicioQuadro < fim) {
+        double agora = RelogioSimulacao();
+        double dt = agora - inicioQuadro; // O frame anterior, cujos cliques a fila entrega agora.
+        const EstadoJogo* estado = &jogo;
+        double tempoEstado = agora;
+        if (naThread) {
+            estado = LerEstadoSimulacao(&simulacao, &vista, &tempoEstado);
+            // A thread parou no fim da partida: a partida volta para o frame, que começa outra.
+            if (!SimulacaoRodando(&simulacao) && jogo.jogoAcabou) {
+                configuracao.semente++;
+                InicializarEstadoJogo(&jogo, &configuracao);
+                RetomarSimulacao(&simulacao);
+                estado = LerEstadoSimulacao(&simulacao, &vista, &tempoEstado);
+            }
+        }
+        float x, y;
+        bool clicou = EscolherClique(estado, &gerador, &x, &y);
+        double tempoClique = inicioQuadro + dt * SortearValor(&gerador, 0, 999) / 1000.0;
+
+        if (naThread) {
+            if (clicou)
+                EnviarCliqueSimulacao(&simulacao, tempoClique, x, y);
+            AcertoJogo acertos[MAX_ACERTOS_SIMULACAO];
+            LerAcertosSimulacao(&simulacao, acertos, MAX_ACERTOS_SIMULACAO);
+            Anotar(&r->idadeEstado, (agora - tempoEstado) * 1000.0);
+        } else {
+            EntradaJogo entrada = {0};
+            if (clicou)
+                entrada.cliques[entrada.totalCliques++] = (CliqueJogo){ tempoClique - inicioQuadro, x, y };
+            int64_t tickAntes = jogo.tick;
+            PassoJogo(&jogo, dt, &entrada);
+            int ticks = (int)(jogo.tick - tickAntes);
+            for (int k = 0; k < ticks; k++)
+                Anotar(&r->atrasoTick, (jogo.acumulador + (ticks - 1 - k) * PASSO_FIXO) * 1000.0);
+            r->ticks += ticks;
+            if (ticks > r->maxTicksPorPasso)
+                r->maxTicksPorPasso = ticks;
+            if (jogo.totalAcertosRecentes > 0 && clicou)
+                Anotar(&cliqueLogica, (RelogioSimulacao() - tempoClique) * 1000.0);
+            jogo.totalAcertosRecentes = 0;
+            Anotar(&r->idadeEstado, jogo.acumulador * 1000.0);
+            if (jogo.jogoAcabou) {
+                configuracao.semente++;
+                InicializarEstadoJogo(&jogo, &configuracao);
+            }
+        }
+        inicioQuadro = agora;
+
+        // O "desenho": às vezes trava; o frame seguinte começa na próxima batida de 60 Hz depois dele.
+        if (SortearValor(&gerador, 0, 9999) < (int)(chanceTravada * 100)) {
+            Dormir(duracaoTravada);
+            r->travadas++;
+        } else {
+            Dormir(0.002);
+        }
+        proximoQuadro += duracaoQuadro;
+        double depois = RelogioSimulacao();
+        while (proximoQuadro < depois)
+            proximoQuadro += duracaoQuadro;
+        Dormir(proximoQuadro - RelogioSimulacao());
+    }
+
+    if (naThread) {
+        PausarSimulacao(&simulacao);
+        ResumoSimulacao resumo = ResumirSimulacao(&simulacao);
+        r->ticks = resumo.ticks;
+        r->maxTicksPorPasso = resumo.maxTicksPorPasso;
+        int total = simulacao.totalAtrasos < MAX_ATRASOS_SIMULACAO ? (int)simulacao.totalAtrasos : MAX_ATRASOS_SIMULACAO;
+        for (int i = 0; i < total; i++)
+            Anotar(&r->atrasoTick, simulacao.atrasos[i]);
+        EncerrarThreadSimulacao(&simulacao);
+    }
+    qsort(r->atrasoTick.valores, (size_t)r->atrasoTick.total, sizeof(float), CompararFloat);
+    qsort(r->idadeEstado.valores, (size_t)r->idadeEstado.total, sizeof(float), CompararFloat);
+    qsort(cliqueLogica.valores, (size_t)cliqueLogica.total, sizeof(float), CompararFloat);
+    r->cliqueP50 = Percentil(&cliqueLogica, 50);
+    r->cliqueP99 = Percentil(&cliqueLogica, 99);
+    r->cliqueMax = Percentil(&cliqueLogica, 100);
+    LiberarEstadoJogo(&jogo);
+}
+
+int main(int argc, char* argv[]) {
+    const char* arquivoCsv = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--segundos") == 0 && i + 1 < argc)
+            segundos = atof(argv[++i]);
+        else if (strcmp(argv[i], "--travadas") == 0 && i + 1 < argc)
+            chanceTravada = atof(argv[++i]);
+        else if (strcmp(argv[i], "--travada") == 0 && i + 1 < argc)
+            duracaoTravada = atof(argv[++i]) / 1000.0;
+        else if (strcmp(argv[i], "--buracos") == 0 && i + 1 < argc)
+            buracos = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            arquivoCsv = argv[++i];
+        else {
+            fprintf(stderr, "uso: %s [--segundos S] [--travadas %%] [--travada MS] [--buracos N] [--csv arquivo]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (segundos <= 0.0 || segundos > 600.0 || chanceTravada < 0.0 || chanceTravada > 100.0 || duracaoTravada < 0.0 || buracos < 0) {
+        fprintf(stderr, "segundos: até 600, travadas: 0 a 100%%, travada >= 0, buracos >= 0\n");
+        return 2;
+    }
+
+    Resultado resultados[2] = { { .nome = "no frame" }, { .nome = "na thread" } };
+    cliqueLogica.valores = (float*)malloc(MAX_MEDIDAS * sizeof(float));
+    for (int k = 0; k < 2; k++) {
+        resultados[k].atrasoTick.valores = (float*)malloc(MAX_MEDIDAS * sizeof(float));
+        resultados[k].idadeEstado.valores = (float*)malloc(MAX_MEDIDAS * sizeof(float));
+        Rodar(k == 1, &resultados[k]);
+    }
+
+    printf("desenho a 60 FPS, %.0f%% dos frames travando %.0f ms, %.0f s de cada forma, simulação a %d ticks/s\n", chanceTravada,
+           duracaoTravada * 1000.0, segundos, TICKS_POR_SEGUNDO);
+    FILE* csv = NULL;
+    if (arquivoCsv != NULL) {
+        csv = fopen(arquivoCsv, "a");
+        if (csv == NULL) {
+            fprintf(stderr, "não foi possível abrir %s\n", arquivoCsv);
+            return 1;
+        }
+        if (ftell(csv) == 0)
+            fprintf(csv, "forma,travadas_pct,travada_ms,ticks,max_ticks_passo,atraso_p50_ms,atraso_p99_ms,atraso_max_ms,"
+                         "clique_p50_ms,clique_p99_ms,idade_p50_ms,idade_p99_ms\n");
+    }
+    for (int k = 0; k < 2; k++) {
+        Resultado* r = &resultados[k];
+        printf("\n%s: %lld ticks, até %d ticks por passo, %lld frames travados\n", r->nome, (long long)r->ticks, r->maxTicksPorPasso,
+               (long long)r->travadas);
+        printf("  atraso do tick:    p50 %6.2f ms, p99 %6.2f ms, máximo %6.2f ms\n", Percentil(&r->atrasoTick, 50),
+               Percentil(&r->atrasoTick, 99), Percentil(&r->atrasoTick, 100));
+        printf("  clique -> lógica:  p50 %6.2f ms, p99 %6.2f ms, máximo %6.2f ms\n", r->cliqueP50, r->cliqueP99, r->cliqueMax);
+        printf("  idade do estado:   p50 %6.2f ms, p99 %6.2f ms\n", Percentil(&r->idadeEstado, 50), Percentil(&r->idadeEstado, 99));
+        if (csv != NULL)
+            fprintf(csv, "%s,%.1f,%.0f,%lld,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n", k == 0 ? "frame" : "thread", chanceTravada,
+                    duracaoTravada * 1000.0, (long long)r->ticks, r->maxTicksPorPasso, Percentil(&r->atrasoTick, 50),
+                    Percentil(&r->atrasoTick, 99), Percentil(&r->atrasoTick, 100), r->cliqueP50, r->cliqueP99,
+                    Percentil(&r->idadeEstado, 50), Percentil(&r->idadeEstado, 99));
+    }
+    if (csv != NULL)
+        fclose(csv);
+    bool ok = Percentil(&resultados[1].atrasoTick, 99) <= PASSO_FIXO * 1000.0;
+    for (int k = 0; k < 2; k++) {
+        free(resultados[k].atrasoTick.valores);
+        free(resultados[k].idadeEstado.valores);
+    }
+    printf("\n%s\n", ok ? "resultado: a simulação manteve o ritmo com o desenho travando"
+                        : "resultado: a simulação na thread PERDEU O RITMO (p99 do atraso acima de um tick)");
+    free(cliqueLogica.valores);
+    return ok ? 0 : 1;
+}
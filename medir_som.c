@@ -0,0 +1,224 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime e nanosleep.
+#include "logica.h"
+#include "som.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// --- LATÊNCIA DO SOM SEM JANELA ---
+// Repete o caminho do som do jogo sem a Raylib: uma thread de áudio pede um buffer ao mixer a cada período do
+// buffer, como o dispositivo de áudio faria, e a thread do jogo roda frames a 60 Hz com um robô clicando nos
+// animais. Cada clique acontece em um momento qualquer do frame anterior (é quando a fila de entrada o registra)
+// e só é aplicado no frame seguinte, como no jogo. No fim mostra, em milissegundos:
+//   clique -> envio    espera do frame e a lógica até TocarSom (a mesma espera do retorno visual);
+//   envio -> mistura   do comando até a thread de áudio misturar o início do som;
+//   clique -> mistura  a soma, e uma estimativa até o alto-falante somando um buffer de saída.
+// Também mostra o custo da mistura de um buffer e as vozes ocupadas e roubadas. Sai com código 1 se o p99 da
+// parte do áudio (envio -> mistura mais um buffer de saída) passar de --limite ms: a espera do frame não depende
+// do mixer e cai junto com a taxa de quadros.
+//
+// Uso: medir_som [--segundos S] [--buffer QUADROS] [--fps F] [--buracos N] [--limite MS] [--csv arquivo]
+//   --segundos  tempo medido (padrão 60)              --buracos  buracos do tabuleiro (padrão: o da dificuldade)
+//   --buffer    quadros por buffer (padrão 256)       --limite   p99 máximo da parte do áudio (padrão 20 ms)
+//   --fps       frames por segundo do jogo (padrão 60) --csv     acrescenta uma linha com o resultado
+
+#define MAX_BUFFER_MEDIDO 4096
+#define MAX_MISTURAS (TAXA_SOM * 600 / 32) // Custos de mistura guardados (10 minutos com buffers de 32 quadros).
+
+typedef struct {
+    MixerSom* mixer;
+    int quadros;
+    volatile int parar;
+    float* custos;   // Microssegundos de cada MisturarSom.
+    int totalCustos;
+    int atrasados;   // Buffers que começaram mais de um período depois da hora (a thread perdeu a vez).
+} ThreadAudio;
+
+static double Agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void Dormir(double segundos) {
+    if (segundos <= 0.0)
+        return;
+    struct timespec t = { (time_t)segundos, (long)((segundos - (time_t)segundos) * 1e9) };
+    nanosleep(&t, NULL);
+}
+
+// O dispositivo de áudio: a cada período, um buffer. O horário é absoluto, então um atraso não se acumula.
+static void* RodarAudio(void* argumento) {
+    ThreadAudio* a = (ThreadAudio*)argumento;
+    static int16_t saida[2 * MAX_BUFFER_MEDIDO];
+    double periodo = (double)a->quadros / TAXA_SOM;
+    double proximo = Agora();
+    while (!__atomic_load_n(&a->parar, __ATOMIC_ACQUIRE)) {
+        Dormir(proximo - Agora());
+        double antes = Agora();
+        if (antes > proximo + periodo)
+            a->atrasados++;
+        MisturarSom(a->mixer, saida, a->quadros);
+        if (a->totalCustos < MAX_MISTURAS)
+            a->custos[a->totalCustos++] = (float)((Agora() - antes) * 1e6);
+        proximo += periodo;
+        if (proximo < antes - 4 * periodo)
+            proximo = antes; // Muito atrasado (o sistema parou a thread): não tenta recuperar.
+    }
+    return NULL;
+}
+
+static int CompararFloat(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+static float Percentil(float* v, int n, int p) {
+    return n > 0 ? v[(int64_t)n * p / 100 < n ? (int64_t)n * p / 100 : n - 1] : 0.0f;
+}
+
+// Robô: em cada frame, com alguma chance, clica no meio de um animal visível (raramente numa cutia).
+static void ClicarRobo(const EstadoJogo* jogo, GeradorAleatorio* gerador, EntradaJogo* entrada, double* tempoCliques,
+                       double inicioAnterior, double duracao) {
+    const Capivaras* c = &jogo->capivaras;
+    if (!jogo->jogoIniciado || SortearValor(gerador, 0, 99) >= 40)
+        return;
+    int inicio = SortearValor(gerador, 0, jogo->totalCapivaras - 1);
+    for (int n = 0; n < jogo->totalCapivaras && entrada->totalCliques < MAX_CLIQUES_PASSO; n++) {
+        int i = (inicio + n) % jogo->totalCapivaras;
+        if (!c->visivel[i] || c->hit[i] || (c->tipo[i] == CUTIA && SortearValor(gerador, 0, 99) < 80))
+            continue;
+        // O clique aconteceu durante o frame anterior e chega a este na fila, com o momento registrado.
+        double deslocamento = duracao * SortearValor(gerador, 0, 999) / 1000.0;
+        Retangulo r = c->rect[i];
+        tempoCliques[entrada->totalCliques] = inicioAnterior + deslocamento;
+        entrada->cliques[entrada->totalCliques++] = (CliqueJogo){ deslocamento, r.x + r.largura / 2, r.y + r.altura / 2 };
+        return;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    double segundos = 60.0, fps = 60.0, limite = 20.0;
+    int quadrosBuffer = QUADROS_BUFFER_SOM, buracos = 0;
+    const char* arquivoCsv = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--segundos") == 0 && i + 1 < argc)
+            segundos = atof(argv[++i]);
+        else if (strcmp(argv[i], "--buffer") == 0 && i + 1 < argc)
+            quadrosBuffer = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+            fps = atof(argv[++i]);
+        else if (strcmp(argv[i], "--buracos") == 0 && i + 1 < argc)
+            buracos = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--limite") == 0 && i + 1 < argc)
+            limite = atof(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            arquivoCsv = argv[++i];
+        else {
+            fprintf(stderr, "uso: %s [--segundos S] [--buffer QUADROS] [--fps F] [--buracos N] [--limite MS] [--csv arquivo]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (segundos <= 0.0 || segundos > 600.0 || fps < 10.0 || quadrosBuffer < 32 || quadrosBuffer > MAX_BUFFER_MEDIDO || buracos < 0) {
+        fprintf(stderr, "segundos: até 600, fps >= 10, buffer: 32 a %d quadros, buracos >= 0\n", MAX_BUFFER_MEDIDO);
+        return 2;
+    }
+
+    static MixerSom mixer;
+    if (!IniciarSom(&mixer, Agora)) {
+        fprintf(stderr, "sem memória para as amostras\n");
+        return 1;
+    }
+    ThreadAudio audio = { &mixer, quadrosBuffer, 0, (float*)malloc(MAX_MISTURAS * sizeof(float)), 0, 0 };
+    pthread_t thread;
+    pthread_create(&thread, NULL, RodarAudio, &audio);
+
+    EstadoJogo jogo;
+    memset(&jogo, 0, sizeof(jogo));
+    ConfiguracaoJogo configuracao = { DIFICIL, buracos, 1500.0f, 800.0f, 12345 };
+    if (!InicializarEstadoJogo(&jogo, &configuracao)) {
+        fprintf(stderr, "sem memória para a partida\n");
+        return 1;
+    }
+    AndamentoSom andamento = {0};
+    GeradorAleatorio gerador;
+    IniciarGerador(&gerador, 777);
+    int partidas = 1;
+
+    double duracao = 1.0 / fps;
+    double inicio = Agora(), inicioQuadro = inicio, fim = inicio + segundos;
+    while (inicioQuadro < fim) {
+        double agora = Agora();
+        double dt = agora - inicioQuadro; // O frame anterior, cujos cliques a fila entrega agora.
+        EntradaJogo entrada = {0};
+        double tempoCliques[MAX_CLIQUES_PASSO];
+        ClicarRobo(&jogo, &gerador, &entrada, tempoCliques, inicioQuadro, dt);
+        int antes = jogo.totalAcertosRecentes;
+        PassoJogo(&jogo, dt, &entrada);
+        TocarAcertosSom(&mixer, &jogo, antes, tempoCliques, 1500.0f);
+        AtualizarAndamentoSom(&mixer, &andamento, &jogo, true);
+        jogo.totalAcertosRecentes = 0; // A interface leu os acertos (AtualizarEfeitos).
+        if (jogo.jogoAcabou) {
+            configuracao.semente++;
+            InicializarEstadoJogo(&jogo, &configuracao);
+            partidas++;
+        }
+        inicioQuadro = agora;
+        Dormir(agora + duracao - Agora()); // O resto do frame (o desenho, no jogo).
+    }
+    __atomic_store_n(&audio.parar, 1, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+
+    ResumoLatenciaSom r = ResumirLatenciaSom(&mixer);
+    double msBuffer = 1000.0 * quadrosBuffer / TAXA_SOM;
+    qsort(audio.custos, (size_t)audio.totalCustos, sizeof(float), CompararFloat);
+    float custoP50 = Percentil(audio.custos, audio.totalCustos, 50), custoP99 = Percentil(audio.custos, audio.totalCustos, 99);
+    float custoMax = Percentil(audio.custos, audio.totalCustos, 100);
+
+    // A parte do áudio por acerto: espera até a mistura mais o buffer de saída.
+    int total = mixer.totalLatencias < MAX_LATENCIAS_SOM ? (int)mixer.totalLatencias : MAX_LATENCIAS_SOM;
+    float* parteAudio = (float*)malloc((total > 0 ? total : 1) * sizeof(float));
+    for (int i = 0; i < total; i++)
+        parteAudio[i] = mixer.latencias[i].envioMistura + (float)msBuffer;
+    qsort(parteAudio, (size_t)total, sizeof(float), CompararFloat);
+    float audioP50 = Percentil(parteAudio, total, 50), audioP99 = Percentil(parteAudio, total, 99);
+
+    printf("buffer de %d quadros (%.2f ms a %d Hz), jogo a %.0f fps, %.0f s, %d partida(s), %lld acertos com som\n", quadrosBuffer,
+           msBuffer, TAXA_SOM, fps, segundos, partidas, (long long)r.total);
+    printf("  clique -> envio:    p50 %6.2f ms, p99 %6.2f ms, máximo %6.2f ms (espera do frame, igual à do retorno visual)\n",
+           r.cliqueEnvioP50, r.cliqueEnvioP99, r.cliqueEnvioMax);
+    printf("  envio -> mistura:   p50 %6.2f ms, p99 %6.2f ms, máximo %6.2f ms\n", r.envioMisturaP50, r.envioMisturaP99, r.envioMisturaMax);
+    printf("  clique -> mistura:  p50 %6.2f ms, p99 %6.2f ms, máximo %6.2f ms\n", r.totalP50, r.totalP99, r.totalMax);
+    printf("  clique -> saída:    p50 %6.2f ms, p99 %6.2f ms (estimado: mistura + um buffer)\n", r.totalP50 + msBuffer, r.totalP99 + msBuffer);
+    printf("  parte do áudio:     p50 %6.2f ms, p99 %6.2f ms (envio -> mistura + um buffer; limite %.0f ms)\n", audioP50, audioP99, limite);
+    printf("  mistura: p50 %.1f us, p99 %.1f us, máximo %.1f us por buffer (%.2f%% do período no p99), %d buffers atrasados de %lld\n",
+           custoP50, custoP99, custoMax, 100.0 * custoP99 / (msBuffer * 1000.0), audio.atrasados, (long long)mixer.buffersMisturados);
+    printf("  vozes: no máximo %d de %d ocupadas, %lld roubadas; %lld comandos perdidos\n", mixer.maxVozesAtivas, MAX_VOZES_SOM,
+           (long long)mixer.vozesRoubadas, (long long)mixer.comandosPerdidos);
+
+    if (arquivoCsv != NULL) {
+        FILE* csv = fopen(arquivoCsv, "a");
+        if (csv == NULL) {
+            fprintf(stderr, "não foi possível abrir %s\n", arquivoCsv);
+            return 1;
+        }
+        if (ftell(csv) == 0)
+            fprintf(csv, "buffer,fps,acertos,clique_envio_p50_ms,clique_envio_p99_ms,envio_mistura_p50_ms,envio_mistura_p99_ms,"
+                         "clique_mistura_p50_ms,clique_mistura_p99_ms,clique_mistura_max_ms,audio_p99_ms,mistura_p99_us,"
+                         "vozes_max,vozes_roubadas,comandos_perdidos\n");
+        fprintf(csv, "%d,%.0f,%lld,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.1f,%d,%lld,%lld\n", quadrosBuffer, fps, (long long)r.total,
+                r.cliqueEnvioP50, r.cliqueEnvioP99, r.envioMisturaP50, r.envioMisturaP99, r.totalP50, r.totalP99, r.totalMax, audioP99,
+                custoP99, mixer.maxVozesAtivas, (long long)mixer.vozesRoubadas, (long long)mixer.comandosPerdidos);
+        fclose(csv);
+    }
+    bool ok = r.total > 0 && audioP99 <= limite;
+    printf("\n%s\n", ok ? "resultado: a parte do áudio ficou dentro do limite"
+                        : (r.total == 0 ? "resultado: nenhum acerto medido" : "resultado: ACIMA DO LIMITE"));
+    free(parteAudio);
+    free(audio.custos);
+    LiberarEstadoJogo(&jogo);
+    LiberarSom(&mixer);
+    return ok ? 0 : 1;
+}
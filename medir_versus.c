@@ -0,0 +1,294 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime e nanosleep.
+#include "logica.h"
+#include "versus.h"
+#include "rede_versus.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// --- TESTE DO MODO VERSUS NO LOOPBACK ---
+// Dois robôs jogam uma partida versus em tempo real, cada um em uma thread com a sua conexão UDP no loopback, como
+// se fossem duas máquinas. A rede simulada atrasa, varia e perde os pacotes dos dois lados. No fim, cada lado
+// mostra quantos ticks tiveram rollback, quantos ticks foram refeitos e quanto custou cada passo, e os dois
+// conferem se chegaram exatamente no mesmo estado (código de saída 1 se não chegaram).
+//
+// Uso: medir_versus [--latencia MS] [--variacao MS] [--perda %] [--atraso TICKS] [--segundos S]
+//                   [--dificuldade 0-2] [--porta P] [--csv arquivo]
+//   --latencia  atraso de ida de cada pacote (padrão 40 ms)      --segundos  segundos de partida jogados (padrão 20)
+//   --variacao  jitter de cada pacote (padrão 10 ms)             --porta     usa P e P + 1 (padrão 7430)
+//   --perda     porcentagem de pacotes perdidos (padrão 2)       --csv       acrescenta uma linha por jogador
+//   --atraso    atraso de entrada (padrão 2 ticks)
+
+#define MAX_PASSOS (TICKS_POR_SEGUNDO * 180)  // Tempos de passo guardados por jogador.
+#define ORCAMENTO_QUADRO_US (1e6 / 60)         // Um frame a 60 Hz.
+
+typedef struct {
+    int jogador;               // 0 ou 1 do lado da thread (o número no jogo sai do aperto de mão).
+    uint16_t portaLocal, portaRival;
+    EstadoJogo jogo;
+    SessaoVersus sessao;
+    ConexaoVersus conexao;
+    float* passos;             // Microssegundos de cada AvancarSessaoVersus que simulou ou refez algo.
+    float* passosRollback;     // Só os que refizeram ticks.
+    int totalPassos, totalPassosRollback;
+    double janelaUs;           // Custo de refazer JANELA_ROLLBACK ticks.
+    uint64_t resumo;
+    bool ok;
+} Jogador;
+
+static SimulacaoRede simulacao = { 40, 10, 2.0f };
+static int atrasoEntrada = 2;
+static double segundosPartida = 20.0;
+static Dificuldade dificuldade = DIFICIL;
+
+static double Agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void Dormir(double segundos) {
+    if (segundos <= 0.0)
+        return;
+    struct timespec t = { (time_t)segundos, (long)((segundos - (time_t)segundos) * 1e9) };
+    nanosleep(&t, NULL);
+}
+
+// Robô simples: vê um animal aparecer, reage depois de 200 a 450 ms e clica no meio dele; quase sempre deixa a
+// cutia passar. Ele olha a partida prevista, como um jogador de verdade olharia a tela.
+typedef struct {
+    GeradorAleatorio gerador;
+    int alvo;
+    int64_t tickClique;
+    int64_t ignorado[64];      // tickSurgimento da cutia que o robô decidiu deixar passar, por buraco.
+} Robo;
+
+static void DecidirRobo(Robo* robo, const SessaoVersus* sessao, EntradaVersus* entrada) {
+    const EstadoJogo* jogo = sessao->jogo;
+    const Capivaras* c = &jogo->capivaras;
+    int n = jogo->totalCapivaras < 64 ? jogo->totalCapivaras : 64;
+    if (robo->alvo >= 0 && (!c->visivel[robo->alvo] || c->hit[robo->alvo]))
+        robo->alvo = -1;
+    if (robo->alvo < 0) {
+        for (int i = 0; i < n; i++) {
+            if (!c->visivel[i] || c->hit[i] || robo->ignorado[i] == c->tickSurgimento[i])
+                continue;
+            if (c->tipo[i] == CUTIA && SortearValor(&robo->gerador, 0, 99) < 85) {
+                robo->ignorado[i] = c->tickSurgimento[i];
+                continue;
+            }
+            robo->alvo = i;
+            robo->tickClique = sessao->quadro + SortearValor(&robo->gerador, TICKS_POR_SEGUNDO / 5, TICKS_POR_SEGUNDO * 9 / 20);
+            break;
+        }
+    }
+    if (robo->alvo >= 0 && sessao->quadro >= robo->tickClique && entrada->totalCliques < MAX_CLIQUES_VERSUS) {
+        Retangulo r = c->rect[robo->alvo];
+        entrada->x[entrada->totalCliques] = (uint16_t)(r.x + r.largura / 2);
+        entrada->y[entrada->totalCliques] = (uint16_t)(r.y + r.altura / 2);
+        entrada->totalCliques++;
+        robo->alvo = -1;
+    }
+}
+
+static void* RodarJogador(void* argumento) {
+    Jogador* j = (Jogador*)argumento;
+    double inicio = Agora();
+    uint32_t nonce = (uint32_t)(inicio * 1e6) * 2654435761u + (uint32_t)j->jogador * 0x9E3779B9u;
+    if (!AbrirConexaoVersus(&j->conexao, j->portaLocal, "127.0.0.1", j->portaRival, nonce, dificuldade, atrasoEntrada, inicio)) {
+        fprintf(stderr, "jogador %d: não foi possível abrir a porta %d\n", j->jogador, j->portaLocal);
+        return NULL;
+    }
+    j->conexao.simulacao = simulacao;
+    ConfiguracaoJogo base = { dificuldade, 0, 1500.0f, 800.0f, 0 };
+    Robo robo;
+    memset(&robo, 0, sizeof(robo));
+    EntradaVersus entrada = {0};
+    double proximoTick = 0.0;
+    bool terminou = false;
+
+    while (!terminou) {
+        double agora = Agora();
+        if (agora - inicio > segundosPartida + 60.0) {
+            fprintf(stderr, "jogador %d: a partida não terminou (rival parado?)\n", j->jogador);
+            break;
+        }
+        if (ProcessarConexaoVersus(&j->conexao, &j->sessao, &j->jogo, &base, agora)) {
+            // A partida começa a contar agora; o limite é o mesmo nas duas threads.
+            int64_t limite = j->jogo.tickInicioJogo + (int64_t)(segundosPartida * TICKS_POR_SEGUNDO);
+            if (limite < j->sessao.tickLimite)
+                j->sessao.tickLimite = limite;
+            IniciarGerador(&robo.gerador, nonce);
+            robo.alvo = -1;
+            proximoTick = agora;
+        }
+        if (!j->conexao.comecou) {
+            EnviarConexaoVersus(&j->conexao, &j->sessao, agora);
+            Dormir(0.001);
+            continue;
+        }
+
+        // Um passo por tick de relógio; um atraso do sistema é recuperado com vários passos seguidos.
+        for (int passos = 0; agora >= proximoTick && passos < 8; passos++) {
+            DecidirRobo(&robo, &j->sessao, &entrada);
+            double antes = Agora();
+            PassoVersus r = AvancarSessaoVersus(&j->sessao, &entrada);
+            float us = (float)((Agora() - antes) * 1e6);
+            if (r == PASSO_AVANCOU || j->sessao.refeitosUltimoPasso > 0) {
+                if (j->totalPassos < MAX_PASSOS)
+                    j->passos[j->totalPassos++] = us;
+                if (j->sessao.refeitosUltimoPasso > 0 && j->totalPassosRollback < MAX_PASSOS)
+                    j->passosRollback[j->totalPassosRollback++] = us;
+            }
+            if (r == PASSO_AVANCOU)
+                entrada.totalCliques = 0;
+            proximoTick += PASSO_FIXO;
+            EnviarConexaoVersus(&j->conexao, &j->sessao, agora);
+        }
+        if (agora >= proximoTick + 8 * PASSO_FIXO)
+            proximoTick = agora; // Muito atrasado: não tenta recuperar.
+
+        // Termina quando o resultado está confirmado dos dois lados (o rival recebeu todas as entradas locais).
+        if (SessaoVersusConfirmada(&j->sessao) && j->conexao.ackRival >= j->sessao.tickLimite - 1) {
+            AvancarSessaoVersus(&j->sessao, &entrada); // Aplica um rollback que tenha chegado no último pacote.
+            terminou = true;
+        } else {
+            Dormir(proximoTick - Agora());
+        }
+    }
+    j->ok = terminou;
+    j->resumo = ResumoSessaoVersus(&j->sessao);
+
+    // Pior caso: refazer a janela inteira. Refazer com as mesmas entradas não muda o resultado.
+    if (terminou) {
+        int vezes = 2000;
+        double antes = Agora();
+        for (int k = 0; k < vezes; k++)
+            RefazerSessaoVersus(&j->sessao, j->sessao.quadro - JANELA_ROLLBACK);
+        j->janelaUs = (Agora() - antes) * 1e6 / vezes;
+        if (ResumoSessaoVersus(&j->sessao) != j->resumo) {
+            fprintf(stderr, "jogador %d: refazer a janela mudou o estado\n", j->jogador);
+            j->ok = false;
+        }
+    }
+    // Continua respondendo um pouco, para o rival receber a confirmação das últimas entradas dele.
+    for (double fim = Agora() + 0.3; Agora() < fim; Dormir(PASSO_FIXO)) {
+        ProcessarConexaoVersus(&j->conexao, &j->sessao, &j->jogo, &base, Agora());
+        EnviarConexaoVersus(&j->conexao, &j->sessao, Agora());
+    }
+    return NULL;
+}
+
+static int CompararFloat(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+static float Percentil(float* v, int n, int p) {
+    return n > 0 ? v[(int64_t)n * p / 100 < n ? (int64_t)n * p / 100 : n - 1] : 0.0f;
+}
+
+int main(int argc, char* argv[]) {
+    int porta = PORTA_VERSUS;
+    const char* arquivoCsv = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--latencia") == 0 && i + 1 < argc)
+            simulacao.latenciaMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--variacao") == 0 && i + 1 < argc)
+            simulacao.variacaoMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--perda") == 0 && i + 1 < argc)
+            simulacao.perda = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--atraso") == 0 && i + 1 < argc)
+            atrasoEntrada = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--segundos") == 0 && i + 1 < argc)
+            segundosPartida = atof(argv[++i]);
+        else if (strcmp(argv[i], "--dificuldade") == 0 && i + 1 < argc)
+            dificuldade = (Dificuldade)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--porta") == 0 && i + 1 < argc)
+            porta = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            arquivoCsv = argv[++i];
+        else {
+            fprintf(stderr, "uso: %s [--latencia MS] [--variacao MS] [--perda %%] [--atraso TICKS] [--segundos S] "
+                            "[--dificuldade 0-2] [--porta P] [--csv arquivo]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (dificuldade < FACIL || dificuldade > DIFICIL || atrasoEntrada < 0 || atrasoEntrada > MAX_ATRASO_VERSUS || segundosPartida <= 0.0) {
+        fprintf(stderr, "dificuldade: 0 a 2, atraso: 0 a %d ticks, segundos > 0\n", MAX_ATRASO_VERSUS);
+        return 2;
+    }
+    if (!IniciarRedePlacar())
+        return 1;
+
+    static Jogador jogadores[2];
+    pthread_t threads[2];
+    for (int k = 0; k < 2; k++) {
+        jogadores[k].jogador = k;
+        jogadores[k].portaLocal = (uint16_t)(porta + k);
+        jogadores[k].portaRival = (uint16_t)(porta + 1 - k);
+        jogadores[k].passos = (float*)malloc(MAX_PASSOS * sizeof(float));
+        jogadores[k].passosRollback = (float*)malloc(MAX_PASSOS * sizeof(float));
+        pthread_create(&threads[k], NULL, RodarJogador, &jogadores[k]);
+    }
+    for (int k = 0; k < 2; k++)
+        pthread_join(threads[k], NULL);
+
+    printf("rede simulada: %d ms +- %d ms, %.1f%% de perda; atraso de entrada %d ticks (%.1f ms); %.0f s de partida\n",
+           simulacao.latenciaMs, simulacao.variacaoMs, simulacao.perda, atrasoEntrada, atrasoEntrada * 1000.0 / TICKS_POR_SEGUNDO,
+           segundosPartida);
+    FILE* csv = NULL;
+    if (arquivoCsv != NULL) {
+        csv = fopen(arquivoCsv, "a");
+        if (csv == NULL) {
+            fprintf(stderr, "não foi possível abrir %s\n", arquivoCsv);
+            return 1;
+        }
+        if (ftell(csv) == 0)
+            fprintf(csv, "latencia_ms,variacao_ms,perda,atraso,jogador,ticks,rollbacks,rollbacks_pct,refeitos_medio,refeitos_max,"
+                         "esperas,sincronizacoes,passo_p50_us,passo_p99_us,passo_max_us,rollback_p99_us,rollback_max_us,"
+                         "janela_us,rtt_ms,pontos,sincronizado\n");
+    }
+    bool sincronizado = jogadores[0].ok && jogadores[1].ok && jogadores[0].resumo == jogadores[1].resumo;
+    for (int k = 0; k < 2; k++) {
+        Jogador* j = &jogadores[k];
+        const EstatisticasVersus* e = &j->sessao.estatisticas;
+        qsort(j->passos, (size_t)j->totalPassos, sizeof(float), CompararFloat);
+        qsort(j->passosRollback, (size_t)j->totalPassosRollback, sizeof(float), CompararFloat);
+        double pct = e->ticks > 0 ? 100.0 * e->rollbacks / e->ticks : 0.0;
+        double medio = e->rollbacks > 0 ? (double)e->ticksRefeitos / e->rollbacks : 0.0;
+        int numero = j->sessao.jogadorLocal;
+        printf("\njogador %d (porta %d): %lld ticks, %d pontos\n", numero, j->portaLocal, (long long)e->ticks, j->sessao.pontos[numero]);
+        printf("  rollbacks: %lld (%.1f%% dos ticks), %.1f ticks refeitos em média, no máximo %d\n", (long long)e->rollbacks, pct, medio,
+               e->maxRefeitos);
+        printf("  paradas: %lld com a janela cheia, %lld para sincronizar\n", (long long)e->esperas, (long long)e->sincronizacoes);
+        printf("  passo: p50 %.1f us, p99 %.1f us, máximo %.1f us; com rollback: p99 %.1f us, máximo %.1f us\n",
+               Percentil(j->passos, j->totalPassos, 50), Percentil(j->passos, j->totalPassos, 99),
+               Percentil(j->passos, j->totalPassos, 100), Percentil(j->passosRollback, j->totalPassosRollback, 99),
+               Percentil(j->passosRollback, j->totalPassosRollback, 100));
+        printf("  refazer a janela inteira (%d ticks): %.1f us = %.2f%% de um frame a 60 Hz\n", JANELA_ROLLBACK, j->janelaUs,
+               100.0 * j->janelaUs / ORCAMENTO_QUADRO_US);
+        printf("  rede: %lld pacotes enviados (%lld perdidos), %lld recebidos (%lld fora de ordem), rtt %.1f ms (máximo %.1f)\n",
+               (long long)j->conexao.pacotesEnviados, (long long)j->conexao.pacotesPerdidos, (long long)j->conexao.pacotesRecebidos,
+               (long long)j->conexao.pacotesForaDeOrdem, j->conexao.rttMs, j->conexao.rttMaximoMs);
+        if (csv != NULL)
+            fprintf(csv, "%d,%d,%.1f,%d,%d,%lld,%lld,%.2f,%.2f,%d,%lld,%lld,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d,%d\n", simulacao.latenciaMs,
+                    simulacao.variacaoMs, simulacao.perda, atrasoEntrada, numero, (long long)e->ticks, (long long)e->rollbacks, pct, medio,
+                    e->maxRefeitos, (long long)e->esperas, (long long)e->sincronizacoes, Percentil(j->passos, j->totalPassos, 50),
+                    Percentil(j->passos, j->totalPassos, 99), Percentil(j->passos, j->totalPassos, 100),
+                    Percentil(j->passosRollback, j->totalPassosRollback, 99), Percentil(j->passosRollback, j->totalPassosRollback, 100),
+                    j->janelaUs, j->conexao.rttMs, j->sessao.pontos[numero], sincronizado);
+        FecharConexaoVersus(&j->conexao);
+        LiberarSessaoVersus(&j->sessao);
+        LiberarEstadoJogo(&j->jogo);
+        free(j->passos);
+        free(j->passosRollback);
+    }
+    if (csv != NULL)
+        fclose(csv);
+    printf("\n%s\n", sincronizado ? "resultado: as duas máquinas terminaram no mesmo estado"
+                                   : "resultado: DESSINCRONIZADO (os estados finais são diferentes)");
+    return sincronizado ? 0 : 1;
+}
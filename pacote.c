@@ -0,0 +1,118 @@
+#include "pacote.h"
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Valida o cabeçalho e o índice de um pacote que já está na memória.
+static bool ValidarPacote(Pacote* pacote) {
+    if (pacote->tamanho < sizeof(CabecalhoPacote))
+        return false;
+    const CabecalhoPacote* cabecalho = (const CabecalhoPacote*)pacote->dados;
+    if (memcmp(cabecalho->magica, MAGICA_PACOTE, 4) != 0 || cabecalho->versao != VERSAO_PACOTE)
+        return false;
+    size_t tamanhoIndice = (size_t)cabecalho->totalEntradas * sizeof(EntradaPacote);
+    if (sizeof(CabecalhoPacote) + tamanhoIndice > pacote->tamanho)
+        return false;
+
+    pacote->entradas = (const EntradaPacote*)(pacote->dados + sizeof(CabecalhoPacote));
+    pacote->totalEntradas = cabecalho->totalEntradas;
+    // Nenhuma entrada pode apontar para fora do arquivo.
+    for (uint32_t i = 0; i < pacote->totalEntradas; i++) {
+        const EntradaPacote* e = &pacote->entradas[i];
+        if (e->deslocamento > pacote->tamanho || e->tamanho > pacote->tamanho - e->deslocamento)
+            return false;
+        if (memchr(e->nome, '\0', sizeof(e->nome)) == NULL)
+            return false;
+    }
+    return true;
+}
+
+bool AbrirPacoteMemoria(Pacote* pacote, const void* dados, size_t tamanho) {
+    memset(pacote, 0, sizeof(*pacote));
+    pacote->dados = (const uint8_t*)dados;
+    pacote->tamanho = tamanho;
+    if (!ValidarPacote(pacote)) {
+        memset(pacote, 0, sizeof(*pacote));
+        return false;
+    }
+    return true;
+}
+
+bool AbrirPacote(Pacote* pacote, const char* arquivo) {
+    memset(pacote, 0, sizeof(*pacote));
+#if defined(_WIN32)
+    HANDLE arquivoWin = CreateFileA(arquivo, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (arquivoWin == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER tamanho;
+    if (!GetFileSizeEx(arquivoWin, &tamanho) || tamanho.QuadPart == 0) {
+        CloseHandle(arquivoWin);
+        return false;
+    }
+    HANDLE mapeamento = CreateFileMappingA(arquivoWin, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(arquivoWin); // O mapeamento mantém o arquivo aberto.
+    if (mapeamento == NULL)
+        return false;
+    void* dados = MapViewOfFile(mapeamento, FILE_MAP_READ, 0, 0, 0);
+    if (dados == NULL) {
+        CloseHandle(mapeamento);
+        return false;
+    }
+    pacote->sistema = mapeamento;
+    size_t tamanhoArquivo = (size_t)tamanho.QuadPart;
+#else
+    int fd = open(arquivo, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* dados = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // O mapeamento continua válido depois de fechar o arquivo.
+    if (dados == MAP_FAILED)
+        return false;
+    size_t tamanhoArquivo = (size_t)info.st_size;
+#endif
+    pacote->dados = (const uint8_t*)dados;
+    pacote->tamanho = tamanhoArquivo;
+    pacote->mapeado = true;
+    if (!ValidarPacote(pacote)) {
+        FecharPacote(pacote);
+        return false;
+    }
+    return true;
+}
+
+void FecharPacote(Pacote* pacote) {
+    if (pacote->mapeado) {
+#if defined(_WIN32)
+        UnmapViewOfFile(pacote->dados);
+        CloseHandle((HANDLE)pacote->sistema);
+#else
+        munmap((void*)pacote->dados, pacote->tamanho);
+#endif
+    }
+    memset(pacote, 0, sizeof(*pacote));
+}
+
+const EntradaPacote* BuscarEntradaPacote(const Pacote* pacote, const char* nome) {
+    // São poucas entradas, então uma busca linear é suficiente.
+    for (uint32_t i = 0; i < pacote->totalEntradas; i++)
+        if (strncmp(pacote->entradas[i].nome, nome, sizeof(pacote->entradas[i].nome)) == 0)
+            return &pacote->entradas[i];
+    return NULL;
+}
+
+const void* DadosEntradaPacote(const Pacote* pacote, const EntradaPacote* entrada) {
+    return pacote->dados + entrada->deslocamento;
+}
@@ -0,0 +1,69 @@
+#ifndef PACOTE_H
+#define PACOTE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// --- PACOTE DE RECURSOS PRÉ-PROCESSADOS ---
+// Todos os recursos do jogo ficam em um único arquivo (barigueira.pak), com os pixels já decodificados no
+// formato que a GPU recebe. O arquivo é mapeado na memória (mmap), então carregar uma textura é só entregar
+// um ponteiro para a Raylib, sem ler nem decodificar PNG. Este módulo não depende da Raylib.
+//
+// Formato (little-endian):
+//   CabecalhoPacote
+//   EntradaPacote[totalEntradas]   <- índice
+//   dados de cada entrada, começando em múltiplos de ALINHAMENTO_PACOTE
+
+#define MAGICA_PACOTE "BPAK"          // Identifica o arquivo.
+#define VERSAO_PACOTE 1               // Deve ser incrementada sempre que o formato ou o conteúdo mudar de forma incompatível.
+#define ALINHAMENTO_PACOTE 4096       // Cada entrada começa no início de uma página de memória.
+#define ARQUIVO_PACOTE "barigueira.pak"
+
+typedef enum TipoEntradaPacote {
+    ENTRADA_TEXTURA = 0, // Pixels prontos para a GPU (largura x altura no formato de pixel da Raylib).
+    ENTRADA_DADOS = 1    // Bytes quaisquer (por exemplo, a descrição do atlas).
+} TipoEntradaPacote;
+
+typedef struct {
+    char magica[4];          // "BPAK".
+    uint32_t versao;         // VERSAO_PACOTE.
+    uint32_t totalEntradas;  // Quantas entradas existem no índice.
+    uint32_t reservado;
+} CabecalhoPacote;
+
+typedef struct {
+    char nome[32];           // Nome do recurso, terminado em '\0'.
+    uint32_t tipo;           // TipoEntradaPacote.
+    uint32_t largura;        // Só para texturas.
+    uint32_t altura;         // Só para texturas.
+    uint32_t formato;        // Formato de pixel da Raylib (PIXELFORMAT_*), só para texturas.
+    uint64_t deslocamento;   // Posição dos dados a partir do início do arquivo.
+    uint64_t tamanho;        // Tamanho dos dados em bytes.
+} EntradaPacote;
+
+typedef struct {
+    const uint8_t* dados;          // Início do arquivo mapeado (ou do pacote embutido no executável).
+    size_t tamanho;                // Tamanho total em bytes.
+    const EntradaPacote* entradas; // Índice, apontando para dentro de 'dados'.
+    uint32_t totalEntradas;
+    bool mapeado;                  // true se 'dados' veio de um mmap que precisa ser desfeito.
+    void* sistema;                 // Handle do mapeamento no Windows.
+} Pacote;
+
+// Mapeia o arquivo na memória e valida o cabeçalho e o índice. Retorna false se o arquivo não existir,
+// tiver outra versão ou estiver corrompido.
+bool AbrirPacote(Pacote* pacote, const char* arquivo);
+
+// Usa um pacote que já está na memória (por exemplo, embutido no executável). Os dados não são copiados.
+bool AbrirPacoteMemoria(Pacote* pacote, const void* dados, size_t tamanho);
+
+void FecharPacote(Pacote* pacote);
+
+// Procura uma entrada pelo nome. Retorna NULL se ela não existir.
+const EntradaPacote* BuscarEntradaPacote(const Pacote* pacote, const char* nome);
+
+// Ponteiro para os dados de uma entrada, dentro do arquivo mapeado.
+const void* DadosEntradaPacote(const Pacote* pacote, const EntradaPacote* entrada);
+
+#endif
@@ -0,0 +1,213 @@
+#include "particulas.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PARTICULAS_SSE2 1
+#else
+    #define PARTICULAS_SSE2 0
+#endif
+
+#define VENTO_CHUVA -0.18f // Inclinação da chuva: deslocamento horizontal por pixel de queda.
+
+static void* ReservarBloco(char** cursor, size_t tamanho) {
+    void* p = *cursor;
+    *cursor += (tamanho + 15) & ~(size_t)15; // Cada array começa alinhado em 16 bytes, o tamanho de um registrador SSE.
+    return p;
+}
+
+bool IniciarParticulas(SistemaParticulas* sistema, int capacidade) {
+    memset(sistema, 0, sizeof(*sistema));
+    capacidade = (capacidade + 3) & ~3;
+    size_t n = (size_t)capacidade;
+    size_t tamanho = 8 * ((n * sizeof(float) + 15) & ~(size_t)15) + ((n * sizeof(uint32_t) + 15) & ~(size_t)15) + 2 * ((n + 15) & ~(size_t)15);
+    sistema->memoria = malloc(tamanho + 15);
+    if (sistema->memoria == NULL)
+        return false;
+    memset(sistema->memoria, 0, tamanho + 15); // As lanes além de 'total' no último grupo do kernel ficam sempre definidas.
+    char* cursor = (char*)(((uintptr_t)sistema->memoria + 15) & ~(uintptr_t)15);
+    sistema->x = (float*)ReservarBloco(&cursor, n * sizeof(float));
+    sistema->y = (float*)ReservarBloco(&cursor, n * sizeof(float));
+    sistema->vx = (float*)ReservarBloco(&cursor, n * sizeof(float));
+    sistema->vy = (float*)ReservarBloco(&cursor, n * sizeof(float));
+    sistema->ay = (float*)ReservarBloco(&cursor, n * sizeof(float));
+    sistema->vida = (float*)ReservarBloco(&cursor, n * sizeof(float));
+    sistema->duracao = (float*)ReservarBloco(&cursor, n * sizeof(float));
+    sistema->tamanho = (float*)ReservarBloco(&cursor, n * sizeof(float));
+    sistema->cor = (uint32_t*)ReservarBloco(&cursor, n * sizeof(uint32_t));
+    sistema->valor = (int8_t*)ReservarBloco(&cursor, n);
+    sistema->tipo = (uint8_t*)ReservarBloco(&cursor, n);
+    sistema->capacidade = capacidade;
+    return true;
+}
+
+void LiberarParticulas(SistemaParticulas* sistema) {
+    free(sistema->memoria);
+    memset(sistema, 0, sizeof(*sistema));
+}
+
+void LimparParticulas(SistemaParticulas* sistema) {
+    sistema->total = 0;
+}
+
+// Move a última partícula viva para o lugar da partícula 'i'.
+static void RemoverParticula(SistemaParticulas* s, int i) {
+    int u = --s->total;
+    s->x[i] = s->x[u];
+    s->y[i] = s->y[u];
+    s->vx[i] = s->vx[u];
+    s->vy[i] = s->vy[u];
+    s->ay[i] = s->ay[u];
+    s->vida[i] = s->vida[u];
+    s->duracao[i] = s->duracao[u];
+    s->tamanho[i] = s->tamanho[u];
+    s->cor[i] = s->cor[u];
+    s->valor[i] = s->valor[u];
+    s->tipo[i] = s->tipo[u];
+}
+
+void AtualizarParticulas(SistemaParticulas* sistema, float dt, float limiteY, float alturaCiclo, bool reciclar) {
+    SistemaParticulas* s = sistema;
+    int n = s->total;
+    int mortas = 0;
+    int i = 0;
+
+#if PARTICULAS_SSE2
+    // Kernel: integra velocidade e posição, desconta a vida e trata quem passou do limite, quatro de cada vez.
+    // Os arrays têm capacidade múltipla de 4, então o último grupo pode ler partículas mortas sem sair do pool;
+    // elas são atualizadas à toa, mas nunca são desenhadas nem contadas.
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vlimite = _mm_set1_ps(limiteY);
+    const __m128 vciclo = _mm_set1_ps(alturaCiclo);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i < n; i += 4) {
+        __m128 vy = _mm_add_ps(_mm_load_ps(s->vy + i), _mm_mul_ps(_mm_load_ps(s->ay + i), vdt));
+        __m128 vx = _mm_load_ps(s->vx + i);
+        __m128 x = _mm_add_ps(_mm_load_ps(s->x + i), _mm_mul_ps(vx, vdt));
+        __m128 y = _mm_add_ps(_mm_load_ps(s->y + i), _mm_mul_ps(vy, vdt));
+        __m128 vida = _mm_sub_ps(_mm_load_ps(s->vida + i), vdt);
+        __m128 abaixo = _mm_cmpgt_ps(y, vlimite);
+        if (reciclar) {
+            // Sobe 'alturaCiclo' e desfaz o deslocamento do vento nessa subida, para a chuva não escorrer para o lado.
+            y = _mm_sub_ps(y, _mm_and_ps(abaixo, vciclo));
+            x = _mm_sub_ps(x, _mm_and_ps(abaixo, _mm_mul_ps(vciclo, _mm_div_ps(vx, _mm_max_ps(vy, _mm_set1_ps(1.0f))))));
+        } else {
+            vida = _mm_andnot_ps(abaixo, vida); // Vida 0 para quem passou do limite.
+        }
+        _mm_store_ps(s->x + i, x);
+        _mm_store_ps(s->y + i, y);
+        _mm_store_ps(s->vy + i, vy);
+        _mm_store_ps(s->vida + i, vida);
+        int validas = n - i >= 4 ? 0xF : (1 << (n - i)) - 1; // Lanes do último grupo depois de 'total' não contam.
+        mortas |= _mm_movemask_ps(_mm_cmple_ps(vida, zero)) & validas;
+    }
+#else
+    for (; i < n; i++) {
+        s->vy[i] += s->ay[i] * dt;
+        s->x[i] += s->vx[i] * dt;
+        s->y[i] += s->vy[i] * dt;
+        s->vida[i] -= dt;
+        if (s->y[i] > limiteY) {
+            if (reciclar) {
+                s->y[i] -= alturaCiclo;
+                s->x[i] -= alturaCiclo * s->vx[i] / fmaxf(s->vy[i], 1.0f);
+            } else {
+                s->vida[i] = 0.0f;
+            }
+        }
+        mortas |= s->vida[i] <= 0.0f;
+    }
+#endif
+
+    // Só percorre de novo se alguma partícula morreu (na chuva contínua, quase nunca).
+    if (mortas != 0) {
+        for (int k = 0; k < s->total;) {
+            if (s->vida[k] <= 0.0f)
+                RemoverParticula(s, k); // A partícula trazida do fim também é testada.
+            else
+                k++;
+        }
+    }
+}
+
+// Número entre 0 e 1.
+static float SortearFracao(GeradorAleatorio* gerador) {
+    return SortearValor(gerador, 0, 1 << 24) / (float)(1 << 24);
+}
+
+static float SortearEntre(GeradorAleatorio* gerador, float min, float max) {
+    return min + (max - min) * SortearFracao(gerador);
+}
+
+static uint32_t Rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    return (uint32_t)r | (uint32_t)g << 8 | (uint32_t)b << 16 | (uint32_t)a << 24;
+}
+
+// Reserva uma partícula nova. Retorna -1 com o pool cheio.
+static int NovaParticula(SistemaParticulas* s, TipoParticula tipo) {
+    if (s->total == s->capacidade)
+        return -1;
+    int i = s->total++;
+    s->tipo[i] = (uint8_t)tipo;
+    s->ay[i] = 0.0f;
+    s->valor[i] = 0;
+    return i;
+}
+
+void EmitirChuva(SistemaParticulas* sistema, GeradorAleatorio* gerador, int totalGotas, float larguraTela, float alturaTela) {
+    // A chuva cai inclinada para a esquerda, então as gotas nascem também à direita da tela.
+    float margem = alturaTela * -VENTO_CHUVA;
+    while (sistema->total < totalGotas) {
+        int i = NovaParticula(sistema, PARTICULA_CHUVA);
+        if (i < 0)
+            return;
+        float vy = SortearEntre(gerador, 900.0f, 1300.0f);
+        sistema->vy[i] = vy;
+        sistema->vx[i] = vy * VENTO_CHUVA;
+        sistema->x[i] = SortearEntre(gerador, 0.0f, larguraTela + margem);
+        sistema->y[i] = SortearEntre(gerador, -alturaTela, 0.0f); // Acima da tela: entram caindo, não aparecem de repente.
+        sistema->tamanho[i] = SortearEntre(gerador, 12.0f, 24.0f);
+        sistema->vida[i] = 1e9f; // A gota só morre ao passar do chão depois que a chuva para.
+        sistema->duracao[i] = 1e9f;
+        sistema->cor[i] = Rgba(170, 200, 255, (uint8_t)SortearValor(gerador, 90, 180));
+    }
+}
+
+void EmitirAcerto(SistemaParticulas* sistema, GeradorAleatorio* gerador, float x, float y, TipoCapivara tipo, int pontos) {
+    // Cores das faíscas: brancas e amarelas na capivara, douradas na dourada, vermelhas na cutia.
+    uint32_t cores[3][2] = {
+        { Rgba(255, 255, 255, 255), Rgba(255, 230, 120, 255) },
+        { Rgba(255, 203, 0, 255), Rgba(255, 161, 0, 255) },
+        { Rgba(230, 41, 55, 255), Rgba(190, 33, 55, 255) },
+    };
+    int faiscas = tipo == DOURADA ? 40 : 24;
+    for (int k = 0; k < faiscas; k++) {
+        int i = NovaParticula(sistema, PARTICULA_FAISCA);
+        if (i < 0)
+            break;
+        float angulo = SortearEntre(gerador, 0.0f, 6.2831853f);
+        float velocidade = SortearEntre(gerador, 150.0f, 450.0f);
+        sistema->x[i] = x;
+        sistema->y[i] = y;
+        sistema->vx[i] = cosf(angulo) * velocidade;
+        sistema->vy[i] = sinf(angulo) * velocidade - 150.0f; // Um pouco para cima.
+        sistema->ay[i] = 900.0f;
+        sistema->vida[i] = sistema->duracao[i] = SortearEntre(gerador, 0.35f, 0.8f);
+        sistema->tamanho[i] = SortearEntre(gerador, 3.0f, 7.0f);
+        sistema->cor[i] = cores[tipo][k & 1];
+    }
+
+    int i = NovaParticula(sistema, PARTICULA_PONTOS);
+    if (i < 0)
+        return;
+    sistema->x[i] = x;
+    sistema->y[i] = y - 30.0f;
+    sistema->vx[i] = 0.0f;
+    sistema->vy[i] = -140.0f;
+    sistema->ay[i] = 120.0f; // Sobe cada vez mais devagar.
+    sistema->vida[i] = sistema->duracao[i] = 0.9f;
+    sistema->tamanho[i] = 40.0f;
+    sistema->valor[i] = (int8_t)pontos;
+    sistema->cor[i] = pontos > 0 ? (tipo == DOURADA ? Rgba(255, 203, 0, 255) : Rgba(255, 255, 255, 255)) : Rgba(230, 41, 55, 255);
+}
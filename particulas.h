@@ -0,0 +1,58 @@
+#ifndef PARTICULAS_H
+#define PARTICULAS_H
+
+#include "logica.h" // GeradorAleatorio e TipoCapivara.
+
+// --- SISTEMA DE PARTÍCULAS ---
+// Gotas de chuva, faíscas dos acertos e os pontos que sobem de cada animal acertado. Cada sistema é um pool de
+// capacidade fixa em estrutura de arrays (um array contínuo por campo), e a atualização passa por todos os
+// campos com SSE2, quatro partículas por instrução; sem SSE2 o mesmo laço roda em C puro. As partículas mortas
+// são removidas trocando com a última, então as vivas ficam sempre em [0, total).
+// A simulação não depende da Raylib; o desenho, em um único lote com a textura da fonte, fica no JogoC.c.
+//
+// As partículas não fazem parte da lógica da partida: usam o seu próprio gerador de números aleatórios, então
+// a gravação e a reprodução de uma partida não mudam com elas.
+
+typedef enum TipoParticula {
+    PARTICULA_CHUVA,  // Gota: risco fino que cai inclinado pelo vento.
+    PARTICULA_FAISCA, // Faísca de um acerto: quadrado que cai com a gravidade e some aos poucos.
+    PARTICULA_PONTOS  // Pontos ganhos ou perdidos ("+1", "-3"), subindo do animal acertado.
+} TipoParticula;
+
+typedef struct {
+    // Campos atualizados pelo kernel a cada frame.
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    float* ay;        // Aceleração vertical (gravidade das faíscas, freio dos pontos, 0 na chuva).
+    float* vida;      // Segundos até a partícula morrer.
+    // Campos só lidos no desenho.
+    float* duracao;   // Vida inicial, para o desbotamento.
+    float* tamanho;   // Comprimento da gota, lado da faísca.
+    uint32_t* cor;    // RGBA, um byte por canal (r no byte mais baixo).
+    int8_t* valor;    // Pontos mostrados por PARTICULA_PONTOS.
+    uint8_t* tipo;    // TipoParticula.
+    void* memoria;    // Bloco único com todos os arrays.
+    int total;        // Partículas vivas.
+    int capacidade;   // Múltiplo de 4.
+} SistemaParticulas;
+
+// Aloca o pool. Retorna false sem memória.
+bool IniciarParticulas(SistemaParticulas* sistema, int capacidade);
+void LiberarParticulas(SistemaParticulas* sistema);
+
+// Mata todas as partículas (nova partida).
+void LimparParticulas(SistemaParticulas* sistema);
+
+// Avança 'dt' segundos. Partículas abaixo de 'limiteY' voltam para cima (se 'reciclar') ou morrem;
+// 'alturaCiclo' é quanto uma partícula reciclada sobe.
+void AtualizarParticulas(SistemaParticulas* sistema, float dt, float limiteY, float alturaCiclo, bool reciclar);
+
+// Completa a chuva até 'totalGotas' gotas, espalhadas acima da tela para entrarem caindo.
+void EmitirChuva(SistemaParticulas* sistema, GeradorAleatorio* gerador, int totalGotas, float larguraTela, float alturaTela);
+
+// Faíscas e pontos de um acerto no animal de 'tipo' com centro em (x, y).
+void EmitirAcerto(SistemaParticulas* sistema, GeradorAleatorio* gerador, float x, float y, TipoCapivara tipo, int pontos);
+
+#endif
@@ -0,0 +1,196 @@
+#include "perfil.h"
+
+#if PERFIL_HABILITADO
+
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROFUNDIDADE_MAXIMA 8          // Fases aninhadas ao mesmo tempo.
+#define MAX_QUADROS_SESSAO (1 << 19)   // Frames guardados para o CSV (mais de 2 horas a 60 FPS).
+
+static const char* NOMES_FASES[TOTAL_FASES] = {
+    [FASE_CARGA]        = "Carga",
+    [FASE_LOGICA]       = "AtualizarJogo",
+    [FASE_JOGO]         = "DesenharJogo",
+    [FASE_TELAS]        = "Menus e botoes",
+    [FASE_TEXTO]        = "Texto",
+    [FASE_PARTICULAS]   = "Particulas",
+    [FASE_PAINEIS]      = "Paineis",
+    [FASE_APRESENTACAO] = "EndDrawing",
+    [FASE_ESPERA]       = "Espera",
+};
+
+// Mesmas cores da paleta da Raylib, escritas por extenso para poderem ser usadas em uma constante estática.
+static const Color CORES_FASES[TOTAL_FASES] = {
+    [FASE_CARGA]        = { 200, 122, 255, 255 }, // PURPLE
+    [FASE_LOGICA]       = { 230, 41, 55, 255 },   // RED
+    [FASE_JOGO]         = { 255, 161, 0, 255 },   // ORANGE
+    [FASE_TELAS]        = { 253, 249, 0, 255 },   // YELLOW
+    [FASE_TEXTO]        = { 211, 176, 131, 255 }, // BEIGE
+    [FASE_PARTICULAS]   = { 0, 121, 241, 255 },   // BLUE
+    [FASE_PAINEIS]      = { 255, 109, 194, 255 }, // PINK
+    [FASE_APRESENTACAO] = { 102, 191, 255, 255 }, // SKYBLUE
+    [FASE_ESPERA]       = { 80, 80, 80, 255 },    // DARKGRAY
+};
+
+// Uma fase aberta: quando começou e quanto tempo as fases de dentro dela já gastaram.
+typedef struct {
+    FasePerfil fase;
+    double inicio;
+    double filhos;
+} FaseAberta;
+
+// Tempos de um frame, em milissegundos.
+typedef struct {
+    float fases[TOTAL_FASES];
+    float total;
+} AmostraPerfil;
+
+static FaseAberta pilha[PROFUNDIDADE_MAXIMA];
+static int profundidade;
+static AmostraPerfil quadroAtual;
+static double inicioQuadro;                       // 0 antes do primeiro frame.
+static AmostraPerfil historico[QUADROS_GRAFICO];  // Últimos frames completos (anel).
+static int proximoHistorico;
+static int totalHistorico;
+static AmostraPerfil* sessao;                     // Todos os frames da sessão, para o CSV.
+static int totalSessao;
+static int capacidadeSessao;
+
+void EntrarFasePerfil(FasePerfil fase) {
+    if (profundidade == PROFUNDIDADE_MAXIMA)
+        return;
+    pilha[profundidade++] = (FaseAberta){ fase, GetTime(), 0.0 };
+}
+
+void SairFasePerfil(void) {
+    if (profundidade == 0)
+        return;
+    FaseAberta* f = &pilha[--profundidade];
+    double duracao = GetTime() - f->inicio;
+    quadroAtual.fases[f->fase] += (float)((duracao - f->filhos) * 1000.0); // Só o tempo próprio da fase.
+    if (profundidade > 0)
+        pilha[profundidade - 1].filhos += duracao;
+}
+
+// Guarda o frame completo no anel do gráfico e nas amostras da sessão.
+static void RegistrarQuadro(const AmostraPerfil* amostra) {
+    historico[proximoHistorico] = *amostra;
+    proximoHistorico = (proximoHistorico + 1) % QUADROS_GRAFICO;
+    if (totalHistorico < QUADROS_GRAFICO)
+        totalHistorico++;
+
+    if (totalSessao == capacidadeSessao && capacidadeSessao < MAX_QUADROS_SESSAO) {
+        int novaCapacidade = capacidadeSessao == 0 ? 4096 : capacidadeSessao * 2;
+        AmostraPerfil* novo = (AmostraPerfil*)realloc(sessao, (size_t)novaCapacidade * sizeof(AmostraPerfil));
+        if (novo != NULL) {
+            sessao = novo;
+            capacidadeSessao = novaCapacidade;
+        }
+    }
+    if (totalSessao < capacidadeSessao)
+        sessao[totalSessao++] = *amostra;
+}
+
+void IniciarQuadroPerfil(void) {
+    double agora = GetTime();
+    if (inicioQuadro > 0.0) {
+        quadroAtual.total = (float)((agora - inicioQuadro) * 1000.0);
+        RegistrarQuadro(&quadroAtual);
+    }
+    memset(&quadroAtual, 0, sizeof(quadroAtual));
+    inicioQuadro = agora;
+    profundidade = 0; // Uma fase esquecida aberta não contamina o próximo frame.
+}
+
+static int CompararFloat(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+// Valor no percentil 'p' (0 a 100) de um array já ordenado.
+static float Percentil(const float* ordenados, int total, float p) {
+    int i = (int)(p / 100.0f * (total - 1) + 0.5f);
+    return ordenados[i];
+}
+
+void DesenharPerfil(int x, int y) {
+    // Desenhado direto com a Raylib, como o painel de lotes, para não entrar na contagem de chamadas.
+    const int largura = 360, altura = 350;
+    DrawRectangle(x, y, largura, altura, Fade(BLACK, 0.75f));
+    if (totalHistorico == 0)
+        return;
+
+    // Médias por fase nos últimos frames.
+    float medias[TOTAL_FASES] = {0};
+    float ordenados[QUADROS_GRAFICO];
+    float maiorQuadro = 0.0f;
+    for (int i = 0; i < totalHistorico; i++) {
+        for (int f = 0; f < TOTAL_FASES; f++)
+            medias[f] += historico[i].fases[f] / totalHistorico;
+        ordenados[i] = historico[i].total;
+        if (historico[i].total > maiorQuadro)
+            maiorQuadro = historico[i].total;
+    }
+    qsort(ordenados, (size_t)totalHistorico, sizeof(float), CompararFloat);
+
+    const AmostraPerfil* ultimo = &historico[(proximoHistorico + QUADROS_GRAFICO - 1) % QUADROS_GRAFICO];
+    int linha = y + 8;
+    DrawText(TextFormat("Frame: %.2f ms (%d frames)", ultimo->total, totalHistorico), x + 10, linha, 18, WHITE);
+    linha += 22;
+    DrawText(TextFormat("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f", Percentil(ordenados, totalHistorico, 50), Percentil(ordenados, totalHistorico, 95),
+             Percentil(ordenados, totalHistorico, 99), ordenados[totalHistorico - 1]), x + 10, linha, 16, WHITE);
+    linha += 26;
+    for (int f = 0; f < TOTAL_FASES; f++) {
+        DrawRectangle(x + 10, linha + 3, 10, 10, CORES_FASES[f]);
+        DrawText(TextFormat("%-16s %6.2f ms", NOMES_FASES[f], medias[f]), x + 26, linha, 16, WHITE);
+        linha += 20;
+    }
+
+    // Gráfico dos últimos frames: cada coluna é um frame, dividida pelas fases. A linha verde marca 16,7 ms (60 FPS).
+    const int alturaGrafico = 100;
+    int baseGrafico = y + altura - 8;
+    float escala = alturaGrafico / (maiorQuadro > 33.3f ? maiorQuadro : 33.3f);
+    float larguraColuna = (float)(largura - 20) / QUADROS_GRAFICO;
+    for (int i = 0; i < totalHistorico; i++) {
+        const AmostraPerfil* a = &historico[(proximoHistorico + QUADROS_GRAFICO - totalHistorico + i) % QUADROS_GRAFICO];
+        float topo = (float)baseGrafico;
+        for (int f = 0; f < TOTAL_FASES; f++) {
+            float h = a->fases[f] * escala;
+            topo -= h;
+            DrawRectangleRec((Rectangle){ x + 10 + i * larguraColuna, topo, larguraColuna, h }, CORES_FASES[f]);
+        }
+    }
+    int linha60 = baseGrafico - (int)(16.7f * escala);
+    DrawLine(x + 10, linha60, x + largura - 10, linha60, GREEN);
+}
+
+bool SalvarPerfilCsv(const char* arquivo) {
+    FILE* f = fopen(arquivo, "w");
+    if (f == NULL)
+        return false;
+    fprintf(f, "quadro,total_ms");
+    for (int i = 0; i < TOTAL_FASES; i++)
+        fprintf(f, ",%s", NOMES_FASES[i]);
+    fprintf(f, "\n");
+    for (int q = 0; q < totalSessao; q++) {
+        fprintf(f, "%d,%.4f", q, sessao[q].total);
+        for (int i = 0; i < TOTAL_FASES; i++)
+            fprintf(f, ",%.4f", sessao[q].fases[i]);
+        fprintf(f, "\n");
+    }
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+void EncerrarPerfil(void) {
+    free(sessao);
+    sessao = NULL;
+    totalSessao = 0;
+    capacidadeSessao = 0;
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef PERFIL_H
+#define PERFIL_H
+
+#include <stdbool.h>
+
+// --- PERFILADOR DE FRAMES ---
+// Mede quanto tempo cada fase do loop principal ocupa em cada frame e mostra um painel (tecla F3) com o tempo
+// médio de cada fase, um gráfico dos últimos frames e os percentis p50/p95/p99 e o máximo do tempo de frame.
+// Todos os frames da sessão podem ser gravados em CSV no fim (opção --perfil).
+//
+// Uma fase é medida envolvendo o código com PERFIL_BLOCO:
+//
+//     PERFIL_BLOCO(FASE_LOGICA) {
+//         AtualizarJogo();
+//     }
+//
+// Fases podem ser aninhadas; o tempo de uma fase não inclui o das fases de dentro dela. O bloco não pode ser
+// abandonado com return, break ou goto, senão a fase não é encerrada.
+//
+// Em builds de release (NDEBUG) o perfilador some: PERFIL_BLOCO vira um bloco comum e as outras funções não
+// fazem nada. Para medir um build otimizado, compile com -DPERFIL_ATIVO.
+
+#if !defined(NDEBUG) || defined(PERFIL_ATIVO)
+    #define PERFIL_HABILITADO 1
+#else
+    #define PERFIL_HABILITADO 0
+#endif
+
+// Fases do loop principal, na ordem em que aparecem no painel e no CSV.
+typedef enum FasePerfil {
+    FASE_CARGA,         // Envio das texturas carregadas em segundo plano para a GPU.
+    FASE_LOGICA,        // AtualizarJogo: simulação da partida.
+    FASE_JOGO,          // DesenharJogo: campo de jogo e interface da partida.
+    FASE_TELAS,         // Menus, botões e o resto das telas.
+    FASE_TEXTO,         // Layout e desenho de texto (texto.c), descontado das fases em que aparece.
+    FASE_PARTICULAS,    // Atualização e desenho da chuva, das faíscas e dos pontos.
+    FASE_PAINEIS,       // Painéis de depuração (F2 e F3).
+    FASE_APRESENTACAO,  // EndDrawing: envio do frame para a GPU e troca de buffers (inclui a espera do vsync, se ativo).
+    FASE_ESPERA,        // Espera até o próximo frame, lendo a entrada.
+    TOTAL_FASES
+} FasePerfil;
+
+#define QUADROS_GRAFICO 240 // Frames mostrados no gráfico e usados nos percentis.
+
+#if PERFIL_HABILITADO
+
+#define PERFIL_BLOCO(fase) for (int perfil_##fase = (EntrarFasePerfil(fase), 1); perfil_##fase; perfil_##fase = (SairFasePerfil(), 0))
+
+// Fecha o frame anterior e começa a medir um novo. Deve ser chamada no início de cada frame.
+void IniciarQuadroPerfil(void);
+
+void EntrarFasePerfil(FasePerfil fase);
+void SairFasePerfil(void);
+
+// Desenha o painel com os tempos do último frame completo e dos últimos QUADROS_GRAFICO frames.
+void DesenharPerfil(int x, int y);
+
+// Grava todos os frames da sessão em CSV (um frame por linha, tempos em milissegundos).
+bool SalvarPerfilCsv(const char* arquivo);
+
+// Libera a memória com as amostras da sessão.
+void EncerrarPerfil(void);
+
+#else
+
+#define PERFIL_BLOCO(fase)
+#define IniciarQuadroPerfil() ((void)0)
+#define EntrarFasePerfil(fase) ((void)0)
+#define SairFasePerfil() ((void)0)
+#define DesenharPerfil(x, y) ((void)0)
+#define SalvarPerfilCsv(arquivo) (false)
+#define EncerrarPerfil() ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,470 @@
+#define _POSIX_C_SOURCE 200809L // fileno, fsync e ftruncate.
+#include "placar.h"
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#define TAMANHO_CABECALHO_LOG 12     // Mágica, versão, 3 bytes reservados e geração.
+#define TAMANHO_CABECALHO_INDICE 24  // Mágica, versão, 3 bytes reservados, geração e o total de cada dificuldade.
+#define TAMANHO_REGISTRO_LOG (TAMANHO_REGISTRO_PLACAR + 4) // Registro e soma de verificação.
+
+// --- CODIFICAÇÃO ---
+// Little-endian byte a byte, como na gravação: os arquivos e as mensagens são os mesmos em qualquer plataforma.
+
+static uint8_t* EscreverU32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++)
+        *p++ = (uint8_t)(v >> (8 * i));
+    return p;
+}
+
+static uint8_t* EscreverU64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; i++)
+        *p++ = (uint8_t)(v >> (8 * i));
+    return p;
+}
+
+static uint32_t LerU32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++)
+        v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static uint64_t LerU64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++)
+        v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+// FNV-1a dos bytes: detecta um registro cortado ou um índice corrompido.
+static uint32_t SomaVerificacao(const uint8_t* p, size_t tamanho) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < tamanho; i++)
+        h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+void CodificarRegistroPlacar(uint8_t* p, const RegistroPlacar* registro) {
+    p = EscreverU32(p, (uint32_t)registro->pontos);
+    *p++ = registro->dificuldade;
+    *p++ = 0;
+    *p++ = 0;
+    *p++ = 0;
+    p = EscreverU64(p, (uint64_t)registro->data);
+    EscreverU64(p, registro->semente);
+}
+
+void DecodificarRegistroPlacar(const uint8_t* p, RegistroPlacar* registro) {
+    registro->pontos = (int32_t)LerU32(p);
+    registro->dificuldade = p[4];
+    registro->data = (int64_t)LerU64(p + 8);
+    registro->semente = LerU64(p + 16);
+}
+
+// --- ARQUIVOS ---
+
+// Envia ao disco o que foi escrito em 'f' (não só ao sistema operacional).
+static bool SincronizarArquivo(FILE* f) {
+    if (fflush(f) != 0)
+        return false;
+#if defined(_WIN32)
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+// Troca 'destino' por 'temporario' de uma vez: quem abrir 'destino' vê o arquivo antigo ou o novo, nunca metade.
+static bool SubstituirArquivo(const char* temporario, const char* destino) {
+#if defined(_WIN32)
+    return MoveFileExA(temporario, destino, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (rename(temporario, destino) != 0)
+        return false;
+    // A troca de nome só é definitiva depois que a pasta também é sincronizada.
+    char pasta[260];
+    snprintf(pasta, sizeof(pasta), "%s", destino);
+    char* barra = strrchr(pasta, '/');
+    if (barra != NULL)
+        *barra = '\0';
+    else
+        snprintf(pasta, sizeof(pasta), ".");
+    int fd = open(pasta, O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+    return true;
+#endif
+}
+
+static bool TruncarArquivo(FILE* f, long tamanho) {
+    fflush(f);
+#if defined(_WIN32)
+    return _chsize_s(_fileno(f), tamanho) == 0;
+#else
+    return ftruncate(fileno(f), (off_t)tamanho) == 0;
+#endif
+}
+
+// Lê o arquivo inteiro. Retorna NULL se ele não existir ou não puder ser lido.
+static uint8_t* LerArquivoInteiro(const char* caminho, size_t* tamanho) {
+    FILE* f = fopen(caminho, "rb");
+    if (f == NULL)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long fim = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t* buffer = fim >= 0 ? (uint8_t*)malloc((size_t)fim + 1) : NULL;
+    if (buffer != NULL && fread(buffer, 1, (size_t)fim, f) != (size_t)fim) {
+        free(buffer);
+        buffer = NULL;
+    }
+    fclose(f);
+    *tamanho = (size_t)fim;
+    return buffer;
+}
+
+// Grava 'dados' em um arquivo temporário, sincroniza e o coloca no lugar de 'destino'.
+static bool GravarArquivoSeguro(const char* destino, const uint8_t* dados, size_t tamanho) {
+    char temporario[270];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", destino);
+    FILE* f = fopen(temporario, "wb");
+    if (f == NULL)
+        return false;
+    bool ok = fwrite(dados, 1, tamanho, f) == tamanho && SincronizarArquivo(f);
+    if (fclose(f) != 0)
+        ok = false;
+    if (ok)
+        ok = SubstituirArquivo(temporario, destino);
+    if (!ok)
+        remove(temporario);
+    return ok;
+}
+
+// Abre o log para acrescentar, sem buffer: cada lote já vai em uma escrita só, e uma escrita que falhar não deixa
+// bytes no buffer para sair depois de o log ser cortado.
+static FILE* AbrirLog(const char* caminho) {
+    FILE* f = fopen(caminho, "ab");
+    if (f != NULL)
+        setvbuf(f, NULL, _IONBF, 0);
+    return f;
+}
+
+static void CabecalhoLog(uint8_t* p, uint32_t geracao) {
+    memcpy(p, MAGICA_LOG_PLACAR, 4);
+    p[4] = VERSAO_PLACAR;
+    p[5] = p[6] = p[7] = 0;
+    EscreverU32(p + 8, geracao);
+}
+
+// --- LISTAS ORDENADAS ---
+
+// true se 'a' vem antes de 'b' no placar: mais pontos, depois o mais antigo, depois a menor semente.
+static bool VemAntes(const RegistroPlacar* a, const RegistroPlacar* b) {
+    if (a->pontos != b->pontos)
+        return a->pontos > b->pontos;
+    if (a->data != b->data)
+        return a->data < b->data;
+    return a->semente < b->semente;
+}
+
+static bool ReservarLista(ListaPlacar* lista, int capacidade) {
+    if (capacidade <= lista->capacidade)
+        return true;
+    int nova = lista->capacidade == 0 ? 256 : lista->capacidade;
+    while (nova < capacidade)
+        nova *= 2;
+    RegistroPlacar* registros = (RegistroPlacar*)realloc(lista->registros, (size_t)nova * sizeof(RegistroPlacar));
+    if (registros == NULL)
+        return false;
+    lista->registros = registros;
+    lista->capacidade = nova;
+    return true;
+}
+
+// Quantos registros da lista têm mais que 'pontos' (busca binária: a lista está em ordem decrescente).
+static int ContarMaiores(const ListaPlacar* lista, int pontos) {
+    int inicio = 0, fim = lista->total;
+    while (inicio < fim) {
+        int meio = (inicio + fim) / 2;
+        if (lista->registros[meio].pontos > pontos)
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+    return inicio;
+}
+
+// Intercala os registros recentes da dificuldade na lista do índice, de trás para frente, sem memória extra.
+static bool IntercalarRecentes(Placar* placar, int d) {
+    ListaPlacar* indice = &placar->indice[d];
+    ListaPlacar* recentes = &placar->recentes[d];
+    if (recentes->total == 0)
+        return true;
+    if (!ReservarLista(indice, indice->total + recentes->total))
+        return false;
+    int i = indice->total - 1, r = recentes->total - 1, destino = indice->total + recentes->total - 1;
+    while (r >= 0) {
+        if (i >= 0 && VemAntes(&recentes->registros[r], &indice->registros[i]))
+            indice->registros[destino--] = indice->registros[i--];
+        else
+            indice->registros[destino--] = recentes->registros[r--];
+    }
+    indice->total += recentes->total;
+    recentes->total = 0;
+    return true;
+}
+
+// Insere um registro na lista de recentes, na sua posição. Com a lista cheia, ela é intercalada antes.
+static bool InserirRecente(Placar* placar, const RegistroPlacar* registro) {
+    int d = registro->dificuldade;
+    ListaPlacar* recentes = &placar->recentes[d];
+    if (recentes->total >= MAX_RECENTES_PLACAR && !IntercalarRecentes(placar, d))
+        return false;
+    if (!ReservarLista(recentes, recentes->total + 1))
+        return false;
+    int inicio = 0, fim = recentes->total; // Primeira posição cujo registro não vem antes do novo.
+    while (inicio < fim) {
+        int meio = (inicio + fim) / 2;
+        if (VemAntes(&recentes->registros[meio], registro))
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+    memmove(&recentes->registros[inicio + 1], &recentes->registros[inicio], (size_t)(recentes->total - inicio) * sizeof(RegistroPlacar));
+    recentes->registros[inicio] = *registro;
+    recentes->total++;
+    return true;
+}
+
+// --- ABERTURA ---
+
+// Lê o arquivo de índice. Retorna false se ele estiver corrompido.
+static bool CarregarIndice(Placar* placar, const uint8_t* dados, size_t tamanho) {
+    if (tamanho < TAMANHO_CABECALHO_INDICE + 4 || memcmp(dados, MAGICA_INDICE_PLACAR, 4) != 0 || dados[4] != VERSAO_PLACAR)
+        return false;
+    if (LerU32(dados + tamanho - 4) != SomaVerificacao(dados, tamanho - 4))
+        return false;
+    uint32_t totais[3];
+    size_t registros = 0;
+    for (int d = 0; d < 3; d++) {
+        totais[d] = LerU32(dados + 12 + 4 * d);
+        registros += totais[d];
+    }
+    if (TAMANHO_CABECALHO_INDICE + registros * TAMANHO_REGISTRO_PLACAR + 4 != tamanho)
+        return false;
+    placar->geracao = LerU32(dados + 8);
+    const uint8_t* p = dados + TAMANHO_CABECALHO_INDICE;
+    for (int d = 0; d < 3; d++) {
+        ListaPlacar* lista = &placar->indice[d];
+        if (!ReservarLista(lista, (int)totais[d]))
+            return false;
+        for (uint32_t k = 0; k < totais[d]; k++, p += TAMANHO_REGISTRO_PLACAR)
+            DecodificarRegistroPlacar(p, &lista->registros[k]);
+        lista->total = (int)totais[d];
+    }
+    return true;
+}
+
+bool AbrirPlacar(Placar* placar, const char* base) {
+    memset(placar, 0, sizeof(*placar));
+    snprintf(placar->caminhoIndice, sizeof(placar->caminhoIndice), "%s.idx", base);
+    snprintf(placar->caminhoLog, sizeof(placar->caminhoLog), "%s.log", base);
+
+    size_t tamanho = 0;
+    uint8_t* dados = LerArquivoInteiro(placar->caminhoIndice, &tamanho);
+    if (dados != NULL) {
+        bool ok = CarregarIndice(placar, dados, tamanho);
+        free(dados);
+        if (!ok) {
+            FecharPlacar(placar);
+            return false;
+        }
+    }
+
+    // O log: só os registros inteiros e com a soma certa, até o primeiro que não for.
+    size_t validos = 0;
+    dados = LerArquivoInteiro(placar->caminhoLog, &tamanho);
+    if (dados != NULL && tamanho >= TAMANHO_CABECALHO_LOG && memcmp(dados, MAGICA_LOG_PLACAR, 4) == 0 && dados[4] == VERSAO_PLACAR) {
+        uint32_t geracaoLog = LerU32(dados + 8);
+        // Um log de geração anterior já foi todo para o índice (a compactação caiu antes de trocar o log).
+        if (geracaoLog >= placar->geracao) {
+            placar->geracao = geracaoLog;
+            validos = TAMANHO_CABECALHO_LOG;
+            while (validos + TAMANHO_REGISTRO_LOG <= tamanho) {
+                const uint8_t* p = dados + validos;
+                RegistroPlacar registro;
+                DecodificarRegistroPlacar(p, &registro);
+                if (LerU32(p + TAMANHO_REGISTRO_PLACAR) != SomaVerificacao(p, TAMANHO_REGISTRO_PLACAR) || registro.dificuldade > DIFICIL)
+                    break;
+                if (!InserirRecente(placar, &registro)) {
+                    // Sem memória: o resto do log é bom e não pode ser cortado como um registro quebrado.
+                    free(dados);
+                    FecharPlacar(placar);
+                    return false;
+                }
+                placar->registrosLog++;
+                validos += TAMANHO_REGISTRO_LOG;
+            }
+        }
+    }
+    free(dados);
+
+    if (validos == 0) {
+        // Sem log válido: começa um vazio da geração do índice.
+        uint8_t cabecalho[TAMANHO_CABECALHO_LOG];
+        CabecalhoLog(cabecalho, placar->geracao);
+        if (!GravarArquivoSeguro(placar->caminhoLog, cabecalho, sizeof(cabecalho))) {
+            FecharPlacar(placar);
+            return false;
+        }
+        tamanho = validos = TAMANHO_CABECALHO_LOG;
+    }
+    placar->log = AbrirLog(placar->caminhoLog);
+    if (placar->log == NULL) {
+        FecharPlacar(placar);
+        return false;
+    }
+    if (validos < tamanho) // Um registro cortado no fim: é descartado para os próximos entrarem logo depois do último bom.
+        TruncarArquivo(placar->log, (long)validos);
+    return true;
+}
+
+void FecharPlacar(Placar* placar) {
+    if (placar->log != NULL)
+        fclose(placar->log);
+    for (int d = 0; d < 3; d++) {
+        free(placar->indice[d].registros);
+        free(placar->recentes[d].registros);
+    }
+    memset(placar, 0, sizeof(*placar));
+}
+
+// --- ESCRITA ---
+
+bool AdicionarPontuacoes(Placar* placar, const RegistroPlacar* registros, int total, PosicaoPlacar* posicoes) {
+    if (placar->log == NULL || total <= 0)
+        return placar->log != NULL;
+    for (int k = 0; k < total; k++)
+        if (registros[k].dificuldade > DIFICIL)
+            return false;
+
+    // Fim do último lote bom. Se a escrita falhar no meio, o pedaço gravado é cortado: senão a abertura pararia nele
+    // e perderia os lotes gravados depois.
+    if (fseek(placar->log, 0, SEEK_END) != 0)
+        return false;
+    long anterior = ftell(placar->log);
+    if (anterior < 0)
+        return false;
+
+    // O lote inteiro vai em uma escrita só: com a sincronização ligada, é um fsync por lote e não por registro.
+    size_t tamanho = (size_t)total * TAMANHO_REGISTRO_LOG;
+    uint8_t* buffer = (uint8_t*)malloc(tamanho);
+    if (buffer == NULL)
+        return false;
+    for (int k = 0; k < total; k++) {
+        uint8_t* p = buffer + (size_t)k * TAMANHO_REGISTRO_LOG;
+        CodificarRegistroPlacar(p, &registros[k]);
+        EscreverU32(p + TAMANHO_REGISTRO_PLACAR, SomaVerificacao(p, TAMANHO_REGISTRO_PLACAR));
+    }
+    bool ok = fwrite(buffer, 1, tamanho, placar->log) == tamanho && fflush(placar->log) == 0;
+    if (ok && placar->sincronizar)
+        ok = SincronizarArquivo(placar->log);
+    free(buffer);
+    if (!ok) {
+        TruncarArquivo(placar->log, anterior);
+        clearerr(placar->log);
+        return false;
+    }
+
+    // O lote já está no disco: se ele não couber na memória, continua aceito e a próxima abertura o lê do log.
+    for (int k = 0; k < total; k++)
+        if (!InserirRecente(placar, &registros[k]))
+            placar->incompleto = true;
+    placar->registrosLog += total;
+    if (posicoes != NULL)
+        for (int k = 0; k < total; k++)
+            posicoes[k] = PosicaoNoPlacar(placar, (Dificuldade)registros[k].dificuldade, registros[k].pontos);
+
+    int64_t totalIndice = 0;
+    for (int d = 0; d < 3; d++)
+        totalIndice += placar->indice[d].total;
+    if (placar->registrosLog >= MIN_LOG_COMPACTAR && placar->registrosLog * 4 >= totalIndice)
+        CompactarPlacar(placar); // Se falhar, os registros continuam seguros no log.
+    return true;
+}
+
+bool CompactarPlacar(Placar* placar) {
+    if (placar->log == NULL || placar->incompleto)
+        return false;
+    size_t registros = 0;
+    for (int d = 0; d < 3; d++) {
+        if (!IntercalarRecentes(placar, d))
+            return false;
+        registros += (size_t)placar->indice[d].total;
+    }
+
+    // 1. O índice novo, com a geração seguinte, no lugar do antigo.
+    size_t tamanho = TAMANHO_CABECALHO_INDICE + registros * TAMANHO_REGISTRO_PLACAR + 4;
+    uint8_t* buffer = (uint8_t*)malloc(tamanho);
+    if (buffer == NULL)
+        return false;
+    uint32_t geracao = placar->geracao + 1;
+    memcpy(buffer, MAGICA_INDICE_PLACAR, 4);
+    buffer[4] = VERSAO_PLACAR;
+    buffer[5] = buffer[6] = buffer[7] = 0;
+    EscreverU32(buffer + 8, geracao);
+    uint8_t* p = buffer + TAMANHO_CABECALHO_INDICE;
+    for (int d = 0; d < 3; d++) {
+        EscreverU32(buffer + 12 + 4 * d, (uint32_t)placar->indice[d].total);
+        for (int k = 0; k < placar->indice[d].total; k++, p += TAMANHO_REGISTRO_PLACAR)
+            CodificarRegistroPlacar(p, &placar->indice[d].registros[k]);
+    }
+    EscreverU32(p, SomaVerificacao(buffer, tamanho - 4));
+    bool ok = GravarArquivoSeguro(placar->caminhoIndice, buffer, tamanho);
+    free(buffer);
+    if (!ok)
+        return false; // Nada mudou no disco: o índice e o log antigos continuam valendo.
+
+    // 2. Um log vazio da geração nova. Até aqui, uma queda deixa o log antigo, que é descartado na abertura.
+    placar->geracao = geracao;
+    placar->registrosLog = 0;
+    uint8_t cabecalho[TAMANHO_CABECALHO_LOG];
+    CabecalhoLog(cabecalho, geracao);
+    fclose(placar->log);
+    placar->log = NULL;
+    if (!GravarArquivoSeguro(placar->caminhoLog, cabecalho, sizeof(cabecalho)))
+        return false; // O log antigo seria descartado na abertura: sem log, as próximas pontuações são recusadas.
+    placar->log = AbrirLog(placar->caminhoLog);
+    return placar->log != NULL;
+}
+
+// --- CONSULTAS ---
+
+PosicaoPlacar PosicaoNoPlacar(const Placar* placar, Dificuldade dificuldade, int pontos) {
+    const ListaPlacar* indice = &placar->indice[dificuldade];
+    const ListaPlacar* recentes = &placar->recentes[dificuldade];
+    return (PosicaoPlacar){ 1 + ContarMaiores(indice, pontos) + ContarMaiores(recentes, pontos), indice->total + recentes->total };
+}
+
+int TopoPlacar(const Placar* placar, Dificuldade dificuldade, RegistroPlacar* saida, int maximo) {
+    const ListaPlacar* a = &placar->indice[dificuldade];
+    const ListaPlacar* b = &placar->recentes[dificuldade];
+    int i = 0, j = 0, total = 0;
+    while (total < maximo && (i < a->total || j < b->total)) {
+        if (j >= b->total || (i < a->total && VemAntes(&a->registros[i], &b->registros[j])))
+            saida[total++] = a->registros[i++];
+        else
+            saida[total++] = b->registros[j++];
+    }
+    return total;
+}
@@ -0,0 +1,89 @@
+#ifndef PLACAR_H
+#define PLACAR_H
+
+#include "logica.h" // Dificuldade.
+#include <stdio.h>
+
+// --- PLACAR (RECORDES POR DIFICULDADE) ---
+// Cada partida terminada vira um registro (pontos, dificuldade, data e semente). No disco, o placar são dois
+// arquivos com o mesmo nome base:
+//   <base>.log  registros novos, só acrescentados no fim; cada um tem uma soma de verificação, então um registro
+//               cortado por uma queda de energia é descartado (e o arquivo truncado) na próxima abertura.
+//   <base>.idx  índice compacto: todos os registros de cada dificuldade já em ordem de pontuação.
+// Na memória, cada dificuldade tem a lista ordenada do índice e uma lista ordenada pequena com os registros
+// recentes; de tempos em tempos a pequena é intercalada na grande. As consultas (os N melhores, a posição de uma
+// pontuação) são buscas binárias nas duas listas: microssegundos mesmo com milhões de registros.
+//
+// A compactação grava um índice novo com tudo e começa um log vazio. Para uma queda no meio dela não perder nem
+// duplicar registros, os dois arquivos têm um número de geração: o índice novo (geração G + 1) é gravado em um
+// arquivo temporário, sincronizado e renomeado por cima do antigo, e só depois o log da geração G é trocado por
+// um vazio da geração G + 1. Na abertura, um log de geração anterior à do índice já está todo no índice e é
+// descartado. Este módulo não depende da Raylib.
+
+#define MAGICA_INDICE_PLACAR "BPLI"
+#define MAGICA_LOG_PLACAR "BPLG"
+#define VERSAO_PLACAR 1
+#define TAMANHO_REGISTRO_PLACAR 24   // Registro codificado (no log, no índice e na rede).
+#define MAX_RECENTES_PLACAR 4096     // Registros recentes por dificuldade antes de intercalar na lista do índice.
+#define MIN_LOG_COMPACTAR 4096       // O log é compactado ao passar deste tamanho e de 1/4 do índice.
+
+typedef struct {
+    int32_t pontos;
+    uint8_t dificuldade;  // Dificuldade.
+    int64_t data;         // Segundos desde 1970.
+    uint64_t semente;     // Semente da partida (acha a gravação, se ela existir).
+} RegistroPlacar;
+
+// Registros de uma dificuldade, do maior para o menor número de pontos (empates: o mais antigo primeiro).
+typedef struct {
+    RegistroPlacar* registros;
+    int total;
+    int capacidade;
+} ListaPlacar;
+
+typedef struct {
+    ListaPlacar indice[3];     // Registros já intercalados, por dificuldade.
+    ListaPlacar recentes[3];   // Registros novos, por dificuldade (no máximo MAX_RECENTES_PLACAR).
+    FILE* log;                 // Aberto para acrescentar.
+    char caminhoIndice[260];
+    char caminhoLog[260];
+    uint32_t geracao;          // Geração do índice e do log atuais.
+    int64_t registrosLog;      // Registros no log atual (ainda fora do arquivo de índice).
+    bool sincronizar;          // Se true, cada lote acrescentado é sincronizado com o disco (fsync) antes de retornar.
+    bool incompleto;           // Algum registro do log não coube na memória: só reabrindo (que relê o log) ele volta.
+} Placar;
+
+// Posição de uma pontuação: 1 + quantos registros da mesma dificuldade têm mais pontos (empates dividem a posição).
+typedef struct {
+    int posicao;
+    int total;     // Registros da dificuldade.
+} PosicaoPlacar;
+
+// Abre (ou cria) o placar '<base>.idx' / '<base>.log'. Retorna false se não der para criar o log, se o índice
+// existir mas estiver corrompido (ele não é sobrescrito) ou se faltar memória para os registros.
+bool AbrirPlacar(Placar* placar, const char* base);
+
+// Fecha os arquivos e libera a memória. Não compacta.
+void FecharPlacar(Placar* placar);
+
+// Acrescenta 'total' registros com uma única escrita (e um único fsync) e preenche a posição de cada um depois do
+// lote inteiro, se 'posicoes' não for NULL. Compacta o log quando ele passa do limite. Retorna false se a escrita
+// falhar (os registros não entram no placar). Depois de gravado, o lote vale mesmo que falte memória para pô-lo nas
+// listas: o placar fica 'incompleto' e as posições e consultas não contam os registros de fora até ele ser reaberto.
+bool AdicionarPontuacoes(Placar* placar, const RegistroPlacar* registros, int total, PosicaoPlacar* posicoes);
+
+// Posição que 'pontos' teria na dificuldade.
+PosicaoPlacar PosicaoNoPlacar(const Placar* placar, Dificuldade dificuldade, int pontos);
+
+// Copia os 'maximo' melhores registros da dificuldade para 'saida'. Retorna quantos foram copiados.
+int TopoPlacar(const Placar* placar, Dificuldade dificuldade, RegistroPlacar* saida, int maximo);
+
+// Grava um índice novo com todos os registros e começa um log vazio (à prova de queda, ver acima). Um placar
+// incompleto não é compactado: o índice novo perderia os registros que só estão no log.
+bool CompactarPlacar(Placar* placar);
+
+// Codificação de um registro em TAMANHO_REGISTRO_PLACAR bytes little-endian, usada nos arquivos e na rede.
+void CodificarRegistroPlacar(uint8_t* p, const RegistroPlacar* registro);
+void DecodificarRegistroPlacar(const uint8_t* p, RegistroPlacar* registro);
+
+#endif
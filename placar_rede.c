@@ -0,0 +1,143 @@
+#define _POSIX_C_SOURCE 200809L // struct timeval e MSG_NOSIGNAL.
+#include "placar_rede.h"
+#include <string.h>
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <unistd.h>
+#endif
+
+// Escrever em uma conexão que o outro lado fechou não pode encerrar o processo com SIGPIPE.
+#if defined(MSG_NOSIGNAL)
+    #define OPCOES_ENVIO MSG_NOSIGNAL
+#else
+    #define OPCOES_ENVIO 0
+#endif
+
+bool IniciarRedePlacar(void) {
+#if defined(_WIN32)
+    WSADATA dados;
+    return WSAStartup(MAKEWORD(2, 2), &dados) == 0;
+#else
+    return true;
+#endif
+}
+
+void FecharSoquete(Soquete soquete) {
+    if (soquete == SOQUETE_INVALIDO)
+        return;
+#if defined(_WIN32)
+    closesocket((SOCKET)soquete);
+#else
+    close(soquete);
+#endif
+}
+
+Soquete ConectarPlacar(uint16_t porta, int tempoLimiteMs) {
+    Soquete s = (Soquete)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s == SOQUETE_INVALIDO)
+        return SOQUETE_INVALIDO;
+    int sim = 1; // Mensagens pequenas saem na hora, sem esperar o algoritmo de Nagle juntar mais bytes.
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&sim, sizeof(sim));
+#if defined(SO_NOSIGPIPE)
+    setsockopt(s, SOL_SOCKET, SO_NOSIGPIPE, (const char*)&sim, sizeof(sim)); // macOS, que não tem MSG_NOSIGNAL.
+#endif
+#if defined(_WIN32)
+    DWORD limite = (DWORD)tempoLimiteMs;
+#else
+    struct timeval limite = { tempoLimiteMs / 1000, (tempoLimiteMs % 1000) * 1000 };
+#endif
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char*)&limite, sizeof(limite));
+    setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, (const char*)&limite, sizeof(limite));
+
+    struct sockaddr_in endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sin_family = AF_INET;
+    endereco.sin_port = htons(porta);
+    endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(s, (struct sockaddr*)&endereco, sizeof(endereco)) != 0) {
+        FecharSoquete(s);
+        return SOQUETE_INVALIDO;
+    }
+    return s;
+}
+
+// Envia ou recebe exatamente 'tamanho' bytes (o TCP pode dividir uma mensagem em vários pedaços).
+static bool EnviarTudo(Soquete s, const uint8_t* dados, size_t tamanho) {
+    while (tamanho > 0) {
+        long n = (long)send(s, (const char*)dados, (int)tamanho, OPCOES_ENVIO);
+        if (n <= 0)
+            return false;
+        dados += n;
+        tamanho -= (size_t)n;
+    }
+    return true;
+}
+
+static bool ReceberTudo(Soquete s, uint8_t* dados, size_t tamanho) {
+    while (tamanho > 0) {
+        long n = (long)recv(s, (char*)dados, (int)tamanho, 0);
+        if (n <= 0)
+            return false;
+        dados += n;
+        tamanho -= (size_t)n;
+    }
+    return true;
+}
+
+void EscreverCabecalhoRede(uint8_t* p, uint8_t tipo, uint8_t parametro, uint16_t quantidade) {
+    p[0] = tipo;
+    p[1] = parametro;
+    p[2] = (uint8_t)quantidade;
+    p[3] = (uint8_t)(quantidade >> 8);
+}
+
+static uint32_t LerU32Rede(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+bool EnviarPontuacoesRede(Soquete soquete, const RegistroPlacar* registros, int total, PosicaoPlacar* posicoes) {
+    uint8_t mensagem[MAX_MENSAGEM_PLACAR]; // Na pilha: o teste de carga chama de várias threads.
+    for (int inicio = 0; inicio < total; inicio += MAX_LOTE_PLACAR) {
+        int n = total - inicio < MAX_LOTE_PLACAR ? total - inicio : MAX_LOTE_PLACAR;
+        EscreverCabecalhoRede(mensagem, MENSAGEM_ENVIAR, 0, (uint16_t)n);
+        for (int k = 0; k < n; k++)
+            CodificarRegistroPlacar(mensagem + TAMANHO_CABECALHO_REDE + k * TAMANHO_REGISTRO_PLACAR, &registros[inicio + k]);
+        if (!EnviarTudo(soquete, mensagem, TAMANHO_CABECALHO_REDE + (size_t)n * TAMANHO_REGISTRO_PLACAR))
+            return false;
+        uint8_t cabecalho[TAMANHO_CABECALHO_REDE];
+        if (!ReceberTudo(soquete, cabecalho, sizeof(cabecalho)) || cabecalho[0] != MENSAGEM_ENVIAR || cabecalho[1] != 0 ||
+            (cabecalho[2] | cabecalho[3] << 8) != n)
+            return false;
+        if (!ReceberTudo(soquete, mensagem, (size_t)n * 8))
+            return false;
+        if (posicoes != NULL)
+            for (int k = 0; k < n; k++)
+                posicoes[inicio + k] = (PosicaoPlacar){ (int)LerU32Rede(mensagem + 8 * k), (int)LerU32Rede(mensagem + 8 * k + 4) };
+    }
+    return true;
+}
+
+int ConsultarTopoRede(Soquete soquete, Dificuldade dificuldade, RegistroPlacar* saida, int maximo) {
+    uint8_t mensagem[MAX_MENSAGEM_PLACAR]; // Na pilha: o teste de carga chama de várias threads.
+    if (maximo > MAX_LOTE_PLACAR)
+        maximo = MAX_LOTE_PLACAR;
+    EscreverCabecalhoRede(mensagem, MENSAGEM_TOPO, (uint8_t)dificuldade, (uint16_t)maximo);
+    if (!EnviarTudo(soquete, mensagem, TAMANHO_CABECALHO_REDE))
+        return -1;
+    if (!ReceberTudo(soquete, mensagem, TAMANHO_CABECALHO_REDE) || mensagem[0] != MENSAGEM_TOPO || mensagem[1] != 0)
+        return -1;
+    int n = mensagem[2] | mensagem[3] << 8;
+    if (n > maximo || !ReceberTudo(soquete, mensagem, (size_t)n * TAMANHO_REGISTRO_PLACAR))
+        return -1;
+    for (int k = 0; k < n; k++)
+        DecodificarRegistroPlacar(mensagem + k * TAMANHO_REGISTRO_PLACAR, &saida[k]);
+    return n;
+}
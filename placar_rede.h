@@ -0,0 +1,50 @@
+#ifndef PLACAR_REDE_H
+#define PLACAR_REDE_H
+
+#include "placar.h"
+
+// --- PLACAR NA REDE LOCAL ---
+// Protocolo entre o jogo (ou o teste de carga) e o servidor_placar, por TCP no endereço de loopback.
+// Cada mensagem tem um cabeçalho de 4 bytes (tipo, dificuldade ou status, quantidade em 16 bits little-endian)
+// seguido de 'quantidade' itens:
+//   ENVIAR   pedido:   itens de TAMANHO_REGISTRO_PLACAR bytes (os registros, com a dificuldade de cada um)
+//            resposta: itens de 8 bytes (posição e total da dificuldade depois do lote, 32 bits cada)
+//   TOPO     pedido:   sem itens; 'quantidade' é quantos registros da dificuldade do cabeçalho devolver
+//            resposta: itens de TAMANHO_REGISTRO_PLACAR bytes, do melhor para o pior
+// Os envios de todos os clientes que chegam juntos viram um único lote no placar (uma escrita e um fsync).
+
+#define PORTA_PLACAR 7420
+#define MAX_LOTE_PLACAR 1024          // Registros por mensagem.
+#define TAMANHO_CABECALHO_REDE 4
+#define MAX_MENSAGEM_PLACAR (TAMANHO_CABECALHO_REDE + MAX_LOTE_PLACAR * TAMANHO_REGISTRO_PLACAR)
+
+typedef enum {
+    MENSAGEM_ENVIAR = 1,
+    MENSAGEM_TOPO = 2
+} TipoMensagemPlacar;
+
+#if defined(_WIN32)
+    typedef uintptr_t Soquete;        // SOCKET do Winsock.
+    #define SOQUETE_INVALIDO ((Soquete)~(uintptr_t)0)
+#else
+    typedef int Soquete;
+    #define SOQUETE_INVALIDO (-1)
+#endif
+
+// Inicia a biblioteca de rede (só faz algo no Windows). Chamar uma vez antes de qualquer outra função.
+bool IniciarRedePlacar(void);
+
+// Conecta ao servidor no loopback. As leituras e escritas desistem depois de 'tempoLimiteMs' milissegundos.
+Soquete ConectarPlacar(uint16_t porta, int tempoLimiteMs);
+void FecharSoquete(Soquete soquete);
+
+// Envia um lote e espera a posição de cada registro. Retorna false se a conexão falhar.
+bool EnviarPontuacoesRede(Soquete soquete, const RegistroPlacar* registros, int total, PosicaoPlacar* posicoes);
+
+// Pede os 'maximo' melhores da dificuldade. Retorna quantos vieram, ou -1 se a conexão falhar.
+int ConsultarTopoRede(Soquete soquete, Dificuldade dificuldade, RegistroPlacar* saida, int maximo);
+
+// Cabeçalho das mensagens (usado também pelo servidor).
+void EscreverCabecalhoRede(uint8_t* p, uint8_t tipo, uint8_t parametro, uint16_t quantidade);
+
+#endif
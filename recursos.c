@@ -0,0 +1,375 @@
+#include "recursos.h"
+#include "pacote.h"
+#include <pthread.h> // Threads de trabalho do carregamento assíncrono.
+#include <string.h>
+
+const DefinicaoRecurso RECURSOS[TOTAL_RECURSOS] = {
+    [RECURSO_ATLAS]           = { "atlas",          NULL },
+    [RECURSO_FUNDO_PRINCIPAL] = { "fundoPrincipal", "fundoPrincipal.png" },
+    [RECURSO_FUNDO_MENU]      = { "fundoMenu",      "fundoMenu.png" },
+    [RECURSO_FUNDO_CREDITOS]  = { "fundoCreditos",  "fundoCreditos.png" },
+};
+
+#define TOTAL_TRABALHADORES 3 // Threads de trabalho. O atlas vindo dos PNGs é o trabalho mais longo.
+
+#if defined(PACOTE_EMBUTIDO)
+// Gerados pelo empacotar_assets com a opção --c.
+extern const unsigned char DADOS_PACOTE_EMBUTIDO[];
+extern const size_t TAMANHO_PACOTE_EMBUTIDO;
+#endif
+
+// Imagem pronta na memória, esperando para ser enviada à GPU pela thread de desenho.
+typedef struct {
+    IdRecurso id;
+    Image imagem;          // Pixels prontos (no pacote, aponta para dentro do arquivo mapeado).
+    bool imagemPropria;    // true se a imagem foi decodificada e precisa ser descarregada depois do envio.
+    bool ok;               // false se a leitura falhou.
+} RecursoDecodificado;
+
+// --- ESTADO DO CARREGADOR ---
+// Só existe um carregador por vez, então o estado fica neste módulo.
+static Pacote pacote;                                 // Pacote mapeado (se usouPacote), até o fim do jogo: um recurso descartado pode voltar.
+static bool usandoPacote;
+static pthread_t trabalhadores[TOTAL_TRABALHADORES];
+static int totalTrabalhadores;
+static pthread_mutex_t travaFila = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sinalFila = PTHREAD_COND_INITIALIZER;
+static IdRecurso pedidos[TOTAL_RECURSOS];              // Fila de pedidos, os adquiridos na frente (protegida pela trava).
+static int totalPedidos;
+static bool encerrarTrabalhadores;
+static RecursoDecodificado concluidos[TOTAL_RECURSOS]; // Fila de concluídos (protegida pela trava). Cada recurso está
+static int totalConcluidos;                            // no máximo uma vez entre os pedidos e os concluídos.
+static Rectangle regioesAtlas[TOTAL_SPRITES];          // Preenchidas pela thread que lê o atlas.
+
+// Abre o pacote embutido no executável ou, se não houver, o arquivo ao lado dele.
+static bool AbrirPacoteJogo(Pacote* p) {
+#if defined(PACOTE_EMBUTIDO)
+    if (AbrirPacoteMemoria(p, DADOS_PACOTE_EMBUTIDO, TAMANHO_PACOTE_EMBUTIDO))
+        return true;
+#endif
+    if (AbrirPacote(p, ARQUIVO_PACOTE))
+        return true;
+    // O jogo pode ser iniciado de outra pasta: procura o pacote na pasta do executável.
+    return AbrirPacote(p, TextFormat("%s%s", GetApplicationDirectory(), ARQUIVO_PACOTE));
+}
+
+// true se o pacote tem todas as entradas que o jogo usa.
+static bool PacoteCompleto(const Pacote* p) {
+    const EntradaPacote* descricao = BuscarEntradaPacote(p, ENTRADA_DESCRICAO_ATLAS);
+    if (descricao == NULL || descricao->tamanho >= 1024)
+        return false;
+    for (int i = 0; i < TOTAL_RECURSOS; i++) {
+        const EntradaPacote* e = BuscarEntradaPacote(p, RECURSOS[i].nome);
+        if (e == NULL || e->tipo != ENTRADA_TEXTURA)
+            return false;
+    }
+    return true;
+}
+
+// Lê um recurso do pacote. Os pixels já estão prontos; a thread só percorre as páginas do arquivo mapeado
+// para que o sistema as traga do disco aqui, e não durante o envio para a GPU na thread de desenho.
+static RecursoDecodificado LerDoPacote(IdRecurso id) {
+    RecursoDecodificado r = { id, {0}, false, false };
+    if (id == RECURSO_ATLAS) {
+        const EntradaPacote* descricao = BuscarEntradaPacote(&pacote, ENTRADA_DESCRICAO_ATLAS);
+        char texto[1024];
+        memcpy(texto, DadosEntradaPacote(&pacote, descricao), (size_t)descricao->tamanho);
+        texto[descricao->tamanho] = '\0'; // A entrada não guarda o terminador.
+        if (!LerDescricaoAtlas(texto, regioesAtlas))
+            return r;
+    }
+    const EntradaPacote* e = BuscarEntradaPacote(&pacote, RECURSOS[id].nome);
+    const volatile unsigned char* dados = (const volatile unsigned char*)DadosEntradaPacote(&pacote, e);
+    unsigned char soma = 0;
+    for (uint64_t i = 0; i < e->tamanho; i += 4096)
+        soma += dados[i];
+    (void)soma;
+    r.imagem = (Image){ (void*)dados, (int)e->largura, (int)e->altura, 1, (int)e->formato };
+    r.ok = true;
+    return r;
+}
+
+// Caminho sem pacote: decodifica o PNG (ou monta o atlas a partir dos PNGs).
+static RecursoDecodificado LerDoPng(IdRecurso id) {
+    RecursoDecodificado r = { id, {0}, true, false };
+    if (id == RECURSO_ATLAS)
+        r.ok = CarregarImagemAtlas(&r.imagem, regioesAtlas, ARQUIVO_ATLAS_IMAGEM, ARQUIVO_ATLAS_DESCRICAO);
+    else {
+        r.imagem = LoadImage(RECURSOS[id].arquivo);
+        r.ok = r.imagem.data != NULL;
+    }
+    return r;
+}
+
+// Laço de cada thread de trabalho: espera um pedido, lê o recurso e o coloca na fila de concluídos.
+static void* TrabalhadorRecursos(void* argumento) {
+    (void)argumento;
+    pthread_mutex_lock(&travaFila);
+    for (;;) {
+        while (totalPedidos == 0 && !encerrarTrabalhadores)
+            pthread_cond_wait(&sinalFila, &travaFila);
+        if (encerrarTrabalhadores)
+            break;
+        IdRecurso id = pedidos[0];
+        memmove(&pedidos[0], &pedidos[1], (size_t)(totalPedidos - 1) * sizeof(IdRecurso));
+        totalPedidos--;
+        pthread_mutex_unlock(&travaFila);
+
+        RecursoDecodificado r = usandoPacote ? LerDoPacote(id) : LerDoPng(id);
+
+        pthread_mutex_lock(&travaFila);
+        concluidos[totalConcluidos++] = r;
+    }
+    pthread_mutex_unlock(&travaFila);
+    return NULL;
+}
+
+void IniciarCarregamentoRecursos(Recursos* recursos, size_t orcamento) {
+    memset(recursos, 0, sizeof(*recursos));
+    recursos->inicioCarga = GetTime();
+    recursos->orcamento = orcamento;
+
+    usandoPacote = AbrirPacoteJogo(&pacote);
+    if (usandoPacote && !PacoteCompleto(&pacote)) {
+        TraceLog(LOG_WARNING, "RECURSOS: pacote incompleto, usando os PNGs");
+        FecharPacote(&pacote);
+        usandoPacote = false;
+    }
+    // Se o jogo foi iniciado de outra pasta, os PNGs estão na pasta do executável.
+    if (!usandoPacote && !FileExists(RECURSOS[RECURSO_FUNDO_PRINCIPAL].arquivo))
+        ChangeDirectory(GetApplicationDirectory());
+    recursos->usouPacote = usandoPacote;
+    // No pacote, o tamanho de cada textura já é conhecido antes de carregá-la; dos PNGs, só depois.
+    for (int i = 0; usandoPacote && i < TOTAL_RECURSOS; i++) {
+        const EntradaPacote* e = BuscarEntradaPacote(&pacote, RECURSOS[i].nome);
+        recursos->bytes[i] = (size_t)GetPixelDataSize((int)e->largura, (int)e->altura, (int)e->formato);
+    }
+
+    totalPedidos = 0;
+    totalConcluidos = 0;
+    totalTrabalhadores = 0;
+    encerrarTrabalhadores = false;
+    for (int i = 0; i < TOTAL_TRABALHADORES; i++) {
+        if (pthread_create(&trabalhadores[totalTrabalhadores], NULL, TrabalhadorRecursos, NULL) == 0)
+            totalTrabalhadores++;
+    }
+}
+
+static void PedirRecurso(Recursos* recursos, IdRecurso id, bool urgente) {
+    recursos->residencia[id] = RECURSO_PEDIDO;
+    recursos->inicioPedido[id] = GetTime();
+    if (totalTrabalhadores == 0) { // Sem threads: lê aqui mesmo, e o envio fica para o próximo ProcessarCarregamentoRecursos.
+        concluidos[totalConcluidos++] = usandoPacote ? LerDoPacote(id) : LerDoPng(id);
+        return;
+    }
+    pthread_mutex_lock(&travaFila);
+    if (urgente) {
+        memmove(&pedidos[1], &pedidos[0], (size_t)totalPedidos * sizeof(IdRecurso));
+        pedidos[0] = id;
+    } else {
+        pedidos[totalPedidos] = id;
+    }
+    totalPedidos++;
+    pthread_cond_signal(&sinalFila);
+    pthread_mutex_unlock(&travaFila);
+}
+
+// Um recurso previsto que ainda está na fila passou a ser adquirido: vai para a frente.
+static void PriorizarRecurso(IdRecurso id) {
+    pthread_mutex_lock(&travaFila);
+    for (int i = 1; i < totalPedidos; i++) {
+        if (pedidos[i] == id) {
+            memmove(&pedidos[1], &pedidos[0], (size_t)i * sizeof(IdRecurso));
+            pedidos[0] = id;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&travaFila);
+}
+
+static void DescartarRecurso(Recursos* recursos, IdRecurso id) {
+    if (recursos->texturas[id].id != 0)
+        UnloadTexture(recursos->texturas[id]);
+    recursos->texturas[id] = (Texture2D){0};
+    if (id == RECURSO_ATLAS)
+        recursos->atlas.textura = (Texture2D){0};
+    recursos->prontos[id] = false;
+    recursos->totalProntos--;
+    recursos->bytesResidentes -= recursos->bytes[id];
+    recursos->residencia[id] = RECURSO_AUSENTE;
+    recursos->descartes++;
+    TraceLog(LOG_INFO, "RECURSOS: %s descartada (%.1f MB residentes)", RECURSOS[id].nome, recursos->bytesResidentes / 1048576.0);
+}
+
+// Descarta texturas residentes sem referência (as previstas só com 'descartarPrevistas'), da usada há mais tempo
+// para a mais recente, até caberem mais 'necessarios' bytes no orçamento. Os pedidos em andamento já contam.
+// Retorna true se couber.
+static bool AbrirEspaco(Recursos* recursos, size_t necessarios, bool descartarPrevistas) {
+    if (recursos->orcamento == 0)
+        return true;
+    for (;;) {
+        size_t ocupados = 0;
+        for (int i = 0; i < TOTAL_RECURSOS; i++)
+            if (recursos->residencia[i] != RECURSO_AUSENTE)
+                ocupados += recursos->bytes[i];
+        if (ocupados + necessarios <= recursos->orcamento)
+            return true;
+        int vitima = -1;
+        for (int i = 0; i < TOTAL_RECURSOS; i++) {
+            if (recursos->residencia[i] != RECURSO_RESIDENTE || recursos->referencias[i] > 0 || (recursos->previstos[i] && !descartarPrevistas))
+                continue;
+            if (vitima < 0 || recursos->ultimoUso[i] < recursos->ultimoUso[vitima])
+                vitima = i;
+        }
+        if (vitima < 0)
+            return false;
+        DescartarRecurso(recursos, (IdRecurso)vitima);
+    }
+}
+
+// Envia para a GPU um item da fila de concluídos. Retorna false se a fila estava vazia.
+static bool EnviarConcluido(Recursos* recursos) {
+    RecursoDecodificado r;
+    bool temItem = false;
+    pthread_mutex_lock(&travaFila);
+    if (totalConcluidos > 0) {
+        r = concluidos[0];
+        memmove(&concluidos[0], &concluidos[1], (size_t)(totalConcluidos - 1) * sizeof(RecursoDecodificado));
+        totalConcluidos--;
+        temItem = true;
+    }
+    pthread_mutex_unlock(&travaFila);
+    if (!temItem)
+        return false;
+
+    IdRecurso id = r.id;
+    if (recursos->referencias[id] == 0 && !recursos->previstos[id]) {
+        // Ninguém precisa mais dela (a tela mudou durante a leitura): nem chega na GPU.
+        recursos->residencia[id] = RECURSO_AUSENTE;
+    } else {
+        // Envia para a GPU (só a thread de desenho pode fazer isso).
+        if (r.ok) {
+            recursos->texturas[id] = LoadTextureFromImage(r.imagem);
+            recursos->bytes[id] = (size_t)GetPixelDataSize(r.imagem.width, r.imagem.height, r.imagem.format);
+            if (id == RECURSO_ATLAS) {
+                SetTextureFilter(recursos->texturas[id], TEXTURE_FILTER_BILINEAR); // Suaviza as imagens reduzidas ao desenhar.
+                memcpy(recursos->atlas.regioes, regioesAtlas, sizeof(regioesAtlas));
+                recursos->atlas.textura = recursos->texturas[id];
+            }
+        } else {
+            TraceLog(LOG_ERROR, "RECURSOS: falha ao carregar %s", RECURSOS[id].nome);
+            recursos->bytes[id] = 0;
+        }
+        recursos->residencia[id] = RECURSO_RESIDENTE;
+        recursos->prontos[id] = true; // Mesmo com falha, para a tela não esperar para sempre.
+        recursos->totalProntos++;
+        recursos->bytesResidentes += recursos->bytes[id];
+        if (recursos->bytesResidentes > recursos->picoResidentes)
+            recursos->picoResidentes = recursos->bytesResidentes;
+        recursos->carregamentos++;
+        recursos->ultimoUso[id] = GetTime();
+        TraceLog(LOG_INFO, "RECURSOS: %s na GPU em %.1f ms, de %s (%.1f MB residentes)", RECURSOS[id].nome,
+                 (GetTime() - recursos->inicioPedido[id]) * 1000.0, usandoPacote ? "pacote" : "PNG", recursos->bytesResidentes / 1048576.0);
+        // Dos PNGs, o tamanho só é conhecido agora: se passou do orçamento, sai o que não é necessário.
+        AbrirEspaco(recursos, 0, recursos->referencias[id] > 0);
+    }
+    if (r.imagemPropria)
+        UnloadImage(r.imagem);
+    return true;
+}
+
+void ProcessarCarregamentoRecursos(Recursos* recursos) {
+    EnviarConcluido(recursos);
+}
+
+void AdquirirRecurso(Recursos* recursos, IdRecurso id) {
+    recursos->referencias[id]++;
+    recursos->ultimoUso[id] = GetTime();
+    if (recursos->residencia[id] == RECURSO_AUSENTE) {
+        AbrirEspaco(recursos, recursos->bytes[id], true); // Se não couber, carrega mesmo assim: a tela precisa dela.
+        PedirRecurso(recursos, id, true);
+    } else if (recursos->residencia[id] == RECURSO_PEDIDO) {
+        PriorizarRecurso(id);
+    }
+}
+
+void LiberarRecurso(Recursos* recursos, IdRecurso id) {
+    if (recursos->referencias[id] > 0)
+        recursos->referencias[id]--;
+    recursos->ultimoUso[id] = GetTime(); // Fica na GPU até precisar do espaço.
+}
+
+void PreverRecursos(Recursos* recursos, const IdRecurso* ids, int total) {
+    memset(recursos->previstos, 0, sizeof(recursos->previstos));
+    for (int i = 0; i < total; i++)
+        recursos->previstos[ids[i]] = true;
+    // Na ordem dada: a mais provável primeiro, e só o que couber sem descartar texturas usadas ou previstas.
+    for (int i = 0; i < total; i++)
+        if (recursos->residencia[ids[i]] == RECURSO_AUSENTE && AbrirEspaco(recursos, recursos->bytes[ids[i]], false))
+            PedirRecurso(recursos, ids[i], false);
+}
+
+double EsperarRecursos(Recursos* recursos, unsigned mascara) {
+    double inicio = GetTime();
+    for (;;) {
+        bool faltando = false;
+        for (int i = 0; i < TOTAL_RECURSOS; i++)
+            if ((mascara & (1u << i)) && recursos->residencia[i] == RECURSO_PEDIDO)
+                faltando = true;
+        if (!faltando)
+            return GetTime() - inicio;
+        if (!EnviarConcluido(recursos))
+            WaitTime(0.0005); // As threads ainda estão lendo.
+    }
+}
+
+float ProgressoRecursos(const Recursos* recursos) {
+    int desejados = 0, prontos = 0;
+    for (int i = 0; i < TOTAL_RECURSOS; i++) {
+        if (recursos->referencias[i] > 0 || recursos->previstos[i]) {
+            desejados++;
+            prontos += recursos->prontos[i];
+        }
+    }
+    return desejados > 0 ? (float)prontos / desejados : 1.0f;
+}
+
+bool CarregandoRecursos(const Recursos* recursos) {
+    for (int i = 0; i < TOTAL_RECURSOS; i++)
+        if (recursos->residencia[i] == RECURSO_PEDIDO)
+            return true;
+    return false;
+}
+
+bool RecursoPronto(const Recursos* recursos, IdRecurso id) {
+    return recursos->prontos[id];
+}
+
+void DescarregarRecursos(Recursos* recursos) {
+    // Se o jogo fechar no meio de um carregamento, espera as threads e descarta o que ainda não foi enviado.
+    pthread_mutex_lock(&travaFila);
+    encerrarTrabalhadores = true;
+    pthread_cond_broadcast(&sinalFila);
+    pthread_mutex_unlock(&travaFila);
+    for (int i = 0; i < totalTrabalhadores; i++)
+        pthread_join(trabalhadores[i], NULL);
+    totalTrabalhadores = 0;
+    for (int i = 0; i < totalConcluidos; i++)
+        if (concluidos[i].imagemPropria)
+            UnloadImage(concluidos[i].imagem);
+    totalConcluidos = 0;
+    totalPedidos = 0;
+    if (usandoPacote && pacote.dados != NULL)
+        FecharPacote(&pacote);
+
+    for (int i = 0; i < TOTAL_RECURSOS; i++) {
+        if (recursos->texturas[i].id != 0)
+            UnloadTexture(recursos->texturas[i]);
+        recursos->texturas[i] = (Texture2D){0};
+        recursos->prontos[i] = false;
+        recursos->residencia[i] = RECURSO_AUSENTE;
+    }
+    recursos->atlas.textura = (Texture2D){0};
+    recursos->totalProntos = 0;
+    recursos->bytesResidentes = 0;
+}
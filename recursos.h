@@ -0,0 +1,96 @@
+#ifndef RECURSOS_H
+#define RECURSOS_H
+
+#include "raylib.h"
+#include "atlas.h"
+#include <stddef.h>
+
+// --- CARREGAMENTO DAS TEXTURAS DO JOGO ---
+// As texturas vêm do pacote pré-processado (barigueira.pak, gerado pelo empacotar_assets), que é mapeado na
+// memória e enviado direto para a GPU, sem decodificar PNG. Se o jogo for compilado com PACOTE_EMBUTIDO, o
+// pacote vem de dentro do próprio executável. Sem pacote, as texturas são carregadas dos PNGs, como antes.
+//
+// O carregamento é assíncrono: threads de trabalho leem (ou decodificam) as imagens pedidas e as colocam em uma
+// fila de concluídos. A thread de desenho esvazia essa fila a cada frame e envia as imagens para a GPU, porque
+// só ela pode chamar a OpenGL. Assim a tela inicial aparece no primeiro frame, com uma barra de progresso.
+//
+// --- RESIDÊNCIA ---
+// Uma textura só é carregada quando alguém precisa dela. Cada tela adquire as texturas que desenha (contagem de
+// referências) e prevê as das telas que costumam vir depois, que são carregadas em segundo plano enquanto ela
+// está aberta. As texturas sem referência continuam na GPU enquanto couberem no orçamento; quando uma textura nova
+// não cabe, as sem referência são descartadas da usada há mais tempo para a mais recente (LRU). Uma textura
+// referenciada nunca é descartada, mesmo acima do orçamento; uma prevista só é carregada se couber.
+
+// Texturas carregadas pelo jogo. O atlas reúne o fundo do jogo, a chuva e os animais.
+typedef enum IdRecurso {
+    RECURSO_ATLAS,            // Atlas do campo de jogo.
+    RECURSO_FUNDO_PRINCIPAL,  // Fundo da tela inicial.
+    RECURSO_FUNDO_MENU,       // Fundo do menu principal e seleção de dificuldade.
+    RECURSO_FUNDO_CREDITOS,   // Fundo da tela de créditos.
+    TOTAL_RECURSOS
+} IdRecurso;
+
+typedef struct {
+    const char* nome;     // Nome da entrada no pacote.
+    const char* arquivo;  // PNG original (NULL para o atlas, que é montado a partir de vários PNGs).
+} DefinicaoRecurso;
+
+extern const DefinicaoRecurso RECURSOS[TOTAL_RECURSOS];
+
+#define ENTRADA_DESCRICAO_ATLAS "atlas.txt" // Entrada do pacote com as regiões do atlas.
+
+#define ORCAMENTO_TEXTURAS_PADRAO (24u << 20) // 24 MB: o atlas do campo de jogo e um fundo de menu.
+
+typedef enum { RECURSO_AUSENTE, RECURSO_PEDIDO, RECURSO_RESIDENTE } ResidenciaRecurso;
+
+typedef struct {
+    Texture2D texturas[TOTAL_RECURSOS]; // Texturas na GPU, indexadas por IdRecurso (id 0 enquanto não carregada).
+    bool prontos[TOTAL_RECURSOS];       // true quando a textura está na GPU (ou falhou, para a tela não esperar para sempre).
+    int totalProntos;                   // Quantas texturas estão na GPU.
+    Atlas atlas;                        // Regiões do atlas (a textura é a mesma de texturas[RECURSO_ATLAS]).
+    bool usouPacote;                    // true se as texturas vêm do pacote, false se vêm dos PNGs.
+    double inicioCarga;                 // Momento (GetTime) em que o carregamento começou.
+
+    // Residência (mexida só pela thread de desenho)
+    ResidenciaRecurso residencia[TOTAL_RECURSOS];
+    int referencias[TOTAL_RECURSOS];    // Telas abertas (ou partes do jogo) que usam a textura.
+    bool previstos[TOTAL_RECURSOS];     // Pedidas para a próxima tela provável.
+    double ultimoUso[TOTAL_RECURSOS];   // Última vez (GetTime) que a textura foi adquirida ou liberada, para o LRU.
+    size_t bytes[TOTAL_RECURSOS];       // Tamanho na GPU (do índice do pacote; dos PNGs, só depois do primeiro carregamento).
+    double inicioPedido[TOTAL_RECURSOS];
+    size_t orcamento;                   // Bytes de textura que o jogo se permite manter (0: sem limite).
+    size_t bytesResidentes, picoResidentes;
+    int carregamentos, descartes;
+} Recursos;
+
+// Começa as threads de carregamento, sem carregar nada, e retorna imediatamente. Deve ser chamada depois do
+// InitWindow. 'orcamento' em bytes (0: sem limite).
+void IniciarCarregamentoRecursos(Recursos* recursos, size_t orcamento);
+
+// Envia para a GPU as imagens que as threads de trabalho terminaram. Deve ser chamada a cada frame, na thread
+// de desenho. Envia no máximo uma textura por chamada, para não travar o frame.
+void ProcessarCarregamentoRecursos(Recursos* recursos);
+
+// Uma referência a mais ou a menos à textura. Adquirir uma textura ausente a pede na frente das previstas.
+void AdquirirRecurso(Recursos* recursos, IdRecurso id);
+void LiberarRecurso(Recursos* recursos, IdRecurso id);
+
+// Troca as texturas previstas, da mais provável para a menos. As que couberem no orçamento são pedidas, em ordem.
+void PreverRecursos(Recursos* recursos, const IdRecurso* ids, int total);
+
+// Espera as texturas da máscara chegarem na GPU (ou falharem), enviando-as aqui mesmo. Retorna os segundos de espera.
+double EsperarRecursos(Recursos* recursos, unsigned mascara);
+
+// Fração das texturas adquiridas ou previstas que já estão na GPU (0 a 1).
+float ProgressoRecursos(const Recursos* recursos);
+
+// true se alguma textura está sendo carregada.
+bool CarregandoRecursos(const Recursos* recursos);
+
+// true se a textura já pode ser usada.
+bool RecursoPronto(const Recursos* recursos, IdRecurso id);
+
+// Para as threads de trabalho e descarrega todas as texturas.
+void DescarregarRecursos(Recursos* recursos);
+
+#endif
@@ -0,0 +1,291 @@
+#define _POSIX_C_SOURCE 200809L
+#include "rede_versus.h"
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    typedef int TamanhoEndereco;
+#else
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    typedef socklen_t TamanhoEndereco;
+#endif
+
+static void EscreverU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void EscreverU32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++)
+        p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint16_t LerU16(const uint8_t* p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static uint32_t LerU32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+// Carimbo de tempo do pacote: microssegundos desde a abertura, nunca 0 (0 no eco quer dizer "nenhum").
+static uint32_t Carimbo(const ConexaoVersus* conexao, double agora) {
+    uint32_t c = (uint32_t)(uint64_t)((agora - conexao->inicio) * 1e6);
+    return c != 0 ? c : 1;
+}
+
+bool AbrirConexaoVersus(ConexaoVersus* conexao, uint16_t portaLocal, const char* enderecoRival, uint16_t portaRival,
+                        uint32_t nonce, Dificuldade dificuldade, int atraso, double agora) {
+    memset(conexao, 0, sizeof(*conexao));
+    conexao->soquete = SOQUETE_INVALIDO;
+    if (strcmp(enderecoRival, "localhost") == 0)
+        enderecoRival = "127.0.0.1";
+    uint32_t endereco = inet_addr(enderecoRival);
+    if (endereco == INADDR_NONE)
+        return false;
+
+    Soquete s = (Soquete)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == SOQUETE_INVALIDO)
+        return false;
+    // As leituras não esperam: o jogo lê o que chegou uma vez por frame e segue.
+#if defined(_WIN32)
+    u_long naoBloquear = 1;
+    ioctlsocket((SOCKET)s, FIONBIO, &naoBloquear);
+#else
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons(portaLocal);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(s, (struct sockaddr*)&local, sizeof(local)) != 0) {
+        FecharSoquete(s);
+        return false;
+    }
+
+    conexao->atrasados = (PacoteAtrasado*)malloc(MAX_PACOTES_ATRASADOS * sizeof(PacoteAtrasado));
+    if (conexao->atrasados == NULL) {
+        FecharSoquete(s);
+        return false;
+    }
+    conexao->soquete = s;
+    conexao->enderecoRival = endereco;
+    conexao->portaRival = portaRival;
+    conexao->nonce = nonce != 0 ? nonce : 1;
+    conexao->dificuldade = dificuldade;
+    conexao->atraso = atraso;
+    conexao->ackRival = -1;
+    conexao->inicio = agora;
+    conexao->ultimoEnvio = -1.0;
+    conexao->ultimoRecebimento = agora;
+    IniciarGerador(&conexao->gerador, nonce);
+    return true;
+}
+
+void FecharConexaoVersus(ConexaoVersus* conexao) {
+    if (conexao->atrasados == NULL)
+        return; // Nunca aberta (uma struct zerada) ou já fechada.
+    FecharSoquete(conexao->soquete);
+    conexao->soquete = SOQUETE_INVALIDO;
+    free(conexao->atrasados);
+    conexao->atrasados = NULL;
+    conexao->totalAtrasados = 0;
+    conexao->comecou = false;
+}
+
+static void EnviarAgora(ConexaoVersus* conexao, const uint8_t* dados, int tamanho) {
+    struct sockaddr_in destino;
+    memset(&destino, 0, sizeof(destino));
+    destino.sin_family = AF_INET;
+    destino.sin_port = htons(conexao->portaRival);
+    destino.sin_addr.s_addr = conexao->enderecoRival;
+    // Um erro (rival ainda não abriu a porta, buffer cheio) é igual a um pacote perdido: o próximo repete tudo.
+    sendto(conexao->soquete, (const char*)dados, tamanho, 0, (struct sockaddr*)&destino, sizeof(destino));
+}
+
+// Solta os pacotes retidos pela rede simulada cujo momento já passou (em qualquer ordem de chegada na fila).
+static void SoltarAtrasados(ConexaoVersus* conexao, double agora) {
+    for (int i = 0; i < conexao->totalAtrasados;) {
+        PacoteAtrasado* p = &conexao->atrasados[i];
+        if (p->envioEm > agora) {
+            i++;
+            continue;
+        }
+        EnviarAgora(conexao, p->dados, p->tamanho);
+        *p = conexao->atrasados[--conexao->totalAtrasados]; // Troca com o último: a ordem da fila não importa.
+    }
+}
+
+static void Enviar(ConexaoVersus* conexao, const uint8_t* dados, int tamanho, double agora) {
+    conexao->pacotesEnviados++;
+    conexao->ultimoEnvio = agora;
+    const SimulacaoRede* r = &conexao->simulacao;
+    if (r->latenciaMs <= 0 && r->variacaoMs <= 0 && r->perda <= 0.0f) {
+        EnviarAgora(conexao, dados, tamanho);
+        return;
+    }
+    if (SortearValor(&conexao->gerador, 0, 9999) < (int)(r->perda * 100.0f)) {
+        conexao->pacotesPerdidos++;
+        return;
+    }
+    int atrasoMs = r->latenciaMs + SortearValor(&conexao->gerador, -r->variacaoMs, r->variacaoMs);
+    if (atrasoMs <= 0 || conexao->totalAtrasados == MAX_PACOTES_ATRASADOS) {
+        EnviarAgora(conexao, dados, tamanho);
+        return;
+    }
+    PacoteAtrasado* p = &conexao->atrasados[conexao->totalAtrasados++];
+    p->envioEm = agora + atrasoMs / 1000.0;
+    p->tamanho = tamanho;
+    memcpy(p->dados, dados, (size_t)tamanho);
+}
+
+void EnviarConexaoVersus(ConexaoVersus* conexao, const SessaoVersus* sessao, double agora) {
+    SoltarAtrasados(conexao, agora);
+    if (!conexao->comecou && agora - conexao->ultimoEnvio < 0.05)
+        return;
+
+    uint8_t pacote[MAX_PACOTE_VERSUS];
+    int64_t primeiro = conexao->ackRival + 1;
+    int previstos = 0, totalEntradas = 0, tamanho = TAMANHO_CABECALHO_VERSUS;
+    int32_t quadro = -1, ack = -1;
+    if (conexao->comecou) {
+        previstos = TicksPrevistosVersus(sessao);
+        quadro = (int32_t)sessao->quadro;
+        ack = (int32_t)sessao->ultimoRemoto;
+        for (int64_t t = primeiro; t <= sessao->ultimoLocal && totalEntradas < MAX_ENTRADAS_PACOTE; t++, totalEntradas++) {
+            const EntradaVersus* e = &sessao->entradas[sessao->jogadorLocal][t & (HISTORICO_VERSUS - 1)];
+            pacote[tamanho++] = e->totalCliques;
+            for (int k = 0; k < e->totalCliques; k++) {
+                EscreverU16(pacote + tamanho, e->x[k]);
+                EscreverU16(pacote + tamanho + 2, e->y[k]);
+                tamanho += 4;
+            }
+        }
+    }
+    memcpy(pacote, "BV", 2);
+    pacote[2] = VERSAO_REDE_VERSUS;
+    pacote[3] = (uint8_t)conexao->dificuldade;
+    pacote[4] = (uint8_t)conexao->atraso;
+    pacote[5] = (uint8_t)(int8_t)(previstos > 127 ? 127 : (previstos < -127 ? -127 : previstos));
+    pacote[6] = (uint8_t)totalEntradas;
+    pacote[7] = 0;
+    EscreverU32(pacote + 8, conexao->nonce);
+    EscreverU32(pacote + 12, conexao->nonceRival);
+    EscreverU32(pacote + 16, conexao->sequencia++);
+    EscreverU32(pacote + 20, Carimbo(conexao, agora));
+    EscreverU32(pacote + 24, conexao->ecoRival);
+    EscreverU32(pacote + 28, (uint32_t)quadro);
+    EscreverU32(pacote + 32, (uint32_t)ack);
+    EscreverU32(pacote + 36, (uint32_t)(int32_t)primeiro);
+    Enviar(conexao, pacote, tamanho, agora);
+}
+
+// Fim do aperto de mão: os dois lados chegam na mesma configuração a partir dos dois nonces. Se faltar memória
+// para a partida, o aperto de mão fica pendente e o próximo pacote do rival tenta de novo.
+static bool ComecarPartida(ConexaoVersus* conexao, SessaoVersus* sessao, EstadoJogo* jogo, const ConfiguracaoJogo* base) {
+    bool souJogador0 = conexao->nonce < conexao->nonceRival;
+    uint32_t menor = souJogador0 ? conexao->nonce : conexao->nonceRival;
+    uint32_t maior = souJogador0 ? conexao->nonceRival : conexao->nonce;
+    ConfiguracaoJogo configuracao = *base;
+    configuracao.dificuldade = souJogador0 ? conexao->dificuldade : conexao->dificuldadeRival;
+    configuracao.semente = (uint64_t)menor << 32 | maior;
+    if (!IniciarSessaoVersus(sessao, jogo, &configuracao, souJogador0 ? 0 : 1, souJogador0 ? conexao->atraso : conexao->atrasoRival))
+        return false;
+    conexao->ackRival = sessao->atraso - 1; // O rival já sabe que os primeiros ticks são vazios.
+    conexao->comecou = true;
+    return true;
+}
+
+// Trata um pacote recebido. Retorna true se ele terminou o aperto de mão.
+static bool TratarPacote(ConexaoVersus* conexao, SessaoVersus* sessao, EstadoJogo* jogo, const ConfiguracaoJogo* base,
+                         const uint8_t* p, int tamanho, double agora) {
+    if (tamanho < TAMANHO_CABECALHO_VERSUS || memcmp(p, "BV", 2) != 0 || p[2] != VERSAO_REDE_VERSUS || p[3] > DIFICIL)
+        return false;
+    uint32_t nonce = LerU32(p + 8), eco = LerU32(p + 12);
+    if (nonce == 0 || nonce == conexao->nonce || (eco != 0 && eco != conexao->nonce))
+        return false; // Outra partida (ou o próprio pacote voltando).
+    if (conexao->nonceRival == 0) {
+        conexao->nonceRival = nonce;
+        conexao->dificuldadeRival = (Dificuldade)p[3];
+        conexao->atrasoRival = p[4];
+    } else if (nonce != conexao->nonceRival) {
+        return false;
+    }
+    conexao->pacotesRecebidos++;
+    conexao->ultimoRecebimento = agora;
+    bool comecouAgora = false;
+    if (!conexao->comecou) {
+        if (eco != conexao->nonce)
+            return false; // O rival ainda não viu o nosso convite.
+        if (!ComecarPartida(conexao, sessao, jogo, base))
+            return false;
+        comecouAgora = true;
+    }
+
+    // Só o pacote mais novo atualiza o eco, a confirmação e a previsão do rival; as entradas valem de qualquer um.
+    uint32_t sequencia = LerU32(p + 16);
+    if (conexao->pacotesRecebidos == 1 || (int32_t)(sequencia - conexao->sequenciaRival) > 0) {
+        conexao->sequenciaRival = sequencia;
+        conexao->ecoRival = LerU32(p + 20);
+        uint32_t meuCarimbo = LerU32(p + 24);
+        if (meuCarimbo != 0) {
+            double rtt = (double)(uint32_t)(Carimbo(conexao, agora) - meuCarimbo) / 1000.0;
+            conexao->rttMs = conexao->rttMs == 0.0 ? rtt : conexao->rttMs * 0.9 + rtt * 0.1;
+            if (rtt > conexao->rttMaximoMs)
+                conexao->rttMaximoMs = rtt;
+        }
+        int32_t ack = (int32_t)LerU32(p + 32);
+        if (ack > conexao->ackRival)
+            conexao->ackRival = ack;
+        if ((int32_t)LerU32(p + 28) >= 0)
+            sessao->aFrenteRival = (int8_t)p[5];
+    } else {
+        conexao->pacotesForaDeOrdem++;
+    }
+
+    int64_t tick = (int32_t)LerU32(p + 36);
+    int offset = TAMANHO_CABECALHO_VERSUS;
+    for (int k = 0; k < p[6]; k++, tick++) {
+        if (offset >= tamanho)
+            break;
+        EntradaVersus e;
+        e.totalCliques = p[offset++];
+        if (e.totalCliques > MAX_CLIQUES_VERSUS || offset + 4 * e.totalCliques > tamanho)
+            break; // Pacote corrompido.
+        for (int c = 0; c < e.totalCliques; c++, offset += 4) {
+            e.x[c] = LerU16(p + offset);
+            e.y[c] = LerU16(p + offset + 2);
+        }
+        ReceberEntradaVersus(sessao, tick, &e);
+    }
+    return comecouAgora;
+}
+
+bool ProcessarConexaoVersus(ConexaoVersus* conexao, SessaoVersus* sessao, EstadoJogo* jogo, const ConfiguracaoJogo* base, double agora) {
+    SoltarAtrasados(conexao, agora);
+    bool comecou = false;
+    uint8_t pacote[MAX_PACOTE_VERSUS + 1];
+    for (;;) {
+        struct sockaddr_in origem;
+        TamanhoEndereco tamanhoOrigem = sizeof(origem);
+        long n = (long)recvfrom(conexao->soquete, (char*)pacote, (int)sizeof(pacote), 0, (struct sockaddr*)&origem, &tamanhoOrigem);
+        if (n < 0)
+            break; // Nada mais na fila (ou um erro de ICMP do rival ainda fechado, no Windows).
+        if (origem.sin_addr.s_addr != conexao->enderecoRival || ntohs(origem.sin_port) != conexao->portaRival)
+            continue;
+        if (TratarPacote(conexao, sessao, jogo, base, pacote, (int)n, agora))
+            comecou = true;
+    }
+    return comecou;
+}
+
+bool ConexaoVersusPerdida(const ConexaoVersus* conexao, double agora) {
+    return agora - conexao->ultimoRecebimento > SEGUNDOS_SEM_RESPOSTA;
+}
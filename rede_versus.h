@@ -0,0 +1,95 @@
+#ifndef REDE_VERSUS_H
+#define REDE_VERSUS_H
+
+#include "versus.h"
+#include "placar_rede.h" // Soquete e a iniciação da rede (a mesma do placar).
+
+// --- REDE DO MODO VERSUS (UDP) ---
+// Cada lado manda um pacote por tick com as suas entradas que o rival ainda não confirmou, a partir da última
+// confirmada. Um pacote perdido não é reenviado: as mesmas entradas vão de novo no próximo, até o rival confirmá-las.
+// Como as entradas só valem em ordem, um pacote atrasado ou fora de ordem não atrapalha.
+//
+// Antes da partida, os dois lados trocam um número aleatório (nonce). A partida começa quando cada um vê o seu
+// nonce ecoado pelo outro; o menor nonce é o jogador 0, cuja dificuldade e atraso de entrada valem para os dois, e a
+// semente vem dos dois nonces. Pacotes com o eco de outro nonce são de uma partida anterior e são ignorados.
+//
+// Para testar em uma máquina só, a conexão pode atrasar, variar (jitter) e perder os pacotes que envia.
+//
+// Formato do pacote (little-endian):
+//   "BV", versão (1 byte), dificuldade (1), atraso de entrada (1), ticks previstos (1, com sinal), total de entradas (1),
+//   1 byte reservado, nonce (4), nonce do rival (4, 0 se ainda não conhece), sequência (4),
+//   carimbo (4, microssegundos), eco (4, o último carimbo recebido do rival), quadro (4, -1 antes de começar),
+//   último tick do rival recebido (4), tick da primeira entrada (4)
+//   para cada entrada: total de cliques (1 byte), e para cada clique x (2) e y (2)
+
+#define VERSAO_REDE_VERSUS 2 // 2: máscaras de colisão (versões diferentes acertariam animais diferentes).
+#define PORTA_VERSUS 7430
+#define TAMANHO_CABECALHO_VERSUS 40
+#define MAX_ENTRADAS_PACOTE 64          // Entradas por pacote (as seguintes vão no próximo).
+#define MAX_PACOTE_VERSUS (TAMANHO_CABECALHO_VERSUS + MAX_ENTRADAS_PACOTE * (1 + 4 * MAX_CLIQUES_VERSUS))
+#define MAX_PACOTES_ATRASADOS 512       // Pacotes retidos pela rede simulada.
+#define SEGUNDOS_SEM_RESPOSTA 5.0       // Sem nenhum pacote do rival por esse tempo, a conexão é dada como perdida.
+
+// Rede simulada, aplicada aos pacotes enviados. Com tudo zerado, os pacotes saem na hora.
+typedef struct {
+    int latenciaMs;   // Atraso de ida de cada pacote.
+    int variacaoMs;   // Cada pacote atrasa mais ou menos até este tanto (pode trocar a ordem deles).
+    float perda;      // Porcentagem de pacotes descartados.
+} SimulacaoRede;
+
+typedef struct {
+    double envioEm;   // Momento (no relógio de 'agora') em que o pacote sai.
+    int tamanho;
+    uint8_t dados[MAX_PACOTE_VERSUS];
+} PacoteAtrasado;
+
+typedef struct {
+    Soquete soquete;
+    uint32_t enderecoRival;      // IPv4 do rival, na ordem da rede.
+    uint16_t portaRival;
+    uint32_t nonce, nonceRival;  // nonceRival é 0 até o primeiro pacote do rival.
+    Dificuldade dificuldade;     // Propostas deste lado (valem as do jogador 0).
+    int atraso;
+    Dificuldade dificuldadeRival;
+    int atrasoRival;
+    bool comecou;                // true depois do aperto de mão: a sessão está rodando.
+    SimulacaoRede simulacao;
+    GeradorAleatorio gerador;    // Sorteia a perda e o jitter da rede simulada.
+    PacoteAtrasado* atrasados;   // Pacotes retidos pela rede simulada (MAX_PACOTES_ATRASADOS).
+    int totalAtrasados;
+    uint32_t sequencia;          // Sequência do próximo pacote enviado.
+    uint32_t sequenciaRival;     // Maior sequência recebida do rival.
+    uint32_t ecoRival;           // Último carimbo recebido do rival, devolvido no próximo pacote.
+    int64_t ackRival;            // Último tick local que o rival confirmou ter recebido.
+    double inicio;               // Momento da abertura (zero dos carimbos).
+    double ultimoEnvio;
+    double ultimoRecebimento;
+
+    // Estatísticas
+    int64_t pacotesEnviados;
+    int64_t pacotesPerdidos;     // Descartados pela rede simulada.
+    int64_t pacotesRecebidos;
+    int64_t pacotesForaDeOrdem;
+    double rttMs;                // Tempo de ida e volta, média móvel.
+    double rttMaximoMs;
+} ConexaoVersus;
+
+// Abre a porta UDP local e guarda o rival ("a.b.c.d" ou "localhost"). 'agora' é o relógio usado em todas as chamadas
+// (segundos). Retorna false se a porta não abrir ou o endereço for inválido.
+bool AbrirConexaoVersus(ConexaoVersus* conexao, uint16_t portaLocal, const char* enderecoRival, uint16_t portaRival,
+                        uint32_t nonce, Dificuldade dificuldade, int atraso, double agora);
+// Fecha a porta. Pode ser chamada de novo, ou com a struct zerada de uma conexão que nunca foi aberta.
+void FecharConexaoVersus(ConexaoVersus* conexao);
+
+// Lê os pacotes que chegaram e solta os atrasados que venceram. Antes da partida, faz o aperto de mão e, quando ele
+// termina, inicia a sessão em 'jogo' com 'base' (tela e buracos; dificuldade e semente vêm do aperto de mão) e
+// retorna true. Depois, passa as entradas do rival para a sessão.
+bool ProcessarConexaoVersus(ConexaoVersus* conexao, SessaoVersus* sessao, EstadoJogo* jogo, const ConfiguracaoJogo* base, double agora);
+
+// Envia as entradas locais que o rival ainda não confirmou. Antes da partida, envia o convite (no máximo 20 por segundo).
+void EnviarConexaoVersus(ConexaoVersus* conexao, const SessaoVersus* sessao, double agora);
+
+// true se o rival não mandou nada há SEGUNDOS_SEM_RESPOSTA (só faz sentido depois que a partida começou).
+bool ConexaoVersusPerdida(const ConexaoVersus* conexao, double agora);
+
+#endif
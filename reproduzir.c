@@ -0,0 +1,69 @@
+#include "logica.h"
+#include "gravacao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// --- REPRODUTOR SEM JANELA ---
+// Reproduz partidas gravadas (JogoC --gravar) na velocidade máxima e confere se a pontuação final é a gravada.
+// Serve como teste de regressão (o código de saída é 1 se alguma partida divergir) e de desempenho (--vezes N
+// repete cada partida N vezes e mostra quantas partidas e ticks por segundo a simulação alcança).
+// Não depende da Raylib.
+// Uso: reproduzir arquivo.brec [outro.brec ...] [--vezes N]
+
+static const char* NOMES_DIFICULDADE[] = { "FACIL", "MEDIO", "DIFICIL" };
+
+int main(int argc, char* argv[]) {
+    int vezes = 1;
+    int totalArquivos = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--vezes") == 0 && i + 1 < argc)
+            vezes = atoi(argv[++i]);
+        else
+            totalArquivos++;
+    }
+    if (totalArquivos == 0 || vezes < 1) {
+        fprintf(stderr, "Uso: %s arquivo.brec [outro.brec ...] [--vezes N]\n", argv[0]);
+        return 2;
+    }
+
+    int falhas = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--vezes") == 0) {
+            i++;
+            continue;
+        }
+        Gravacao gravacao = {0};
+        if (!CarregarGravacao(&gravacao, argv[i])) {
+            printf("%s: não foi possível ler a gravação\n", argv[i]);
+            falhas++;
+            continue;
+        }
+
+        int pontos = 0;
+        bool bateu = true;
+        clock_t inicio = clock();
+        for (int v = 0; v < vezes; v++) {
+            pontos = ReproduzirGravacao(&gravacao);
+            bateu = bateu && pontos == gravacao.pontosFinais;
+        }
+        double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+        if (pontos < 0) {
+            printf("%s: memória insuficiente para a partida\n", argv[i]);
+            falhas++;
+            LiberarGravacao(&gravacao);
+            continue;
+        }
+
+        printf("%s: %s, %d buracos, %d cliques, pontos %d (gravado %d) %s\n", argv[i], NOMES_DIFICULDADE[gravacao.configuracao.dificuldade],
+               gravacao.configuracao.totalBuracos, gravacao.totalCliques, pontos, gravacao.pontosFinais, bateu ? "OK" : "DIVERGIU");
+        if (segundos > 0.0)
+            printf("  %d reproduções em %.3f s: %.0f partidas/s, %.2e ticks/s\n", vezes, segundos, vezes / segundos,
+                   (double)gravacao.tickFinal * vezes / segundos);
+        if (!bateu)
+            falhas++;
+        LiberarGravacao(&gravacao);
+    }
+    return falhas > 0 ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+#include "resolucao.h"
+#include "lotes.h"
+#include "rlgl.h" // Viewport e projeção do desenho na textura de destino.
+#include <math.h>
+
+// Calcula o tamanho da resolução interna a partir da área na janela e da escala.
+static void AplicarEscala(Resolucao* resolucao) {
+    resolucao->larguraInterna = (int)(resolucao->destino.width * resolucao->escala + 0.5f);
+    resolucao->alturaInterna = (int)(resolucao->destino.height * resolucao->escala + 0.5f);
+    if (resolucao->larguraInterna < 1)
+        resolucao->larguraInterna = 1;
+    if (resolucao->alturaInterna < 1)
+        resolucao->alturaInterna = 1;
+}
+
+// Recalcula a área do jogo na janela e recria a textura de destino se a janela mudou de tamanho.
+static void AtualizarDestino(Resolucao* resolucao) {
+    int largura = GetScreenWidth(), altura = GetScreenHeight();
+    if (largura == resolucao->larguraJanela && altura == resolucao->alturaJanela && resolucao->alvo.id != 0)
+        return;
+    if (largura < 1 || altura < 1) // Janela minimizada: fica com o destino anterior.
+        return;
+    resolucao->larguraJanela = largura;
+    resolucao->alturaJanela = altura;
+
+    // A maior área com a proporção virtual que cabe na janela, centralizada. As bordas ficam em pixels inteiros
+    // para a escala cheia copiar a textura para a janela pixel a pixel.
+    float fator = fminf((float)largura / LARGURA_VIRTUAL, (float)altura / ALTURA_VIRTUAL);
+    float larguraDestino = floorf(LARGURA_VIRTUAL * fator), alturaDestino = floorf(ALTURA_VIRTUAL * fator);
+    resolucao->destino = (Rectangle){ floorf((largura - larguraDestino) / 2), floorf((altura - alturaDestino) / 2), larguraDestino, alturaDestino };
+
+    if (resolucao->alvo.id == 0 || resolucao->alvo.texture.width != (int)larguraDestino || resolucao->alvo.texture.height != (int)alturaDestino) {
+        if (resolucao->alvo.id != 0)
+            UnloadRenderTexture(resolucao->alvo);
+        resolucao->alvo = LoadRenderTexture((int)larguraDestino, (int)alturaDestino);
+        SetTextureFilter(resolucao->alvo.texture, TEXTURE_FILTER_BILINEAR); // Suaviza a ampliação da resolução interna.
+    }
+    AplicarEscala(resolucao);
+
+    // A Raylib devolve (posição + deslocamento) * escala no GetMousePosition: o mouse já sai em coordenadas virtuais.
+    SetMouseOffset(-(int)resolucao->destino.x, -(int)resolucao->destino.y);
+    SetMouseScale(LARGURA_VIRTUAL / larguraDestino, ALTURA_VIRTUAL / alturaDestino);
+    TraceLog(LOG_INFO, "RESOLUCAO: janela %dx%d, jogo em %dx%d", largura, altura, (int)larguraDestino, (int)alturaDestino);
+}
+
+void IniciarResolucao(Resolucao* resolucao, double duracaoAlvo, float escala) {
+    *resolucao = (Resolucao){0};
+    resolucao->dinamica = escala <= 0.0f;
+    if (escala <= 0.0f || escala > 1.0f)
+        escala = 1.0f;
+    if (escala < ESCALA_MINIMA)
+        escala = ESCALA_MINIMA;
+    resolucao->escala = escala;
+    resolucao->menorEscala = escala;
+    resolucao->duracaoAlvo = duracaoAlvo;
+    AtualizarDestino(resolucao);
+}
+
+void LiberarResolucao(Resolucao* resolucao) {
+    if (resolucao->alvo.id != 0)
+        UnloadRenderTexture(resolucao->alvo);
+    resolucao->alvo = (RenderTexture2D){0};
+    SetMouseOffset(0, 0);
+    SetMouseScale(1.0f, 1.0f);
+}
+
+void IniciarDesenhoVirtual(Resolucao* resolucao, Color fundo) {
+    AtualizarDestino(resolucao);
+    BeginTextureMode(resolucao->alvo);
+    ClearBackground(fundo);
+    // Desenha só no canto da textura com a resolução interna, e a projeção leva as coordenadas virtuais para ele.
+    rlViewport(0, 0, resolucao->larguraInterna, resolucao->alturaInterna);
+    rlMatrixMode(RL_PROJECTION);
+    rlLoadIdentity();
+    rlOrtho(0, LARGURA_VIRTUAL, ALTURA_VIRTUAL, 0, 0.0, 1.0);
+    rlMatrixMode(RL_MODELVIEW);
+    rlLoadIdentity();
+}
+
+void TerminarDesenhoVirtual(Resolucao* resolucao) {
+    EndTextureMode(); // Envia o lote da textura de destino e volta para a janela.
+    ClearBackground(BLACK);
+    // A textura de destino fica de cabeça para baixo (origem do OpenGL embaixo): a altura negativa a desvira. O canto
+    // desenhado é o de baixo da textura, que começa em y = 0 nas coordenadas de textura.
+    Rectangle origem = { 0, 0, (float)resolucao->larguraInterna, -(float)resolucao->alturaInterna };
+    DesenharTexturaLote(resolucao->alvo.texture, origem, resolucao->destino, WHITE);
+}
+
+void MedirQuadroResolucao(Resolucao* resolucao, double trabalho) {
+    resolucao->quadrosMedidos++;
+    resolucao->somaEscala += resolucao->escala;
+    // Média móvel: um frame lento isolado (um pico do sistema) não derruba a resolução sozinho.
+    if (resolucao->mediaTrabalho == 0.0)
+        resolucao->mediaTrabalho = trabalho;
+    else
+        resolucao->mediaTrabalho += 0.1 * (trabalho - resolucao->mediaTrabalho);
+    if (!resolucao->dinamica)
+        return;
+
+    resolucao->quadrosDesdeMudanca++;
+    float escalaAnterior = resolucao->escala;
+    if (resolucao->mediaTrabalho > resolucao->duracaoAlvo * FRACAO_ORCAMENTO) {
+        // Estourou o orçamento: desce logo, mas espera a média refletir a mudança anterior antes de descer de novo.
+        resolucao->quadrosComFolga = 0;
+        if (resolucao->quadrosDesdeMudanca >= QUADROS_PARA_DESCER && resolucao->escala > ESCALA_MINIMA + 0.001f) {
+            resolucao->escala = fmaxf(ESCALA_MINIMA, resolucao->escala - PASSO_ESCALA);
+            resolucao->descidas++;
+        }
+    } else if (resolucao->mediaTrabalho < resolucao->duracaoAlvo * FRACAO_FOLGA) {
+        // Folga grande o bastante para um degrau a mais de pixels caber no orçamento.
+        if (++resolucao->quadrosComFolga >= QUADROS_PARA_SUBIR && resolucao->escala < 1.0f - 0.001f) {
+            resolucao->escala = fminf(1.0f, resolucao->escala + PASSO_ESCALA);
+            resolucao->subidas++;
+        }
+    } else {
+        resolucao->quadrosComFolga = 0;
+    }
+    if (resolucao->escala != escalaAnterior) {
+        resolucao->quadrosDesdeMudanca = 0;
+        resolucao->quadrosComFolga = 0;
+        if (resolucao->escala < resolucao->menorEscala)
+            resolucao->menorEscala = resolucao->escala;
+        AplicarEscala(resolucao);
+        TraceLog(LOG_INFO, "RESOLUCAO: %dx%d (%.0f%%), trabalho médio %.1f ms", resolucao->larguraInterna, resolucao->alturaInterna,
+                 resolucao->escala * 100.0f, resolucao->mediaTrabalho * 1000.0);
+    }
+}
+
+void DesenharResolucao(const Resolucao* resolucao, int x, int y) {
+    // Desenhado direto com a Raylib, como o painel dos lotes, para não entrar na contagem.
+    DrawRectangle(x, y, 360, 50, Fade(BLACK, 0.6f));
+    DrawText(TextFormat("Resolucao interna: %dx%d (%.0f%%)%s", resolucao->larguraInterna, resolucao->alturaInterna,
+                        resolucao->escala * 100.0f, resolucao->dinamica ? "" : " fixa"), x + 10, y + 6, 18, WHITE);
+    DrawText(TextFormat("Trabalho: %.1f ms (orcamento %.1f)", resolucao->mediaTrabalho * 1000.0,
+                        resolucao->duracaoAlvo * FRACAO_ORCAMENTO * 1000.0), x + 10, y + 28, 18, WHITE);
+}
@@ -0,0 +1,75 @@
+#ifndef RESOLUCAO_H
+#define RESOLUCAO_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// --- RESOLUÇÃO VIRTUAL E RESOLUÇÃO DINÂMICA ---
+// Todo o jogo (lógica, telas, botões, partículas e texto) usa coordenadas virtuais de 1500x800, o tamanho original
+// da janela. Cada frame é desenhado em uma textura de destino (render target) e depois esticado para a janela, com
+// faixas pretas nos lados ou em cima e embaixo quando a proporção da janela é outra. O mouse é convertido de volta
+// para coordenadas virtuais pela própria Raylib (SetMouseOffset / SetMouseScale), então a fila de entrada, os
+// botões e os cliques no campo de jogo não mudam.
+//
+// A textura de destino tem o tamanho da área ocupada na janela (em 4K, 3840x2048) e só é recriada quando a janela
+// muda de tamanho. A resolução interna é uma fração dela: o frame é desenhado só no canto da textura (viewport
+// menor) e esse canto é esticado para a janela. Mudar a resolução interna não aloca nada, então ela pode mudar
+// durante a partida sem travar um frame.
+//
+// O controle de resolução dinâmica mede o tempo de trabalho de cada frame da partida (do início do frame até o fim
+// do EndDrawing, sem a espera do próximo frame): com a GPU atrasada, o EndDrawing fica esperando na troca de
+// buffers, então o tempo da GPU aparece ali. Quando a média passa do orçamento do frame, a escala desce um degrau
+// logo; quando sobra bastante folga por alguns segundos, sobe um degrau. Os limiares diferentes e as esperas entre
+// mudanças evitam que a escala fique oscilando entre dois degraus.
+
+#define LARGURA_VIRTUAL 1500
+#define ALTURA_VIRTUAL 800
+
+#define ESCALA_MINIMA 0.5f          // Menor resolução interna, em fração da área na janela (um quarto dos pixels).
+#define PASSO_ESCALA 0.1f           // Degrau de cada mudança da resolução interna.
+#define FRACAO_ORCAMENTO 0.85       // Orçamento do trabalho de um frame, em fração da duração do frame.
+#define FRACAO_FOLGA 0.55           // Abaixo disto (em fração da duração do frame) há folga para subir um degrau.
+#define QUADROS_PARA_DESCER 15      // Frames depois de uma mudança antes de poder descer de novo.
+#define QUADROS_PARA_SUBIR 120      // Frames com folga antes de subir (2 s a 60 FPS).
+
+typedef struct {
+    RenderTexture2D alvo;      // Textura de destino, do tamanho de 'destino'.
+    int larguraJanela, alturaJanela; // Tamanho da janela quando 'destino' foi calculado.
+    Rectangle destino;         // Área da janela ocupada pelo jogo, com a proporção virtual (o resto fica preto).
+    float escala;              // Resolução interna, em fração de 'destino' (de ESCALA_MINIMA a 1).
+    int larguraInterna, alturaInterna; // Pixels realmente desenhados no frame.
+    bool dinamica;             // false mantém a escala fixa (--escala).
+
+    // Controle da resolução dinâmica
+    double duracaoAlvo;        // Duração desejada de um frame, em segundos.
+    double mediaTrabalho;      // Média móvel do tempo de trabalho dos frames, em segundos.
+    int quadrosDesdeMudanca;
+    int quadrosComFolga;
+
+    // Estatísticas
+    int descidas, subidas;
+    float menorEscala;
+    double somaEscala;         // Soma da escala de cada frame medido, para a média no fim.
+    long long quadrosMedidos;
+} Resolucao;
+
+// Prepara a resolução para frames de 'duracaoAlvo' segundos. 'escala' entre ESCALA_MINIMA e 1 fixa a resolução
+// interna; 0 liga a resolução dinâmica, começando na resolução cheia. Deve ser chamada depois do InitWindow.
+void IniciarResolucao(Resolucao* resolucao, double duracaoAlvo, float escala);
+void LiberarResolucao(Resolucao* resolucao);
+
+// Começa o desenho do frame na textura de destino, em coordenadas virtuais. Se a janela mudou de tamanho, recria a
+// textura e ajusta a conversão do mouse. Deve ser chamada logo depois do BeginDrawing.
+void IniciarDesenhoVirtual(Resolucao* resolucao, Color fundo);
+
+// Termina o desenho virtual e o estica para a janela. Depois dela, o desenho continua em coordenadas da janela
+// (para os painéis de depuração), até o EndDrawing.
+void TerminarDesenhoVirtual(Resolucao* resolucao);
+
+// Informa o tempo de trabalho de um frame da partida (sem a espera). Pode mudar a escala para o próximo frame.
+void MedirQuadroResolucao(Resolucao* resolucao, double trabalho);
+
+// Mostra a resolução interna e a média do tempo de trabalho, em coordenadas da janela.
+void DesenharResolucao(const Resolucao* resolucao, int x, int y);
+
+#endif
@@ -0,0 +1,366 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime e poll.
+#include "placar.h"
+#include "placar_rede.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #define poll WSAPoll
+    typedef WSAPOLLFD EventoSoquete;
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    typedef struct pollfd EventoSoquete;
+#endif
+
+// --- SERVIDOR DO PLACAR ---
+// Recebe as pontuações de várias instâncias do jogo (e do teste de carga) pelo loopback e responde a posição de
+// cada uma. Uma thread só, com poll: a cada volta, os envios de todas as conexões que chegaram juntos formam um
+// único lote no placar, com uma escrita no log e um fsync, e cada conexão recebe as posições dos seus registros.
+// Assim o custo do fsync é dividido entre os clientes, e o número de envios por segundo cresce com a carga.
+// Protocolo em placar_rede.h. Não depende da Raylib.
+//
+// Uso: servidor_placar [--porta P] [--arquivo base] [--sem-fsync]
+//   --arquivo    nome base do placar (padrão "placar": placar.idx e placar.log)
+//   --sem-fsync  não espera o disco a cada lote (mais rápido, mas uma queda pode perder os últimos envios)
+// Ao receber Ctrl+C, compacta o placar e sai.
+
+#define MAX_CONEXOES 256
+#define MAX_LOTE_SERVIDOR (MAX_CONEXOES * 64) // Registros por lote do placar (de todas as conexões juntas).
+
+typedef struct {
+    Soquete soquete;
+    uint8_t entrada[MAX_MENSAGEM_PLACAR]; // Bytes recebidos e ainda não tratados (no máximo uma mensagem inteira).
+    size_t tamanhoEntrada;
+    uint8_t* saida;                       // Respostas ainda não enviadas.
+    size_t tamanhoSaida, capacidadeSaida, enviado;
+    int inicioLote, totalLote;            // Registros desta conexão no lote atual.
+    bool fechar;
+} Conexao;
+
+static Conexao* conexoes[MAX_CONEXOES];
+static int totalConexoes;
+static Placar placar;
+static RegistroPlacar lote[MAX_LOTE_SERVIDOR];
+static PosicaoPlacar posicoes[MAX_LOTE_SERVIDOR];
+static volatile sig_atomic_t parar;
+static int64_t enviosPeriodo, lotesPeriodo; // Para a linha de estatísticas.
+
+static void PedirParada(int sinal) {
+    (void)sinal;
+    parar = 1;
+}
+
+static double Agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void TornarNaoBloqueante(Soquete s) {
+#if defined(_WIN32)
+    u_long sim = 1;
+    ioctlsocket((SOCKET)s, FIONBIO, &sim);
+#else
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+#endif
+}
+
+// Acrescenta bytes às respostas pendentes da conexão.
+static void Responder(Conexao* c, const uint8_t* dados, size_t tamanho) {
+    if (c->tamanhoSaida + tamanho > c->capacidadeSaida) {
+        size_t nova = c->capacidadeSaida == 0 ? MAX_MENSAGEM_PLACAR : c->capacidadeSaida;
+        while (nova < c->tamanhoSaida + tamanho)
+            nova *= 2;
+        uint8_t* saida = (uint8_t*)realloc(c->saida, nova);
+        if (saida == NULL) {
+            c->fechar = true;
+            return;
+        }
+        c->saida = saida;
+        c->capacidadeSaida = nova;
+    }
+    memcpy(c->saida + c->tamanhoSaida, dados, tamanho);
+    c->tamanhoSaida += tamanho;
+}
+
+// Tamanho da primeira mensagem da entrada se ela já chegou inteira, 0 se ainda falta algo, -1 se for inválida.
+static long MensagemCompleta(const Conexao* c) {
+    if (c->tamanhoEntrada < TAMANHO_CABECALHO_REDE)
+        return 0;
+    int tipo = c->entrada[0], parametro = c->entrada[1], quantidade = c->entrada[2] | c->entrada[3] << 8;
+    if (quantidade > MAX_LOTE_PLACAR)
+        return -1;
+    size_t tamanho = TAMANHO_CABECALHO_REDE;
+    if (tipo == MENSAGEM_ENVIAR)
+        tamanho += (size_t)quantidade * TAMANHO_REGISTRO_PLACAR;
+    else if (tipo != MENSAGEM_TOPO || parametro > DIFICIL)
+        return -1;
+    return c->tamanhoEntrada >= tamanho ? (long)tamanho : 0;
+}
+
+static void Consumir(Conexao* c, size_t tamanho) {
+    memmove(c->entrada, c->entrada + tamanho, c->tamanhoEntrada - tamanho);
+    c->tamanhoEntrada -= tamanho;
+}
+
+// Trata as mensagens recebidas. Cada volta junta no máximo um envio de cada conexão em um lote, grava o lote e
+// depois responde as consultas, na ordem em que cada conexão as mandou.
+static void ProcessarMensagens(void) {
+    for (;;) {
+        bool progresso = false;
+        int totalLote = 0;
+        for (int i = 0; i < totalConexoes; i++)
+            conexoes[i]->totalLote = 0;
+        for (int i = 0; i < totalConexoes; i++) {
+            Conexao* c = conexoes[i];
+            long tamanho = MensagemCompleta(c);
+            if (tamanho < 0) {
+                c->fechar = true;
+                continue;
+            }
+            if (tamanho == 0 || c->entrada[0] != MENSAGEM_ENVIAR)
+                continue;
+            int quantidade = c->entrada[2] | c->entrada[3] << 8;
+            if (totalLote + quantidade > MAX_LOTE_SERVIDOR)
+                break; // Fica para a próxima volta.
+            c->inicioLote = totalLote;
+            c->totalLote = quantidade;
+            for (int k = 0; k < quantidade; k++) {
+                DecodificarRegistroPlacar(c->entrada + TAMANHO_CABECALHO_REDE + k * TAMANHO_REGISTRO_PLACAR, &lote[totalLote]);
+                if (lote[totalLote++].dificuldade > DIFICIL)
+                    c->fechar = true; // Um registro inválido não pode derrubar o lote das outras conexões.
+            }
+            if (c->fechar) {
+                totalLote = c->inicioLote;
+                c->totalLote = 0;
+            }
+            Consumir(c, (size_t)tamanho);
+        }
+
+        if (totalLote > 0) {
+            bool ok = AdicionarPontuacoes(&placar, lote, totalLote, posicoes);
+            enviosPeriodo += ok ? totalLote : 0;
+            lotesPeriodo++;
+            for (int i = 0; i < totalConexoes; i++) {
+                Conexao* c = conexoes[i];
+                if (c->totalLote == 0)
+                    continue;
+                uint8_t resposta[TAMANHO_CABECALHO_REDE + MAX_LOTE_PLACAR * 8];
+                EscreverCabecalhoRede(resposta, MENSAGEM_ENVIAR, ok ? 0 : 1, (uint16_t)(ok ? c->totalLote : 0));
+                uint8_t* p = resposta + TAMANHO_CABECALHO_REDE;
+                for (int k = 0; ok && k < c->totalLote; k++) {
+                    PosicaoPlacar posicao = posicoes[c->inicioLote + k];
+                    for (int b = 0; b < 4; b++) {
+                        p[b] = (uint8_t)((uint32_t)posicao.posicao >> (8 * b));
+                        p[4 + b] = (uint8_t)((uint32_t)posicao.total >> (8 * b));
+                    }
+                    p += 8;
+                }
+                Responder(c, resposta, (size_t)(p - resposta));
+            }
+            progresso = true;
+        }
+
+        for (int i = 0; i < totalConexoes; i++) {
+            Conexao* c = conexoes[i];
+            long tamanho;
+            while (!c->fechar && (tamanho = MensagemCompleta(c)) > 0 && c->entrada[0] == MENSAGEM_TOPO) {
+                static RegistroPlacar topo[MAX_LOTE_PLACAR];
+                static uint8_t resposta[MAX_MENSAGEM_PLACAR];
+                int total = TopoPlacar(&placar, (Dificuldade)c->entrada[1], topo, c->entrada[2] | c->entrada[3] << 8);
+                EscreverCabecalhoRede(resposta, MENSAGEM_TOPO, 0, (uint16_t)total);
+                for (int k = 0; k < total; k++)
+                    CodificarRegistroPlacar(resposta + TAMANHO_CABECALHO_REDE + k * TAMANHO_REGISTRO_PLACAR, &topo[k]);
+                Responder(c, resposta, TAMANHO_CABECALHO_REDE + (size_t)total * TAMANHO_REGISTRO_PLACAR);
+                Consumir(c, (size_t)tamanho);
+                progresso = true;
+            }
+        }
+        if (!progresso)
+            return;
+    }
+}
+
+// Envia o que der das respostas pendentes sem bloquear.
+static void EnviarPendentes(Conexao* c) {
+    while (c->enviado < c->tamanhoSaida) {
+#if defined(_WIN32)
+        int n = send((SOCKET)c->soquete, (const char*)c->saida + c->enviado, (int)(c->tamanhoSaida - c->enviado), 0);
+        if (n <= 0) {
+            if (WSAGetLastError() != WSAEWOULDBLOCK)
+                c->fechar = true;
+            return;
+        }
+#else
+        ssize_t n = send(c->soquete, c->saida + c->enviado, c->tamanhoSaida - c->enviado, 0);
+        if (n <= 0) {
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+                return;
+            c->fechar = true;
+            return;
+        }
+#endif
+        c->enviado += (size_t)n;
+    }
+    c->tamanhoSaida = c->enviado = 0;
+}
+
+static void LerEntrada(Conexao* c) {
+    size_t livre = sizeof(c->entrada) - c->tamanhoEntrada;
+    if (livre == 0)
+        return; // Uma mensagem inteira já está esperando na entrada.
+#if defined(_WIN32)
+    int n = recv((SOCKET)c->soquete, (char*)c->entrada + c->tamanhoEntrada, (int)livre, 0);
+    if (n == 0 || (n < 0 && WSAGetLastError() != WSAEWOULDBLOCK))
+        c->fechar = true;
+#else
+    ssize_t n = recv(c->soquete, c->entrada + c->tamanhoEntrada, livre, 0);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+        c->fechar = true;
+#endif
+    if (n > 0)
+        c->tamanhoEntrada += (size_t)n;
+}
+
+static void AceitarConexoes(Soquete escuta) {
+    for (;;) {
+        Soquete s = (Soquete)accept(escuta, NULL, NULL);
+        if (s == SOQUETE_INVALIDO)
+            return;
+        Conexao* c = totalConexoes < MAX_CONEXOES ? (Conexao*)calloc(1, sizeof(Conexao)) : NULL;
+        if (c == NULL) {
+            FecharSoquete(s);
+            continue;
+        }
+        int sim = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&sim, sizeof(sim));
+        TornarNaoBloqueante(s);
+        c->soquete = s;
+        conexoes[totalConexoes++] = c;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int porta = PORTA_PLACAR;
+    const char* base = "placar";
+    bool sincronizar = true;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--porta") == 0 && i + 1 < argc) {
+            porta = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--arquivo") == 0 && i + 1 < argc) {
+            base = argv[++i];
+        } else if (strcmp(argv[i], "--sem-fsync") == 0) {
+            sincronizar = false;
+        } else {
+            fprintf(stderr, "uso: %s [--porta P] [--arquivo base] [--sem-fsync]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (!AbrirPlacar(&placar, base)) {
+        fprintf(stderr, "não foi possível abrir o placar %s (índice corrompido ou pasta sem permissão)\n", base);
+        return 1;
+    }
+    placar.sincronizar = sincronizar;
+    if (!IniciarRedePlacar())
+        return 1;
+#if !defined(_WIN32)
+    signal(SIGPIPE, SIG_IGN);
+#endif
+    signal(SIGINT, PedirParada);
+    signal(SIGTERM, PedirParada);
+
+    Soquete escuta = (Soquete)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int sim = 1;
+    setsockopt(escuta, SOL_SOCKET, SO_REUSEADDR, (const char*)&sim, sizeof(sim));
+    struct sockaddr_in endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sin_family = AF_INET;
+    endereco.sin_port = htons((uint16_t)porta);
+    endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Só aceita conexões da própria máquina.
+    if (escuta == SOQUETE_INVALIDO || bind(escuta, (struct sockaddr*)&endereco, sizeof(endereco)) != 0 || listen(escuta, 64) != 0) {
+        fprintf(stderr, "não foi possível escutar na porta %d\n", porta);
+        FecharPlacar(&placar);
+        return 1;
+    }
+    TornarNaoBloqueante(escuta);
+
+    int totais[3];
+    for (int d = 0; d < 3; d++)
+        totais[d] = PosicaoNoPlacar(&placar, (Dificuldade)d, 0).total;
+    printf("placar: %s, %d + %d + %d registros, porta %d%s\n", base, totais[0], totais[1], totais[2], porta,
+           sincronizar ? "" : " (sem fsync)");
+    fflush(stdout);
+
+    static EventoSoquete eventos[MAX_CONEXOES + 1];
+    double ultimaEstatistica = Agora();
+    while (!parar) {
+        eventos[0].fd = escuta;
+        eventos[0].events = POLLIN;
+        for (int i = 0; i < totalConexoes; i++) {
+            eventos[i + 1].fd = conexoes[i]->soquete;
+            eventos[i + 1].events = (short)(POLLIN | (conexoes[i]->tamanhoSaida > conexoes[i]->enviado ? POLLOUT : 0));
+            eventos[i + 1].revents = 0;
+        }
+        eventos[0].revents = 0;
+        int prontos = poll(eventos, (unsigned long)(totalConexoes + 1), 1000);
+        int conexoesAntes = totalConexoes;
+        if (prontos > 0) {
+            for (int i = 0; i < conexoesAntes; i++)
+                if (eventos[i + 1].revents & (POLLIN | POLLHUP | POLLERR))
+                    LerEntrada(conexoes[i]);
+            if (eventos[0].revents & POLLIN)
+                AceitarConexoes(escuta);
+            ProcessarMensagens();
+        }
+        // Envia as respostas e remove as conexões fechadas (trocando com a última).
+        for (int i = 0; i < totalConexoes;) {
+            Conexao* c = conexoes[i];
+            if (!c->fechar)
+                EnviarPendentes(c);
+            if (c->fechar) {
+                FecharSoquete(c->soquete);
+                free(c->saida);
+                free(c);
+                conexoes[i] = conexoes[--totalConexoes];
+            } else {
+                i++;
+            }
+        }
+
+        double agora = Agora();
+        if (agora - ultimaEstatistica >= 5.0) {
+            if (lotesPeriodo > 0) {
+                printf("placar: %.0f envios/s em %.0f lotes/s (%.1f por lote), %d conexões\n", enviosPeriodo / (agora - ultimaEstatistica),
+                       lotesPeriodo / (agora - ultimaEstatistica), (double)enviosPeriodo / lotesPeriodo, totalConexoes);
+                fflush(stdout);
+            }
+            enviosPeriodo = lotesPeriodo = 0;
+            ultimaEstatistica = agora;
+        }
+    }
+
+    printf("placar: compactando e saindo\n");
+    for (int i = 0; i < totalConexoes; i++) {
+        FecharSoquete(conexoes[i]->soquete);
+        free(conexoes[i]->saida);
+        free(conexoes[i]);
+    }
+    FecharSoquete(escuta);
+    if (placar.incompleto)
+        printf("placar: faltou memória para parte dos registros; eles ficam no log para a próxima abertura\n");
+    CompactarPlacar(&placar);
+    FecharPlacar(&placar);
+    return 0;
+}
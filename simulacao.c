@@ -0,0 +1,263 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime e nanosleep.
+#include "simulacao.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+double RelogioSimulacao(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void Dormir(double segundos) {
+    if (segundos <= 0.0)
+        return;
+    struct timespec t = { (time_t)segundos, (long)((segundos - (time_t)segundos) * 1e9) };
+    nanosleep(&t, NULL);
+}
+
+// --- BUFFER TRIPLO ---
+
+void PublicarBufferTriplo(BufferTriplo* buffer, const EstadoJogo* jogo, double tempo) {
+    if (!SalvarInstantaneo(jogo, &buffer->quadros[buffer->escrita]))
+        return;
+    buffer->tempos[buffer->escrita] = tempo;
+    // O quadro escrito vira o do meio, e o antigo do meio (que o desenho não pegou ou já largou) é o próximo a escrever.
+    uint32_t anterior = __atomic_exchange_n(&buffer->meio, (uint32_t)buffer->escrita | NOVO_BUFFER_TRIPLO, __ATOMIC_ACQ_REL);
+    buffer->escrita = (int)(anterior & 3u);
+}
+
+const InstantaneoJogo* LerBufferTriplo(BufferTriplo* buffer, double* tempo) {
+    if (__atomic_load_n(&buffer->meio, __ATOMIC_ACQUIRE) & NOVO_BUFFER_TRIPLO) {
+        uint32_t anterior = __atomic_exchange_n(&buffer->meio, (uint32_t)buffer->leitura, __ATOMIC_ACQ_REL);
+        buffer->leitura = (int)(anterior & 3u);
+    }
+    const InstantaneoJogo* quadro = &buffer->quadros[buffer->leitura];
+    if (quadro->memoria == NULL) // Nada publicado ainda.
+        return NULL;
+    if (tempo != NULL)
+        *tempo = buffer->tempos[buffer->leitura];
+    return quadro;
+}
+
+void LiberarBufferTriplo(BufferTriplo* buffer) {
+    for (int i = 0; i < 3; i++)
+        LiberarInstantaneo(&buffer->quadros[i]);
+}
+
+// --- THREAD DA SIMULAÇÃO ---
+
+// Um passo: aplica os cliques que chegaram, avança de 'inicio' até 'agora' e publica o estado.
+static void PassoSimulacao(ThreadSimulacao* s, double inicio, double agora) {
+    EstadoJogo* jogo = s->jogo;
+    double dt = agora > inicio ? agora - inicio : 0.0;
+    EntradaJogo entrada;
+    entrada.totalCliques = 0;
+    double tempoCliques[MAX_CLIQUES_PASSO];
+
+    uint32_t escrita = __atomic_load_n(&s->escritaCliques, __ATOMIC_ACQUIRE);
+    uint32_t leitura = s->leituraCliques;
+    for (; leitura != escrita && entrada.totalCliques < MAX_CLIQUES_PASSO; leitura++) {
+        CliqueSimulacao c = s->cliques[leitura & (MAX_CLIQUES_SIMULACAO - 1)];
+        // Um clique que chegou depois do tick dele (o desenho só lê o mouse entre os frames) vale no início do passo.
+        double deslocamento = c.tempo - inicio;
+        deslocamento = deslocamento < 0.0 ? 0.0 : (deslocamento > dt ? dt : deslocamento);
+        tempoCliques[entrada.totalCliques] = c.tempo;
+        entrada.cliques[entrada.totalCliques++] = (CliqueJogo){ deslocamento, c.x, c.y };
+    }
+    __atomic_store_n(&s->leituraCliques, leitura, __ATOMIC_RELEASE);
+
+    int64_t tickAntes = jogo->tick;
+    int acertosAntes = jogo->totalAcertosRecentes;
+    PassoJogo(jogo, dt, &entrada);
+    int ticks = (int)(jogo->tick - tickAntes);
+
+    // Atraso de cada tick simulado: da hora em que ele venceu até agora. Acordando na hora, é o do último tick.
+    for (int k = 0; k < ticks; k++) {
+        s->atrasos[s->totalAtrasos & (MAX_ATRASOS_SIMULACAO - 1)] = (float)((jogo->acumulador + (ticks - 1 - k) * PASSO_FIXO) * 1000.0);
+        s->totalAtrasos++;
+    }
+    s->passos++;
+    s->ticks += ticks;
+    if (ticks > s->maxTicksPorPasso)
+        s->maxTicksPorPasso = ticks;
+
+    if (s->aoPassar != NULL)
+        s->aoPassar(s->contexto, jogo, acertosAntes, tempoCliques);
+    // Os acertos vão para o anel do desenho, e a partida fica pronta para os do próximo passo.
+    uint32_t escritaAcertos = s->escritaAcertos;
+    uint32_t leituraAcertos = __atomic_load_n(&s->leituraAcertos, __ATOMIC_ACQUIRE);
+    for (int k = 0; k < jogo->totalAcertosRecentes; k++) {
+        if (escritaAcertos - leituraAcertos >= MAX_ACERTOS_SIMULACAO) {
+            s->acertosPerdidos += jogo->totalAcertosRecentes - k;
+            break;
+        }
+        s->acertos[escritaAcertos++ & (MAX_ACERTOS_SIMULACAO - 1)] = jogo->acertosRecentes[k];
+    }
+    __atomic_store_n(&s->escritaAcertos, escritaAcertos, __ATOMIC_RELEASE);
+    jogo->totalAcertosRecentes = 0;
+
+    PublicarBufferTriplo(&s->estados, jogo, agora - jogo->acumulador);
+}
+
+static void* ExecutarSimulacao(void* argumento) {
+    ThreadSimulacao* s = (ThreadSimulacao*)argumento;
+    double ultimo = 0.0, proximo = 0.0;
+    pthread_mutex_lock(&s->trava);
+    for (;;) {
+        if (s->pedido != SIMULACAO_RODANDO || !s->rodando) {
+            // Parada, ou a principal pediu para rodar antes de a thread chegar aqui pela primeira vez.
+            s->rodando = false;
+            pthread_cond_broadcast(&s->sinal);
+            while (s->pedido == SIMULACAO_PARADA)
+                pthread_cond_wait(&s->sinal, &s->trava);
+            if (s->pedido == SIMULACAO_ENCERRADA)
+                break;
+            s->rodando = true;
+            ultimo = s->relogio();
+            proximo = ultimo + PASSO_FIXO - s->jogo->acumulador;
+        }
+        pthread_mutex_unlock(&s->trava);
+
+        // Acorda quando o próximo tick vence. O horário vem do acumulador da partida, então um atraso do sistema
+        // não se acumula: o passo seguinte simula os ticks que faltaram e volta ao ritmo.
+        Dormir(proximo - s->relogio());
+        double agora = s->relogio();
+        PassoSimulacao(s, ultimo, agora);
+        ultimo = agora;
+        proximo = agora + PASSO_FIXO - s->jogo->acumulador;
+
+        pthread_mutex_lock(&s->trava);
+        if (s->jogo->jogoAcabou && s->pedido == SIMULACAO_RODANDO)
+            s->pedido = SIMULACAO_PARADA; // A partida acabou: devolve a partida à principal.
+    }
+    s->rodando = false;
+    pthread_cond_broadcast(&s->sinal);
+    pthread_mutex_unlock(&s->trava);
+    return NULL;
+}
+
+bool IniciarThreadSimulacao(ThreadSimulacao* simulacao, EstadoJogo* jogo, double (*relogio)(void),
+                            void (*aoPassar)(void*, const EstadoJogo*, int, const double*), void* contexto) {
+    memset(simulacao, 0, sizeof(*simulacao));
+    simulacao->jogo = jogo;
+    simulacao->relogio = relogio;
+    simulacao->aoPassar = aoPassar;
+    simulacao->contexto = contexto;
+    simulacao->estados.escrita = 0;
+    simulacao->estados.meio = 1;
+    simulacao->estados.leitura = 2;
+    simulacao->pedido = SIMULACAO_PARADA;
+    simulacao->atrasos = (float*)malloc(MAX_ATRASOS_SIMULACAO * sizeof(float));
+    if (simulacao->atrasos == NULL)
+        return false;
+    pthread_mutex_init(&simulacao->trava, NULL);
+    pthread_cond_init(&simulacao->sinal, NULL);
+    if (pthread_create(&simulacao->thread, NULL, ExecutarSimulacao, simulacao) != 0) {
+        pthread_cond_destroy(&simulacao->sinal);
+        pthread_mutex_destroy(&simulacao->trava);
+        free(simulacao->atrasos);
+        simulacao->atrasos = NULL;
+        return false;
+    }
+    simulacao->iniciada = true;
+    return true;
+}
+
+void EncerrarThreadSimulacao(ThreadSimulacao* simulacao) {
+    if (simulacao->iniciada) {
+        pthread_mutex_lock(&simulacao->trava);
+        simulacao->pedido = SIMULACAO_ENCERRADA;
+        pthread_cond_broadcast(&simulacao->sinal);
+        pthread_mutex_unlock(&simulacao->trava);
+        pthread_join(simulacao->thread, NULL);
+        pthread_cond_destroy(&simulacao->sinal);
+        pthread_mutex_destroy(&simulacao->trava);
+        simulacao->iniciada = false;
+    }
+    LiberarBufferTriplo(&simulacao->estados);
+    free(simulacao->atrasos);
+    simulacao->atrasos = NULL;
+}
+
+void RetomarSimulacao(ThreadSimulacao* simulacao) {
+    pthread_mutex_lock(&simulacao->trava);
+    while (simulacao->rodando) // A thread ainda está saindo de uma pausa pedida por ela mesma.
+        pthread_cond_wait(&simulacao->sinal, &simulacao->trava);
+    // Parada, a partida é da principal, que publica como se fosse a simulação (a trava ordena as duas escritas).
+    PublicarBufferTriplo(&simulacao->estados, simulacao->jogo, simulacao->relogio() - simulacao->jogo->acumulador);
+    // Cliques enviados depois da pausa (no botão de continuar, por exemplo) não são da partida.
+    __atomic_store_n(&simulacao->leituraCliques, __atomic_load_n(&simulacao->escritaCliques, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+    simulacao->pedido = SIMULACAO_RODANDO;
+    pthread_cond_broadcast(&simulacao->sinal);
+    pthread_mutex_unlock(&simulacao->trava);
+}
+
+void PausarSimulacao(ThreadSimulacao* simulacao) {
+    pthread_mutex_lock(&simulacao->trava);
+    if (simulacao->pedido == SIMULACAO_RODANDO)
+        simulacao->pedido = SIMULACAO_PARADA;
+    while (simulacao->rodando) // No máximo um tick: a thread termina o passo em andamento e para.
+        pthread_cond_wait(&simulacao->sinal, &simulacao->trava);
+    pthread_mutex_unlock(&simulacao->trava);
+}
+
+bool SimulacaoRodando(ThreadSimulacao* simulacao) {
+    pthread_mutex_lock(&simulacao->trava);
+    bool rodando = simulacao->pedido == SIMULACAO_RODANDO || simulacao->rodando;
+    pthread_mutex_unlock(&simulacao->trava);
+    return rodando;
+}
+
+bool EnviarCliqueSimulacao(ThreadSimulacao* simulacao, double tempo, float x, float y) {
+    uint32_t escrita = simulacao->escritaCliques;
+    uint32_t leitura = __atomic_load_n(&simulacao->leituraCliques, __ATOMIC_ACQUIRE);
+    if (escrita - leitura >= MAX_CLIQUES_SIMULACAO) {
+        simulacao->cliquesPerdidos++;
+        return false;
+    }
+    simulacao->cliques[escrita & (MAX_CLIQUES_SIMULACAO - 1)] = (CliqueSimulacao){ tempo, x, y };
+    __atomic_store_n(&simulacao->escritaCliques, escrita + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+const EstadoJogo* LerEstadoSimulacao(ThreadSimulacao* simulacao, EstadoJogo* vista, double* tempo) {
+    const InstantaneoJogo* quadro = LerBufferTriplo(&simulacao->estados, tempo);
+    if (quadro == NULL)
+        return NULL;
+    VerInstantaneo(quadro, vista);
+    return vista;
+}
+
+int LerAcertosSimulacao(ThreadSimulacao* simulacao, AcertoJogo* destino, int maximo) {
+    uint32_t escrita = __atomic_load_n(&simulacao->escritaAcertos, __ATOMIC_ACQUIRE);
+    uint32_t leitura = simulacao->leituraAcertos;
+    int total = 0;
+    for (; leitura != escrita && total < maximo; leitura++)
+        destino[total++] = simulacao->acertos[leitura & (MAX_ACERTOS_SIMULACAO - 1)];
+    __atomic_store_n(&simulacao->leituraAcertos, leitura, __ATOMIC_RELEASE);
+    return total;
+}
+
+static int CompararFloat(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+ResumoSimulacao ResumirSimulacao(const ThreadSimulacao* simulacao) {
+    ResumoSimulacao r = { simulacao->ticks, simulacao->passos, 0.0f, 0.0f, 0.0f, simulacao->maxTicksPorPasso };
+    int total = simulacao->totalAtrasos < MAX_ATRASOS_SIMULACAO ? (int)simulacao->totalAtrasos : MAX_ATRASOS_SIMULACAO;
+    if (total == 0 || simulacao->atrasos == NULL)
+        return r;
+    float* copia = (float*)malloc((size_t)total * sizeof(float));
+    if (copia == NULL)
+        return r;
+    memcpy(copia, simulacao->atrasos, (size_t)total * sizeof(float));
+    qsort(copia, (size_t)total, sizeof(float), CompararFloat);
+    r.atrasoP50 = copia[total / 2];
+    r.atrasoP99 = copia[(int)(total * 0.99)];
+    r.atrasoMax = copia[total - 1];
+    free(copia);
+    return r;
+}
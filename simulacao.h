@@ -0,0 +1,114 @@
+#ifndef SIMULACAO_H
+#define SIMULACAO_H
+
+#include "logica.h"
+#include <pthread.h>
+
+// --- SIMULAÇÃO EM UMA THREAD PRÓPRIA ---
+// A partida avança em uma thread só dela, acordando a cada tick (PASSO_FIXO) em horários absolutos. Um frame
+// lento ou uma espera do vsync atrasa só o desenho: a lógica continua no tempo dela. A thread principal continua
+// sendo a única que usa a Raylib e o OpenGL (e lê o mouse); ela conversa com a simulação por três canais:
+//   - cliques: anel de capacidade fixa, principal -> simulação, com o momento de cada clique;
+//   - estados: buffer triplo sem trava, simulação -> principal. A simulação copia a partida (arena inclusa) para
+//     um quadro livre depois de cada passo e o troca com o quadro do meio; o desenho pega o mais novo, sem
+//     esperar e sem nunca ler um quadro sendo escrito;
+//   - acertos: anel simulação -> principal, para as faíscas (o buffer triplo pula estados, o anel não perde acertos).
+// Só o controle (rodar, pausar, encerrar) usa uma trava, uma vez por tick e sem disputa.
+//
+// Enquanto a thread roda, a partida é dela: a principal só lê os estados publicados. Pausada (pausa, fim da
+// partida, menus), a partida volta a ser da principal, que pode reiniciá-la, gravá-la ou registrá-la no placar.
+
+#define MAX_CLIQUES_SIMULACAO 64       // Cliques esperando a simulação (potência de 2).
+#define MAX_ACERTOS_SIMULACAO 128      // Acertos esperando o desenho (potência de 2).
+#define MAX_ATRASOS_SIMULACAO 65536    // Atrasos de tick guardados (os mais recentes, potência de 2).
+#define NOVO_BUFFER_TRIPLO 4u          // Bit do índice do meio: o quadro do meio ainda não foi lido.
+
+// Três cópias da partida: uma sendo escrita pela simulação, uma sendo lida pelo desenho e a do meio, trocadas
+// com uma única operação atômica. Depois do primeiro uso, publicar é uma cópia da struct e um memcpy da arena.
+typedef struct {
+    InstantaneoJogo quadros[3];
+    double tempos[3];    // Momento, no relógio da simulação, a que o estado de cada quadro corresponde.
+    uint32_t meio;       // Índice do quadro do meio, com NOVO_BUFFER_TRIPLO se ele é mais novo que o lido.
+    int escrita;         // Quadro do produtor (só ele mexe).
+    int leitura;         // Quadro do consumidor (só ele mexe); -1 antes da primeira leitura.
+} BufferTriplo;
+
+// Copia a partida para o quadro livre e o torna o mais novo. 'tempo' é o momento do estado (tick atual). Se faltar
+// memória para a cópia, nada é publicado e o desenho continua com o quadro anterior.
+void PublicarBufferTriplo(BufferTriplo* buffer, const EstadoJogo* jogo, double tempo);
+
+// Retorna o estado mais novo publicado (NULL se nenhum foi). Ele fica intacto até a próxima leitura.
+const InstantaneoJogo* LerBufferTriplo(BufferTriplo* buffer, double* tempo);
+void LiberarBufferTriplo(BufferTriplo* buffer);
+
+typedef struct {
+    double tempo;   // Momento do clique (relógio da simulação).
+    float x, y;
+} CliqueSimulacao;
+
+typedef enum { SIMULACAO_PARADA, SIMULACAO_RODANDO, SIMULACAO_ENCERRADA } PedidoSimulacao;
+
+typedef struct {
+    EstadoJogo* jogo;
+    double (*relogio)(void);   // Mesmo relógio dos cliques.
+    // Chamada pela thread da simulação depois de cada passo, com os acertos novos a partir de 'primeiroAcerto' e o
+    // momento de cada clique da entrada do passo (o som sai daqui, sem esperar o desenho).
+    void (*aoPassar)(void* contexto, const EstadoJogo* jogo, int primeiroAcerto, const double* tempoCliques);
+    void* contexto;
+
+    BufferTriplo estados;
+    CliqueSimulacao cliques[MAX_CLIQUES_SIMULACAO];
+    uint32_t escritaCliques, leituraCliques;
+    AcertoJogo acertos[MAX_ACERTOS_SIMULACAO];
+    uint32_t escritaAcertos, leituraAcertos;
+
+    pthread_t thread;
+    pthread_mutex_t trava;
+    pthread_cond_t sinal;
+    PedidoSimulacao pedido;    // O que a principal quer (ou a própria thread, no fim da partida).
+    bool rodando;              // O que a thread está fazendo (protegidos pela trava).
+    bool iniciada;
+
+    // Estatísticas (escritas pela thread da simulação, lidas com ela parada)
+    float* atrasos;            // Milissegundos entre a hora de cada tick e o passo que o simulou.
+    int64_t totalAtrasos;
+    int64_t passos;            // Vezes que a thread acordou e simulou.
+    int64_t ticks;
+    int maxTicksPorPasso;
+    int64_t acertosPerdidos;   // Anel de acertos cheio (desenho parado).
+    int64_t cliquesPerdidos;   // Anel de cliques cheio (escrita pela principal).
+} ThreadSimulacao;
+
+// Cria a thread, parada. Retorna false se não foi possível.
+bool IniciarThreadSimulacao(ThreadSimulacao* simulacao, EstadoJogo* jogo, double (*relogio)(void),
+                            void (*aoPassar)(void*, const EstadoJogo*, int, const double*), void* contexto);
+void EncerrarThreadSimulacao(ThreadSimulacao* simulacao);
+
+// Chamadas pela thread principal.
+// Publica a partida atual (para o primeiro frame já ver a partida nova) e a entrega à thread, que a avança a
+// partir de agora: o tempo parado não conta.
+void RetomarSimulacao(ThreadSimulacao* simulacao);
+// Espera a thread aplicar os cliques já enviados, avançar até agora e parar. Depois dela, a partida é da principal.
+void PausarSimulacao(ThreadSimulacao* simulacao);
+// false depois de PausarSimulacao ou quando a própria thread parou no fim da partida.
+bool SimulacaoRodando(ThreadSimulacao* simulacao);
+bool EnviarCliqueSimulacao(ThreadSimulacao* simulacao, double tempo, float x, float y);
+// Estado mais novo em 'vista' (que lê direto do buffer triplo, sem cópia); NULL se nada foi publicado.
+// 'tempo' recebe o momento a que o estado corresponde.
+const EstadoJogo* LerEstadoSimulacao(ThreadSimulacao* simulacao, EstadoJogo* vista, double* tempo);
+// Tira até 'maximo' acertos do anel. Retorna quantos.
+int LerAcertosSimulacao(ThreadSimulacao* simulacao, AcertoJogo* destino, int maximo);
+
+// Percentis do atraso dos ticks, em milissegundos. Deve ser chamada com a thread parada.
+typedef struct {
+    int64_t ticks, passos;
+    float atrasoP50, atrasoP99, atrasoMax;
+    int maxTicksPorPasso;
+} ResumoSimulacao;
+
+ResumoSimulacao ResumirSimulacao(const ThreadSimulacao* simulacao);
+
+// Relógio monotônico em segundos, para as ferramentas sem janela.
+double RelogioSimulacao(void);
+
+#endif
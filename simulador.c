@@ -0,0 +1,451 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime e sysconf.
+#include "logica.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// --- SIMULADOR DE DIFICULDADE (MONTE CARLO) ---
+// Joga milhões de partidas de dois minutos sem janela, com jogadores robôs parametrizados (tempo de reação,
+// precisão e quanto evitam as cutias), e mostra a distribuição da pontuação de cada robô em cada dificuldade.
+// As partidas são divididas em blocos e distribuídas entre todos os núcleos por um escalonador com roubo de
+// trabalho: cada thread tem a sua fila de blocos e, quando ela esvazia, rouba blocos do fim da fila de outra.
+// Cada partida tem uma semente derivada do seu número, então o resultado não depende do número de threads.
+// Não depende da Raylib.
+//
+// Uso: simulador [--sessoes N] [--threads T] [--semente S] [--buracos N] [--csv arquivo]
+//                [--tabela NOME=facil,medio,dificil ...]
+//   --sessoes   partidas por combinação de dificuldade e robô (padrão 100000)
+//   --tabela    troca uma tabela de dificuldade antes de simular, por exemplo --tabela TEMPO_VISIVEL_MIN=1.0,0.7,0.4
+//   --csv       grava o histograma completo de cada combinação
+
+#define SESSOES_POR_BLOCO 512    // Partidas por tarefa do escalonador.
+#define MAX_PONTOS 512           // Pontuações maiores entram na última posição do histograma.
+#define MAX_THREADS 256
+#define MAX_FILA_BOT 4096      // Cliques pendentes do robô numa partida.
+#define LARGURA_TELA 1500.0f     // Mesma janela do jogo, para os buracos ficarem nas mesmas posições.
+#define ALTURA_TELA 800.0f
+
+// --- JOGADORES ROBÔS ---
+
+typedef struct {
+    const char* nome;
+    float reacaoMedia;   // Tempo médio entre o animal aparecer (ou o robô terminar o clique anterior) e o clique, em segundos.
+    float reacaoDesvio;  // Desvio padrão do tempo de reação.
+    float precisao;      // Chance de o clique acertar o buraco.
+    float evitarCutia;   // Chance de reconhecer uma cutia e não clicar nela.
+} ParametrosBot;
+
+static const ParametrosBot BOTS[] = {
+    { "iniciante",  0.55f, 0.15f, 0.75f, 0.30f },
+    { "casual",     0.40f, 0.10f, 0.85f, 0.60f },
+    { "experiente", 0.28f, 0.06f, 0.95f, 0.90f },
+};
+#define TOTAL_BOTS ((int)(sizeof(BOTS) / sizeof(BOTS[0])))
+#define TOTAL_DIFICULDADES 3
+#define TOTAL_COMBINACOES (TOTAL_DIFICULDADES * TOTAL_BOTS)
+
+static const char* NOMES_DIFICULDADE[TOTAL_DIFICULDADES] = { "FACIL", "MEDIO", "DIFICIL" };
+
+// Um clique que o robô já decidiu dar: no buraco 'buraco', no tick 'tick'.
+typedef struct {
+    int64_t tick;
+    int buraco;
+} CliqueBot;
+
+// Resultados de uma combinação de dificuldade e robô.
+typedef struct {
+    int64_t histograma[MAX_PONTOS + 1];
+    int64_t sessoes;
+    int64_t somaPontos;
+    int64_t somaQuadrados;
+    int64_t acertos;
+    int64_t cutias;   // Cutias acertadas.
+} Resultado;
+
+// Número entre 0 e 1 sorteado com o gerador do robô.
+static float SortearFracao(GeradorAleatorio* gerador) {
+    return SortearValor(gerador, 0, 1 << 24) / (float)(1 << 24);
+}
+
+// Tempo de reação aproximadamente normal (soma de quatro uniformes), nunca abaixo de 0,1 s.
+static int64_t SortearReacao(GeradorAleatorio* gerador, const ParametrosBot* bot) {
+    float soma = 0.0f;
+    for (int i = 0; i < 4; i++)
+        soma += SortearFracao(gerador);
+    float segundos = bot->reacaoMedia + (soma - 2.0f) * 1.7320508f * bot->reacaoDesvio; // Variância de 4 uniformes = 1/3.
+    if (segundos < 0.1f)
+        segundos = 0.1f;
+    return (int64_t)(segundos * TICKS_POR_SEGUNDO + 0.5f);
+}
+
+// Guarda em 'saida' os buracos cujo evento vence em 'tick' (o menor da agenda), descendo pelo heap só
+// enquanto a chave for igual. 'saida' precisa de espaço para um buraco por slot.
+static int ColetarVencidos(const EstadoJogo* jogo, int64_t tick, int* saida) {
+    if (!jogo->jogoIniciado || jogo->tamanhoAgenda == 0)
+        return 0;
+    int total = 0, lidos = 0;
+    if (jogo->capivaras.tickEvento[jogo->agenda[0]] == tick)
+        saida[total++] = 0;
+    while (lidos < total) { // Primeiro guarda posições no heap, depois troca pelos buracos.
+        int p = saida[lidos++];
+        for (int f = 2 * p + 1; f <= 2 * p + 2 && f < jogo->tamanhoAgenda; f++)
+            if (jogo->capivaras.tickEvento[jogo->agenda[f]] == tick)
+                saida[total++] = f;
+    }
+    for (int k = 0; k < total; k++)
+        saida[k] = jogo->agenda[saida[k]];
+    // Em ordem de buraco, como a varredura do tabuleiro, para o robô sortear as reações sempre na mesma ordem.
+    for (int k = 1; k < total; k++)
+        for (int j = k; j > 0 && saida[j - 1] > saida[j]; j--) {
+            int troca = saida[j];
+            saida[j] = saida[j - 1];
+            saida[j - 1] = troca;
+        }
+    return total;
+}
+
+// Joga uma partida inteira com o robô. O robô vê cada animal no tick em que ele aparece, reage depois do seu
+// tempo de reação (um animal de cada vez, como uma pessoa com um mouse) e clica se o animal ainda estiver lá.
+// A simulação só para nos ticks com eventos ou cliques, então uma partida custa poucos milhares de passos.
+static void JogarSessao(EstadoJogo* jogo, const ConfiguracaoJogo* configuracao, const ParametrosBot* bot, uint64_t sementeBot,
+                        CliqueBot* fila, int* pilha, Resultado* resultado) {
+    if (!InicializarEstadoJogo(jogo, configuracao)) {
+        fprintf(stderr, "Sem memória\n");
+        exit(1);
+    }
+    GeradorAleatorio gerador;
+    IniciarGerador(&gerador, sementeBot);
+    int inicioFila = 0, fimFila = 0;  // Cliques pendentes, em ordem de tick (no máximo um por buraco).
+    int64_t livre = 0;                // Tick em que o robô termina o clique que está fazendo.
+    const Capivaras* c = &jogo->capivaras;
+
+    while (!jogo->jogoAcabou) {
+        int64_t proximoEvento = ProximoEventoJogo(jogo);
+        // No mesmo tick, o evento vem antes do clique, como no PassoJogo.
+        if (inicioFila < fimFila && fila[inicioFila].tick < proximoEvento) {
+            CliqueBot clique = fila[inicioFila++];
+            AvancarJogoAte(jogo, clique.tick);
+            int i = clique.buraco;
+            if (!c->visivel[i] || c->hit[i])
+                continue; // O animal já sumiu: o robô percebe e não clica.
+            if (c->tipo[i] == CUTIA && SortearFracao(&gerador) < bot->evitarCutia)
+                continue;
+            if (SortearFracao(&gerador) >= bot->precisao)
+                continue; // Errou o buraco.
+            bool cutia = c->tipo[i] == CUTIA;
+            Retangulo r = c->rect[i];
+            if (AplicarClique(jogo, r.x + r.largura / 2, r.y + r.altura / 2) >= 0) {
+                resultado->acertos++;
+                resultado->cutias += cutia;
+            }
+            continue;
+        }
+
+        // Os buracos com evento neste tick estão no topo da agenda. Um evento sempre reagenda o buraco para um
+        // tick posterior, então eles são exatamente os candidatos a animal novo (sem varrer todos os buracos).
+        int vencidos = ColetarVencidos(jogo, proximoEvento, pilha);
+        AvancarJogoAte(jogo, proximoEvento);
+        if (jogo->jogoAcabou)
+            break;
+        if (inicioFila == fimFila)
+            inicioFila = fimFila = 0;
+        else if (fimFila > MAX_FILA_BOT - jogo->totalCapivaras) { // Tabuleiros enormes: recua a fila para o começo.
+            memmove(fila, fila + inicioFila, (size_t)(fimFila - inicioFila) * sizeof(CliqueBot));
+            fimFila -= inicioFila;
+            inicioFila = 0;
+        }
+        // Animais que acabaram de aparecer entram na fila do robô.
+        for (int v = 0; v < vencidos; v++) {
+            int i = pilha[v];
+            if (c->visivel[i] && !c->hit[i] && c->tickSurgimento[i] == jogo->tick && fimFila < MAX_FILA_BOT) {
+                int64_t inicio = livre > jogo->tick ? livre : jogo->tick;
+                livre = inicio + SortearReacao(&gerador, bot);
+                fila[fimFila++] = (CliqueBot){ livre, i };
+            }
+        }
+    }
+
+    int pontos = jogo->pontos < MAX_PONTOS ? jogo->pontos : MAX_PONTOS;
+    resultado->histograma[pontos]++;
+    resultado->sessoes++;
+    resultado->somaPontos += jogo->pontos;
+    resultado->somaQuadrados += (int64_t)jogo->pontos * jogo->pontos;
+}
+
+// --- ESCALONADOR COM ROUBO DE TRABALHO ---
+
+typedef struct {
+    int combinacao;       // dificuldade * TOTAL_BOTS + bot
+    int64_t primeira;     // Número da primeira partida do bloco (define as sementes).
+    int total;
+} Tarefa;
+
+// Fila de uma thread. A dona tira do fim; as outras roubam do início, onde estão os blocos mais antigos.
+typedef struct {
+    pthread_mutex_t trava;
+    int* tarefas;
+    int inicio, fim;
+} FilaTarefas;
+
+typedef struct {
+    int id;
+    Resultado* resultados;  // TOTAL_COMBINACOES resultados desta thread, somados no fim.
+    int roubos;
+} Trabalhador;
+
+static Tarefa* tarefas;
+static FilaTarefas* filas;
+static int totalThreads;
+static uint64_t sementeBase;
+static int totalBuracos;
+
+static bool PegarPropria(FilaTarefas* f, int* tarefa) {
+    pthread_mutex_lock(&f->trava);
+    bool ok = f->fim > f->inicio;
+    if (ok)
+        *tarefa = f->tarefas[--f->fim];
+    pthread_mutex_unlock(&f->trava);
+    return ok;
+}
+
+static bool Roubar(FilaTarefas* f, int* tarefa) {
+    pthread_mutex_lock(&f->trava);
+    bool ok = f->fim > f->inicio;
+    if (ok)
+        *tarefa = f->tarefas[f->inicio++];
+    pthread_mutex_unlock(&f->trava);
+    return ok;
+}
+
+// Semente de uma partida: mistura a semente base com o número da partida e a combinação.
+static uint64_t SementeSessao(int combinacao, int64_t sessao, uint64_t fluxo) {
+    return sementeBase ^ ((uint64_t)combinacao << 56) ^ ((uint64_t)sessao * 0x9E3779B97F4A7C15ULL) ^ fluxo;
+}
+
+static void* ExecutarTrabalhador(void* argumento) {
+    Trabalhador* t = (Trabalhador*)argumento;
+    EstadoJogo jogo = {0};
+    CliqueBot fila[MAX_FILA_BOT];
+    int* pilha = NULL;  // Buracos com evento no tick, um espaço por buraco.
+    int capacidadePilha = 0;
+    for (;;) {
+        int indice = 0; // Iniciado só para o GCC não avisar no build com PGO.
+        bool achou = PegarPropria(&filas[t->id], &indice);
+        // Fila vazia: tenta roubar das outras, começando pela vizinha.
+        for (int k = 1; !achou && k < totalThreads; k++) {
+            achou = Roubar(&filas[(t->id + k) % totalThreads], &indice);
+            t->roubos += achou;
+        }
+        if (!achou)
+            break; // Todas as filas estão vazias e nenhuma tarefa cria outras: acabou.
+
+        const Tarefa* tarefa = &tarefas[indice];
+        Dificuldade dificuldade = (Dificuldade)(tarefa->combinacao / TOTAL_BOTS);
+        const ParametrosBot* bot = &BOTS[tarefa->combinacao % TOTAL_BOTS];
+        int buracos = totalBuracos > 0 ? totalBuracos : CAPIVARAS_POR_DIFICULDADE[dificuldade];
+        if (buracos > capacidadePilha) {
+            free(pilha);
+            pilha = (int*)malloc((size_t)buracos * sizeof(int));
+            capacidadePilha = buracos;
+        }
+        for (int s = 0; s < tarefa->total; s++) {
+            int64_t sessao = tarefa->primeira + s;
+            ConfiguracaoJogo configuracao = { dificuldade, totalBuracos, LARGURA_TELA, ALTURA_TELA, SementeSessao(tarefa->combinacao, sessao, 0) };
+            JogarSessao(&jogo, &configuracao, bot, SementeSessao(tarefa->combinacao, sessao, 0xB07B07ULL), fila, pilha, &t->resultados[tarefa->combinacao]);
+        }
+    }
+    LiberarEstadoJogo(&jogo);
+    free(pilha);
+    return NULL;
+}
+
+// --- TABELAS E SAÍDA ---
+
+// Troca uma tabela de dificuldade: "NOME=facil,medio,dificil".
+static bool AplicarTabela(const char* definicao) {
+    struct { const char* nome; int* inteiros; float* reais; } TABELAS[] = {
+        { "MAX_SIMULTANEAS_INICIAL", MAX_SIMULTANEAS_INICIAL, NULL },
+        { "INTERVALO_MIN", NULL, INTERVALO_MIN },
+        { "INTERVALO_MAX", NULL, INTERVALO_MAX },
+        { "TEMPO_VISIVEL_MIN", NULL, TEMPO_VISIVEL_MIN },
+        { "TEMPO_VISIVEL_MAX", NULL, TEMPO_VISIVEL_MAX },
+        { "PENALIDADE_CUTIA", PENALIDADE_CUTIA, NULL },
+        { "CHANCE_CUTIA", CHANCE_CUTIA, NULL },
+        { "CHANCE_DOURADA", CHANCE_DOURADA, NULL },
+        { "CAPIVARAS_POR_DIFICULDADE", CAPIVARAS_POR_DIFICULDADE, NULL },
+    };
+    const char* igual = strchr(definicao, '=');
+    if (igual == NULL)
+        return false;
+    for (size_t t = 0; t < sizeof(TABELAS) / sizeof(TABELAS[0]); t++) {
+        if (strlen(TABELAS[t].nome) != (size_t)(igual - definicao) || strncmp(TABELAS[t].nome, definicao, (size_t)(igual - definicao)) != 0)
+            continue;
+        float v[TOTAL_DIFICULDADES];
+        if (sscanf(igual + 1, "%f,%f,%f", &v[0], &v[1], &v[2]) != TOTAL_DIFICULDADES)
+            return false;
+        for (int d = 0; d < TOTAL_DIFICULDADES; d++) {
+            if (TABELAS[t].inteiros != NULL)
+                TABELAS[t].inteiros[d] = (int)v[d];
+            else
+                TABELAS[t].reais[d] = v[d];
+        }
+        return true;
+    }
+    return false;
+}
+
+// Menor pontuação p tal que pelo menos 'fracao' das partidas fizeram p pontos ou menos.
+static int PercentilHistograma(const Resultado* r, double fracao) {
+    int64_t alvo = (int64_t)(fracao * (r->sessoes - 1)) + 1;
+    int64_t acumulado = 0;
+    for (int p = 0; p <= MAX_PONTOS; p++) {
+        acumulado += r->histograma[p];
+        if (acumulado >= alvo)
+            return p;
+    }
+    return MAX_PONTOS;
+}
+
+static double Agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main(int argc, char* argv[]) {
+    int64_t sessoes = 100000;
+    const char* arquivoCsv = NULL;
+    totalThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    sementeBase = 20240601;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--sessoes") == 0 && i + 1 < argc)
+            sessoes = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            totalThreads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc)
+            sementeBase = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--buracos") == 0 && i + 1 < argc)
+            totalBuracos = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            arquivoCsv = argv[++i];
+        else if (strcmp(argv[i], "--tabela") == 0 && i + 1 < argc) {
+            if (!AplicarTabela(argv[++i])) {
+                fprintf(stderr, "Tabela inválida: %s\n", argv[i]);
+                return 2;
+            }
+        } else {
+            fprintf(stderr, "Uso: %s [--sessoes N] [--threads T] [--semente S] [--buracos N] [--csv arquivo] [--tabela NOME=f,m,d]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (totalThreads < 1)
+        totalThreads = 1;
+    if (totalThreads > MAX_THREADS)
+        totalThreads = MAX_THREADS;
+    if (sessoes < 1)
+        sessoes = 1;
+
+    // Divide cada combinação em blocos. Os blocos são espalhados em rodízio, mas o DIFICIL custa mais que o
+    // FACIL, então as filas ficam desiguais: é o roubo de trabalho que equilibra a carga.
+    int blocosPorCombinacao = (int)((sessoes + SESSOES_POR_BLOCO - 1) / SESSOES_POR_BLOCO);
+    int totalTarefas = blocosPorCombinacao * TOTAL_COMBINACOES;
+    tarefas = (Tarefa*)malloc((size_t)totalTarefas * sizeof(Tarefa));
+    filas = (FilaTarefas*)calloc((size_t)totalThreads, sizeof(FilaTarefas));
+    Trabalhador* trabalhadores = (Trabalhador*)calloc((size_t)totalThreads, sizeof(Trabalhador));
+    pthread_t* threads = (pthread_t*)malloc((size_t)totalThreads * sizeof(pthread_t));
+    if (tarefas == NULL || filas == NULL || trabalhadores == NULL || threads == NULL) {
+        fprintf(stderr, "Sem memória\n");
+        return 1;
+    }
+    for (int t = 0; t < totalThreads; t++) {
+        pthread_mutex_init(&filas[t].trava, NULL);
+        filas[t].tarefas = (int*)malloc((size_t)totalTarefas * sizeof(int));
+        trabalhadores[t].id = t;
+        trabalhadores[t].resultados = (Resultado*)calloc(TOTAL_COMBINACOES, sizeof(Resultado));
+        if (filas[t].tarefas == NULL || trabalhadores[t].resultados == NULL) {
+            fprintf(stderr, "Sem memória\n");
+            return 1;
+        }
+    }
+    int n = 0;
+    for (int c = 0; c < TOTAL_COMBINACOES; c++) {
+        for (int b = 0; b < blocosPorCombinacao; b++) {
+            int64_t primeira = (int64_t)b * SESSOES_POR_BLOCO;
+            int total = (int)(sessoes - primeira < SESSOES_POR_BLOCO ? sessoes - primeira : SESSOES_POR_BLOCO);
+            tarefas[n] = (Tarefa){ c, primeira, total };
+            FilaTarefas* f = &filas[c % totalThreads];
+            f->tarefas[f->fim++] = n++;
+        }
+    }
+
+    double inicio = Agora();
+    int threadsCriadas = 0;
+    for (int t = 1; t < totalThreads; t++)
+        if (pthread_create(&threads[t], NULL, ExecutarTrabalhador, &trabalhadores[t]) == 0)
+            threadsCriadas = t;
+    ExecutarTrabalhador(&trabalhadores[0]); // A thread principal também trabalha (e sozinha rouba tudo se nenhuma thread subir).
+    for (int t = 1; t <= threadsCriadas; t++)
+        pthread_join(threads[t], NULL);
+    double segundos = Agora() - inicio;
+
+    // Soma os resultados das threads.
+    Resultado* total = trabalhadores[0].resultados;
+    int roubos = trabalhadores[0].roubos;
+    for (int t = 1; t < totalThreads; t++) {
+        roubos += trabalhadores[t].roubos;
+        for (int c = 0; c < TOTAL_COMBINACOES; c++) {
+            Resultado* r = &trabalhadores[t].resultados[c];
+            for (int p = 0; p <= MAX_PONTOS; p++)
+                total[c].histograma[p] += r->histograma[p];
+            total[c].sessoes += r->sessoes;
+            total[c].somaPontos += r->somaPontos;
+            total[c].somaQuadrados += r->somaQuadrados;
+            total[c].acertos += r->acertos;
+            total[c].cutias += r->cutias;
+        }
+    }
+
+    int64_t totalSessoes = sessoes * TOTAL_COMBINACOES;
+    printf("%lld partidas em %.2f s com %d threads: %.0f partidas/s (%d blocos roubados)\n\n",
+           (long long)totalSessoes, segundos, totalThreads, totalSessoes / segundos, roubos);
+    printf("%-8s %-11s %8s %7s %5s %5s %5s %5s %5s %5s %8s %7s\n",
+           "dific.", "robo", "media", "desvio", "min", "p5", "p50", "p95", "p99", "max", "acertos", "cutias");
+    for (int c = 0; c < TOTAL_COMBINACOES; c++) {
+        const Resultado* r = &total[c];
+        double media = (double)r->somaPontos / r->sessoes;
+        double variancia = (double)r->somaQuadrados / r->sessoes - media * media;
+        printf("%-8s %-11s %8.2f %7.2f %5d %5d %5d %5d %5d %5d %8.1f %7.2f\n", NOMES_DIFICULDADE[c / TOTAL_BOTS], BOTS[c % TOTAL_BOTS].nome,
+               media, variancia > 0 ? sqrt(variancia) : 0.0, PercentilHistograma(r, 0.0), PercentilHistograma(r, 0.05), PercentilHistograma(r, 0.5),
+               PercentilHistograma(r, 0.95), PercentilHistograma(r, 0.99), PercentilHistograma(r, 1.0),
+               (double)r->acertos / r->sessoes, (double)r->cutias / r->sessoes);
+    }
+
+    if (arquivoCsv != NULL) {
+        FILE* f = fopen(arquivoCsv, "w");
+        if (f == NULL) {
+            fprintf(stderr, "Não foi possível gravar %s\n", arquivoCsv);
+            return 1;
+        }
+        fprintf(f, "dificuldade,robo,pontos,partidas\n");
+        for (int c = 0; c < TOTAL_COMBINACOES; c++)
+            for (int p = 0; p <= MAX_PONTOS; p++)
+                if (total[c].histograma[p] > 0)
+                    fprintf(f, "%s,%s,%d,%lld\n", NOMES_DIFICULDADE[c / TOTAL_BOTS], BOTS[c % TOTAL_BOTS].nome, p, (long long)total[c].histograma[p]);
+        fclose(f);
+    }
+
+    for (int t = 0; t < totalThreads; t++) {
+        pthread_mutex_destroy(&filas[t].trava);
+        free(filas[t].tarefas);
+        free(trabalhadores[t].resultados);
+    }
+    free(filas);
+    free(trabalhadores);
+    free(threads);
+    free(tarefas);
+    return 0;
+}
@@ -0,0 +1,364 @@
+#include "som.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PI_SOM 3.14159265358979f
+#define DURACAO_FADE_SOM 0.02f    // Segundos para uma voz parada chegar ao silêncio, sem estalo.
+#define DURACAO_LACO_CHUVA 2.0f   // Segundos do laço da chuva.
+#define EMENDA_LACO_CHUVA 0.1f    // Segundos do fim do laço misturados no começo, para a emenda não estalar.
+
+// Timbre de um som sintetizado: um tom com um segundo parcial, um envelope que decai e um pouco de ruído no
+// ataque (a batida). Todos os sons do jogo saem daqui, menos a chuva.
+typedef struct {
+    float frequencia;   // Hz do parcial principal.
+    float razao;        // Frequência do segundo parcial, em múltiplos do primeiro.
+    float harmonico;    // Volume do segundo parcial.
+    float decaimento;   // Segundos para o volume cair a 1/e.
+    float duracao;      // Segundos gerados.
+    float ruido;        // Volume do ruído nos primeiros 10 ms.
+    float queda;        // Quanto a frequência cai até o fim (0.3 = 30% mais grave).
+} TimbreSom;
+
+// Variações de altura de cada som, tocadas em rodízio.
+static const float VARIACOES[MAX_VARIACOES_SOM] = { 1.0f, 1.06f, 0.95f, 1.12f };
+
+static const TimbreSom TIMBRES[TOTAL_SONS] = {
+    [SOM_ACERTO_NORMAL]  = { 520.0f, 2.0f, 0.3f, 0.05f, 0.15f, 0.5f, 0.1f },  // Batida seca.
+    [SOM_ACERTO_DOURADA] = { 1320.0f, 1.5f, 0.5f, 0.18f, 0.5f, 0.1f, 0.0f },  // Sino (quinta).
+    [SOM_ACERTO_CUTIA]   = { 140.0f, 2.0f, 0.6f, 0.12f, 0.3f, 0.3f, 0.3f },   // Grave, caindo.
+    [SOM_CONTAGEM]       = { 880.0f, 2.0f, 0.1f, 0.08f, 0.12f, 0.0f, 0.0f },
+    [SOM_LARGADA]        = { 1320.0f, 2.0f, 0.3f, 0.25f, 0.4f, 0.0f, 0.0f },
+    [SOM_FIM]            = { 660.0f, 2.0f, 0.2f, 0.15f, 0.22f, 0.0f, 0.0f },   // Nota de um arpejo descendente.
+};
+
+static const int TOTAL_VARIACOES[TOTAL_SONS] = {
+    [SOM_ACERTO_NORMAL] = 4, [SOM_ACERTO_DOURADA] = 4, [SOM_ACERTO_CUTIA] = 4,
+    [SOM_CONTAGEM] = 1, [SOM_LARGADA] = 1, [SOM_CHUVA] = 1, [SOM_FIM] = 1,
+};
+
+static const float GANHOS[TOTAL_SONS] = {
+    [SOM_ACERTO_NORMAL] = 0.8f, [SOM_ACERTO_DOURADA] = 0.6f, [SOM_ACERTO_CUTIA] = 0.8f,
+    [SOM_CONTAGEM] = 0.5f, [SOM_LARGADA] = 0.5f, [SOM_CHUVA] = 0.25f, [SOM_FIM] = 0.6f,
+};
+
+static const float NOTAS_FIM[3] = { 1.0f, 0.7937f, 0.5946f }; // Mi, dó e sol abaixo: um arpejo descendo.
+
+// Ruído branco determinístico (xorshift32), entre -1 e 1.
+static float Ruido(uint32_t* estado) {
+    uint32_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return (float)(int32_t)x / 2147483648.0f;
+}
+
+static int16_t ParaPcm(float x) {
+    if (x > 1.0f)
+        x = 1.0f;
+    if (x < -1.0f)
+        x = -1.0f;
+    return (int16_t)(x * 32767.0f);
+}
+
+static int QuadrosTimbre(const TimbreSom* t) {
+    return (int)(t->duracao * TAXA_SOM);
+}
+
+// Sintetiza um timbre com a altura multiplicada por 'altura'. Retorna os quadros escritos.
+static int Sintetizar(int16_t* destino, const TimbreSom* t, float altura, uint32_t semente) {
+    int quadros = QuadrosTimbre(t);
+    float fase = 0.0f, fase2 = 0.0f;
+    uint32_t ruido = semente;
+    for (int i = 0; i < quadros; i++) {
+        float tempo = (float)i / TAXA_SOM;
+        float progresso = (float)i / quadros;
+        float frequencia = t->frequencia * altura * (1.0f - t->queda * progresso);
+        fase += 2.0f * PI_SOM * frequencia / TAXA_SOM;
+        fase2 += 2.0f * PI_SOM * frequencia * t->razao / TAXA_SOM;
+        float ataque = tempo < 0.002f ? tempo / 0.002f : 1.0f;
+        float fim = progresso > 0.9f ? (1.0f - progresso) * 10.0f : 1.0f; // Termina em silêncio.
+        float envelope = ataque * fim * expf(-tempo / t->decaimento);
+        float x = (sinf(fase) + t->harmonico * sinf(fase2)) / (1.0f + t->harmonico);
+        if (tempo < 0.01f)
+            x += t->ruido * Ruido(&ruido) * (1.0f - tempo / 0.01f);
+        destino[i] = ParaPcm(x * envelope);
+    }
+    return quadros;
+}
+
+// Ruído filtrado (passa-baixa de um polo) em laço: o fim é misturado no começo para a emenda não estalar.
+static int SintetizarChuva(int16_t* destino, float* temporario) {
+    int quadros = (int)(DURACAO_LACO_CHUVA * TAXA_SOM), emenda = (int)(EMENDA_LACO_CHUVA * TAXA_SOM);
+    uint32_t ruido = 0x9E3779B9u;
+    float filtrado = 0.0f;
+    for (int i = 0; i < quadros + emenda; i++) {
+        filtrado += 0.25f * (Ruido(&ruido) - filtrado);
+        temporario[i] = filtrado * 1.6f;
+    }
+    for (int i = 0; i < quadros; i++) {
+        float x = temporario[i];
+        if (i < emenda) {
+            float f = (float)i / emenda;
+            x = x * f + temporario[quadros + i] * (1.0f - f);
+        }
+        destino[i] = ParaPcm(x);
+    }
+    return quadros;
+}
+
+bool IniciarSom(MixerSom* mixer, double (*relogio)(void)) {
+    memset(mixer, 0, sizeof(*mixer));
+    mixer->relogio = relogio;
+    mixer->volumeGeral = 0.7f;
+
+    // Um bloco só para todas as amostras; a mistura nunca aloca.
+    size_t total = 0;
+    for (int id = 0; id < TOTAL_SONS; id++) {
+        if (id == SOM_CHUVA)
+            total += (size_t)(DURACAO_LACO_CHUVA * TAXA_SOM);
+        else if (id == SOM_FIM)
+            total += 3 * (size_t)QuadrosTimbre(&TIMBRES[id]);
+        else
+            total += (size_t)TOTAL_VARIACOES[id] * QuadrosTimbre(&TIMBRES[id]);
+    }
+    mixer->memoria = (int16_t*)malloc(total * sizeof(int16_t));
+    float* temporario = (float*)malloc((size_t)((DURACAO_LACO_CHUVA + EMENDA_LACO_CHUVA) * TAXA_SOM + 1) * sizeof(float));
+    if (mixer->memoria == NULL || temporario == NULL) {
+        free(mixer->memoria);
+        free(temporario);
+        mixer->memoria = NULL;
+        return false;
+    }
+
+    int16_t* livre = mixer->memoria;
+    for (int id = 0; id < TOTAL_SONS; id++) {
+        BancoSom* banco = &mixer->bancos[id];
+        banco->ganho = GANHOS[id];
+        banco->repetir = id == SOM_CHUVA;
+        banco->totalVariacoes = TOTAL_VARIACOES[id];
+        for (int v = 0; v < banco->totalVariacoes; v++) {
+            AmostraSom* a = &banco->variacoes[v];
+            a->amostras = livre;
+            if (id == SOM_CHUVA) {
+                a->quadros = SintetizarChuva(livre, temporario);
+            } else if (id == SOM_FIM) {
+                a->quadros = 0;
+                for (int n = 0; n < 3; n++)
+                    a->quadros += Sintetizar(livre + a->quadros, &TIMBRES[id], NOTAS_FIM[n], 1u + n);
+            } else {
+                a->quadros = Sintetizar(livre, &TIMBRES[id], VARIACOES[v], 1u + (uint32_t)(id * MAX_VARIACOES_SOM + v));
+            }
+            livre += a->quadros;
+        }
+    }
+    free(temporario);
+    return true;
+}
+
+void LiberarSom(MixerSom* mixer) {
+    free(mixer->memoria);
+    mixer->memoria = NULL;
+    memset(mixer->vozes, 0, sizeof(mixer->vozes));
+}
+
+// Põe um comando no anel. Só a thread do jogo escreve 'escrita'; a thread de áudio só escreve 'leitura'.
+static bool EnviarComando(MixerSom* mixer, ComandoSom comando) {
+    uint32_t escrita = mixer->escrita;
+    uint32_t leitura = __atomic_load_n(&mixer->leitura, __ATOMIC_ACQUIRE);
+    if (escrita - leitura >= MAX_COMANDOS_SOM) {
+        mixer->comandosPerdidos++;
+        return false;
+    }
+    comando.tempoEnvio = mixer->relogio != NULL ? mixer->relogio() : 0.0;
+    mixer->comandos[escrita & (MAX_COMANDOS_SOM - 1)] = comando;
+    __atomic_store_n(&mixer->escrita, escrita + 1, __ATOMIC_RELEASE); // O comando fica visível antes do índice.
+    return true;
+}
+
+bool TocarSom(MixerSom* mixer, IdSom id, float pan, float ganho, double tempoEvento) {
+    return EnviarComando(mixer, (ComandoSom){ COMANDO_TOCAR, (uint8_t)id, pan, ganho, tempoEvento, 0.0 });
+}
+
+bool PararSom(MixerSom* mixer, IdSom id) {
+    return EnviarComando(mixer, (ComandoSom){ COMANDO_PARAR, (uint8_t)id, 0.0f, 0.0f, 0.0, 0.0 });
+}
+
+// Começa um som em uma voz livre ou, se não houver, na mais antiga.
+static void IniciarVoz(MixerSom* mixer, const ComandoSom* comando, double agora) {
+    BancoSom* banco = &mixer->bancos[comando->id];
+    if (banco->totalVariacoes == 0)
+        return;
+    VozSom* livre = NULL;
+    VozSom* antiga = NULL; // Candidata a ser roubada: a mais antiga que não é um laço.
+    for (int i = 0; i < MAX_VOZES_SOM; i++) {
+        VozSom* v = &mixer->vozes[i];
+        if (v->amostra == NULL) {
+            if (livre == NULL)
+                livre = v;
+        } else if (banco->repetir && v->id == comando->id && !v->parando) {
+            return; // Um som em laço já tocando não começa de novo.
+        } else if (!v->repetir && (antiga == NULL || v->ordem < antiga->ordem)) {
+            antiga = v;
+        }
+    }
+    VozSom* voz = livre != NULL ? livre : antiga;
+    if (voz == NULL)
+        return;
+    if (voz->amostra != NULL)
+        mixer->vozesRoubadas++;
+
+    // Pan de potência constante: o volume total não muda do centro para os lados.
+    float pan = comando->pan < -1.0f ? -1.0f : (comando->pan > 1.0f ? 1.0f : comando->pan);
+    float angulo = (pan + 1.0f) * PI_SOM / 4.0f;
+    float ganho = comando->ganho * banco->ganho;
+    *voz = (VozSom){ &banco->variacoes[banco->proxima], 0, cosf(angulo) * ganho, sinf(angulo) * ganho, 1.0f, false, banco->repetir,
+                     comando->id, mixer->proximaOrdem++ };
+    banco->proxima = (banco->proxima + 1) % banco->totalVariacoes;
+
+    if (comando->tempoEvento > 0.0) {
+        LatenciaSom* l = &mixer->latencias[mixer->totalLatencias % MAX_LATENCIAS_SOM];
+        l->cliqueEnvio = (float)((comando->tempoEnvio - comando->tempoEvento) * 1000.0);
+        l->envioMistura = (float)((agora - comando->tempoEnvio) * 1000.0);
+        mixer->totalLatencias++;
+    }
+}
+
+static void LerComandos(MixerSom* mixer, double agora) {
+    uint32_t escrita = __atomic_load_n(&mixer->escrita, __ATOMIC_ACQUIRE);
+    uint32_t leitura = mixer->leitura;
+    for (; leitura != escrita; leitura++) {
+        ComandoSom comando = mixer->comandos[leitura & (MAX_COMANDOS_SOM - 1)];
+        if (comando.id >= TOTAL_SONS)
+            continue;
+        if (comando.tipo == COMANDO_TOCAR) {
+            IniciarVoz(mixer, &comando, agora);
+        } else {
+            for (int i = 0; i < MAX_VOZES_SOM; i++)
+                if (mixer->vozes[i].amostra != NULL && mixer->vozes[i].id == comando.id)
+                    mixer->vozes[i].parando = true;
+        }
+    }
+    __atomic_store_n(&mixer->leitura, leitura, __ATOMIC_RELEASE); // Libera os espaços para o jogo.
+}
+
+// Soma 'quadros' quadros de uma voz na mistura. Libera a voz quando a amostra acaba ou o fade chega a zero.
+static void MisturarVoz(MixerSom* mixer, VozSom* voz, int quadros) {
+    const AmostraSom* a = voz->amostra;
+    float passoFade = 1.0f / (DURACAO_FADE_SOM * TAXA_SOM);
+    float* m = mixer->mistura;
+    for (int i = 0; i < quadros; i++) {
+        if (voz->posicao >= a->quadros) {
+            if (!voz->repetir) {
+                voz->amostra = NULL;
+                return;
+            }
+            voz->posicao = 0;
+        }
+        if (voz->parando) {
+            voz->volume -= passoFade;
+            if (voz->volume <= 0.0f) {
+                voz->amostra = NULL;
+                return;
+            }
+        }
+        float x = a->amostras[voz->posicao++] * (voz->volume / 32768.0f);
+        m[2 * i] += x * voz->ganhoEsquerdo;
+        m[2 * i + 1] += x * voz->ganhoDireito;
+    }
+}
+
+void MisturarSom(MixerSom* mixer, int16_t* saida, int quadros) {
+    double agora = mixer->relogio != NULL ? mixer->relogio() : 0.0;
+    LerComandos(mixer, agora);
+    while (quadros > 0) {
+        int n = quadros < QUADROS_BLOCO_SOM ? quadros : QUADROS_BLOCO_SOM;
+        memset(mixer->mistura, 0, 2 * (size_t)n * sizeof(float));
+        int ativas = 0;
+        for (int v = 0; v < MAX_VOZES_SOM; v++) {
+            if (mixer->vozes[v].amostra != NULL) {
+                ativas++;
+                MisturarVoz(mixer, &mixer->vozes[v], n);
+            }
+        }
+        if (ativas > mixer->maxVozesAtivas)
+            mixer->maxVozesAtivas = ativas;
+        for (int i = 0; i < 2 * n; i++)
+            saida[i] = ParaPcm(mixer->mistura[i] * mixer->volumeGeral);
+        saida += 2 * n;
+        quadros -= n;
+    }
+    mixer->buffersMisturados++;
+}
+
+void TocarAcertosSom(MixerSom* mixer, const EstadoJogo* jogo, int primeiro, const double* tempoCliques, float larguraTela) {
+    for (int k = primeiro < 0 ? 0 : primeiro; k < jogo->totalAcertosRecentes; k++) {
+        const AcertoJogo* a = &jogo->acertosRecentes[k];
+        IdSom id = a->tipo == DOURADA ? SOM_ACERTO_DOURADA : (a->tipo == CUTIA ? SOM_ACERTO_CUTIA : SOM_ACERTO_NORMAL);
+        Retangulo r = jogo->capivaras.rect[a->buraco];
+        float pan = 0.8f * (2.0f * (r.x + r.largura / 2) / larguraTela - 1.0f); // Nunca só em um lado.
+        double tempo = tempoCliques != NULL && a->clique >= 0 ? tempoCliques[a->clique] : 0.0;
+        TocarSom(mixer, id, pan, 1.0f, tempo);
+    }
+}
+
+void AtualizarAndamentoSom(MixerSom* mixer, AndamentoSom* andamento, const EstadoJogo* jogo, bool ativa) {
+    bool chuva = ativa && jogo->chovendo && !jogo->jogoAcabou;
+    if (chuva != andamento->chuva) {
+        if (chuva)
+            TocarSom(mixer, SOM_CHUVA, 0.0f, 1.0f, 0.0);
+        else
+            PararSom(mixer, SOM_CHUVA);
+        andamento->chuva = chuva;
+    }
+    if (!ativa)
+        return;
+    // Um bipe a cada segundo da contagem ("3", "2", "1") e outro, mais agudo, no "GO!".
+    int contador = jogo->jogoIniciado ? -1 : (jogo->contadorRegressivoInicial > 1.0 ? (int)jogo->contadorRegressivoInicial : 0);
+    if (contador != andamento->ultimoContador) {
+        if (contador > 0)
+            TocarSom(mixer, SOM_CONTAGEM, 0.0f, 1.0f, 0.0);
+        else if (contador == 0)
+            TocarSom(mixer, SOM_LARGADA, 0.0f, 1.0f, 0.0);
+        andamento->ultimoContador = contador;
+    }
+    if (jogo->jogoAcabou && !andamento->acabou)
+        TocarSom(mixer, SOM_FIM, 0.0f, 1.0f, 0.0);
+    andamento->acabou = jogo->jogoAcabou;
+}
+
+static int CompararFloat(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+static void Percentis(float* valores, int total, float* p50, float* p99, float* maximo) {
+    qsort(valores, (size_t)total, sizeof(float), CompararFloat);
+    *p50 = valores[total / 2];
+    *p99 = valores[(int)(total * 0.99)];
+    *maximo = valores[total - 1];
+}
+
+ResumoLatenciaSom ResumirLatenciaSom(const MixerSom* mixer) {
+    ResumoLatenciaSom r = {0};
+    int total = mixer->totalLatencias < MAX_LATENCIAS_SOM ? (int)mixer->totalLatencias : MAX_LATENCIAS_SOM;
+    r.total = mixer->totalLatencias;
+    if (total == 0)
+        return r;
+    float* valores = (float*)malloc(3 * (size_t)total * sizeof(float));
+    if (valores == NULL)
+        return r;
+    float* envio = valores + total;
+    float* soma = envio + total;
+    for (int i = 0; i < total; i++) {
+        valores[i] = mixer->latencias[i].cliqueEnvio;
+        envio[i] = mixer->latencias[i].envioMistura;
+        soma[i] = valores[i] + envio[i];
+    }
+    Percentis(valores, total, &r.cliqueEnvioP50, &r.cliqueEnvioP99, &r.cliqueEnvioMax);
+    Percentis(envio, total, &r.envioMisturaP50, &r.envioMisturaP99, &r.envioMisturaMax);
+    Percentis(soma, total, &r.totalP50, &r.totalP99, &r.totalMax);
+    free(valores);
+    return r;
+}
@@ -0,0 +1,137 @@
+#ifndef SOM_H
+#define SOM_H
+
+#include "logica.h" // TipoCapivara e os acertos da partida.
+
+// --- MIXER DE SOM DE BAIXA LATÊNCIA ---
+// Os sons dos acertos, da contagem regressiva, da chuva e do fim da partida. Todas as amostras são geradas na
+// iniciação (PCM de 16 bits já pronto, sem decodificar nada durante o jogo), com algumas variações de cada som
+// para os acertos seguidos não soarem iguais. Tocar um som não aloca memória: o jogo põe um comando em um anel
+// de capacidade fixa (uma thread escreve, outra lê, sem trava) e a thread de áudio, a cada buffer, lê os
+// comandos, ocupa uma voz do pool (roubando a mais antiga se todas estiverem tocando) e mistura as vozes ativas.
+//
+// A latência do clique ao som tem três partes: do clique até o frame que o aplica (a mesma que a do retorno
+// visual), do comando até o próximo buffer misturado (no máximo um buffer) e o buffer até sair no alto-falante.
+// Com buffers de 256 quadros a 48 kHz (5,3 ms), as duas últimas somam uns 10 ms. O mixer mede as duas primeiras
+// em cada acerto: cada comando leva o momento do clique e o momento do envio, e a thread de áudio anota quando o
+// misturou. O 'medir_som' mede a mesma coisa sem janela. Este módulo não depende da Raylib; a saída para o
+// dispositivo de áudio fica no JogoC.c.
+
+#define TAXA_SOM 48000           // Quadros por segundo (estéreo, 16 bits).
+#define QUADROS_BUFFER_SOM 256   // Tamanho padrão do buffer de áudio (5,3 ms a 48 kHz).
+#define MAX_VOZES_SOM 32         // Sons tocando ao mesmo tempo.
+#define MAX_COMANDOS_SOM 64      // Comandos esperando a thread de áudio (potência de 2).
+#define MAX_VARIACOES_SOM 4      // Variações de cada som, tocadas em rodízio.
+#define QUADROS_BLOCO_SOM 512    // A mistura é feita em blocos deste tamanho, em um buffer fixo.
+#define MAX_LATENCIAS_SOM 8192   // Medidas de latência guardadas (as mais recentes).
+
+typedef enum IdSom {
+    SOM_ACERTO_NORMAL,
+    SOM_ACERTO_DOURADA,
+    SOM_ACERTO_CUTIA,
+    SOM_CONTAGEM,    // Cada segundo da contagem regressiva.
+    SOM_LARGADA,     // "GO!".
+    SOM_CHUVA,       // Repete enquanto chove.
+    SOM_FIM,         // Fim da partida.
+    TOTAL_SONS
+} IdSom;
+
+typedef struct {
+    int16_t* amostras;   // Mono, dentro da memória do mixer.
+    int quadros;
+} AmostraSom;
+
+typedef struct {
+    AmostraSom variacoes[MAX_VARIACOES_SOM];
+    int totalVariacoes;
+    int proxima;         // Próxima variação do rodízio (só a thread de áudio mexe).
+    bool repetir;        // Toca em laço até PararSom.
+    float ganho;
+} BancoSom;
+
+typedef struct {
+    const AmostraSom* amostra;  // NULL se a voz está livre.
+    int posicao;                // Próximo quadro da amostra.
+    float ganhoEsquerdo, ganhoDireito;
+    float volume;               // Envelope de saída: 1 tocando; cai até 0 depois de PararSom.
+    bool parando;
+    bool repetir;
+    uint8_t id;                 // IdSom.
+    uint32_t ordem;             // Quando começou, para roubar a voz mais antiga.
+} VozSom;
+
+typedef enum { COMANDO_TOCAR, COMANDO_PARAR } TipoComandoSom;
+
+typedef struct {
+    uint8_t tipo;         // TipoComandoSom.
+    uint8_t id;           // IdSom.
+    float pan;            // -1 (esquerda) a 1 (direita).
+    float ganho;
+    double tempoEvento;   // Momento do clique que causou o som (0 se não veio de um clique).
+    double tempoEnvio;    // Momento em que o jogo enviou o comando.
+} ComandoSom;
+
+// Latência de um som disparado por um clique, em milissegundos.
+typedef struct {
+    float cliqueEnvio;    // Do clique até o jogo enviar o comando (espera do frame + lógica).
+    float envioMistura;   // Do envio até a thread de áudio misturar o início do som.
+} LatenciaSom;
+
+typedef struct {
+    BancoSom bancos[TOTAL_SONS];
+    VozSom vozes[MAX_VOZES_SOM];
+    ComandoSom comandos[MAX_COMANDOS_SOM];
+    uint32_t escrita;     // Próximo comando a escrever (só o jogo escreve).
+    uint32_t leitura;     // Próximo comando a ler (só a thread de áudio escreve).
+    float mistura[2 * QUADROS_BLOCO_SOM];
+    int16_t* memoria;     // Todas as amostras.
+    double (*relogio)(void); // Mesmo relógio dos momentos dos comandos (GetTime no jogo).
+    uint32_t proximaOrdem;
+    float volumeGeral;
+
+    // Estatísticas (escritas pela thread de áudio)
+    LatenciaSom latencias[MAX_LATENCIAS_SOM];
+    int64_t totalLatencias;
+    int64_t buffersMisturados;
+    int64_t vozesRoubadas;
+    int64_t comandosPerdidos;  // Anel cheio (escrita pelo jogo).
+    int maxVozesAtivas;
+} MixerSom;
+
+// Gera todas as amostras e zera as vozes. 'relogio' é chamado pela thread de áudio a cada buffer.
+bool IniciarSom(MixerSom* mixer, double (*relogio)(void));
+void LiberarSom(MixerSom* mixer);
+
+// Chamadas pela thread do jogo. Retornam false se o anel estiver cheio (o som é descartado).
+bool TocarSom(MixerSom* mixer, IdSom id, float pan, float ganho, double tempoEvento);
+bool PararSom(MixerSom* mixer, IdSom id);
+
+// Chamada pela thread de áudio: lê os comandos e escreve 'quadros' quadros estéreo em 'saida'.
+void MisturarSom(MixerSom* mixer, int16_t* saida, int quadros);
+
+// Toca os acertos do último passo da partida: o som do tipo do animal, à esquerda ou à direita conforme o buraco.
+// Só os acertos a partir de 'primeiro' tocam (os anteriores já tocaram em outro frame). 'tempoCliques[k]' é o
+// momento do clique k da EntradaJogo do passo (NULL se os acertos não vieram de cliques).
+void TocarAcertosSom(MixerSom* mixer, const EstadoJogo* jogo, int primeiro, const double* tempoCliques, float larguraTela);
+
+// Sons do andamento da partida, a partir das mudanças no estado: contagem regressiva, chuva e fim.
+typedef struct {
+    int ultimoContador;   // Último segundo da contagem tocado.
+    bool chuva;           // O som da chuva está tocando.
+    bool acabou;          // O fim da partida já tocou.
+} AndamentoSom;
+
+// Chamada uma vez por frame. Com 'ativa' false (pausa, menus), só para a chuva.
+void AtualizarAndamentoSom(MixerSom* mixer, AndamentoSom* andamento, const EstadoJogo* jogo, bool ativa);
+
+// Percentis das latências medidas, em milissegundos. Deve ser chamada com a thread de áudio parada.
+typedef struct {
+    int64_t total;
+    float cliqueEnvioP50, cliqueEnvioP99, cliqueEnvioMax;
+    float envioMisturaP50, envioMisturaP99, envioMisturaMax;
+    float totalP50, totalP99, totalMax; // Do clique até a mistura.
+} ResumoLatenciaSom;
+
+ResumoLatenciaSom ResumirLatenciaSom(const MixerSom* mixer);
+
+#endif
@@ -0,0 +1,189 @@
+#define _POSIX_C_SOURCE 200809L // nanosleep.
+#include "telemetria.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TAMANHO_CABECALHO_TELEMETRIA 8
+#define MAXIMO_CODIFICADO 16 // Bytes de um registro codificado no pior caso: 1 + 5 + 5 + 5.
+
+static void Dormir(double segundos) {
+    struct timespec t = { (time_t)segundos, (long)((segundos - (time_t)segundos) * 1e9) };
+    nanosleep(&t, NULL);
+}
+
+// Inteiro sem sinal em 7 bits por byte.
+static uint8_t* EscreverVarint(uint8_t* p, uint32_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+// Lê um varint entre 'p' e 'fim'. Retorna NULL se os dados acabarem no meio ou ele não couber em 32 bits.
+static const uint8_t* LerVarint(const uint8_t* p, const uint8_t* fim, uint32_t* v) {
+    *v = 0;
+    for (int deslocamento = 0; p < fim && deslocamento < 35; deslocamento += 7) {
+        uint8_t byte = *p++;
+        *v |= (uint32_t)(byte & 0x7F) << deslocamento;
+        if ((byte & 0x80) == 0)
+            return p;
+    }
+    return NULL;
+}
+
+// Zigzag: 0, -1, 1, -2, 2... viram 0, 1, 2, 3, 4..., então diferenças pequenas para trás também ocupam 1 byte.
+static uint32_t Zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t DesfazerZigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+// Codifica os registros de 'leitura' até 'escrita' no buffer e os grava. Chamada só pelo consumidor.
+static void EsvaziarTelemetria(Telemetria* t) {
+    uint32_t escrita = __atomic_load_n(&t->escrita, __ATOMIC_ACQUIRE);
+    uint32_t leitura = t->leitura;
+    while (leitura != escrita) {
+        // Em blocos que cabem no buffer, liberando o anel para o produtor a cada bloco.
+        uint8_t* p = t->buffer;
+        uint32_t inicioBloco = leitura;
+        uint32_t fimBloco = escrita - leitura > CAPACIDADE_TELEMETRIA / 4 ? leitura + CAPACIDADE_TELEMETRIA / 4 : escrita;
+        for (; leitura != fimBloco; leitura++) {
+            const RegistroTelemetria* r = &t->registros[leitura & (CAPACIDADE_TELEMETRIA - 1)];
+            *p++ = (uint8_t)(r->evento | r->tipo << 4);
+            p = EscreverVarint(p, Zigzag(r->tick - t->tickAnterior));
+            p = EscreverVarint(p, (uint32_t)(r->buraco + 1));
+            p = EscreverVarint(p, (uint32_t)r->valor);
+            t->tickAnterior = r->tick;
+        }
+        __atomic_store_n(&t->leitura, leitura, __ATOMIC_RELEASE);
+        size_t tamanho = (size_t)(p - t->buffer);
+        fwrite(t->buffer, 1, tamanho, t->arquivo);
+        t->bytesGravados += tamanho;
+        t->registrosGravados += fimBloco - inicioBloco;
+        if (leitura == escrita) // Uma queda do jogo perde no máximo o último intervalo.
+            fflush(t->arquivo);
+    }
+}
+
+static void* ExecutarTelemetria(void* argumento) {
+    Telemetria* t = (Telemetria*)argumento;
+    while (!__atomic_load_n(&t->encerrar, __ATOMIC_ACQUIRE)) {
+        Dormir(INTERVALO_TELEMETRIA);
+        EsvaziarTelemetria(t);
+    }
+    return NULL;
+}
+
+bool IniciarTelemetria(Telemetria* telemetria, const char* arquivo) {
+    memset(telemetria, 0, sizeof(*telemetria));
+    telemetria->registros = (RegistroTelemetria*)calloc(CAPACIDADE_TELEMETRIA, sizeof(RegistroTelemetria));
+    telemetria->buffer = (uint8_t*)malloc((size_t)CAPACIDADE_TELEMETRIA / 4 * MAXIMO_CODIFICADO);
+    if (telemetria->registros == NULL || telemetria->buffer == NULL) {
+        EncerrarTelemetria(telemetria);
+        return false;
+    }
+    if (arquivo == NULL)
+        return true;
+
+    telemetria->arquivo = fopen(arquivo, "wb");
+    if (telemetria->arquivo == NULL) {
+        EncerrarTelemetria(telemetria);
+        return false;
+    }
+    uint8_t cabecalho[TAMANHO_CABECALHO_TELEMETRIA] = { 0 };
+    memcpy(cabecalho, MAGICA_TELEMETRIA, 4);
+    cabecalho[4] = VERSAO_TELEMETRIA;
+    cabecalho[6] = (uint8_t)(TICKS_POR_SEGUNDO & 0xFF);
+    cabecalho[7] = (uint8_t)(TICKS_POR_SEGUNDO >> 8);
+    fwrite(cabecalho, 1, sizeof(cabecalho), telemetria->arquivo);
+    telemetria->bytesGravados = sizeof(cabecalho);
+    if (pthread_create(&telemetria->thread, NULL, ExecutarTelemetria, telemetria) != 0) {
+        EncerrarTelemetria(telemetria);
+        return false;
+    }
+    telemetria->iniciada = true;
+    return true;
+}
+
+void EncerrarTelemetria(Telemetria* telemetria) {
+    if (telemetria->iniciada) {
+        __atomic_store_n(&telemetria->encerrar, 1, __ATOMIC_RELEASE);
+        pthread_join(telemetria->thread, NULL);
+        telemetria->iniciada = false;
+    }
+    if (telemetria->arquivo != NULL) {
+        // O produtor parou: o que sobrou no anel e, por último, quantos registros se perderam.
+        EsvaziarTelemetria(telemetria);
+        uint64_t perdidos = telemetria->perdidos;
+        RegistrarTelemetria(telemetria, EVENTO_PERDAS, telemetria->tickAnterior, -1, 0,
+                            perdidos > INT32_MAX ? INT32_MAX : (int)perdidos);
+        EsvaziarTelemetria(telemetria);
+        fclose(telemetria->arquivo);
+        telemetria->arquivo = NULL;
+    }
+    free(telemetria->registros);
+    free(telemetria->buffer);
+    telemetria->registros = NULL;
+    telemetria->buffer = NULL;
+}
+
+int64_t CarregarTelemetria(const char* arquivo, RegistroTelemetria** registros, int* ticksPorSegundo) {
+    *registros = NULL;
+    FILE* f = fopen(arquivo, "rb");
+    if (f == NULL)
+        return -1;
+    fseek(f, 0, SEEK_END);
+    long tamanho = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t* dados = tamanho >= TAMANHO_CABECALHO_TELEMETRIA ? (uint8_t*)malloc((size_t)tamanho) : NULL;
+    bool lido = dados != NULL && fread(dados, 1, (size_t)tamanho, f) == (size_t)tamanho;
+    fclose(f);
+    if (!lido || memcmp(dados, MAGICA_TELEMETRIA, 4) != 0 || dados[4] != VERSAO_TELEMETRIA) {
+        free(dados);
+        return -1;
+    }
+    if (ticksPorSegundo != NULL)
+        *ticksPorSegundo = dados[6] | dados[7] << 8;
+
+    // Cada registro ocupa pelo menos 4 bytes.
+    size_t capacidade = (size_t)(tamanho - TAMANHO_CABECALHO_TELEMETRIA) / 4 + 1;
+    RegistroTelemetria* lista = (RegistroTelemetria*)malloc(capacidade * sizeof(RegistroTelemetria));
+    if (lista == NULL) {
+        free(dados);
+        return -1;
+    }
+    const uint8_t* p = dados + TAMANHO_CABECALHO_TELEMETRIA;
+    const uint8_t* fim = dados + tamanho;
+    int64_t total = 0;
+    int32_t tick = 0;
+    bool corrompido = false;
+    while (p < fim) {
+        uint8_t cabecalho = *p++;
+        uint32_t diferenca, buraco, valor;
+        const uint8_t* q = LerVarint(p, fim, &diferenca);
+        q = q != NULL ? LerVarint(q, fim, &buraco) : NULL;
+        q = q != NULL ? LerVarint(q, fim, &valor) : NULL;
+        if (q == NULL) // Registro cortado no fim do arquivo.
+            break;
+        if ((cabecalho & 0x0F) >= TOTAL_EVENTOS_TELEMETRIA) {
+            corrompido = true;
+            break;
+        }
+        p = q;
+        tick += DesfazerZigzag(diferenca);
+        lista[total++] = (RegistroTelemetria){ tick, (int32_t)buraco - 1, (int32_t)valor, (uint8_t)(cabecalho & 0x0F),
+                                               (uint8_t)(cabecalho >> 4), { 0, 0 } };
+    }
+    free(dados);
+    if (corrompido) {
+        free(lista);
+        return -1;
+    }
+    *registros = lista;
+    return total;
+}
@@ -0,0 +1,116 @@
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+#include "logica.h"
+#include <pthread.h>
+#include <stddef.h> // offsetof.
+#include <stdio.h>
+
+// --- TELEMETRIA DOS TEMPOS DE REAÇÃO ---
+// Cada aparecimento, acerto, clique perdido, animal que se escondeu e chuva vira um registro de tamanho fixo em
+// um anel de um produtor só (quem avança a partida) e um consumidor só (a thread da telemetria). Registrar um
+// evento é escrever 16 bytes no anel e publicar o índice: não trava, não aloca e não faz chamada ao sistema. Se o
+// anel estiver cheio (disco parado), o registro é descartado e contado. A thread da telemetria acorda a cada
+// INTERVALO_TELEMETRIA, esvazia o anel e grava os registros em diferenças compactas no arquivo. O analisar_telemetria
+// transforma os arquivos em histogramas do tempo de reação por animal e dificuldade.
+// Este módulo não depende da Raylib.
+//
+// Formato do arquivo (little-endian):
+//   "BTEL", versão (1 byte), 1 byte reservado, ticks por segundo (2 bytes)
+//   para cada registro: evento | tipo << 4 (1 byte), diferença de tick para o registro anterior (varint zigzag),
+//   buraco + 1 (varint), valor (varint)
+// Os ticks recomeçam em cada partida (o INICIO_PARTIDA volta a diferença para trás, daí o zigzag).
+
+#define MAGICA_TELEMETRIA "BTEL"
+#define VERSAO_TELEMETRIA 1
+#define EXTENSAO_TELEMETRIA ".btel"
+#define CAPACIDADE_TELEMETRIA 16384   // Registros no anel (potência de 2): 256 KB, mais de um segundo de um tabuleiro enorme.
+#define INTERVALO_TELEMETRIA 0.02     // Segundos entre os esvaziamentos do anel.
+#define LINHA_CACHE 64
+
+// Faz um campo começar em uma linha de cache nova (o que alinha também a struct inteira a ela).
+#if defined(_MSC_VER)
+    #define ALINHADO_CACHE __declspec(align(LINHA_CACHE))
+#else
+    #define ALINHADO_CACHE __attribute__((aligned(LINHA_CACHE)))
+#endif
+
+typedef enum {
+    EVENTO_INICIO_PARTIDA, // Fim da contagem regressiva. tipo: Dificuldade, buraco: total de buracos.
+    EVENTO_APARECEU,       // tipo: TipoCapivara, valor: ticks que ele vai ficar visível.
+    EVENTO_ACERTO,         // tipo: TipoCapivara, valor: ticks do aparecimento ao clique (o tempo de reação).
+    EVENTO_ERRO,           // Clique durante a partida que não acertou nada. buraco: -1.
+    EVENTO_ESCONDEU,       // O animal sumiu sem ser acertado. tipo: TipoCapivara, valor: ticks que ele ficou visível.
+    EVENTO_INICIO_CHUVA,   // Uma cutia no DIFICIL (também quando a chuva já estava ativa). valor: ticks até o fim.
+    EVENTO_FIM_CHUVA,
+    EVENTO_FIM_PARTIDA,    // valor: pontos finais.
+    EVENTO_PERDAS,         // Último registro do arquivo. valor: registros descartados com o anel cheio.
+    TOTAL_EVENTOS_TELEMETRIA
+} EventoTelemetria;
+
+typedef struct {
+    int32_t tick;     // Tick da partida.
+    int32_t buraco;   // Buraco do evento (-1 se não se aplica).
+    int32_t valor;    // Depende do evento (veja EventoTelemetria).
+    uint8_t evento;   // EventoTelemetria.
+    uint8_t tipo;     // TipoCapivara, ou Dificuldade no INICIO_PARTIDA.
+    uint8_t reservado[2];
+} RegistroTelemetria;
+
+typedef struct Telemetria {
+    RegistroTelemetria* registros; // Anel com CAPACIDADE_TELEMETRIA registros.
+    // Lado do produtor (a thread que avança a partida). Cada lado começa na sua linha de cache, para o produtor não
+    // invalidar a do consumidor a cada registro.
+    ALINHADO_CACHE uint32_t escrita; // Próximo registro a escrever (publicado com release).
+    uint32_t leituraVista;         // Última 'leitura' lida pelo produtor: só relê a do consumidor com o anel cheio.
+    uint64_t perdidos;             // Registros descartados com o anel cheio.
+    // Lado do consumidor (a thread da telemetria).
+    ALINHADO_CACHE uint32_t leitura; // Próximo registro a ler (publicado com release).
+    int32_t tickAnterior;          // Tick do último registro gravado, para a diferença.
+    FILE* arquivo;                 // NULL: só o anel, sem thread (para medir o custo de registrar).
+    uint8_t* buffer;               // Registros já codificados, antes do fwrite.
+    uint64_t registrosGravados;
+    uint64_t bytesGravados;
+    pthread_t thread;
+    int encerrar;                  // Pedido de parada para a thread (atômico).
+    bool iniciada;
+} Telemetria;
+
+// Se o alinhamento for ignorado (outro compilador, ou o atributo perdido), o produtor e o consumidor voltam a dividir
+// a mesma linha de cache sem nada avisar.
+_Static_assert(offsetof(Telemetria, escrita) % LINHA_CACHE == 0, "'escrita' tem que começar uma linha de cache");
+_Static_assert(offsetof(Telemetria, leitura) % LINHA_CACHE == 0, "'leitura' tem que começar uma linha de cache");
+_Static_assert(_Alignof(Telemetria) == LINHA_CACHE, "a Telemetria tem que estar alinhada à linha de cache");
+
+// Cria o arquivo (substituindo um existente) e começa a thread que o escreve; com 'arquivo' NULL, só aloca o anel.
+// Retorna false se não foi possível.
+bool IniciarTelemetria(Telemetria* telemetria, const char* arquivo);
+
+// Para a thread, grava o que sobrou no anel e o total de perdidos e fecha o arquivo. O produtor já deve ter parado.
+void EncerrarTelemetria(Telemetria* telemetria);
+
+// Registra um evento. Chamada pela lógica quando o estado do jogo aponta para a telemetria.
+static inline void RegistrarTelemetria(Telemetria* t, EventoTelemetria evento, int64_t tick, int buraco, int tipo, int valor) {
+    uint32_t escrita = t->escrita;
+    if (escrita - t->leituraVista >= CAPACIDADE_TELEMETRIA) {
+        t->leituraVista = __atomic_load_n(&t->leitura, __ATOMIC_ACQUIRE);
+        if (escrita - t->leituraVista >= CAPACIDADE_TELEMETRIA) {
+            t->perdidos++;
+            return;
+        }
+    }
+    RegistroTelemetria* r = &t->registros[escrita & (CAPACIDADE_TELEMETRIA - 1)];
+    r->tick = (int32_t)tick;
+    r->buraco = buraco;
+    r->valor = valor;
+    r->evento = (uint8_t)evento;
+    r->tipo = (uint8_t)tipo;
+    __atomic_store_n(&t->escrita, escrita + 1, __ATOMIC_RELEASE);
+}
+
+// Lê todos os registros de um arquivo em '*registros' (alocado; o chamador libera). Retorna quantos, ou -1 se o
+// arquivo não existir, tiver outra versão ou estiver corrompido. Um registro cortado no fim (o jogo caiu no meio
+// de uma gravação) é ignorado.
+int64_t CarregarTelemetria(const char* arquivo, RegistroTelemetria** registros, int* ticksPorSegundo);
+
+#endif
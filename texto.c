@@ -0,0 +1,182 @@
+#include "texto.h"
+#include "lotes.h"
+#include "perfil.h"
+#include "rlgl.h"
+#include <stdint.h>
+#include <string.h>
+
+#define TOTAL_TEXTOS_FIXOS 64 // Entradas da tabela de textos fixos (o jogo inteiro usa umas 30).
+
+// Tabela de textos fixos com endereçamento aberto, indexada pelo hash do texto e do tamanho.
+static TextoCacheado textosFixos[TOTAL_TEXTOS_FIXOS];
+static uint32_t hashesFixos[TOTAL_TEXTOS_FIXOS];
+static int totalFixos;
+
+bool TextoPrecisaAtualizar(TextoCacheado* texto, int chave) {
+#if defined(TEXTO_SEM_CACHE)
+    texto->chave = chave;
+    return true; // Sem cache: o texto é montado de novo a cada frame, como antes.
+#else
+    if (texto->definido && texto->chave == chave)
+        return false;
+    texto->chave = chave;
+    return true;
+#endif
+}
+
+// Monta os glifos do texto com as mesmas regras do DrawText (e a largura com as do MeasureText):
+// escala = tamanho / tamanho base da fonte, espaçamento = tamanho / 10, espaços e tabs só avançam.
+static void MontarLayout(TextoCacheado* texto) {
+    Font fonte = GetFontDefault();
+    int tamanho = texto->tamanho < 10 ? 10 : texto->tamanho; // O DrawText nunca desenha menor que 10.
+    float escala = (float)tamanho / fonte.baseSize;
+    float espacamento = (float)(tamanho / 10);
+    float larguraTextura = (float)fonte.texture.width, alturaTextura = (float)fonte.texture.height;
+    float padding = (float)fonte.glyphPadding;
+
+    texto->textura = fonte.texture.id;
+    texto->totalGlifos = 0;
+    texto->emCache = true;
+    float avanco = 0.0f;        // Posição x da próxima letra.
+    float larguraBase = 0.0f;   // Largura sem escala, somada como no MeasureTextEx.
+    int letras = 0;
+    for (int i = 0; texto->texto[i] != '\0';) {
+        int bytes = 0;
+        int codigo = GetCodepointNext(&texto->texto[i], &bytes);
+        int g = GetGlyphIndex(fonte, codigo);
+        i += bytes;
+        letras++;
+        if (codigo == '\n') { // Textos de várias linhas ficam com o DrawText.
+            texto->emCache = false;
+            return;
+        }
+        Rectangle r = fonte.recs[g];
+        GlyphInfo info = fonte.glyphs[g];
+        if (codigo != ' ' && codigo != '\t') {
+            if (texto->totalGlifos == MAX_GLIFOS_TEXTO) {
+                texto->emCache = false;
+                return;
+            }
+            texto->glifos[texto->totalGlifos++] = (GlifoTexto){
+                avanco + (info.offsetX - padding) * escala, (info.offsetY - padding) * escala,
+                (r.width + 2 * padding) * escala, (r.height + 2 * padding) * escala,
+                (r.x - padding) / larguraTextura, (r.y - padding) / alturaTextura,
+                (r.x + r.width + padding) / larguraTextura, (r.y + r.height + padding) / alturaTextura
+            };
+        }
+        avanco += (info.advanceX == 0 ? r.width : (float)info.advanceX) * escala + espacamento;
+        larguraBase += info.advanceX != 0 ? (float)info.advanceX : r.width + info.offsetX;
+    }
+    texto->largura = letras > 0 ? (int)(larguraBase * escala + (letras - 1) * espacamento) : 0;
+}
+
+void DefinirTexto(TextoCacheado* texto, const char* conteudo, int tamanho) {
+#if !defined(TEXTO_SEM_CACHE)
+    if (texto->definido && texto->tamanho == tamanho && strcmp(texto->texto, conteudo) == 0)
+        return;
+#endif
+    texto->definido = true;
+    texto->tamanho = tamanho;
+    size_t comprimento = strlen(conteudo);
+    bool cortado = comprimento >= MAX_BYTES_TEXTO;
+    if (cortado)
+        comprimento = MAX_BYTES_TEXTO - 1;
+    memcpy(texto->texto, conteudo, comprimento);
+    texto->texto[comprimento] = '\0';
+    PERFIL_BLOCO(FASE_TEXTO) {
+#if defined(TEXTO_SEM_CACHE)
+        texto->emCache = false;
+#else
+        texto->emCache = false;
+        if (!cortado) // Um texto cortado seria desenhado errado: fica sem cache.
+            MontarLayout(texto);
+#endif
+        if (!texto->emCache)
+            texto->largura = MeasureText(texto->texto, tamanho);
+    }
+    ContarLayoutTextoLote();
+}
+
+void DesenharTextoCacheado(const TextoCacheado* texto, int x, int y, Color cor) {
+    if (!texto->definido)
+        return;
+    PERFIL_BLOCO(FASE_TEXTO) {
+        if (!texto->emCache) {
+            DesenharTextoLote(texto->texto, x, y, texto->tamanho, cor);
+        } else if (texto->totalGlifos > 0) {
+            // Os mesmos vértices que o DrawTexturePro gera para cada letra, mas em um único rlBegin/rlEnd.
+            ContarDesenhoLote(texto->textura);
+            rlCheckRenderBatchLimit(4 * texto->totalGlifos);
+            rlSetTexture(texto->textura);
+            rlBegin(RL_QUADS);
+            rlColor4ub(cor.r, cor.g, cor.b, cor.a);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            for (int i = 0; i < texto->totalGlifos; i++) {
+                const GlifoTexto* g = &texto->glifos[i];
+                float gx = x + g->x, gy = y + g->y;
+                rlTexCoord2f(g->u0, g->v0);
+                rlVertex2f(gx, gy);
+                rlTexCoord2f(g->u0, g->v1);
+                rlVertex2f(gx, gy + g->altura);
+                rlTexCoord2f(g->u1, g->v1);
+                rlVertex2f(gx + g->largura, gy + g->altura);
+                rlTexCoord2f(g->u1, g->v0);
+                rlVertex2f(gx + g->largura, gy);
+            }
+            rlEnd();
+            rlSetTexture(0);
+        }
+    }
+}
+
+// FNV-1a do texto, misturado com o tamanho.
+static uint32_t HashTexto(const char* conteudo, int tamanho) {
+    uint32_t h = 2166136261u ^ (uint32_t)tamanho;
+    for (const unsigned char* p = (const unsigned char*)conteudo; *p != '\0'; p++)
+        h = (h ^ *p) * 16777619u;
+    return h | 1u; // 0 marca uma entrada vazia.
+}
+
+const TextoCacheado* TextoFixo(const char* conteudo, int tamanho) {
+    uint32_t h = HashTexto(conteudo, tamanho);
+    int i = (int)(h % TOTAL_TEXTOS_FIXOS);
+    for (;;) {
+        if (hashesFixos[i] == 0)
+            break;
+        if (hashesFixos[i] == h && textosFixos[i].tamanho == tamanho && strcmp(textosFixos[i].texto, conteudo) == 0)
+            return &textosFixos[i];
+        i = (i + 1) % TOTAL_TEXTOS_FIXOS;
+    }
+    // Texto novo. Com a tabela quase cheia, ela é esvaziada: os textos em uso voltam a ser montados nos próximos frames.
+    if (totalFixos >= TOTAL_TEXTOS_FIXOS * 3 / 4) {
+        memset(hashesFixos, 0, sizeof(hashesFixos));
+        memset(textosFixos, 0, sizeof(textosFixos));
+        totalFixos = 0;
+        i = (int)(h % TOTAL_TEXTOS_FIXOS);
+    }
+    hashesFixos[i] = h;
+    totalFixos++;
+    DefinirTexto(&textosFixos[i], conteudo, tamanho);
+    return &textosFixos[i];
+}
+
+void DesenharTextoFixo(const char* conteudo, int x, int y, int tamanho, Color cor) {
+#if defined(TEXTO_SEM_CACHE)
+    PERFIL_BLOCO(FASE_TEXTO) {
+        DesenharTextoLote(conteudo, x, y, tamanho, cor);
+    }
+#else
+    DesenharTextoCacheado(TextoFixo(conteudo, tamanho), x, y, cor);
+#endif
+}
+
+void DesenharTextoFixoCentralizado(const char* conteudo, int centroX, int y, int tamanho, Color cor) {
+#if defined(TEXTO_SEM_CACHE)
+    PERFIL_BLOCO(FASE_TEXTO) {
+        DesenharTextoLote(conteudo, centroX - MeasureText(conteudo, tamanho) / 2, y, tamanho, cor);
+    }
+#else
+    const TextoCacheado* texto = TextoFixo(conteudo, tamanho);
+    DesenharTextoCacheado(texto, centroX - texto->largura / 2, y, cor);
+#endif
+}
@@ -0,0 +1,64 @@
+#ifndef TEXTO_H
+#define TEXTO_H
+
+#include "raylib.h"
+
+// --- TEXTO EM CACHE ---
+// O DrawText refaz todo o trabalho a cada frame: decodifica o UTF-8, procura cada glifo na fonte, calcula a
+// posição de cada letra (e o MeasureText faz tudo de novo para centralizar). Aqui o texto vira uma sequência
+// de glifos já posicionados, com as coordenadas na textura da fonte, e desenhar é só enviar os quadriláteros.
+// O layout só é refeito quando o texto muda: o cronômetro uma vez por segundo, os pontos a cada acerto.
+//
+// Textos variáveis usam um TextoCacheado próprio:
+//
+//     static TextoCacheado textoPontos;
+//     if (TextoPrecisaAtualizar(&textoPontos, jogo.pontos))
+//         DefinirTexto(&textoPontos, TextFormat("Pontos: %d", jogo.pontos), 30);
+//     DesenharTextoCacheado(&textoPontos, 20, 20, WHITE);
+//
+// Textos fixos (títulos, botões, créditos) passam por DesenharTextoFixo, que guarda o layout numa tabela na
+// primeira vez que o texto aparece. O desenho usa a fonte padrão, igual ao DrawText, e o painel F2 mostra
+// quantos layouts foram refeitos no frame.
+//
+// Compilado com -DTEXTO_SEM_CACHE, tudo volta a passar pelo DrawText/MeasureText a cada frame, para comparar
+// o tempo da fase "Texto" no perfilador (F3 ou --perfil) com e sem o cache.
+
+#define MAX_BYTES_TEXTO 96  // Textos maiores são cortados e desenhados pelo DrawText, sem cache.
+#define MAX_GLIFOS_TEXTO 64 // Glifos visíveis por texto (espaços não contam).
+
+// Um glifo posicionado: retângulo de destino relativo à origem do texto e coordenadas na textura da fonte.
+typedef struct {
+    float x, y, largura, altura;
+    float u0, v0, u1, v1;
+} GlifoTexto;
+
+typedef struct {
+    char texto[MAX_BYTES_TEXTO]; // Texto do layout atual.
+    int tamanho;                 // Tamanho da fonte (o mesmo parâmetro do DrawText).
+    int largura;                 // Largura em pixels, igual à do MeasureText.
+    int chave;                   // Valor que gerou o texto (ex.: os pontos), usado por TextoPrecisaAtualizar.
+    bool definido;               // false até o primeiro DefinirTexto.
+    bool emCache;                // false se o texto não coube no cache (é desenhado pelo DrawText).
+    unsigned int textura;        // Textura da fonte usada no layout.
+    int totalGlifos;
+    GlifoTexto glifos[MAX_GLIFOS_TEXTO];
+} TextoCacheado;
+
+// Retorna true na primeira chamada e sempre que 'chave' mudar; o chamador então monta o texto e chama DefinirTexto.
+// Evita até o TextFormat nos frames em que o valor não mudou.
+bool TextoPrecisaAtualizar(TextoCacheado* texto, int chave);
+
+// Troca o texto. O layout só é refeito se o texto ou o tamanho forem diferentes dos atuais.
+void DefinirTexto(TextoCacheado* texto, const char* conteudo, int tamanho);
+
+// Desenha o texto com o canto superior esquerdo em (x, y).
+void DesenharTextoCacheado(const TextoCacheado* texto, int x, int y, Color cor);
+
+// Layout de um texto fixo, guardado na tabela na primeira vez que é pedido.
+const TextoCacheado* TextoFixo(const char* conteudo, int tamanho);
+
+// Desenha um texto fixo em (x, y), ou centralizado horizontalmente em 'centroX'.
+void DesenharTextoFixo(const char* conteudo, int x, int y, int tamanho, Color cor);
+void DesenharTextoFixoCentralizado(const char* conteudo, int centroX, int y, int tamanho, Color cor);
+
+#endif
@@ -0,0 +1,208 @@
+#include "versus.h"
+#include <string.h>
+
+#define NENHUM_ERRO INT64_MAX
+#define TICKS_ENTRE_SINCRONIZACOES 10 // No máximo uma parada para sincronizar a cada 10 ticks.
+
+bool IniciarSessaoVersus(SessaoVersus* sessao, EstadoJogo* jogo, const ConfiguracaoJogo* configuracao, int jogadorLocal, int atraso) {
+    if (atraso < 0)
+        atraso = 0;
+    if (atraso > MAX_ATRASO_VERSUS)
+        atraso = MAX_ATRASO_VERSUS;
+    if (!InicializarEstadoJogo(jogo, configuracao))
+        return false;
+    jogo->gravacao = NULL; // O versus não é gravado: a gravação só tem os cliques de um jogador.
+    sessao->jogo = jogo;
+    sessao->pontos[0] = sessao->pontos[1] = 0;
+    sessao->jogadorLocal = jogadorLocal;
+    sessao->atraso = atraso;
+    sessao->quadro = 0;
+    sessao->tickLimite = jogo->tickFimJogo;
+    // Os primeiros 'atraso' ticks dos dois jogadores são vazios: ninguém clicou antes da partida começar.
+    sessao->ultimoLocal = atraso - 1;
+    sessao->ultimoRemoto = atraso - 1;
+    sessao->primeiroErro = NENHUM_ERRO;
+    sessao->aFrenteRival = 0;
+    sessao->vantagem = 0.0f;
+    sessao->ultimaSincronizacao = 0;
+    sessao->refeitosUltimoPasso = 0;
+    memset(sessao->entradas, 0, sizeof(sessao->entradas));
+    memset(&sessao->estatisticas, 0, sizeof(sessao->estatisticas));
+    return true;
+}
+
+void LiberarSessaoVersus(SessaoVersus* sessao) {
+    for (int i = 0; i < HISTORICO_VERSUS; i++)
+        LiberarInstantaneo(&sessao->instantaneos[i]);
+}
+
+// Pontos de um acerto, como no AplicarClique, mas para o jogador que clicou. Cada jogador tem a sua pontuação,
+// que também nunca fica negativa.
+static void PontuarAcerto(SessaoVersus* sessao, int jogador, int buraco) {
+    const EstadoJogo* jogo = sessao->jogo;
+    int* pontos = &sessao->pontos[jogador];
+    switch (jogo->capivaras.tipo[buraco]) {
+        case NORMAL:
+            *pontos += 1;
+        break;
+        case DOURADA:
+            *pontos += 2;
+        break;
+        case CUTIA:
+            *pontos += PENALIDADE_CUTIA[jogo->dificuldade];
+            if (*pontos < 0)
+                *pontos = 0;
+        break;
+    }
+}
+
+// Simula o tick 't' (a partida está no início dele): os cliques do jogador 0, depois os do jogador 1, e então os
+// eventos até o próximo tick. A entrada do rival que ainda não chegou é prevista como nenhum clique.
+static void SimularTick(SessaoVersus* sessao, int64_t t) {
+    int s = (int)(t & (HISTORICO_VERSUS - 1));
+    for (int j = 0; j < 2; j++) {
+        if (j != sessao->jogadorLocal && t > sessao->ultimoRemoto)
+            continue;
+        const EntradaVersus* e = &sessao->entradas[j][s];
+        for (int k = 0; k < e->totalCliques; k++) {
+            int buraco = AplicarClique(sessao->jogo, e->x[k], e->y[k]);
+            if (buraco >= 0)
+                PontuarAcerto(sessao, j, buraco);
+        }
+    }
+    AvancarJogoAte(sessao->jogo, t + 1);
+}
+
+// Guarda a partida e os pontos no início do tick 't'.
+static bool SalvarTick(SessaoVersus* sessao, int64_t t) {
+    int s = (int)(t & (HISTORICO_VERSUS - 1));
+    if (!SalvarInstantaneo(sessao->jogo, &sessao->instantaneos[s]))
+        return false;
+    sessao->pontosInstantaneo[s][0] = sessao->pontos[0];
+    sessao->pontosInstantaneo[s][1] = sessao->pontos[1];
+    return true;
+}
+
+int RefazerSessaoVersus(SessaoVersus* sessao, int64_t desde) {
+    if (desde < 0)
+        desde = 0;
+    // Só os últimos ticks têm instantâneo; a previsão nunca passa de JANELA_ROLLBACK, então um erro sempre cabe.
+    if (desde >= sessao->quadro || desde <= sessao->quadro - HISTORICO_VERSUS)
+        return 0;
+    int s = (int)(desde & (HISTORICO_VERSUS - 1));
+    if (!RestaurarInstantaneo(sessao->jogo, &sessao->instantaneos[s]))
+        return -1;
+    sessao->pontos[0] = sessao->pontosInstantaneo[s][0];
+    sessao->pontos[1] = sessao->pontosInstantaneo[s][1];
+    for (int64_t t = desde; t < sessao->quadro; t++) {
+        if (t > desde)
+            SalvarTick(sessao, t); // Não falha: o instantâneo já guardou este tick antes, com a mesma arena.
+        SimularTick(sessao, t);
+    }
+    // Os acertos refeitos já foram mostrados quando o tick foi simulado pela primeira vez (ou eram previsão errada).
+    sessao->jogo->totalAcertosRecentes = 0;
+    return (int)(sessao->quadro - desde);
+}
+
+int TicksPrevistosVersus(const SessaoVersus* sessao) {
+    return (int)(sessao->quadro - 1 - sessao->ultimoRemoto);
+}
+
+PassoVersus AvancarSessaoVersus(SessaoVersus* sessao, const EntradaVersus* entrada) {
+    EstatisticasVersus* e = &sessao->estatisticas;
+    sessao->refeitosUltimoPasso = 0;
+    if (sessao->primeiroErro != NENHUM_ERRO) {
+        int refeitos = RefazerSessaoVersus(sessao, sessao->primeiroErro);
+        if (refeitos < 0)
+            return PASSO_ESPERANDO; // O erro continua marcado e o rollback é tentado de novo no próximo passo.
+        sessao->primeiroErro = NENHUM_ERRO;
+        sessao->refeitosUltimoPasso = refeitos;
+        e->rollbacks++;
+        e->ticksRefeitos += refeitos;
+        if (refeitos > e->maxRefeitos)
+            e->maxRefeitos = refeitos;
+    }
+    if (sessao->quadro >= sessao->tickLimite)
+        return PASSO_ACABOU;
+
+    // Sem a entrada do rival há JANELA_ROLLBACK ticks, a sessão para: um erro mais antigo não teria instantâneo.
+    int previstos = TicksPrevistosVersus(sessao);
+    if (previstos >= JANELA_ROLLBACK) {
+        e->esperas++;
+        return PASSO_ESPERANDO;
+    }
+    // Quem prevê mais ticks que o rival está à frente dele no tempo: para um tick de vez em quando até os dois
+    // preverem o mesmo tanto. Sem isso, quem começou antes faria rollback o tempo todo. A média móvel filtra o
+    // jitter, que sozinho muda a diferença em um ou dois ticks de um pacote para o outro.
+    sessao->vantagem += 0.05f * ((float)(previstos - sessao->aFrenteRival) - sessao->vantagem);
+    if (sessao->vantagem >= 2.0f && sessao->quadro - sessao->ultimaSincronizacao >= TICKS_ENTRE_SINCRONIZACOES) {
+        sessao->ultimaSincronizacao = sessao->quadro;
+        e->sincronizacoes++;
+        return PASSO_SINCRONIZANDO;
+    }
+
+    // O tick é salvo antes de usar a entrada: sem memória para o instantâneo, a entrada fica para o próximo passo.
+    if (!SalvarTick(sessao, sessao->quadro))
+        return PASSO_ESPERANDO;
+    // A entrada local vale 'atraso' ticks à frente.
+    EntradaVersus* destino = &sessao->entradas[sessao->jogadorLocal][(sessao->ultimoLocal + 1) & (HISTORICO_VERSUS - 1)];
+    *destino = *entrada;
+    if (destino->totalCliques > MAX_CLIQUES_VERSUS)
+        destino->totalCliques = MAX_CLIQUES_VERSUS;
+    sessao->ultimoLocal++;
+
+    SimularTick(sessao, sessao->quadro);
+    sessao->quadro++;
+    e->ticks++;
+    return PASSO_AVANCOU;
+}
+
+bool ReceberEntradaVersus(SessaoVersus* sessao, int64_t tick, const EntradaVersus* entrada) {
+    // Só em ordem, e sem passar do histórico (o rival nunca fica tão à frente enquanto os dois respeitam a janela).
+    if (tick != sessao->ultimoRemoto + 1 || tick >= sessao->quadro + HISTORICO_VERSUS / 2)
+        return false;
+    int jogador = 1 - sessao->jogadorLocal;
+    EntradaVersus* destino = &sessao->entradas[jogador][tick & (HISTORICO_VERSUS - 1)];
+    *destino = *entrada;
+    if (destino->totalCliques > MAX_CLIQUES_VERSUS)
+        destino->totalCliques = MAX_CLIQUES_VERSUS;
+    sessao->ultimoRemoto = tick;
+    // O tick já simulado usou a previsão (nenhum clique): só uma entrada com cliques o deixa errado.
+    if (tick < sessao->quadro && destino->totalCliques > 0 && tick < sessao->primeiroErro)
+        sessao->primeiroErro = tick;
+    return true;
+}
+
+bool SessaoVersusConfirmada(const SessaoVersus* sessao) {
+    return sessao->quadro >= sessao->tickLimite && sessao->ultimoRemoto >= sessao->tickLimite - 1 && sessao->primeiroErro == NENHUM_ERRO;
+}
+
+// FNV-1a de 64 bits.
+static uint64_t Misturar(uint64_t h, const void* dados, size_t tamanho) {
+    const uint8_t* p = (const uint8_t*)dados;
+    for (size_t i = 0; i < tamanho; i++) {
+        h ^= p[i];
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+uint64_t ResumoSessaoVersus(const SessaoVersus* sessao) {
+    // Só os campos da simulação: os bytes de alinhamento da arena não são iniciados e mudam de uma máquina para outra.
+    const EstadoJogo* jogo = sessao->jogo;
+    const Capivaras* c = &jogo->capivaras;
+    size_t n = (size_t)jogo->totalCapivaras;
+    uint64_t h = 0xCBF29CE484222325ULL;
+    h = Misturar(h, &jogo->tick, sizeof(jogo->tick));
+    h = Misturar(h, sessao->pontos, sizeof(sessao->pontos));
+    h = Misturar(h, &jogo->gerador.estado, sizeof(jogo->gerador.estado));
+    h = Misturar(h, &jogo->tickFimChuva, sizeof(jogo->tickFimChuva));
+    h = Misturar(h, &jogo->capivarasVisiveis, sizeof(jogo->capivarasVisiveis));
+    h = Misturar(h, c->visivel, n * sizeof(bool));
+    h = Misturar(h, c->hit, n * sizeof(bool));
+    h = Misturar(h, c->machucada, n * sizeof(bool));
+    h = Misturar(h, c->tipo, n * sizeof(uint8_t));
+    h = Misturar(h, c->tickEvento, n * sizeof(int64_t));
+    h = Misturar(h, c->tickSurgimento, n * sizeof(int64_t));
+    return h;
+}
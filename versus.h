@@ -0,0 +1,92 @@
+#ifndef VERSUS_H
+#define VERSUS_H
+
+#include "logica.h"
+
+// --- MODO VERSUS (DOIS JOGADORES NO MESMO TABULEIRO) ---
+// Os dois jogadores batem nos mesmos animais de uma partida com a mesma semente, cada um na sua máquina. Cada lado
+// roda a simulação inteira; só os cliques de cada tick viajam pela rede (rede_versus.c). Em cada tick, os cliques do
+// jogador 0 são aplicados antes dos do jogador 1, então se os dois acertarem o mesmo animal no mesmo tick, o ponto é
+// do jogador 0 nas duas máquinas.
+//
+// Para a rede não atrasar o jogo, a sessão usa rollback: o clique local entra alguns ticks no futuro (atraso de
+// entrada, que esconde parte da latência) e a entrada do rival que ainda não chegou é prevista como "nenhum clique".
+// Quando ela chega e tinha cliques, a partida volta ao instantâneo do tick errado e refaz os ticks seguintes com a
+// entrada certa, tudo dentro do mesmo frame. Um instantâneo por tick custa um memcpy da arena (uns 40 ns com 5
+// buracos), e refazer a janela inteira custa alguns microssegundos. Este módulo não depende da Raylib nem da rede.
+
+#define MAX_CLIQUES_VERSUS 4    // Cliques de um jogador aceitos por tick (os seguintes ficam para o próximo tick).
+#define JANELA_ROLLBACK 32      // Máximo de ticks previstos sem a entrada do rival (~270 ms); depois a sessão espera.
+#define MAX_ATRASO_VERSUS 8     // Maior atraso de entrada aceito, em ticks.
+#define HISTORICO_VERSUS 128    // Ticks guardados de entrada e instantâneos (potência de 2, > 2 * (janela + atraso)).
+
+// Cliques de um jogador em um tick. As posições são inteiras para as duas máquinas aplicarem exatamente o mesmo
+// clique (o float da tela não passa pela rede).
+typedef struct {
+    uint8_t totalCliques;
+    uint16_t x[MAX_CLIQUES_VERSUS], y[MAX_CLIQUES_VERSUS];
+} EntradaVersus;
+
+typedef struct {
+    int64_t ticks;          // Ticks simulados pela primeira vez.
+    int64_t rollbacks;      // Vezes que a entrada do rival desmentiu a previsão.
+    int64_t ticksRefeitos;  // Soma dos ticks refeitos em todos os rollbacks.
+    int maxRefeitos;        // Maior rollback, em ticks.
+    int64_t esperas;        // Passos parados porque a janela de previsão encheu (rival atrasado demais).
+    int64_t sincronizacoes; // Passos parados de propósito para não ficar à frente do rival.
+} EstatisticasVersus;
+
+typedef struct {
+    EstadoJogo* jogo;             // Partida compartilhada (o 'pontos' dela soma os dois jogadores e não é usado).
+    int pontos[2];                // Pontos de cada jogador.
+    int jogadorLocal;             // 0 ou 1.
+    int atraso;                   // Atraso de entrada em ticks (o mesmo nas duas máquinas).
+    int64_t quadro;               // Próximo tick a simular.
+    int64_t tickLimite;           // A sessão não simula deste tick em diante (o fim da partida, por padrão).
+    int64_t ultimoLocal;          // Último tick com a entrada local definida (quadro + atraso - 1).
+    int64_t ultimoRemoto;         // Último tick com a entrada do rival recebida; os seguintes são previstos.
+    int64_t primeiroErro;         // Menor tick simulado com a previsão errada (INT64_MAX se nenhum).
+    int aFrenteRival;             // Ticks que o rival estava prevendo no último pacote dele.
+    float vantagem;               // Média móvel de (ticks previstos aqui - aFrenteRival): > 0 quer dizer à frente do rival.
+    int64_t ultimaSincronizacao;  // Quadro da última parada para sincronizar.
+    int refeitosUltimoPasso;      // Ticks refeitos pelo último AvancarSessaoVersus.
+    EntradaVersus entradas[2][HISTORICO_VERSUS]; // Entrada de cada jogador no tick t, em [t % HISTORICO_VERSUS].
+    InstantaneoJogo instantaneos[HISTORICO_VERSUS]; // A partida no início de cada tick.
+    int pontosInstantaneo[HISTORICO_VERSUS][2];
+    EstatisticasVersus estatisticas;
+} SessaoVersus;
+
+typedef enum {
+    PASSO_AVANCOU,        // Um tick simulado; a entrada local foi usada.
+    PASSO_ESPERANDO,      // Janela de previsão cheia: a entrada local não foi usada.
+    PASSO_SINCRONIZANDO,  // Parado um tick para o rival alcançar: a entrada local não foi usada.
+    PASSO_ACABOU          // A sessão chegou em 'tickLimite'.
+} PassoVersus;
+
+// Começa uma sessão na partida 'jogo' com esta configuração. Na primeira vez, 'sessao' deve estar zerada; as
+// seguintes reaproveitam a memória dos instantâneos. Retorna false se faltar memória para a partida.
+bool IniciarSessaoVersus(SessaoVersus* sessao, EstadoJogo* jogo, const ConfiguracaoJogo* configuracao, int jogadorLocal, int atraso);
+void LiberarSessaoVersus(SessaoVersus* sessao);
+
+// Refaz os ticks com a previsão errada, se houver, e simula o próximo tick com a entrada local 'entrada'
+// (aplicada 'atraso' ticks depois). Se não avançar, a entrada não foi usada e deve ser passada de novo.
+PassoVersus AvancarSessaoVersus(SessaoVersus* sessao, const EntradaVersus* entrada);
+
+// Entrada do rival no tick 'tick'. Só aceita o tick seguinte ao último recebido (retorna false nos outros, que
+// já chegaram ou virão de novo no próximo pacote).
+bool ReceberEntradaVersus(SessaoVersus* sessao, int64_t tick, const EntradaVersus* entrada);
+
+// Volta a partida ao início do tick 'desde' e refaz até o quadro atual. Retorna quantos ticks foram refeitos, ou -1
+// se faltar memória para voltar (a partida fica como estava).
+int RefazerSessaoVersus(SessaoVersus* sessao, int64_t desde);
+
+// true quando a sessão chegou no limite com todas as entradas do rival: o resultado não muda mais.
+bool SessaoVersusConfirmada(const SessaoVersus* sessao);
+
+// Ticks que a sessão está prevendo além da última entrada do rival.
+int TicksPrevistosVersus(const SessaoVersus* sessao);
+
+// Resumo (hash) do estado da partida e dos pontos, para conferir se as duas máquinas chegaram no mesmo lugar.
+uint64_t ResumoSessaoVersus(const SessaoVersus* sessao);
+
+#endif